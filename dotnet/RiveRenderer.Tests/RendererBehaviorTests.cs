@@ -1,5 +1,13 @@
 using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.Compression;
+using System.Linq;
+using System.Runtime.InteropServices;
+using Microsoft.Win32.SafeHandles;
 using RiveRenderer.Tests.TestUtilities;
+using Xunit;
 
 namespace RiveRenderer.Tests;
 
@@ -51,6 +59,1194 @@ public class RendererBehaviorTests
         }
     }
 
+    [RequiresNativeLibraryFact]
+    public void NullBackendRasterizesPath()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var context = device.CreateContext(width, height);
+        using var path = context.CreatePath();
+        using var paint = context.CreatePaint();
+
+        path.MoveTo(8, 8);
+        path.LineTo(24, 8);
+        path.LineTo(24, 24);
+        path.LineTo(8, 24);
+        path.Close();
+
+        paint.SetStyle(PaintStyle.Fill);
+        paint.SetColor(0xFFFF0000);
+
+        context.BeginFrame();
+        using (var renderer = context.CreateRenderer())
+        {
+            renderer.DrawPath(path, paint);
+        }
+        context.EndFrame();
+
+        var pixels = new byte[width * height * 4];
+        context.CopyCpuFramebuffer(pixels);
+
+        var inside = (int)((16 * width + 16) * 4);
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, pixels[inside..(inside + 4)]);
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, pixels[..4]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRasterizesAppendedPathCommands()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var context = device.CreateContext(width, height);
+        using var path = context.CreatePath();
+        using var paint = context.CreatePaint();
+
+        // A verb that needs more points than supplied is rejected without touching the path.
+        Assert.Throws<RendererException>(() => path.AppendCommands(new[] { PathVerb.Cubic }, new float[] { 8, 8 }));
+
+        path.AppendCommands(
+            new[] { PathVerb.Move, PathVerb.Line, PathVerb.Quad, PathVerb.Line, PathVerb.Close },
+            new float[] { 8, 8, 24, 8, 24, 24, 24, 24, 8, 24 });
+        paint.SetColor(0xFFFF0000);
+
+        context.BeginFrame();
+        using (var renderer = context.CreateRenderer())
+        {
+            renderer.DrawPath(path, paint);
+        }
+        context.EndFrame();
+
+        var pixels = new byte[width * height * 4];
+        context.CopyCpuFramebuffer(pixels);
+
+        var inside = (int)((16 * width + 16) * 4);
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, pixels[inside..(inside + 4)]);
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, pixels[..4]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendSharesImmutablePathAcrossContexts()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        var verbs = new[] { PathVerb.Move, PathVerb.Line, PathVerb.Quad, PathVerb.Close };
+        var points = new float[] { 8, 24, 24, 24, 16, -8, 8, 24 };
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var path = device.CreateImmutablePath(verbs, points);
+        using var same = device.CreateImmutablePath(verbs, points);
+
+        // The quad's control point sits at y = -8, but the curve only reaches y = 8.
+        Assert.Equal(8f, path.Bounds.Top, 3);
+        Assert.Equal(24f, path.Bounds.Bottom);
+        Assert.Equal(path.ContentHash, same.ContentHash);
+
+        foreach (var _ in new[] { 0, 1 })
+        {
+            using var context = device.CreateContext(width, height);
+            using var paint = context.CreatePaint();
+            paint.SetColor(0xFFFF0000);
+
+            context.BeginFrame();
+            using (var renderer = context.CreateRenderer())
+            {
+                renderer.DrawPath(path, paint);
+            }
+            context.EndFrame();
+
+            var pixels = new byte[width * height * 4];
+            context.CopyCpuFramebuffer(pixels);
+
+            var inside = (int)((20 * width + 16) * 4);
+            Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, pixels[inside..(inside + 4)]);
+            Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, pixels[..4]);
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRebuildsImmutablePathsCreatedAfterRelease()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var context = device.CreateContext(width, height);
+        using var paint = context.CreatePaint();
+        paint.SetColor(0xFFFF0000);
+
+        var verbs = new[] { PathVerb.Move, PathVerb.Line, PathVerb.Line, PathVerb.Line, PathVerb.Close };
+
+        // Each path replaces the last one, which the allocator may place at the same address. The context must still
+        // draw the new geometry rather than the render path it cached for the released one.
+        for (var i = 0; i < 4; i++)
+        {
+            var left = i * 8f;
+            using var path = device.CreateImmutablePath(verbs,
+                new[] { left, 0, left + 8, 0, left + 8, 8, left, 8 });
+
+            context.BeginFrame();
+            using (var renderer = context.CreateRenderer())
+            {
+                renderer.DrawPath(path, paint);
+            }
+            context.EndFrame();
+
+            var pixels = new byte[width * height * 4];
+            context.CopyCpuFramebuffer(pixels);
+            for (var column = 0; column < 4; column++)
+            {
+                var offset = (int)((4 * width + column * 8 + 4) * 4);
+                Assert.Equal(column == i ? (byte)0xFF : (byte)0x00, pixels[offset + 3]);
+            }
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendDrawsInternedPathsIndependently()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var context = device.CreateContext(width, height);
+        context.SetPathInterning(true);
+        using var first = context.CreatePath();
+        using var second = context.CreatePath();
+        using var paint = context.CreatePaint();
+
+        void AddRect(RenderPath path, float left, float top, float right, float bottom)
+        {
+            path.MoveTo(left, top);
+            path.LineTo(right, top);
+            path.LineTo(right, bottom);
+            path.LineTo(left, bottom);
+            path.Close();
+        }
+
+        paint.SetColor(0xFFFF0000);
+
+        byte[] Render(RenderPath path)
+        {
+            context.BeginFrame();
+            using (var renderer = context.CreateRenderer())
+            {
+                renderer.DrawPath(path, paint);
+            }
+            context.EndFrame();
+
+            var pixels = new byte[width * height * 4];
+            context.CopyCpuFramebuffer(pixels);
+            return pixels;
+        }
+
+        AddRect(first, 0, 0, 16, 16);
+        AddRect(second, 0, 0, 16, 16);
+        Assert.Equal(Render(first), Render(second));
+
+        // Editing one of two identical paths must not change the other.
+        second.Rewind();
+        AddRect(second, 16, 16, 32, 32);
+        var moved = Render(second);
+        var original = Render(first);
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, original[..4]);
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, moved[..4]);
+        var corner = (int)((31 * width + 31) * 4);
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, moved[corner..(corner + 4)]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendReplaysPictureWithTransformAndOpacity()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var recorder = scene.Context.CreatePictureRecorder();
+        scene.Paint.SetColor(0xFFFF0000);
+
+        recorder.Renderer.DrawPath(scene.Square, scene.Paint);
+        using var picture = recorder.Finish();
+
+        scene.Context.BeginFrame();
+        using (var renderer = scene.Context.CreateRenderer())
+        {
+            renderer.DrawPicture(picture);
+            renderer.DrawPicture(picture, new Mat2D { XX = 1, YY = 1, TX = 16, TY = 16 }, 0.5f);
+        }
+        scene.Context.EndFrame();
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 4, 4));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 12, 12));
+        var faded = NullBackendScene.Pixel(pixels, stride, 20, 20);
+        Assert.InRange(faded[3], 0x7F, 0x80);
+        Assert.Equal(faded[3], faded[0]);
+        Assert.Equal(0, faded[1]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendCullsPictureDrawsOutsideViewport()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var recorder = scene.Context.CreatePictureRecorder();
+        var stride = (int)scene.Width * 4;
+        scene.Paint.SetColor(0xFF00FF00);
+
+        // A 10x10 grid of 16x16 squares, 32 units apart, far larger than the target.
+        for (var y = 0; y < 10; y++)
+        {
+            for (var x = 0; x < 10; x++)
+            {
+                recorder.Renderer.Save();
+                recorder.Renderer.Transform(new Mat2D { XX = 2, YY = 2, TX = x * 32, TY = y * 32 });
+                recorder.Renderer.DrawPath(scene.Square, scene.Paint);
+                recorder.Renderer.Restore();
+            }
+        }
+        using var picture = recorder.Finish();
+
+        PictureStats DrawFrame()
+        {
+            var before = scene.Context.PictureStats;
+            scene.Context.BeginFrame();
+            using (var renderer = scene.Context.CreateRenderer())
+            {
+                renderer.DrawPicture(picture, new Mat2D { XX = 1, YY = 1, TX = -100, TY = -100 });
+            }
+            scene.Context.EndFrame();
+            var after = scene.Context.PictureStats;
+            return new PictureStats
+            {
+                DrawsReplayed = after.DrawsReplayed - before.DrawsReplayed,
+                DrawsCulled = after.DrawsCulled - before.DrawsCulled,
+            };
+        }
+
+        // Only the squares in columns and rows 3 and 4 reach the target.
+        var stats = DrawFrame();
+        Assert.Equal(4ul, stats.DrawsReplayed);
+        Assert.Equal(96ul, stats.DrawsCulled);
+        var pixels = scene.CopyFramebuffer();
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 2, 2));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 14, 14));
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 30, 30));
+
+        // Shrinking the square stays within the indexed bounds, so the same draws are culled.
+        SetSquare(scene.Square, 4);
+        stats = DrawFrame();
+        Assert.Equal(4ul, stats.DrawsReplayed);
+        Assert.Equal(96ul, stats.DrawsCulled);
+
+        // Growing it to 80x80 outgrows them. The index is refitted instead of dropped, and columns and rows 1 to 4
+        // now reach the target.
+        SetSquare(scene.Square, 40);
+        stats = DrawFrame();
+        Assert.Equal(16ul, stats.DrawsReplayed);
+        Assert.Equal(84ul, stats.DrawsCulled);
+        pixels = scene.CopyFramebuffer();
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 14, 14));
+
+        static void SetSquare(RenderPath path, float size)
+        {
+            path.Rewind();
+            path.MoveTo(0, 0);
+            path.LineTo(size, 0);
+            path.LineTo(size, size);
+            path.LineTo(0, size);
+            path.Close();
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendInvalidatesRefittedPictureBounds()
+    {
+        using var scene = new NullBackendScene(64, 64);
+        using var recorder = scene.Context.CreatePictureRecorder();
+        recorder.Renderer.DrawPath(scene.Square, scene.Paint);
+        using var picture = recorder.Finish();
+        scene.Context.SetDamageTracking(true);
+        scene.RenderSquareFrame(0xFFFF0000);
+        scene.RenderSquareFrame(0xFFFF0000);
+
+        // The square grows past the bounds it was recorded with; the damage follows it instead of covering the target.
+        scene.Square.LineTo(20, 20);
+        scene.Context.Invalidate(picture);
+        scene.RenderSquareFrame(0xFFFF0000);
+
+        var damage = scene.Context.FrameDamage;
+        Assert.Equal(0f, damage.Left);
+        Assert.Equal(0f, damage.Top);
+        Assert.InRange(damage.Right, 20f, 21f);
+        Assert.InRange(damage.Bottom, 20f, 21f);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendReplaysPathsEditedAfterRecording()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var recorder = scene.Context.CreatePictureRecorder();
+
+        // Recorded well outside the target, then moved back into it.
+        scene.Square.Rewind();
+        scene.Square.MoveTo(100, 100);
+        scene.Square.LineTo(108, 100);
+        scene.Square.LineTo(108, 108);
+        scene.Square.Close();
+        scene.Paint.SetColor(0xFF0000FF);
+
+        recorder.Renderer.DrawPath(scene.Square, scene.Paint);
+        using var picture = recorder.Finish();
+
+        scene.Square.Rewind();
+        scene.Square.MoveTo(0, 0);
+        scene.Square.LineTo(8, 0);
+        scene.Square.LineTo(8, 8);
+        scene.Square.LineTo(0, 8);
+        scene.Square.Close();
+
+        scene.Context.BeginFrame();
+        using (var renderer = scene.Context.CreateRenderer())
+        {
+            renderer.DrawPicture(picture);
+        }
+        scene.Context.EndFrame();
+
+        var pixels = scene.CopyFramebuffer();
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, (int)scene.Width * 4, 4, 4));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRedrawsOnlyDamagedRegion()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var fill = scene.Context.CreatePath();
+
+        fill.MoveTo(0, 0);
+        fill.LineTo(scene.Width, 0);
+        fill.LineTo(scene.Width, scene.Height);
+        fill.LineTo(0, scene.Height);
+        fill.Close();
+        scene.Context.SetDamageTracking(true);
+
+        void Fill(uint color)
+        {
+            scene.Paint.SetColor(color);
+            scene.Context.BeginFrame();
+            using (var renderer = scene.Context.CreateRenderer())
+            {
+                renderer.DrawPath(fill, scene.Paint);
+            }
+            scene.Context.EndFrame();
+        }
+
+        Fill(0xFFFF0000);
+        scene.Context.Invalidate(new DamageRect(0, 0, 8, 8));
+        Fill(0xFF0000FF);
+
+        var damage = scene.Context.FrameDamage;
+        Assert.Equal(new DamageRect(0, 0, 8, 8), damage);
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, stride, 4, 4));
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 12, 4));
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 4, 12));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendClipsRenderersKeptAcrossFramesToDamage()
+    {
+        using var scene = new NullBackendScene();
+        using var fill = scene.Context.CreatePath();
+        using var renderer = scene.Context.CreateRenderer();
+
+        fill.MoveTo(0, 0);
+        fill.LineTo(scene.Width, 0);
+        fill.LineTo(scene.Width, scene.Height);
+        fill.LineTo(0, scene.Height);
+        fill.Close();
+        scene.Context.SetDamageTracking(true);
+
+        void Fill(uint color)
+        {
+            scene.Paint.SetColor(color);
+            scene.Context.BeginFrame();
+            renderer.DrawPath(fill, scene.Paint);
+            scene.Context.EndFrame();
+        }
+
+        Fill(0xFFFF0000);
+        scene.Context.Invalidate(new DamageRect(0, 0, 8, 8));
+        Fill(0xFF0000FF);
+        scene.Context.Invalidate(new DamageRect(8, 8, 16, 16));
+        Fill(0xFF00FF00);
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, stride, 4, 4));
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 12, 4));
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 12, 12));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendInvalidatesPictureClipChanges()
+    {
+        using var scene = new NullBackendScene();
+        using var paint = scene.Context.CreatePaint();
+        using var triangle = scene.Context.CreatePath();
+        using var rect = scene.Context.CreatePath();
+        using var recorder = scene.Context.CreatePictureRecorder();
+        triangle.MoveTo(0, 0);
+        triangle.LineTo(16, 0);
+        triangle.LineTo(0, 16);
+        triangle.Close();
+        rect.MoveTo(0, 0);
+        rect.LineTo(16, 0);
+        rect.LineTo(16, 16);
+        rect.LineTo(0, 16);
+        rect.Close();
+
+        // Both clips cover the square's bounds, so only the clip path tells the recordings apart.
+        RenderPicture Record(RenderPath clip)
+        {
+            recorder.Renderer.Save();
+            recorder.Renderer.ClipPath(clip);
+            recorder.Renderer.DrawPath(scene.Square, paint);
+            recorder.Renderer.Restore();
+            return recorder.Finish();
+        }
+
+        using var first = Record(triangle);
+        using var same = Record(triangle);
+        using var clipped = Record(rect);
+        scene.Context.SetDamageTracking(true);
+        scene.RenderSquareFrame(0xFFFF0000);
+
+        scene.Context.InvalidateChanges(first, same);
+        scene.RenderSquareFrame(0xFFFF0000);
+        Assert.True(scene.Context.FrameDamage.IsEmpty);
+
+        scene.Context.InvalidateChanges(first, clipped);
+        scene.RenderSquareFrame(0xFFFF0000);
+        Assert.Equal(new DamageRect(0, 0, 8, 8), scene.Context.FrameDamage);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendInvalidatesPicturePaintChanges()
+    {
+        using var scene = new NullBackendScene();
+        using var paint = scene.Context.CreatePaint();
+        using var recorder = scene.Context.CreatePictureRecorder();
+
+        RenderPicture Record()
+        {
+            recorder.Renderer.DrawPath(scene.Square, paint);
+            return recorder.Finish();
+        }
+
+        paint.SetColor(0xFFFF0000);
+        using var red = Record();
+        using var stillRed = Record();
+        scene.Context.SetDamageTracking(true);
+        scene.RenderSquareFrame(0xFFFF0000);
+
+        scene.Context.InvalidateChanges(red, stillRed);
+        scene.RenderSquareFrame(0xFFFF0000);
+        Assert.True(scene.Context.FrameDamage.IsEmpty);
+
+        // The same paint handle with only its color changed.
+        paint.SetColor(0xFF0000FF);
+        using var blue = Record();
+        scene.Context.InvalidateChanges(stillRed, blue);
+        scene.RenderSquareFrame(0xFFFF0000);
+        Assert.Equal(new DamageRect(0, 0, 8, 8), scene.Context.FrameDamage);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendKeepsEachFrameInFlightIntact()
+    {
+        const int frameCount = 6;
+        var colors = new[] { 0xFFFF0000u, 0xFF00FF00u, 0xFF0000FFu, 0xFFFFFF00u, 0xFF00FFFFu, 0xFFFF00FFu };
+
+        using var scene = new NullBackendScene();
+        var context = scene.Context;
+        Assert.Throws<RendererException>(() => context.SetFramesInFlight(0));
+        Assert.Throws<RendererException>(() => context.SetFramesInFlight(RendererContext.MaxFramesInFlight + 1));
+        context.SetFramesInFlight(RendererContext.MaxFramesInFlight);
+        Assert.Equal(0ul, context.CompletedFrame);
+
+        // Each frame's readback is only consumed once the ring has moved on past it, and must still hold that frame.
+        var pending = new Queue<(int Frame, RendererReadback Readback)>();
+        try
+        {
+            for (var frame = 0; frame < frameCount; frame++)
+            {
+                scene.BeginSquareFrame(colors[frame]);
+                Assert.Throws<RendererException>(() => context.SetFramesInFlight(1));
+                pending.Enqueue((frame, context.RequestReadback(new PixelRect(0, 0, 8, 8))));
+                context.EndFrame();
+                context.Submit();
+                Assert.True(context.CompletedFrame <= (ulong)frame + 1);
+
+                while (pending.Count > RendererContext.MaxFramesInFlight - 1)
+                {
+                    var (index, readback) = pending.Dequeue();
+                    using (readback)
+                    {
+                        readback.Wait();
+                        Assert.True(context.CompletedFrame >= (ulong)index + 1);
+                        var expected = BitConverter.GetBytes(colors[index]);
+                        var pixel = NullBackendScene.Pixel(readback.Map(), readback.Stride, 4, 4);
+                        Assert.Equal(new[] { expected[2], expected[1], expected[0], expected[3] }, pixel);
+                    }
+                }
+            }
+        }
+        finally
+        {
+            while (pending.Count > 0)
+            {
+                pending.Dequeue().Readback.Dispose();
+            }
+        }
+
+        context.WaitIdle();
+        Assert.Equal((ulong)frameCount, context.CompletedFrame);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendReadsBackSubmittedFrame()
+    {
+        using var scene = new NullBackendScene();
+        scene.Context.SetFramebufferReadback(true);
+        scene.Context.SetFramesInFlight(RendererContext.MaxFramesInFlight);
+        scene.RenderSquareFrame(0xFF00FF00);
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 0, 0));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 12, 12));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendCompletesAsyncReadback()
+    {
+        using var scene = new NullBackendScene();
+        using var fence = scene.Device.CreateFence();
+        var context = scene.Context;
+
+        scene.BeginSquareFrame(0xFFFF0000);
+        using var readback = context.RequestReadback(new PixelRect(4, 4, 8, 8), PixelFormat.Bgra8Premultiplied);
+        readback.SignalFence(fence, 1);
+        Assert.False(readback.IsReady);
+        Assert.Equal(0ul, fence.GetCompletedValue());
+        context.EndFrame();
+        context.Submit();
+
+        readback.Wait();
+        fence.Wait(1, 0);
+        Assert.Equal(1ul, fence.GetCompletedValue());
+
+        var pixels = readback.Map();
+        Assert.Equal(8 * 8 * 4, pixels.Length);
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, readback.Stride, 0, 0));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, readback.Stride, 6, 6));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendFenceWaitOnAnotherThreadWakesAtSubmit()
+    {
+        using var scene = new NullBackendScene();
+        using var fence = scene.Device.CreateFence();
+        var context = scene.Context;
+
+        scene.BeginSquareFrame(0xFFFF0000);
+        using var readback = context.RequestReadback();
+        readback.SignalFence(fence, 1);
+        var waiter = Task.Run(() => fence.Wait(1));
+        Assert.False(waiter.Wait(50));
+
+        context.EndFrame();
+        context.Submit();
+        Assert.True(waiter.Wait(TimeSpan.FromSeconds(10)));
+        Assert.Equal(1ul, fence.GetCompletedValue());
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendCopiesStridedStraightAlphaRegion()
+    {
+        const int stride = 40;
+
+        using var scene = new NullBackendScene();
+        scene.RenderSquareFrame(0x80FF0000);
+
+        var pixels = new byte[stride * 8];
+        pixels.AsSpan().Fill(0xCD);
+        scene.Context.CopyCpuFramebuffer(pixels, stride, PixelFormat.Bgra8Straight, new PixelRect(4, 4, 8, 8));
+
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0x80 }, NullBackendScene.Pixel(pixels, stride, 0, 0));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 7, 7));
+        Assert.All(pixels[32..stride], value => Assert.Equal(0xCD, value));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendEncodesFramebufferAsPng()
+    {
+        using var scene = new NullBackendScene(16, 12);
+        scene.RenderSquareFrame(0x80FF0000);
+
+        var png = scene.Context.EncodeFramebuffer(ImageEncoding.Png, 100);
+
+        Assert.Equal(new byte[] { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A }, png[..8]);
+        Assert.Equal("IHDR"u8.ToArray(), png[12..16]);
+        Assert.Equal(scene.Width, BinaryPrimitives.ReadUInt32BigEndian(png.AsSpan(16)));
+        Assert.Equal(scene.Height, BinaryPrimitives.ReadUInt32BigEndian(png.AsSpan(20)));
+        Assert.Equal("IEND"u8.ToArray(), png[^8..^4]);
+
+        // The first pixel is stored with straight alpha.
+        var rows = DecodePngRows(png, (int)scene.Width, (int)scene.Height);
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0x80 }, rows[..4]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendEncodesTallFramebufferInBands()
+    {
+        const int width = 24;
+        const int height = 200;
+
+        // The encoder compresses rows in bands of 64. A translucent wedge over the full height changes every row, so
+        // a band that drops, repeats or misfilters its rows shows up as a mismatch.
+        using var scene = new NullBackendScene(width, height);
+        using var wedge = scene.Context.CreatePath();
+        using var wedgePaint = scene.Context.CreatePaint();
+        wedge.MoveTo(0, 0);
+        wedge.LineTo(width, height / 2f);
+        wedge.LineTo(0, height);
+        wedge.Close();
+        wedgePaint.SetColor(0xA03080FF);
+        scene.BeginSquareFrame(0x80FF0000);
+        using (var renderer = scene.Context.CreateRenderer())
+        {
+            renderer.DrawPath(wedge, wedgePaint);
+        }
+
+        scene.Context.EndFrame();
+        scene.Context.Submit();
+
+        const int rowBytes = width * 4;
+        var expected = new byte[rowBytes * height];
+        scene.Context.CopyCpuFramebuffer(expected, rowBytes, PixelFormat.Rgba8Straight);
+        foreach (var quality in new byte[] { 0, 50, 100 })
+        {
+            var rows = DecodePngRows(scene.Context.EncodeFramebuffer(ImageEncoding.Png, quality), width, height);
+            for (var y = 0; y < height; y++)
+            {
+                var row = rows.AsSpan(y * rowBytes, rowBytes);
+                var expectedRow = expected.AsSpan(y * rowBytes, rowBytes);
+                Assert.True(row.SequenceEqual(expectedRow), $"row {y} at quality {quality}");
+            }
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRejectsUnknownEncoding()
+    {
+        using var scene = new NullBackendScene();
+        scene.RenderSquareFrame(0xFF00FF00);
+
+        var ex = Assert.Throws<RendererException>(() => scene.Context.EncodeFramebuffer((ImageEncoding)1));
+        Assert.Equal(RendererStatus.InvalidParameter, ex.Status);
+
+        // The failed request leaves the context able to encode PNG.
+        var png = scene.Context.EncodeFramebuffer(ImageEncoding.Png);
+        var rows = DecodePngRows(png, (int)scene.Width, (int)scene.Height);
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, rows[..4]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRendersBatchInOrder()
+    {
+        const int frameCount = 5;
+
+        using var scene = new NullBackendScene(8, 8);
+        var times = new List<float>();
+        var frames = new List<(int Index, byte[] Pixels)>();
+        var options = new BatchRenderOptions(frameCount, timeStep: 0.5f, startTime: 1f, maxFramesInFlight: 2,
+            format: PixelFormat.Bgra8Straight);
+        scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) =>
+            {
+                times.Add(time);
+                scene.Paint.SetColor(0xFF000000u | (uint)(frameIndex * 40) << 16);
+                renderer.DrawPath(scene.Square, scene.Paint);
+            },
+            (frameIndex, data) => frames.Add((frameIndex, data.ToArray())));
+
+        Assert.Equal(new[] { 1f, 1.5f, 2f, 2.5f, 3f }, times);
+        Assert.Equal(Enumerable.Range(0, frameCount), frames.Select(frame => frame.Index));
+        foreach (var (index, pixels) in frames)
+        {
+            Assert.Equal((int)(scene.Width * scene.Height * 4), pixels.Length);
+            Assert.Equal(new byte[] { 0x00, 0x00, (byte)(index * 40), 0xFF }, pixels[^4..]);
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRendersBatchFromPictures()
+    {
+        using var scene = new NullBackendScene(8, 8);
+        using var recorder = scene.Context.CreatePictureRecorder();
+        var colors = new[] { 0xFFFF0000u, 0xFF0000FFu };
+        var expected = new[] { new byte[] { 0xFF, 0x00, 0x00, 0xFF }, new byte[] { 0x00, 0x00, 0xFF, 0xFF } };
+        var pictures = new List<RenderPicture>();
+        try
+        {
+            foreach (var color in colors)
+            {
+                scene.Paint.SetColor(color);
+                recorder.Renderer.DrawPath(scene.Square, scene.Paint);
+                pictures.Add(recorder.Finish());
+            }
+
+            var frames = new List<(int Index, byte[] Pixels)>();
+            scene.Context.RenderBatch(new BatchRenderOptions(5, timeStep: 1f), pictures,
+                (frameIndex, data) => frames.Add((frameIndex, data.ToArray())));
+
+            // Frame i replays pictures[i % 2].
+            Assert.Equal(Enumerable.Range(0, 5), frames.Select(frame => frame.Index));
+            foreach (var (index, pixels) in frames)
+            {
+                Assert.Equal(expected[index % 2], NullBackendScene.Pixel(pixels, 8 * 4, 4, 4));
+            }
+        }
+        finally
+        {
+            pictures.ForEach(picture => picture.Dispose());
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendEncodesBatchFrames()
+    {
+        using var scene = new NullBackendScene();
+        var frames = new List<(int Index, byte[] Png)>();
+        var options = new BatchRenderOptions(3, timeStep: 1f, encoding: ImageEncoding.Png, quality: 100);
+        scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) =>
+            {
+                scene.Paint.SetColor(0xFF000000u | (uint)(frameIndex * 40) << 16);
+                renderer.DrawPath(scene.Square, scene.Paint);
+            },
+            (frameIndex, data) => frames.Add((frameIndex, data.ToArray())));
+
+        Assert.Equal(new[] { 0, 1, 2 }, frames.Select(frame => frame.Index));
+        foreach (var (index, png) in frames)
+        {
+            var rows = DecodePngRows(png, (int)scene.Width, (int)scene.Height);
+            var stride = (int)scene.Width * 4;
+            var red = (byte)(index * 40);
+            Assert.Equal(new byte[] { red, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(rows, stride, 4, 4));
+            Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(rows, stride, 12, 12));
+        }
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendBatchKeepsFramesInFlightBounded()
+    {
+        const int frameCount = 12;
+        const uint maxFramesInFlight = 2;
+
+        using var scene = new NullBackendScene(8, 8);
+        var delivered = 0;
+        var maxAhead = 0;
+        var options = new BatchRenderOptions(frameCount, timeStep: 1f, maxFramesInFlight: maxFramesInFlight);
+        scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) =>
+            {
+                maxAhead = Math.Max(maxAhead, frameIndex - Volatile.Read(ref delivered));
+                renderer.DrawPath(scene.Square, scene.Paint);
+            },
+            (frameIndex, data) =>
+            {
+                // A slow consumer lets rendering run ahead until every slot is taken.
+                Thread.Sleep(10);
+                Interlocked.Increment(ref delivered);
+            });
+
+        // The frame being drawn holds a slot too, so rendering runs at most maxFramesInFlight - 1 frames ahead. How far
+        // it actually gets depends on scheduling, so only the bound is checked.
+        Assert.Equal(frameCount, delivered);
+        Assert.InRange(maxAhead, 0, (int)maxFramesInFlight - 1);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRejectsBatchFramesInFlightOutOfRange()
+    {
+        using var scene = new NullBackendScene(8, 8);
+        foreach (var maxFramesInFlight in new[] { 0u, RendererContext.MaxBatchFramesInFlight + 1 })
+        {
+            var options = new BatchRenderOptions(2, timeStep: 1f, maxFramesInFlight: maxFramesInFlight);
+            var ex = Assert.Throws<RendererException>(() => scene.Context.RenderBatch(options,
+                (renderer, frameIndex, time) => renderer.DrawPath(scene.Square, scene.Paint),
+                (frameIndex, data) => { }));
+            Assert.Equal(RendererStatus.InvalidParameter, ex.Status);
+        }
+
+        var delivered = 0;
+        scene.Context.RenderBatch(
+            new BatchRenderOptions(2, timeStep: 1f, maxFramesInFlight: RendererContext.MaxBatchFramesInFlight),
+            (renderer, frameIndex, time) => renderer.DrawPath(scene.Square, scene.Paint),
+            (frameIndex, data) => delivered++);
+        Assert.Equal(2, delivered);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRejectsUnknownBatchEncoding()
+    {
+        using var scene = new NullBackendScene(8, 8);
+        var options = new BatchRenderOptions(2, timeStep: 1f, encoding: (ImageEncoding)1);
+
+        var ex = Assert.Throws<RendererException>(() => scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) => renderer.DrawPath(scene.Square, scene.Paint),
+            (frameIndex, data) => { }));
+        Assert.Equal(RendererStatus.InvalidParameter, ex.Status);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRethrowsBatchCallbackExceptions()
+    {
+        using var scene = new NullBackendScene(8, 8);
+        var options = new BatchRenderOptions(6, timeStep: 1f);
+
+        var sceneError = new InvalidOperationException("scene failed");
+        var thrown = Assert.Throws<InvalidOperationException>(() => scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) =>
+            {
+                if (frameIndex == 2)
+                {
+                    throw sceneError;
+                }
+                renderer.DrawPath(scene.Square, scene.Paint);
+            },
+            (frameIndex, data) => { }));
+        Assert.Same(sceneError, thrown);
+
+        var frameError = new FormatException("frame failed");
+        var delivered = new List<int>();
+        var rethrown = Assert.Throws<FormatException>(() => scene.Context.RenderBatch(options,
+            (renderer, frameIndex, time) => renderer.DrawPath(scene.Square, scene.Paint),
+            (frameIndex, data) =>
+            {
+                delivered.Add(frameIndex);
+                if (frameIndex == 1)
+                {
+                    throw frameError;
+                }
+            }));
+        Assert.Same(frameError, rethrown);
+
+        // No frame is delivered after the failing one, and the context is left ready for the next frame.
+        Assert.Equal(new[] { 0, 1 }, delivered);
+        scene.RenderSquareFrame(0xFF00FF00);
+        var pixels = scene.CopyFramebuffer();
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, 8 * 4, 4, 4));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRendersIntoBoundFramebuffer()
+    {
+        const int stride = 80;
+
+        using var scene = new NullBackendScene();
+        var length = stride * (int)scene.Height;
+        var memory = Marshal.AllocHGlobal(length);
+        try
+        {
+            var pixels = new byte[length];
+            pixels.AsSpan().Fill(0xCD);
+            Marshal.Copy(pixels, 0, memory, length);
+            scene.Context.BindCpuFramebuffer(memory, stride, (nuint)length, PixelFormat.Bgra8Premultiplied);
+
+            scene.RenderSquareFrame(0xFFFF0000);
+            scene.Context.UnbindCpuFramebuffer();
+
+            // The frame went straight into the bound memory, converted, and left the row padding alone.
+            Marshal.Copy(memory, pixels, 0, length);
+            Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, stride, 0, 0));
+            Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 12, 12));
+            Assert.Equal(0xCD, pixels[stride - 1]);
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(memory);
+        }
+    }
+
+    [RequiresSharedFramebufferFact]
+    public void NullBackendPublishesFramesToSharedFramebuffer()
+    {
+        using var scene = new NullBackendScene();
+        var context = scene.Context;
+        var info = context.SetSharedFramebuffer(3);
+        Assert.True(info.FileDescriptor >= 0);
+
+        scene.RenderSquareFrame(0xFF00FF00);
+        scene.RenderSquareFrame(0xFF00FF00);
+
+        using var file = new SafeFileHandle(info.FileDescriptor, ownsHandle: false);
+        var region = new byte[info.Size];
+        RandomAccess.Read(file, region, 0);
+
+        var header = SharedFramebufferHeader.Read(region);
+        Assert.Equal(SharedFramebufferHeader.ExpectedMagic, header.Magic);
+        Assert.Equal(SharedFramebufferHeader.ExpectedVersion, header.Version);
+        Assert.Equal(scene.Width, header.Width);
+        Assert.Equal(scene.Height, header.Height);
+        Assert.Equal(3u, header.SlotCount);
+        Assert.Equal(PixelFormat.Rgba8Premultiplied, header.Format);
+        Assert.Equal(2ul, header.LatestSequence);
+        Assert.Equal(2ul, header.GetSlotSequence(2));
+
+        var slot = region.AsSpan((int)(header.SlotOffset + 2 * header.SlotSize), (int)header.SlotSize);
+        Assert.Equal(new byte[] { 0x00, 0xFF, 0x00, 0xFF }, NullBackendScene.Pixel(slot, (int)header.Stride, 0, 0));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(slot, (int)header.Stride, 12, 12));
+
+        context.ReleaseSharedFramebuffer();
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRestrokesEditedPath()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var path = scene.Context.CreatePath();
+        var stride = (int)scene.Width * 4;
+
+        scene.Paint.SetStyle(PaintStyle.Stroke);
+        scene.Paint.SetThickness(4);
+        scene.Paint.SetColor(0xFFFF0000);
+
+        byte[] Render()
+        {
+            scene.Context.BeginFrame();
+            using (var renderer = scene.Context.CreateRenderer())
+            {
+                renderer.DrawPath(path, scene.Paint);
+            }
+            scene.Context.EndFrame();
+            return scene.CopyFramebuffer();
+        }
+
+        path.MoveTo(4, 16);
+        path.LineTo(28, 16);
+        var horizontal = Render();
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(horizontal, stride, 8, 16));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(horizontal, stride, 16, 6));
+
+        // Editing the path and the stroke must both invalidate the cached outline.
+        path.Rewind();
+        path.MoveTo(16, 4);
+        path.LineTo(16, 28);
+        var vertical = Render();
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(vertical, stride, 16, 6));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(vertical, stride, 8, 16));
+
+        scene.Paint.SetThickness(12);
+        var thick = Render();
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(thick, stride, 12, 16));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendAppliesNestedClips()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var outer = scene.Context.CreatePath();
+        using var inner = scene.Context.CreatePath();
+        using var fill = scene.Context.CreatePath();
+
+        void AddRect(RenderPath path, float left, float top, float right, float bottom)
+        {
+            path.MoveTo(left, top);
+            path.LineTo(right, top);
+            path.LineTo(right, bottom);
+            path.LineTo(left, bottom);
+            path.Close();
+        }
+
+        AddRect(outer, 4, 4, 28, 28);
+        // The inner clip is not pixel aligned, so it needs a coverage mask under the outer scissor.
+        AddRect(inner, 11.5f, 11.5f, 20.5f, 20.5f);
+        AddRect(fill, 0, 0, scene.Width, scene.Height);
+
+        scene.Context.BeginFrame();
+        using (var renderer = scene.Context.CreateRenderer())
+        {
+            renderer.ClipPath(outer);
+            scene.Paint.SetColor(0xFF0000FF);
+            renderer.DrawPath(fill, scene.Paint);
+
+            // Clipping the same path again after restore reuses the first clip.
+            scene.Paint.SetColor(0xFFFF0000);
+            for (var i = 0; i < 2; i++)
+            {
+                renderer.Save();
+                renderer.ClipPath(inner);
+                renderer.DrawPath(fill, scene.Paint);
+                renderer.Restore();
+            }
+        }
+        scene.Context.EndFrame();
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 16, 16));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, stride, 4, 4));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(pixels, stride, 27, 27));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 3, 16));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 16, 28));
+
+        // Pixels half inside the inner clip blend red over blue.
+        var edge = NullBackendScene.Pixel(pixels, stride, 11, 16);
+        Assert.InRange(edge[0], (byte)1, (byte)254);
+        Assert.InRange(edge[2], (byte)1, (byte)254);
+        Assert.Equal(0xFF, edge[3]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendFeathersPathEdges()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var path = scene.Context.CreatePath();
+
+        path.MoveTo(8, 8);
+        path.LineTo(24, 8);
+        path.LineTo(24, 24);
+        path.LineTo(8, 24);
+        path.Close();
+        scene.Paint.SetColor(0xFFFF0000);
+        scene.Paint.SetFeather(4);
+
+        scene.Context.BeginFrame();
+        using (var renderer = scene.Context.CreateRenderer())
+        {
+            renderer.DrawPath(path, scene.Paint);
+        }
+        scene.Context.EndFrame();
+
+        var pixels = scene.CopyFramebuffer();
+        var stride = (int)scene.Width * 4;
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(pixels, stride, 16, 16));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(pixels, stride, 1, 16));
+
+        // The blur softens both sides of the edge and treats opposite edges alike.
+        var inside = NullBackendScene.Pixel(pixels, stride, 8, 16);
+        var outside = NullBackendScene.Pixel(pixels, stride, 6, 16);
+        Assert.InRange(inside[3], (byte)1, (byte)254);
+        Assert.InRange(outside[3], (byte)1, (byte)254);
+        Assert.True(inside[3] > outside[3]);
+        Assert.Equal(inside, NullBackendScene.Pixel(pixels, stride, 23, 16));
+        Assert.Equal(outside, NullBackendScene.Pixel(pixels, stride, 25, 16));
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendRasterizesImageMesh()
+    {
+        const uint width = 32;
+        const uint height = 32;
+
+        // 2x2 opaque blue RGBA PNG.
+        var png = Convert.FromBase64String(
+            "iVBORw0KGgoAAAANSUhEUgAAAAIAAAACCAYAAABytg0kAAAAEElEQVR4nGNgYPj/H4KhDAA/0gf5tBJPzQAAAABJRU5ErkJggg==");
+        var vertices = new float[] { 8, 8, 24, 8, 24, 24, 8, 24 };
+        var uvs = new float[] { 0, 0, 1, 0, 1, 1, 0, 1 };
+        var indices = new ushort[] { 0, 1, 2, 0, 2, 3 };
+
+        using var device = RendererDevice.Create(RendererBackend.Null);
+        using var context = device.CreateContext(width, height);
+        using var image = context.DecodeImage(png);
+        var verticesBytes = MemoryMarshal.AsBytes(vertices.AsSpan());
+        using var vertexBuffer = context.CreateBuffer(BufferType.Vertex, (nuint)verticesBytes.Length, initialData: verticesBytes);
+        var uvsBytes = MemoryMarshal.AsBytes(uvs.AsSpan());
+        using var uvBuffer = context.CreateBuffer(BufferType.Vertex, (nuint)uvsBytes.Length, initialData: uvsBytes);
+        var indicesBytes = MemoryMarshal.AsBytes(indices.AsSpan());
+        using var indexBuffer = context.CreateBuffer(BufferType.Index, (nuint)indicesBytes.Length, initialData: indicesBytes);
+
+        context.BeginFrame();
+        using (var renderer = context.CreateRenderer())
+        {
+            renderer.DrawImageMesh(image, vertexBuffer, uvBuffer, indexBuffer, 4, 6, BlendMode.SrcOver);
+        }
+        context.EndFrame();
+
+        var pixels = new byte[width * height * 4];
+        context.CopyCpuFramebuffer(pixels);
+
+        // The shared diagonal must not leave a seam.
+        foreach (var (x, y) in new[] { (12, 12), (16, 16), (20, 12) })
+        {
+            var offset = (int)((y * width + x) * 4);
+            Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, pixels[offset..(offset + 4)]);
+        }
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, pixels[..4]);
+    }
+
+    [RequiresNativeLibraryFact]
+    public void NullBackendReplaysCommandBuffer()
+    {
+        using var scene = new NullBackendScene(32, 32);
+        using var clip = scene.Context.CreatePath();
+        using var fill = scene.Context.CreatePath();
+        using var blue = scene.Context.CreatePaint();
+        using var commands = scene.Context.CreateCommandBuffer();
+        var red = scene.Paint;
+        var stride = (int)scene.Width * 4;
+
+        clip.MoveTo(0, 0);
+        clip.LineTo(16, 0);
+        clip.LineTo(16, 16);
+        clip.LineTo(0, 16);
+        clip.Close();
+        fill.MoveTo(0, 0);
+        fill.LineTo(scene.Width, 0);
+        fill.LineTo(scene.Width, scene.Height);
+        fill.LineTo(0, scene.Height);
+        fill.Close();
+        red.SetColor(0xFFFF0000);
+        blue.SetColor(0xFF0000FF);
+
+        byte[] Render()
+        {
+            scene.Context.BeginFrame();
+            using (var renderer = scene.Context.CreateRenderer())
+            {
+                renderer.Submit(commands);
+            }
+            scene.Context.EndFrame();
+            return scene.CopyFramebuffer();
+        }
+
+        commands.Save();
+        commands.Transform(new Mat2D { XX = 1, YY = 1, TX = 8, TY = 8 });
+        commands.ClipPath(clip);
+        commands.DrawPath(fill, red);
+        commands.Restore();
+        var first = Render();
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(first, stride, 16, 16));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(first, stride, 4, 4));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0x00, 0x00 }, NullBackendScene.Pixel(first, stride, 26, 26));
+
+        // Reset keeps the bindings, so the next frame only re-encodes the stream.
+        commands.Reset();
+        commands.DrawPath(fill, blue);
+        commands.DrawPath(clip, red);
+        var second = Render();
+        Assert.Equal(new byte[] { 0xFF, 0x00, 0x00, 0xFF }, NullBackendScene.Pixel(second, stride, 4, 4));
+        Assert.Equal(new byte[] { 0x00, 0x00, 0xFF, 0xFF }, NullBackendScene.Pixel(second, stride, 26, 26));
+    }
+
     private static RendererBackend? TryGetPreferredBackend()
     {
         try
@@ -92,4 +1288,61 @@ public class RendererBehaviorTests
             return null;
         }
     }
+
+    // Inflates the IDAT chunks of an 8-bit RGBA PNG and undoes each row's filter.
+    private static byte[] DecodePngRows(byte[] png, int width, int height)
+    {
+        Assert.Equal(new byte[] { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A }, png[..8]);
+        using var compressed = new MemoryStream();
+        for (var offset = 8; offset < png.Length;)
+        {
+            var length = (int)BinaryPrimitives.ReadUInt32BigEndian(png.AsSpan(offset));
+            if (png.AsSpan(offset + 4, 4).SequenceEqual("IDAT"u8))
+            {
+                compressed.Write(png, offset + 8, length);
+            }
+            offset += length + 12;
+        }
+        compressed.Position = 0;
+        using var inflater = new ZLibStream(compressed, CompressionMode.Decompress);
+        using var scanlines = new MemoryStream();
+        inflater.CopyTo(scanlines);
+
+        var rowBytes = width * 4;
+        var filtered = scanlines.ToArray();
+        Assert.Equal(height * (rowBytes + 1), filtered.Length);
+
+        var rows = new byte[height * rowBytes];
+        for (var y = 0; y < height; y++)
+        {
+            var filter = filtered[y * (rowBytes + 1)];
+            for (var i = 0; i < rowBytes; i++)
+            {
+                int left = i >= 4 ? rows[y * rowBytes + i - 4] : 0;
+                int up = y > 0 ? rows[(y - 1) * rowBytes + i] : 0;
+                int upLeft = y > 0 && i >= 4 ? rows[(y - 1) * rowBytes + i - 4] : 0;
+                var predicted = filter switch
+                {
+                    0 => 0,
+                    1 => left,
+                    2 => up,
+                    3 => (left + up) / 2,
+                    4 => Paeth(left, up, upLeft),
+                    _ => throw new InvalidDataException($"Unknown PNG filter {filter} on row {y}."),
+                };
+                rows[y * rowBytes + i] = (byte)(filtered[y * (rowBytes + 1) + 1 + i] + predicted);
+            }
+        }
+
+        return rows;
+
+        static int Paeth(int a, int b, int c)
+        {
+            var p = a + b - c;
+            var pa = Math.Abs(p - a);
+            var pb = Math.Abs(p - b);
+            var pc = Math.Abs(p - c);
+            return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+        }
+    }
 }
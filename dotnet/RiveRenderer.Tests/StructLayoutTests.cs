@@ -23,6 +23,47 @@ public class StructLayoutTests
         Assert.Equal(8, Marshal.SizeOf<NativeDeviceCreateInfo>());
     }
 
+    [Fact]
+    public void DamageRect_SizeMatchesNative()
+    {
+        Assert.Equal(16, Marshal.SizeOf<DamageRect>());
+    }
+
+    [Fact]
+    public void SharedFramebufferInfo_LayoutMatchesNative()
+    {
+        Assert.Equal(16, Marshal.SizeOf<SharedFramebufferInfo>());
+        Assert.Equal(8, Marshal.OffsetOf<SharedFramebufferInfo>(nameof(SharedFramebufferInfo.Size)).ToInt32());
+    }
+
+    [Fact]
+    public void SharedFramebufferHeader_LayoutMatchesNative()
+    {
+        Assert.Equal(120, Marshal.SizeOf<SharedFramebufferHeader>());
+        Assert.Equal(20, Marshal.OffsetOf<SharedFramebufferHeader>(nameof(SharedFramebufferHeader.Format)).ToInt32());
+        Assert.Equal(24, Marshal.OffsetOf<SharedFramebufferHeader>(nameof(SharedFramebufferHeader.Stride)).ToInt32());
+        Assert.Equal(48,
+            Marshal.OffsetOf<SharedFramebufferHeader>(nameof(SharedFramebufferHeader.LatestSequence)).ToInt32());
+        Assert.Equal(56, Marshal.OffsetOf<SharedFramebufferHeader>("_slotSequences").ToInt32());
+    }
+
+    [Fact]
+    public void PictureStats_LayoutMatchesNative()
+    {
+        Assert.Equal(16, Marshal.SizeOf<PictureStats>());
+        Assert.Equal(8, Marshal.OffsetOf<PictureStats>(nameof(PictureStats.DrawsCulled)).ToInt32());
+    }
+
+    [Fact]
+    public void BatchRenderInfo_LayoutMatchesNative()
+    {
+        Assert.Equal(24 + 4 * IntPtr.Size, Marshal.SizeOf<NativeBatchRenderInfo>());
+        Assert.Equal(2 * IntPtr.Size + 20,
+            Marshal.OffsetOf<NativeBatchRenderInfo>(nameof(NativeBatchRenderInfo.Encode)).ToInt32());
+        Assert.Equal(2 * IntPtr.Size + 24,
+            Marshal.OffsetOf<NativeBatchRenderInfo>(nameof(NativeBatchRenderInfo.OnFrame)).ToInt32());
+    }
+
     [Fact]
     public void FrameOptions_SizeMatchesNative()
     {
@@ -0,0 +1,341 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer.Tests.TestUtilities;
+
+/// <summary>
+/// Vulkan instance and device on Mesa's lavapipe (or any CPU implementation the loader finds), wrapped in a
+/// <see cref="RendererDevice"/>. Lets the Vulkan backend run on machines without a GPU, such as CI runners.
+/// </summary>
+internal sealed class LavapipeDevice : IDisposable
+{
+    private const int VkSuccess = 0;
+    private const int VkPhysicalDeviceTypeCpu = 4;
+    private const uint VkQueueGraphicsBit = 1;
+    private const uint VkApiVersion11 = (1u << 22) | (1u << 12);
+
+    // VkBool32 indices in VkPhysicalDeviceFeatures.
+    private const int IndependentBlendFeature = 3;
+    private const int FillModeNonSolidFeature = 13;
+    private const int FragmentStoresAndAtomicsFeature = 26;
+    private const int ShaderClipDistanceFeature = 37;
+    private const int FeatureCount = 55;
+
+    private static readonly string[] LoaderNames =
+    {
+        "libvulkan.so.1", "libvulkan.so", "vulkan-1", "libvulkan.1.dylib",
+    };
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate int CreateInstanceFn(IntPtr createInfo, IntPtr allocator, out IntPtr instance);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate IntPtr GetInstanceProcAddrFn(IntPtr instance, [MarshalAs(UnmanagedType.LPStr)] string name);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate void DestroyInstanceFn(IntPtr instance, IntPtr allocator);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate int EnumeratePhysicalDevicesFn(IntPtr instance, ref uint count, IntPtr devices);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate void GetPhysicalDeviceInfoFn(IntPtr physicalDevice, IntPtr info);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate void GetQueueFamilyPropertiesFn(IntPtr physicalDevice, ref uint count, IntPtr properties);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate int CreateDeviceFn(IntPtr physicalDevice, IntPtr createInfo, IntPtr allocator, out IntPtr device);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate void GetDeviceQueueFn(IntPtr device, uint family, uint index, out IntPtr queue);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate int DeviceWaitIdleFn(IntPtr device);
+
+    [UnmanagedFunctionPointer(CallingConvention.Winapi)]
+    private delegate void DestroyDeviceFn(IntPtr device, IntPtr allocator);
+
+    private readonly IntPtr _loader;
+    private readonly GetInstanceProcAddrFn _getInstanceProcAddr;
+    private IntPtr _instance;
+    private IntPtr _device;
+
+    private LavapipeDevice(IntPtr loader, GetInstanceProcAddrFn getInstanceProcAddr)
+    {
+        _loader = loader;
+        _getInstanceProcAddr = getInstanceProcAddr;
+    }
+
+    public RendererDevice Device { get; private set; } = null!;
+
+    /// <summary>
+    /// Creates the device, throwing with the reason when lavapipe cannot be used.
+    /// </summary>
+    public static LavapipeDevice Create()
+    {
+        return TryCreate(out var reason) ?? throw new InvalidOperationException(reason);
+    }
+
+    /// <summary>
+    /// Creates the device, or returns null with the reason when no CPU Vulkan implementation is installed or the
+    /// native library was built without Vulkan.
+    /// </summary>
+    public static LavapipeDevice? TryCreate(out string? reason)
+    {
+        if (IntPtr.Size != 8)
+        {
+            reason = "The lavapipe harness lays out Vulkan structs for 64-bit processes only.";
+            return null;
+        }
+
+        IntPtr loader = IntPtr.Zero;
+        foreach (var name in LoaderNames)
+        {
+            if (NativeLibrary.TryLoad(name, out loader))
+            {
+                break;
+            }
+        }
+
+        if (loader == IntPtr.Zero)
+        {
+            reason = "Vulkan loader not found.";
+            return null;
+        }
+
+        var getInstanceProcAddr = NativeLibrary.GetExport(loader, "vkGetInstanceProcAddr");
+        var lavapipe = new LavapipeDevice(loader,
+            Marshal.GetDelegateForFunctionPointer<GetInstanceProcAddrFn>(getInstanceProcAddr));
+        try
+        {
+            reason = lavapipe.Initialize(getInstanceProcAddr);
+        }
+        catch (RendererException ex) when (ex.Status == RendererStatus.Unsupported)
+        {
+            reason = $"Vulkan backend unavailable: {ex.Message}";
+        }
+
+        if (reason is not null)
+        {
+            lavapipe.Dispose();
+            return null;
+        }
+
+        return lavapipe;
+    }
+
+    private string? Initialize(IntPtr getInstanceProcAddr)
+    {
+        if (!CreateInstance())
+        {
+            return "vkCreateInstance failed.";
+        }
+
+        var physicalDevice = FindCpuDevice(out var queueFamily);
+        if (physicalDevice == IntPtr.Zero)
+        {
+            return "No CPU Vulkan device with a graphics queue; install mesa-vulkan-drivers for lavapipe.";
+        }
+
+        var features = new int[FeatureCount];
+        var supported = Marshal.AllocHGlobal(FeatureCount * sizeof(int));
+        try
+        {
+            Load<GetPhysicalDeviceInfoFn>("vkGetPhysicalDeviceFeatures")(physicalDevice, supported);
+            foreach (var index in new[]
+                     {
+                         IndependentBlendFeature, FillModeNonSolidFeature, FragmentStoresAndAtomicsFeature,
+                         ShaderClipDistanceFeature,
+                     })
+            {
+                features[index] = Marshal.ReadInt32(supported, index * sizeof(int));
+            }
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(supported);
+        }
+
+        if (!CreateDevice(physicalDevice, queueFamily, features))
+        {
+            return "vkCreateDevice failed.";
+        }
+
+        Load<GetDeviceQueueFn>("vkGetDeviceQueue")(_device, queueFamily, 0, out var queue);
+        Device = RendererDevice.CreateVulkan(new RendererVulkanDeviceOptions(
+            _instance,
+            physicalDevice,
+            _device,
+            queue,
+            queueFamily,
+            new RendererVulkanFeatures(
+                VkApiVersion11,
+                independentBlend: features[IndependentBlendFeature] != 0,
+                fillModeNonSolid: features[FillModeNonSolidFeature] != 0,
+                fragmentStoresAndAtomics: features[FragmentStoresAndAtomicsFeature] != 0,
+                shaderClipDistance: features[ShaderClipDistanceFeature] != 0),
+            getInstanceProcAddr: getInstanceProcAddr));
+        return null;
+    }
+
+    private bool CreateInstance()
+    {
+        // VkApplicationInfo followed by VkInstanceCreateInfo, laid out for 64-bit pointers.
+        var memory = Marshal.AllocHGlobal(48 + 64);
+        try
+        {
+            ZeroMemory(memory, 48 + 64);
+            var appInfo = memory;
+            Marshal.WriteInt32(appInfo, 0, 0); // VK_STRUCTURE_TYPE_APPLICATION_INFO
+            Marshal.WriteInt32(appInfo, 44, unchecked((int)VkApiVersion11));
+
+            var createInfo = memory + 48;
+            Marshal.WriteInt32(createInfo, 0, 1); // VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO
+            Marshal.WriteIntPtr(createInfo, 24, appInfo);
+
+            var create = Load<CreateInstanceFn>("vkCreateInstance");
+            return create(createInfo, IntPtr.Zero, out _instance) == VkSuccess && _instance != IntPtr.Zero;
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(memory);
+        }
+    }
+
+    private IntPtr FindCpuDevice(out uint queueFamily)
+    {
+        queueFamily = 0;
+        var enumerate = Load<EnumeratePhysicalDevicesFn>("vkEnumeratePhysicalDevices");
+        uint count = 0;
+        if (enumerate(_instance, ref count, IntPtr.Zero) != VkSuccess || count == 0)
+        {
+            return IntPtr.Zero;
+        }
+
+        var devices = Marshal.AllocHGlobal((int)count * IntPtr.Size);
+        // VkPhysicalDeviceProperties is 824 bytes; deviceType sits after three uint32 fields and apiVersion.
+        var properties = Marshal.AllocHGlobal(1024);
+        try
+        {
+            enumerate(_instance, ref count, devices);
+            var getProperties = Load<GetPhysicalDeviceInfoFn>("vkGetPhysicalDeviceProperties");
+            for (var i = 0; i < count; i++)
+            {
+                var device = Marshal.ReadIntPtr(devices, i * IntPtr.Size);
+                getProperties(device, properties);
+                if (Marshal.ReadInt32(properties, 16) == VkPhysicalDeviceTypeCpu &&
+                    TryFindGraphicsQueue(device, out queueFamily))
+                {
+                    return device;
+                }
+            }
+
+            return IntPtr.Zero;
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(properties);
+            Marshal.FreeHGlobal(devices);
+        }
+    }
+
+    private bool TryFindGraphicsQueue(IntPtr physicalDevice, out uint queueFamily)
+    {
+        const int familySize = 24; // VkQueueFamilyProperties
+        var getFamilies = Load<GetQueueFamilyPropertiesFn>("vkGetPhysicalDeviceQueueFamilyProperties");
+        uint count = 0;
+        getFamilies(physicalDevice, ref count, IntPtr.Zero);
+        var families = Marshal.AllocHGlobal((int)Math.Max(count, 1) * familySize);
+        try
+        {
+            getFamilies(physicalDevice, ref count, families);
+            for (uint i = 0; i < count; i++)
+            {
+                if (((uint)Marshal.ReadInt32(families, (int)i * familySize) & VkQueueGraphicsBit) != 0)
+                {
+                    queueFamily = i;
+                    return true;
+                }
+            }
+
+            queueFamily = 0;
+            return false;
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(families);
+        }
+    }
+
+    private bool CreateDevice(IntPtr physicalDevice, uint queueFamily, int[] features)
+    {
+        // Queue priority, VkPhysicalDeviceFeatures, VkDeviceQueueCreateInfo and VkDeviceCreateInfo in one block.
+        const int featuresOffset = 8;
+        const int queueInfoOffset = featuresOffset + FeatureCount * sizeof(int) + 4;
+        const int deviceInfoOffset = queueInfoOffset + 40;
+        const int size = deviceInfoOffset + 72;
+        var memory = Marshal.AllocHGlobal(size);
+        try
+        {
+            ZeroMemory(memory, size);
+            Marshal.WriteInt32(memory, 0, BitConverter.SingleToInt32Bits(1.0f));
+            Marshal.Copy(features, 0, memory + featuresOffset, FeatureCount);
+
+            var queueInfo = memory + queueInfoOffset;
+            Marshal.WriteInt32(queueInfo, 0, 2); // VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO
+            Marshal.WriteInt32(queueInfo, 20, (int)queueFamily);
+            Marshal.WriteInt32(queueInfo, 24, 1);
+            Marshal.WriteIntPtr(queueInfo, 32, memory);
+
+            var deviceInfo = memory + deviceInfoOffset;
+            Marshal.WriteInt32(deviceInfo, 0, 3); // VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO
+            Marshal.WriteInt32(deviceInfo, 20, 1);
+            Marshal.WriteIntPtr(deviceInfo, 24, queueInfo);
+            Marshal.WriteIntPtr(deviceInfo, 64, memory + featuresOffset);
+
+            var create = Load<CreateDeviceFn>("vkCreateDevice");
+            return create(physicalDevice, deviceInfo, IntPtr.Zero, out _device) == VkSuccess && _device != IntPtr.Zero;
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(memory);
+        }
+    }
+
+    private T Load<T>(string name)
+        where T : Delegate
+    {
+        var address = _getInstanceProcAddr(_instance, name);
+        if (address == IntPtr.Zero)
+        {
+            throw new EntryPointNotFoundException(name);
+        }
+
+        return Marshal.GetDelegateForFunctionPointer<T>(address);
+    }
+
+    private static void ZeroMemory(IntPtr memory, int size)
+    {
+        Marshal.Copy(new byte[size], 0, memory, size);
+    }
+
+    public void Dispose()
+    {
+        Device?.Dispose();
+        if (_device != IntPtr.Zero)
+        {
+            Load<DeviceWaitIdleFn>("vkDeviceWaitIdle")(_device);
+            Load<DestroyDeviceFn>("vkDestroyDevice")(_device, IntPtr.Zero);
+            _device = IntPtr.Zero;
+        }
+
+        if (_instance != IntPtr.Zero)
+        {
+            Load<DestroyInstanceFn>("vkDestroyInstance")(_instance, IntPtr.Zero);
+            _instance = IntPtr.Zero;
+        }
+
+        NativeLibrary.Free(_loader);
+    }
+}
@@ -0,0 +1,82 @@
+using System;
+
+namespace RiveRenderer.Tests.TestUtilities;
+
+/// <summary>
+/// Null-backend context with an 8x8 square at the origin and a paint to fill it, shared by the frame pipeline,
+/// readback and framebuffer tests.
+/// </summary>
+internal sealed class NullBackendScene : IDisposable
+{
+    public NullBackendScene(uint width = 16, uint height = 16)
+    {
+        Width = width;
+        Height = height;
+        Device = RendererDevice.Create(RendererBackend.Null);
+        Context = Device.CreateContext(width, height);
+        Square = Context.CreatePath();
+        Paint = Context.CreatePaint();
+
+        Square.MoveTo(0, 0);
+        Square.LineTo(8, 0);
+        Square.LineTo(8, 8);
+        Square.LineTo(0, 8);
+        Square.Close();
+    }
+
+    public uint Width { get; }
+
+    public uint Height { get; }
+
+    public RendererDevice Device { get; }
+
+    public RendererContext Context { get; }
+
+    public RenderPath Square { get; }
+
+    public RenderPaint Paint { get; }
+
+    /// <summary>
+    /// Begins a frame that fills the square with color. The frame is left open so tests can add to it.
+    /// </summary>
+    public void BeginSquareFrame(uint color)
+    {
+        Paint.SetColor(color);
+        Context.BeginFrame();
+        using var renderer = Context.CreateRenderer();
+        renderer.DrawPath(Square, Paint);
+    }
+
+    /// <summary>
+    /// Renders and submits a frame that fills the square with color.
+    /// </summary>
+    public void RenderSquareFrame(uint color)
+    {
+        BeginSquareFrame(color);
+        Context.EndFrame();
+        Context.Submit();
+    }
+
+    public byte[] CopyFramebuffer()
+    {
+        var pixels = new byte[Width * Height * 4];
+        Context.CopyCpuFramebuffer(pixels);
+        return pixels;
+    }
+
+    /// <summary>
+    /// The four bytes of the pixel at (x, y) in rows of stride bytes.
+    /// </summary>
+    public static byte[] Pixel(ReadOnlySpan<byte> pixels, int stride, int x, int y)
+    {
+        return pixels.Slice(y * stride + x * 4, 4).ToArray();
+    }
+
+    public void Dispose()
+    {
+        Paint.Dispose();
+        Square.Dispose();
+        Context.Dispose();
+        Device.Dispose();
+    }
+}
@@ -0,0 +1,34 @@
+using System;
+using Xunit;
+
+namespace RiveRenderer.Tests.TestUtilities;
+
+/// <summary>
+/// Skips a test when the Vulkan backend cannot run on lavapipe here. Set RIVE_RENDERER_REQUIRE_LAVAPIPE=1 to make
+/// such tests fail instead, as CI does.
+/// </summary>
+[AttributeUsage(AttributeTargets.Method, AllowMultiple = false, Inherited = false)]
+internal sealed class RequiresLavapipeFactAttribute : FactAttribute
+{
+    private static readonly Lazy<string?> SkipReason = new(Probe);
+
+    public RequiresLavapipeFactAttribute()
+    {
+        var required = Environment.GetEnvironmentVariable("RIVE_RENDERER_REQUIRE_LAVAPIPE") == "1";
+        if (!required && SkipReason.Value is { } reason)
+        {
+            Skip = reason;
+        }
+    }
+
+    private static string? Probe()
+    {
+        if (!NativeTestHelper.TryEnsureNative(out var reason))
+        {
+            return reason;
+        }
+
+        using var lavapipe = LavapipeDevice.TryCreate(out reason);
+        return reason;
+    }
+}
@@ -0,0 +1,23 @@
+using System;
+using Xunit;
+
+namespace RiveRenderer.Tests.TestUtilities;
+
+/// <summary>
+/// Skips a test on Windows, which has no shared framebuffers, or when the native library is missing.
+/// </summary>
+[AttributeUsage(AttributeTargets.Method, AllowMultiple = false, Inherited = false)]
+internal sealed class RequiresSharedFramebufferFactAttribute : FactAttribute
+{
+    public RequiresSharedFramebufferFactAttribute()
+    {
+        if (OperatingSystem.IsWindows())
+        {
+            Skip = "Shared framebuffers are not supported on Windows.";
+        }
+        else if (!NativeTestHelper.TryEnsureNative(out var reason))
+        {
+            Skip = reason;
+        }
+    }
+}
@@ -0,0 +1,138 @@
+using System;
+using RiveRenderer.Tests.TestUtilities;
+using Xunit;
+
+namespace RiveRenderer.Tests;
+
+/// <summary>
+/// Runs the Vulkan backend on lavapipe, so frames are really recorded, submitted and copied back by a Vulkan driver.
+/// </summary>
+public class VulkanBackendTests
+{
+    private const uint Size = 16;
+    private const int Stride = (int)Size * 4;
+
+    [RequiresLavapipeFact]
+    public void LavapipeRendersSubmitsAndReadsBackPixels()
+    {
+        using var lavapipe = LavapipeDevice.Create();
+        using var context = lavapipe.Device.CreateContext(Size, Size);
+        using var square = CreateSquare(context);
+        using var paint = context.CreatePaint();
+        context.SetFramebufferReadback(true);
+
+        RenderFrame(context, square, paint, 0xFFFF0000);
+        var pixels = new byte[Size * Size * 4];
+        context.CopyCpuFramebuffer(pixels);
+
+        Assert.Equal(Rgba(0xFFFF0000), NullBackendScene.Pixel(pixels, Stride, 4, 4));
+        Assert.Equal(new byte[] { 0, 0, 0, 0 }, NullBackendScene.Pixel(pixels, Stride, 12, 12));
+    }
+
+    [RequiresLavapipeFact]
+    public void LavapipeReadsBackEveryFrameInFlight()
+    {
+        var colors = new[] { 0xFFFF0000u, 0xFF00FF00u, 0xFF0000FFu, 0xFFFFFF00u, 0xFF00FFFFu, 0xFFFF00FFu };
+
+        using var lavapipe = LavapipeDevice.Create();
+        using var context = lavapipe.Device.CreateContext(Size, Size);
+        using var square = CreateSquare(context);
+        using var paint = context.CreatePaint();
+        context.SetFramesInFlight(RendererContext.MaxFramesInFlight);
+        context.SetFramebufferReadback(true);
+
+        // More frames than slots, so each slot's staging buffer is reused. Submit returns with the frame still on the
+        // GPU, so every copy has to wait for the frame that recorded it.
+        var pixels = new byte[Size * Size * 4];
+        foreach (var color in colors)
+        {
+            RenderFrame(context, square, paint, color);
+            context.CopyCpuFramebuffer(pixels);
+            Assert.Equal(Rgba(color), NullBackendScene.Pixel(pixels, Stride, 4, 4));
+            Assert.Equal(new byte[] { 0, 0, 0, 0 }, NullBackendScene.Pixel(pixels, Stride, 12, 12));
+        }
+    }
+
+    [RequiresLavapipeFact]
+    public void LavapipeKeepsLastReadBackFrameOnceReadbackIsOff()
+    {
+        using var lavapipe = LavapipeDevice.Create();
+        using var context = lavapipe.Device.CreateContext(Size, Size);
+        using var square = CreateSquare(context);
+        using var paint = context.CreatePaint();
+        context.SetFramesInFlight(RendererContext.MaxFramesInFlight);
+        context.SetFramebufferReadback(true);
+        RenderFrame(context, square, paint, 0xFFFF0000);
+
+        // Frames without the end-of-frame copy cycle through every slot, including the one holding the copy.
+        context.SetFramebufferReadback(false);
+        for (var frame = 0; frame < RendererContext.MaxFramesInFlight + 1; frame++)
+        {
+            RenderFrame(context, square, paint, 0xFF00FF00);
+        }
+
+        var pixels = new byte[Size * Size * 4];
+        context.CopyCpuFramebuffer(pixels);
+        Assert.Equal(Rgba(0xFFFF0000), NullBackendScene.Pixel(pixels, Stride, 4, 4));
+    }
+
+    [RequiresLavapipeFact]
+    public void LavapipeFenceWaitOnAnotherThreadFinishesAfterRenderingStops()
+    {
+        using var lavapipe = LavapipeDevice.Create();
+        using var context = lavapipe.Device.CreateContext(Size, Size);
+        using var square = CreateSquare(context);
+        using var paint = context.CreatePaint();
+        using var fence = lavapipe.Device.CreateFence();
+        context.SetFramesInFlight(RendererContext.MaxFramesInFlight);
+
+        RenderFrame(context, square, paint, 0xFFFF0000);
+        paint.SetColor(0xFF00FF00);
+        context.BeginFrame();
+        using (var renderer = context.CreateRenderer())
+        {
+            renderer.DrawPath(square, paint);
+        }
+
+        using var readback = context.RequestReadback();
+        readback.SignalFence(fence, 1);
+        context.EndFrame();
+        context.Submit();
+        context.SignalFence(fence, 2);
+
+        // Nothing drives the context from here on, so only the waiting thread can see the frames finish.
+        var waiter = Task.Run(() => fence.Wait(2));
+        Assert.True(waiter.Wait(TimeSpan.FromSeconds(30)));
+        Assert.Equal(2ul, fence.GetCompletedValue());
+    }
+
+    private static byte[] Rgba(uint argb)
+    {
+        var bytes = BitConverter.GetBytes(argb);
+        return new[] { bytes[2], bytes[1], bytes[0], bytes[3] };
+    }
+
+    private static RenderPath CreateSquare(RendererContext context)
+    {
+        var square = context.CreatePath();
+        square.MoveTo(0, 0);
+        square.LineTo(8, 0);
+        square.LineTo(8, 8);
+        square.LineTo(0, 8);
+        square.Close();
+        return square;
+    }
+
+    private static void RenderFrame(RendererContext context, RenderPath square, RenderPaint paint, uint color)
+    {
+        paint.SetColor(color);
+        context.BeginFrame();
+        using (var renderer = context.CreateRenderer())
+        {
+            renderer.DrawPath(square, paint);
+        }
+
+        context.EndFrame();
+        context.Submit();
+    }
+}
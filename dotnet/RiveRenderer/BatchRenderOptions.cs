@@ -0,0 +1,52 @@
+using System;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Draws frame <paramref name="frameIndex"/> of a batch at <paramref name="time"/> seconds. Called on the thread that
+/// started the batch.
+/// </summary>
+public delegate void BatchSceneCallback(Renderer renderer, int frameIndex, float time);
+
+/// <summary>
+/// Receives frame <paramref name="frameIndex"/> of a batch. Frames arrive in order on a background thread, and
+/// <paramref name="data"/> is only valid during the call.
+/// </summary>
+public delegate void BatchFrameCallback(int frameIndex, ReadOnlySpan<byte> data);
+
+public readonly struct BatchRenderOptions
+{
+    /// <param name="frameCount">Number of frames to render.</param>
+    /// <param name="timeStep">Seconds between frames.</param>
+    /// <param name="startTime">Time of the first frame.</param>
+    /// <param name="maxFramesInFlight">Frames rendered but not yet delivered, at most
+    /// <see cref="RendererContext.MaxBatchFramesInFlight"/>.</param>
+    /// <param name="encoding">Delivers frames as encoded images instead of pixels when set.</param>
+    /// <param name="quality">Encoding quality, as for <see cref="RendererContext.EncodeFramebuffer"/>.</param>
+    /// <param name="format">Format of delivered pixels when <paramref name="encoding"/> is null.</param>
+    public BatchRenderOptions(
+        int frameCount,
+        float timeStep,
+        float startTime = 0f,
+        uint maxFramesInFlight = 3,
+        ImageEncoding? encoding = null,
+        byte quality = 75,
+        PixelFormat format = PixelFormat.Rgba8Premultiplied)
+    {
+        FrameCount = frameCount;
+        TimeStep = timeStep;
+        StartTime = startTime;
+        MaxFramesInFlight = maxFramesInFlight;
+        Encoding = encoding;
+        Quality = quality;
+        Format = format;
+    }
+
+    public int FrameCount { get; }
+    public float TimeStep { get; }
+    public float StartTime { get; }
+    public uint MaxFramesInFlight { get; }
+    public ImageEncoding? Encoding { get; }
+    public byte Quality { get; }
+    public PixelFormat Format { get; }
+}
@@ -0,0 +1,196 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Records renderer calls into a compact binary stream that <see cref="Renderer.Submit"/> replays with a single native
+/// call. Paths, paints and images are bound to slots on first use and stay bound across <see cref="Reset"/>, so a
+/// frame that redraws the same resources only re-encodes the stream.
+/// </summary>
+public sealed class CommandBuffer : IDisposable
+{
+    private enum CommandOp : uint
+    {
+        Save = 1,
+        Restore = 2,
+        Transform = 3,
+        ClipPath = 4,
+        DrawPath = 5,
+        DrawImage = 6,
+    }
+
+    private readonly CommandBufferHandleSafe _handle;
+    private readonly Dictionary<RenderPath, uint> _pathSlots = new();
+    private readonly Dictionary<RenderPaint, uint> _paintSlots = new();
+    private readonly Dictionary<RenderImage, uint> _imageSlots = new();
+    private byte[] _stream = new byte[256];
+    private int _length;
+    private int _written;
+    private bool _disposed;
+
+    internal CommandBuffer(CommandBufferHandleSafe handle)
+    {
+        _handle = handle;
+    }
+
+    internal NativeCommandBufferHandle DangerousGetHandle() => new() { Handle = _handle.DangerousGetHandle() };
+
+    public void Save()
+    {
+        ThrowIfDisposed();
+        WriteOp(CommandOp.Save);
+    }
+
+    public void Restore()
+    {
+        ThrowIfDisposed();
+        WriteOp(CommandOp.Restore);
+    }
+
+    public void Transform(in Mat2D transform)
+    {
+        ThrowIfDisposed();
+        WriteOp(CommandOp.Transform);
+        WriteValue(transform);
+    }
+
+    public void ClipPath(RenderPath path)
+    {
+        ThrowIfDisposed();
+        path.ThrowIfDisposed();
+        var slot = PathSlot(path);
+        WriteOp(CommandOp.ClipPath);
+        WriteValue(slot);
+    }
+
+    public void DrawPath(RenderPath path, RenderPaint paint)
+    {
+        ThrowIfDisposed();
+        path.ThrowIfDisposed();
+        paint.ThrowIfDisposed();
+        var pathSlot = PathSlot(path);
+        var paintSlot = PaintSlot(paint);
+        WriteOp(CommandOp.DrawPath);
+        WriteValue(pathSlot);
+        WriteValue(paintSlot);
+    }
+
+    public void DrawImage(RenderImage image, BlendMode blendMode, float opacity = 1f, ImageSampler? sampler = null)
+    {
+        ThrowIfDisposed();
+        image.ThrowIfDisposed();
+        var slot = ImageSlot(image);
+        WriteOp(CommandOp.DrawImage);
+        WriteValue(slot);
+        WriteValue(sampler ?? ImageSampler.LinearClamp);
+        WriteValue(blendMode);
+        WriteValue<byte>(0);
+        WriteValue<ushort>(0);
+        WriteValue(opacity);
+    }
+
+    /// <summary>
+    /// Drops the recorded commands while keeping resource bindings.
+    /// </summary>
+    public void Reset()
+    {
+        ThrowIfDisposed();
+        NativeMethods.CommandBuffer.Reset(DangerousGetHandle()).ThrowIfFailed("Command buffer reset failed.");
+        _length = 0;
+        _written = 0;
+    }
+
+    /// <summary>
+    /// Sends commands recorded since the last flush to the native buffer.
+    /// </summary>
+    internal void Flush()
+    {
+        ThrowIfDisposed();
+        if (_written == _length)
+        {
+            return;
+        }
+
+        unsafe
+        {
+            fixed (byte* data = &_stream[_written])
+            {
+                NativeMethods.CommandBuffer.Write(DangerousGetHandle(), data, (nuint)(_length - _written))
+                    .ThrowIfFailed("Command buffer write failed.");
+            }
+        }
+        _written = _length;
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        _handle.Dispose();
+    }
+
+    internal void ThrowIfDisposed()
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(CommandBuffer));
+        }
+    }
+
+    private uint PathSlot(RenderPath path)
+    {
+        if (!_pathSlots.TryGetValue(path, out var slot))
+        {
+            slot = (uint)_pathSlots.Count;
+            NativeMethods.CommandBuffer.BindPath(DangerousGetHandle(), slot, path.DangerousGetHandle())
+                .ThrowIfFailed("Command buffer bind path failed.");
+            _pathSlots.Add(path, slot);
+        }
+        return slot;
+    }
+
+    private uint PaintSlot(RenderPaint paint)
+    {
+        if (!_paintSlots.TryGetValue(paint, out var slot))
+        {
+            slot = (uint)_paintSlots.Count;
+            NativeMethods.CommandBuffer.BindPaint(DangerousGetHandle(), slot, paint.DangerousGetHandle())
+                .ThrowIfFailed("Command buffer bind paint failed.");
+            _paintSlots.Add(paint, slot);
+        }
+        return slot;
+    }
+
+    private uint ImageSlot(RenderImage image)
+    {
+        if (!_imageSlots.TryGetValue(image, out var slot))
+        {
+            slot = (uint)_imageSlots.Count;
+            NativeMethods.CommandBuffer.BindImage(DangerousGetHandle(), slot, image.DangerousGetHandle())
+                .ThrowIfFailed("Command buffer bind image failed.");
+            _imageSlots.Add(image, slot);
+        }
+        return slot;
+    }
+
+    private void WriteOp(CommandOp op) => WriteValue((uint)op);
+
+    private void WriteValue<T>(T value)
+        where T : unmanaged
+    {
+        var size = Unsafe.SizeOf<T>();
+        if (_length + size > _stream.Length)
+        {
+            Array.Resize(ref _stream, Math.Max(_stream.Length * 2, _length + size));
+        }
+        MemoryMarshal.Write(_stream.AsSpan(_length), in value);
+        _length += size;
+    }
+}
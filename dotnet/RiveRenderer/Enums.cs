@@ -58,6 +58,15 @@ public enum FillRule : byte
     Clockwise = 2,
 }
 
+public enum PathVerb : byte
+{
+    Move = 0,
+    Line = 1,
+    Quad = 2,
+    Cubic = 4,
+    Close = 5,
+}
+
 public enum PaintStyle : byte
 {
     Fill = 0,
@@ -132,6 +141,19 @@ public enum ImageWrap : byte
     Mirror = 2,
 }
 
+public enum PixelFormat : byte
+{
+    Rgba8Premultiplied = 0,
+    Bgra8Premultiplied = 1,
+    Rgba8Straight = 2,
+    Bgra8Straight = 3,
+}
+
+public enum ImageEncoding : byte
+{
+    Png = 0,
+}
+
 public enum TextAlign : byte
 {
     Left = 0,
@@ -196,6 +196,40 @@ internal sealed class FenceHandleSafe : RefHandle
     }
 }
 
+internal sealed class ReadbackHandleSafe : RefHandle
+{
+    internal static ReadbackHandleSafe FromNative(nint handle)
+    {
+        var result = new ReadbackHandleSafe();
+        result.SetHandle(handle);
+        return result;
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        var native = new NativeReadbackHandle { Handle = handle };
+        var status = NativeMethods.Readback.Release(native);
+        return status == RendererStatus.Ok;
+    }
+}
+
+internal sealed class EncodedImageHandleSafe : RefHandle
+{
+    internal static EncodedImageHandleSafe FromNative(nint handle)
+    {
+        var result = new EncodedImageHandleSafe();
+        result.SetHandle(handle);
+        return result;
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        var native = new NativeEncodedImageHandle { Handle = handle };
+        var status = NativeMethods.EncodedImage.Release(native);
+        return status == RendererStatus.Ok;
+    }
+}
+
 internal sealed class SurfaceHandleSafe : RefHandle
 {
     internal DeviceHandle Device { get; }
@@ -233,3 +267,80 @@ internal sealed class SurfaceHandleSafe : RefHandle
         return status == RendererStatus.Ok;
     }
 }
+
+internal sealed class CommandBufferHandleSafe : RefHandle
+{
+    internal ContextHandle Context { get; }
+    private readonly bool _addRef;
+
+    private CommandBufferHandleSafe(ContextHandle context)
+    {
+        Context = context;
+        Context.DangerousAddRef(ref _addRef);
+    }
+
+    internal static CommandBufferHandleSafe FromNative(nint handle, ContextHandle context)
+    {
+        var result = new CommandBufferHandleSafe(context);
+        result.SetHandle(handle);
+        return result;
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        var native = new NativeCommandBufferHandle { Handle = handle };
+        var status = NativeMethods.CommandBuffer.Release(native);
+        if (_addRef)
+        {
+            Context.DangerousRelease();
+        }
+        return status == RendererStatus.Ok;
+    }
+}
+
+internal sealed class PictureHandleSafe : RefHandle
+{
+    internal ContextHandle Context { get; }
+    private readonly bool _addRef;
+
+    private PictureHandleSafe(ContextHandle context)
+    {
+        Context = context;
+        Context.DangerousAddRef(ref _addRef);
+    }
+
+    internal static PictureHandleSafe FromNative(nint handle, ContextHandle context)
+    {
+        var result = new PictureHandleSafe(context);
+        result.SetHandle(handle);
+        return result;
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        var native = new NativePictureHandle { Handle = handle };
+        var status = NativeMethods.Picture.Release(native);
+        if (_addRef)
+        {
+            Context.DangerousRelease();
+        }
+        return status == RendererStatus.Ok;
+    }
+}
+
+internal sealed class ImmutablePathHandleSafe : RefHandle
+{
+    internal static ImmutablePathHandleSafe FromNative(nint handle)
+    {
+        var result = new ImmutablePathHandleSafe();
+        result.SetHandle(handle);
+        return result;
+    }
+
+    protected override bool ReleaseHandle()
+    {
+        var native = new NativeImmutablePathHandle { Handle = handle };
+        var status = NativeMethods.ImmutablePath.Release(native);
+        return status == RendererStatus.Ok;
+    }
+}
@@ -0,0 +1,59 @@
+using System;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Path geometry fixed at creation. Unlike <see cref="RenderPath"/>, it belongs to a device rather than a context and
+/// may be shared across threads and contexts.
+/// </summary>
+public sealed class ImmutableRenderPath : IDisposable
+{
+    private readonly ImmutablePathHandleSafe _handle;
+    private bool _disposed;
+
+    internal ImmutableRenderPath(ImmutablePathHandleSafe handle, FillRule fillRule)
+    {
+        _handle = handle;
+        FillRule = fillRule;
+
+        NativeMethods.ImmutablePath.GetBounds(DangerousGetHandle(), out var bounds)
+            .ThrowIfFailed("Failed to query immutable path bounds.");
+        NativeMethods.ImmutablePath.GetHash(DangerousGetHandle(), out var hash)
+            .ThrowIfFailed("Failed to query immutable path hash.");
+        Bounds = bounds;
+        ContentHash = hash;
+    }
+
+    public FillRule FillRule { get; }
+
+    /// <summary>
+    /// Tight bounds of the curves, which may be smaller than the bounds of the control points.
+    /// </summary>
+    public PathBounds Bounds { get; }
+
+    /// <summary>
+    /// Hash of the fill rule, verbs and points; paths with identical content share it.
+    /// </summary>
+    public ulong ContentHash { get; }
+
+    internal NativeImmutablePathHandle DangerousGetHandle() => new() { Handle = _handle.DangerousGetHandle() };
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        _handle.Dispose();
+    }
+
+    internal void ThrowIfDisposed()
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(ImmutableRenderPath));
+        }
+    }
+}
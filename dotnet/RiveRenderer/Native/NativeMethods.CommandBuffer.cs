@@ -0,0 +1,56 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+internal static partial class NativeMethods
+{
+    internal static partial class CommandBuffer
+    {
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_create")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Create(
+            NativeContextHandle context,
+            out NativeCommandBufferHandle buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_retain")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Retain(NativeCommandBufferHandle buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_release")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Release(NativeCommandBufferHandle buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_reset")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Reset(NativeCommandBufferHandle buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_write")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus Write(
+            NativeCommandBufferHandle buffer,
+            byte* data,
+            nuint length);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_bind_path")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus BindPath(
+            NativeCommandBufferHandle buffer,
+            uint slot,
+            NativePathHandle path);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_bind_paint")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus BindPaint(
+            NativeCommandBufferHandle buffer,
+            uint slot,
+            NativePaintHandle paint);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_command_buffer_bind_image")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus BindImage(
+            NativeCommandBufferHandle buffer,
+            uint slot,
+            NativeImageHandle image);
+    }
+}
@@ -37,6 +37,51 @@ internal static partial class NativeMethods
             uint width,
             uint height);
 
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_set_path_interning")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SetPathInterning(
+            NativeContextHandle context,
+            byte enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_set_damage_tracking")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SetDamageTracking(
+            NativeContextHandle context,
+            byte enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_invalidate_rect")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus InvalidateRect(
+            NativeContextHandle context,
+            DamageRect* rect);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_invalidate_picture")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus InvalidatePicture(
+            NativeContextHandle context,
+            NativePictureHandle picture,
+            Mat2D* transform);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_invalidate_picture_changes")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus InvalidatePictureChanges(
+            NativeContextHandle context,
+            NativePictureHandle previous,
+            NativePictureHandle next,
+            Mat2D* transform);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_get_frame_damage")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus GetFrameDamage(
+            NativeContextHandle context,
+            out DamageRect rect);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_get_picture_stats")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus GetPictureStats(
+            NativeContextHandle context,
+            out PictureStats stats);
+
         [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_begin_frame")]
         [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
         internal static partial RendererStatus BeginFrame(
@@ -51,11 +96,82 @@ internal static partial class NativeMethods
         [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
         internal static partial RendererStatus Submit(NativeContextHandle context);
 
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_set_frames_in_flight")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SetFramesInFlight(
+            NativeContextHandle context,
+            uint count);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_wait_idle")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus WaitIdle(NativeContextHandle context);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_get_completed_frame")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus GetCompletedFrame(
+            NativeContextHandle context,
+            out ulong frame);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_set_framebuffer_readback")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SetFramebufferReadback(
+            NativeContextHandle context,
+            byte enabled);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_request_readback")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus RequestReadback(
+            NativeContextHandle context,
+            PixelRect* rect,
+            PixelFormat format,
+            out NativeReadbackHandle readback);
+
         [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_copy_cpu_framebuffer")]
         [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
         internal static unsafe partial RendererStatus CopyCpuFramebuffer(
             NativeContextHandle context,
             byte* pixels,
             nuint byteLength);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_bind_cpu_framebuffer")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus BindCpuFramebuffer(
+            NativeContextHandle context,
+            nint pixels,
+            nuint stride,
+            nuint length,
+            PixelFormat format);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_set_shared_framebuffer")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SetSharedFramebuffer(
+            NativeContextHandle context,
+            uint slotCount,
+            PixelFormat format,
+            out SharedFramebufferInfo info);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_copy_cpu_framebuffer_region")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus CopyCpuFramebufferRegion(
+            NativeContextHandle context,
+            PixelRect* rect,
+            PixelFormat format,
+            byte* pixels,
+            nuint destinationStride,
+            nuint byteLength);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_encode_framebuffer")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus EncodeFramebuffer(
+            NativeContextHandle context,
+            ImageEncoding encoding,
+            byte quality,
+            out NativeEncodedImageHandle image);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_context_render_batch")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus RenderBatch(
+            NativeContextHandle context,
+            NativeBatchRenderInfo* info);
     }
 }
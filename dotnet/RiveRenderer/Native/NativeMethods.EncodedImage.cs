@@ -0,0 +1,24 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+internal static partial class NativeMethods
+{
+    internal static partial class EncodedImage
+    {
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_encoded_image_retain")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Retain(NativeEncodedImageHandle image);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_encoded_image_release")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Release(NativeEncodedImageHandle image);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_encoded_image_map")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Map(
+            NativeEncodedImageHandle image,
+            out NativeMappedMemory mapping);
+    }
+}
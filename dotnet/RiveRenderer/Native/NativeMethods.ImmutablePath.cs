@@ -0,0 +1,37 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+internal static partial class NativeMethods
+{
+    internal static partial class ImmutablePath
+    {
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_immutable_path_create")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus Create(
+            NativeDeviceHandle device,
+            FillRule fillRule,
+            PathVerb* verbs,
+            nuint verbCount,
+            float* points,
+            nuint pointCount,
+            out NativeImmutablePathHandle path);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_immutable_path_retain")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Retain(NativeImmutablePathHandle path);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_immutable_path_release")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Release(NativeImmutablePathHandle path);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_immutable_path_get_bounds")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus GetBounds(NativeImmutablePathHandle path, out PathBounds bounds);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_immutable_path_get_hash")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus GetHash(NativeImmutablePathHandle path, out ulong hash);
+    }
+}
@@ -59,5 +59,14 @@ internal static partial class NativeMethods
             NativePathHandle destination,
             NativePathHandle source,
             in Mat2D transform);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_path_append_commands")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus AppendCommands(
+            NativePathHandle path,
+            PathVerb* verbs,
+            nuint verbCount,
+            float* points,
+            nuint pointCount);
     }
 }
@@ -0,0 +1,30 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+internal static partial class NativeMethods
+{
+    internal static partial class Picture
+    {
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_picture_recorder_create")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus CreateRecorder(
+            NativeContextHandle context,
+            out NativeRendererHandle recorder);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_picture_recorder_finish")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus FinishRecording(
+            NativeRendererHandle recorder,
+            out NativePictureHandle picture);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_picture_retain")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Retain(NativePictureHandle picture);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_picture_release")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Release(NativePictureHandle picture);
+    }
+}
@@ -0,0 +1,43 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace RiveRenderer;
+
+internal static partial class NativeMethods
+{
+    internal static partial class Readback
+    {
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_retain")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Retain(NativeReadbackHandle readback);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_release")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Release(NativeReadbackHandle readback);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_poll")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Poll(
+            NativeReadbackHandle readback,
+            out byte ready);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_wait")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Wait(
+            NativeReadbackHandle readback,
+            ulong timeoutMilliseconds);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_map")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus Map(
+            NativeReadbackHandle readback,
+            out NativeMappedMemory mapping);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_readback_signal_fence")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SignalFence(
+            NativeReadbackHandle readback,
+            NativeFenceHandle fence,
+            ulong value);
+    }
+}
@@ -48,6 +48,19 @@ internal static partial class NativeMethods
             NativeRendererHandle renderer,
             NativePathHandle path);
 
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_renderer_draw_immutable_path")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus DrawImmutablePath(
+            NativeRendererHandle renderer,
+            NativeImmutablePathHandle path,
+            NativePaintHandle paint);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_renderer_clip_immutable_path")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus ClipImmutablePath(
+            NativeRendererHandle renderer,
+            NativeImmutablePathHandle path);
+
         [LibraryImport(LibraryName, EntryPoint = "rive_renderer_renderer_draw_image")]
         [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
         internal static unsafe partial RendererStatus DrawImage(
@@ -70,5 +83,19 @@ internal static partial class NativeMethods
             uint indexCount,
             BlendMode blendMode,
             float opacity);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_renderer_submit_commands")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static partial RendererStatus SubmitCommands(
+            NativeRendererHandle renderer,
+            NativeCommandBufferHandle buffer);
+
+        [LibraryImport(LibraryName, EntryPoint = "rive_renderer_renderer_draw_picture")]
+        [UnmanagedCallConv(CallConvs = new[] { typeof(CallConvCdecl) })]
+        internal static unsafe partial RendererStatus DrawPicture(
+            NativeRendererHandle renderer,
+            NativePictureHandle picture,
+            Mat2D* transform,
+            float opacity);
     }
 }
@@ -62,8 +62,38 @@ internal struct NativeFenceHandle
     public nint Handle;
 }
 
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeReadbackHandle
+{
+    public nint Handle;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeEncodedImageHandle
+{
+    public nint Handle;
+}
+
 [StructLayout(LayoutKind.Sequential)]
 internal struct NativeSurfaceHandle
 {
     public nint Handle;
 }
+
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeCommandBufferHandle
+{
+    public nint Handle;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativePictureHandle
+{
+    public nint Handle;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+internal struct NativeImmutablePathHandle
+{
+    public nint Handle;
+}
@@ -0,0 +1,54 @@
+using System;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Records the calls made on <see cref="Renderer"/> into pictures instead of drawing them.
+/// </summary>
+public sealed class PictureRecorder : IDisposable
+{
+    private readonly ContextHandle _context;
+    private bool _disposed;
+
+    internal PictureRecorder(Renderer renderer, ContextHandle context)
+    {
+        Renderer = renderer;
+        _context = context;
+    }
+
+    public Renderer Renderer { get; }
+
+    /// <summary>
+    /// Returns everything recorded since the last call and starts a new recording.
+    /// </summary>
+    public RenderPicture Finish()
+    {
+        ThrowIfDisposed();
+        var status = NativeMethods.Picture.FinishRecording(Renderer.DangerousGetHandle(), out var native);
+        status.ThrowIfFailed("Failed to finish picture recording.");
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native picture handle was null.");
+        }
+        return new RenderPicture(PictureHandleSafe.FromNative(native.Handle, _context));
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        Renderer.Dispose();
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(PictureRecorder));
+        }
+    }
+}
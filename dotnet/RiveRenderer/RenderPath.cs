@@ -65,6 +65,34 @@ public sealed class RenderPath : IDisposable
             .ThrowIfFailed("Failed to add path.");
     }
 
+    /// <summary>
+    /// Appends a batch of verbs in one native call. <paramref name="points"/> holds x/y pairs and must supply exactly
+    /// the points the verbs consume: one for move and line, two for quad, three for cubic and none for close.
+    /// </summary>
+    public void AppendCommands(ReadOnlySpan<PathVerb> verbs, ReadOnlySpan<float> points)
+    {
+        ThrowIfDisposed();
+        if ((points.Length & 1) != 0)
+        {
+            throw new ArgumentException("Points must be x/y pairs.", nameof(points));
+        }
+
+        unsafe
+        {
+            fixed (PathVerb* verbsPtr = verbs)
+            fixed (float* pointsPtr = points)
+            {
+                NativeMethods.Path.AppendCommands(
+                        DangerousGetHandle(),
+                        verbsPtr,
+                        (nuint)verbs.Length,
+                        pointsPtr,
+                        (nuint)(points.Length / 2))
+                    .ThrowIfFailed("Failed to append path commands.");
+            }
+        }
+    }
+
     public void Dispose()
     {
         if (_disposed)
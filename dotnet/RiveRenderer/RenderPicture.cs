@@ -0,0 +1,39 @@
+using System;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Renderer calls recorded once by a <see cref="PictureRecorder"/> and replayed natively with
+/// <see cref="Renderer.DrawPicture"/>. The picture keeps the paths, paints and images it draws alive.
+/// </summary>
+public sealed class RenderPicture : IDisposable
+{
+    private readonly PictureHandleSafe _handle;
+    private bool _disposed;
+
+    internal RenderPicture(PictureHandleSafe handle)
+    {
+        _handle = handle;
+    }
+
+    internal NativePictureHandle DangerousGetHandle() => new() { Handle = _handle.DangerousGetHandle() };
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        _handle.Dispose();
+    }
+
+    internal void ThrowIfDisposed()
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(RenderPicture));
+        }
+    }
+}
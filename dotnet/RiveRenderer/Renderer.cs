@@ -55,6 +55,28 @@ public sealed class Renderer : IDisposable
             .ThrowIfFailed("Renderer clip path failed.");
     }
 
+    public void DrawPath(ImmutableRenderPath path, RenderPaint paint)
+    {
+        ThrowIfDisposed();
+        path.ThrowIfDisposed();
+        paint.ThrowIfDisposed();
+        NativeMethods.Renderer.DrawImmutablePath(
+                DangerousGetHandle(),
+                path.DangerousGetHandle(),
+                paint.DangerousGetHandle())
+            .ThrowIfFailed("Renderer draw immutable path failed.");
+    }
+
+    public void ClipPath(ImmutableRenderPath path)
+    {
+        ThrowIfDisposed();
+        path.ThrowIfDisposed();
+        NativeMethods.Renderer.ClipImmutablePath(
+                DangerousGetHandle(),
+                path.DangerousGetHandle())
+            .ThrowIfFailed("Renderer clip immutable path failed.");
+    }
+
     public void DrawImageMesh(
         RenderImage image,
         RenderBuffer vertices,
@@ -124,6 +146,40 @@ public sealed class Renderer : IDisposable
         }
     }
 
+    public void Submit(CommandBuffer commands)
+    {
+        ThrowIfDisposed();
+        commands.Flush();
+        NativeMethods.Renderer.SubmitCommands(DangerousGetHandle(), commands.DangerousGetHandle())
+            .ThrowIfFailed("Renderer submit commands failed.");
+    }
+
+    /// <summary>
+    /// Replays a recorded picture under an optional extra transform, fading every draw by <paramref name="opacity"/>.
+    /// Draws that fall outside the render target or the current clip are skipped.
+    /// </summary>
+    public void DrawPicture(RenderPicture picture, Mat2D? transform = null, float opacity = 1f)
+    {
+        ThrowIfDisposed();
+        picture.ThrowIfDisposed();
+        if (!(opacity >= 0f && opacity <= 1f))
+        {
+            throw new ArgumentOutOfRangeException(nameof(opacity), "Opacity must be between 0 and 1.");
+        }
+
+        unsafe
+        {
+            Mat2D transformValue = transform ?? default;
+            Mat2D* transformPtr = transform.HasValue ? &transformValue : null;
+            NativeMethods.Renderer.DrawPicture(
+                    DangerousGetHandle(),
+                    picture.DangerousGetHandle(),
+                    transformPtr,
+                    opacity)
+                .ThrowIfFailed("Renderer draw picture failed.");
+        }
+    }
+
     public void Dispose()
     {
         if (_disposed)
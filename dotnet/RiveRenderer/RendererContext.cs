@@ -1,10 +1,17 @@
 using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.ExceptionServices;
+using System.Runtime.InteropServices;
 using System.Text;
 
 namespace RiveRenderer;
 
 public sealed class RendererContext : IDisposable
 {
+    public const uint MaxFramesInFlight = 3;
+    public const uint MaxBatchFramesInFlight = 8;
+
     private readonly RendererDevice _device;
     private readonly ContextHandle _handle;
     private bool _disposed;
@@ -51,6 +58,125 @@ public sealed class RendererContext : IDisposable
         _height = height;
     }
 
+    /// <summary>
+    /// When enabled, paths created afterwards share one native path per distinct geometry and fill rule, so identical
+    /// icons and glyphs are stored and preprocessed once. Paths that already exist are unaffected.
+    /// </summary>
+    public void SetPathInterning(bool enabled)
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.SetPathInterning(DangerousGetHandle(), enabled ? (byte)1 : (byte)0)
+            .ThrowIfFailed("Failed to set path interning.");
+    }
+
+    /// <summary>
+    /// When enabled, each frame redraws only the region invalidated since the previous frame and keeps the rest of the
+    /// target. Renderers are clipped to that region, and renderers kept from an earlier frame are reset by
+    /// <see cref="BeginFrame(FrameOptions)"/> to an identity transform. The null backend clears the region;
+    /// GPU backends keep its old pixels, so partial frames there should repaint an opaque background first. Metal and
+    /// the first frames after enabling or resizing always redraw in full.
+    /// </summary>
+    public void SetDamageTracking(bool enabled)
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.SetDamageTracking(DangerousGetHandle(), enabled ? (byte)1 : (byte)0)
+            .ThrowIfFailed("Failed to set damage tracking.");
+    }
+
+    /// <summary>
+    /// Marks a region of the target, in pixels, as changed for the next frame.
+    /// </summary>
+    public void Invalidate(in DamageRect rect)
+    {
+        ThrowIfDisposed();
+        unsafe
+        {
+            DamageRect value = rect;
+            NativeMethods.Context.InvalidateRect(DangerousGetHandle(), &value)
+                .ThrowIfFailed("Failed to invalidate rect.");
+        }
+    }
+
+    /// <summary>
+    /// Marks the whole target as changed, so the next frame redraws in full.
+    /// </summary>
+    public void InvalidateAll()
+    {
+        ThrowIfDisposed();
+        unsafe
+        {
+            NativeMethods.Context.InvalidateRect(DangerousGetHandle(), null)
+                .ThrowIfFailed("Failed to invalidate rect.");
+        }
+    }
+
+    /// <summary>
+    /// Marks everything the picture draws under the optional transform as changed for the next frame.
+    /// </summary>
+    public void Invalidate(RenderPicture picture, Mat2D? transform = null)
+    {
+        ThrowIfDisposed();
+        picture.ThrowIfDisposed();
+        unsafe
+        {
+            Mat2D transformValue = transform ?? default;
+            Mat2D* transformPtr = transform.HasValue ? &transformValue : null;
+            NativeMethods.Context.InvalidatePicture(DangerousGetHandle(), picture.DangerousGetHandle(), transformPtr)
+                .ThrowIfFailed("Failed to invalidate picture.");
+        }
+    }
+
+    /// <summary>
+    /// Marks only the draws that differ between two recordings of the same scene as changed for the next frame. Draws
+    /// are paired in recorded order and also differ when their transform or clips do, or when a path or paint they use
+    /// was edited between or after the recordings.
+    /// </summary>
+    public void InvalidateChanges(RenderPicture previous, RenderPicture next, Mat2D? transform = null)
+    {
+        ThrowIfDisposed();
+        previous.ThrowIfDisposed();
+        next.ThrowIfDisposed();
+        unsafe
+        {
+            Mat2D transformValue = transform ?? default;
+            Mat2D* transformPtr = transform.HasValue ? &transformValue : null;
+            NativeMethods.Context.InvalidatePictureChanges(
+                    DangerousGetHandle(),
+                    previous.DangerousGetHandle(),
+                    next.DangerousGetHandle(),
+                    transformPtr)
+                .ThrowIfFailed("Failed to invalidate picture changes.");
+        }
+    }
+
+    /// <summary>
+    /// Region, in pixels, redrawn by the current or most recent frame. It is empty when nothing was invalidated.
+    /// </summary>
+    public DamageRect FrameDamage
+    {
+        get
+        {
+            ThrowIfDisposed();
+            NativeMethods.Context.GetFrameDamage(DangerousGetHandle(), out var rect)
+                .ThrowIfFailed("Failed to get frame damage.");
+            return rect;
+        }
+    }
+
+    /// <summary>
+    /// Draws replayed and draws skipped by culling over every <see cref="Renderer.DrawPicture"/> on this context.
+    /// </summary>
+    public PictureStats PictureStats
+    {
+        get
+        {
+            ThrowIfDisposed();
+            NativeMethods.Context.GetPictureStats(DangerousGetHandle(), out var stats)
+                .ThrowIfFailed("Failed to get picture stats.");
+            return stats;
+        }
+    }
+
     public void BeginFrame(float deltaTimeMilliseconds = 0f, bool vsync = true)
     {
         BeginFrame(FrameOptions.Create(_width, _height, deltaTimeMilliseconds, vsync));
@@ -83,6 +209,41 @@ public sealed class RendererContext : IDisposable
         status.ThrowIfFailed("Failed to submit frame.");
     }
 
+    /// <summary>
+    /// Sets how many submitted frames may still be running on the GPU, from 1 to <see cref="MaxFramesInFlight"/>.
+    /// With more than one, <see cref="Submit"/> returns without waiting for the GPU and
+    /// <see cref="BeginFrame(FrameOptions)"/> only blocks once that many frames are outstanding.
+    /// </summary>
+    public void SetFramesInFlight(uint count)
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.SetFramesInFlight(DangerousGetHandle(), count)
+            .ThrowIfFailed("Failed to set frames in flight.");
+    }
+
+    /// <summary>
+    /// Blocks until every submitted frame has finished on the GPU.
+    /// </summary>
+    public void WaitIdle()
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.WaitIdle(DangerousGetHandle()).ThrowIfFailed("Failed to wait for the GPU.");
+    }
+
+    /// <summary>
+    /// Number of the newest frame the GPU has finished. Frames are numbered from 1 in submission order.
+    /// </summary>
+    public ulong CompletedFrame
+    {
+        get
+        {
+            ThrowIfDisposed();
+            NativeMethods.Context.GetCompletedFrame(DangerousGetHandle(), out var frame)
+                .ThrowIfFailed("Failed to get completed frame.");
+            return frame;
+        }
+    }
+
     public void SignalFence(RendererFence fence, ulong value = 0)
     {
         ThrowIfDisposed();
@@ -135,6 +296,32 @@ public sealed class RendererContext : IDisposable
         return new Renderer(handle);
     }
 
+    public CommandBuffer CreateCommandBuffer()
+    {
+        ThrowIfDisposed();
+        var status = NativeMethods.CommandBuffer.Create(DangerousGetHandle(), out var native);
+        status.ThrowIfFailed("Failed to create command buffer.");
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native command buffer handle was null.");
+        }
+        var handle = CommandBufferHandleSafe.FromNative(native.Handle, _handle);
+        return new CommandBuffer(handle);
+    }
+
+    public PictureRecorder CreatePictureRecorder()
+    {
+        ThrowIfDisposed();
+        var status = NativeMethods.Picture.CreateRecorder(DangerousGetHandle(), out var native);
+        status.ThrowIfFailed("Failed to create picture recorder.");
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native picture recorder handle was null.");
+        }
+        var handle = RendererHandleSafe.FromNative(native.Handle, _handle);
+        return new PictureRecorder(new Renderer(handle), _handle);
+    }
+
     public RendererSurface CreateSurfaceWin32(nint hwnd, uint width, uint height, RendererSurfaceOptions options = default)
     {
         ThrowIfDisposed();
@@ -361,6 +548,102 @@ public sealed class RendererContext : IDisposable
         return new RenderShader(ShaderHandleSafe.FromNative(native.Handle));
     }
 
+    /// <summary>
+    /// Makes GPU contexts copy each frame into a staging buffer as it renders, so <see cref="CopyCpuFramebuffer"/> can
+    /// return its pixels. Supported on the null backend, where it has no effect, and on Vulkan.
+    /// </summary>
+    public void SetFramebufferReadback(bool enabled)
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.SetFramebufferReadback(DangerousGetHandle(), enabled ? (byte)1 : (byte)0)
+            .ThrowIfFailed("Failed to set framebuffer readback.");
+    }
+
+    /// <summary>
+    /// Queues a copy of <paramref name="rect"/>, or the whole target when null, from the frame being recorded.
+    /// Supported on the null and Vulkan backends.
+    /// </summary>
+    public RendererReadback RequestReadback(PixelRect? rect = null, PixelFormat format = PixelFormat.Rgba8Premultiplied)
+    {
+        ThrowIfDisposed();
+        var region = rect ?? new PixelRect(0, 0, _width, _height);
+        NativeReadbackHandle native;
+        unsafe
+        {
+            NativeMethods.Context.RequestReadback(DangerousGetHandle(), rect.HasValue ? &region : null, format,
+                    out native)
+                .ThrowIfFailed("Failed to request readback.");
+        }
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native readback handle was null.");
+        }
+        return new RendererReadback(this, ReadbackHandleSafe.FromNative(native.Handle), region, format);
+    }
+
+    /// <summary>
+    /// Makes null-backend frames render straight into <paramref name="pixels"/>, such as a pinned array or a locked
+    /// bitmap, instead of an internal framebuffer. The memory must stay valid and unmodified between frames until
+    /// <see cref="UnbindCpuFramebuffer"/> is called; frames are converted to <paramref name="format"/> in place.
+    /// </summary>
+    public void BindCpuFramebuffer(nint pixels, int stride, nuint length,
+        PixelFormat format = PixelFormat.Rgba8Premultiplied)
+    {
+        ThrowIfDisposed();
+        if (pixels == 0)
+        {
+            throw new ArgumentNullException(nameof(pixels));
+        }
+        if (stride <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(stride));
+        }
+
+        NativeMethods.Context.BindCpuFramebuffer(DangerousGetHandle(), pixels, (nuint)stride, length, format)
+            .ThrowIfFailed("Failed to bind CPU framebuffer.");
+    }
+
+    public void UnbindCpuFramebuffer()
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.BindCpuFramebuffer(DangerousGetHandle(), 0, 0, 0, PixelFormat.Rgba8Premultiplied)
+            .ThrowIfFailed("Failed to unbind CPU framebuffer.");
+    }
+
+    /// <summary>
+    /// Renders null-backend frames into a ring of <paramref name="slotCount"/> slots in anonymous shared memory that
+    /// another process can map read-only through the returned descriptor. The region starts with a header carrying
+    /// the layout and the sequence number of each published frame. The context owns the descriptor. Not available on
+    /// Windows; call again after resizing the context.
+    /// </summary>
+    public SharedFramebufferInfo SetSharedFramebuffer(uint slotCount = 3,
+        PixelFormat format = PixelFormat.Rgba8Premultiplied)
+    {
+        ThrowIfDisposed();
+        if (slotCount == 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(slotCount));
+        }
+
+        NativeMethods.Context.SetSharedFramebuffer(DangerousGetHandle(), slotCount, format, out var info)
+            .ThrowIfFailed("Failed to create shared framebuffer.");
+        return info;
+    }
+
+    /// <summary>
+    /// Stops publishing frames and unmaps the shared framebuffer, closing the context's descriptor. Readers that
+    /// mapped the region keep their mapping.
+    /// </summary>
+    public void ReleaseSharedFramebuffer()
+    {
+        ThrowIfDisposed();
+        NativeMethods.Context.SetSharedFramebuffer(DangerousGetHandle(), 0, PixelFormat.Rgba8Premultiplied, out _)
+            .ThrowIfFailed("Failed to release shared framebuffer.");
+    }
+
+    /// <summary>
+    /// Copies the last rendered frame as premultiplied RGBA8. GPU contexts need <see cref="SetFramebufferReadback"/>.
+    /// </summary>
     public void CopyCpuFramebuffer(Span<byte> destination)
     {
         ThrowIfDisposed();
@@ -375,11 +658,206 @@ public sealed class RendererContext : IDisposable
             fixed (byte* ptr = destination)
             {
                 NativeMethods.Context.CopyCpuFramebuffer(DangerousGetHandle(), ptr, (nuint)required)
-                    .ThrowIfFailed("Failed to copy CPU framebuffer. Only the null backend currently supports this call.");
+                    .ThrowIfFailed("Failed to copy CPU framebuffer.");
             }
         }
     }
 
+    /// <summary>
+    /// Copies <paramref name="rect"/> of the last rendered frame, or all of it when null, converted to
+    /// <paramref name="format"/>. The first row starts at the beginning of <paramref name="destination"/> and rows are
+    /// <paramref name="stride"/> bytes apart; slice the destination to place the rect inside a larger image.
+    /// </summary>
+    public void CopyCpuFramebuffer(Span<byte> destination, int stride, PixelFormat format, PixelRect? rect = null)
+    {
+        ThrowIfDisposed();
+        if (stride <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(stride));
+        }
+
+        var region = rect ?? new PixelRect(0, 0, _width, _height);
+        unsafe
+        {
+            fixed (byte* ptr = destination)
+            {
+                NativeMethods.Context.CopyCpuFramebufferRegion(DangerousGetHandle(), &region, format, ptr,
+                        (nuint)stride, (nuint)destination.Length)
+                    .ThrowIfFailed("Failed to copy CPU framebuffer.");
+            }
+        }
+    }
+
+    /// <summary>
+    /// Encodes the last rendered frame as a straight-alpha PNG file. <paramref name="quality"/> (0-100) is the
+    /// compression effort.
+    /// </summary>
+    public byte[] EncodeFramebuffer(ImageEncoding encoding = ImageEncoding.Png, byte quality = 75)
+    {
+        ThrowIfDisposed();
+        if (quality > 100)
+        {
+            throw new ArgumentOutOfRangeException(nameof(quality));
+        }
+
+        NativeMethods.Context.EncodeFramebuffer(DangerousGetHandle(), encoding, quality, out var native)
+            .ThrowIfFailed("Failed to encode framebuffer.");
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native encoded image handle was null.");
+        }
+
+        using var image = EncodedImageHandleSafe.FromNative(native.Handle);
+        NativeMethods.EncodedImage.Map(native, out var mapping)
+            .ThrowIfFailed("Failed to map encoded image.");
+        unsafe
+        {
+            return new ReadOnlySpan<byte>((void*)mapping.Data, checked((int)mapping.Length)).ToArray();
+        }
+    }
+
+    /// <summary>
+    /// Renders <see cref="BatchRenderOptions.FrameCount"/> frames drawn by <paramref name="scene"/> and hands each to
+    /// <paramref name="onFrame"/>. Frame n + 1 renders while frame n is read back and encoded on a background thread;
+    /// returns once every frame has been delivered. Supported on the null backend and Vulkan.
+    /// </summary>
+    public void RenderBatch(in BatchRenderOptions options, BatchSceneCallback scene, BatchFrameCallback onFrame)
+    {
+        if (scene is null)
+        {
+            throw new ArgumentNullException(nameof(scene));
+        }
+
+        RenderBatch(options, scene, Array.Empty<RenderPicture>(), onFrame);
+    }
+
+    /// <summary>
+    /// Renders a batch in which frame i replays <paramref name="pictures"/>[i % count].
+    /// </summary>
+    public void RenderBatch(in BatchRenderOptions options, IReadOnlyList<RenderPicture> pictures,
+        BatchFrameCallback onFrame)
+    {
+        if (pictures is null)
+        {
+            throw new ArgumentNullException(nameof(pictures));
+        }
+        if (pictures.Count == 0)
+        {
+            throw new ArgumentException("At least one picture is required.", nameof(pictures));
+        }
+
+        RenderBatch(options, null, pictures, onFrame);
+    }
+
+    private unsafe void RenderBatch(in BatchRenderOptions options, BatchSceneCallback? scene,
+        IReadOnlyList<RenderPicture> pictures, BatchFrameCallback onFrame)
+    {
+        ThrowIfDisposed();
+        if (onFrame is null)
+        {
+            throw new ArgumentNullException(nameof(onFrame));
+        }
+        if (options.FrameCount <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(options), "Frame count must be positive.");
+        }
+
+        var nativePictures = new NativePictureHandle[pictures.Count];
+        for (var i = 0; i < pictures.Count; i++)
+        {
+            pictures[i].ThrowIfDisposed();
+            nativePictures[i] = pictures[i].DangerousGetHandle();
+        }
+
+        var state = new BatchCallbackState(this, scene, onFrame);
+        var stateHandle = GCHandle.Alloc(state);
+        RendererStatus status;
+        try
+        {
+            fixed (NativePictureHandle* picturePointer = nativePictures)
+            {
+                var info = new NativeBatchRenderInfo
+                {
+                    Scene = scene is null ? null : &RenderBatchScene,
+                    Pictures = scene is null ? picturePointer : null,
+                    PictureCount = scene is null ? (uint)nativePictures.Length : 0,
+                    FrameCount = (uint)options.FrameCount,
+                    StartTime = options.StartTime,
+                    TimeStep = options.TimeStep,
+                    MaxFramesInFlight = options.MaxFramesInFlight,
+                    Encode = options.Encoding.HasValue ? (byte)1 : (byte)0,
+                    Encoding = options.Encoding ?? ImageEncoding.Png,
+                    Quality = options.Quality,
+                    Format = options.Format,
+                    OnFrame = &DeliverBatchFrame,
+                    UserData = GCHandle.ToIntPtr(stateHandle),
+                };
+                status = NativeMethods.Context.RenderBatch(DangerousGetHandle(), &info);
+            }
+        }
+        finally
+        {
+            stateHandle.Free();
+            GC.KeepAlive(pictures);
+        }
+
+        if (state.Error is not null)
+        {
+            ExceptionDispatchInfo.Capture(state.Error).Throw();
+        }
+        status.ThrowIfFailed("Batch render failed.");
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static RendererStatus RenderBatchScene(nint userData, NativeRendererHandle renderer, uint frameIndex,
+        float time)
+    {
+        var state = (BatchCallbackState)GCHandle.FromIntPtr(userData).Target!;
+        try
+        {
+            NativeMethods.Renderer.Retain(renderer).ThrowIfFailed("Failed to retain batch renderer.");
+            using var wrapper = new Renderer(RendererHandleSafe.FromNative(renderer.Handle, state.Context._handle));
+            state.Scene!(wrapper, (int)frameIndex, time);
+            return RendererStatus.Ok;
+        }
+        catch (Exception ex)
+        {
+            Interlocked.CompareExchange(ref state.Error, ex, null);
+            return RendererStatus.InternalError;
+        }
+    }
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvCdecl) })]
+    private static unsafe RendererStatus DeliverBatchFrame(nint userData, uint frameIndex, byte* data, nuint length)
+    {
+        var state = (BatchCallbackState)GCHandle.FromIntPtr(userData).Target!;
+        try
+        {
+            state.OnFrame((int)frameIndex, new ReadOnlySpan<byte>(data, checked((int)length)));
+            return RendererStatus.Ok;
+        }
+        catch (Exception ex)
+        {
+            Interlocked.CompareExchange(ref state.Error, ex, null);
+            return RendererStatus.InternalError;
+        }
+    }
+
+    private sealed class BatchCallbackState
+    {
+        public readonly RendererContext Context;
+        public readonly BatchSceneCallback? Scene;
+        public readonly BatchFrameCallback OnFrame;
+        public Exception? Error;
+
+        public BatchCallbackState(RendererContext context, BatchSceneCallback? scene, BatchFrameCallback onFrame)
+        {
+            Context = context;
+            Scene = scene;
+            OnFrame = onFrame;
+        }
+    }
+
     public RenderBuffer CreateBuffer(BufferType type, nuint sizeInBytes, BufferFlags flags = BufferFlags.None, ReadOnlySpan<byte> initialData = default)
     {
         ThrowIfDisposed();
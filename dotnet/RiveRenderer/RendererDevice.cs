@@ -74,6 +74,46 @@ public sealed class RendererDevice : IDisposable
         return new RendererContext(this, handle, width, height);
     }
 
+    /// <summary>
+    /// Builds a path that can be drawn from any thread by every context created on this device. The verbs and
+    /// points follow <see cref="RenderPath.AppendCommands"/>.
+    /// </summary>
+    public ImmutableRenderPath CreateImmutablePath(
+        ReadOnlySpan<PathVerb> verbs,
+        ReadOnlySpan<float> points,
+        FillRule fillRule = FillRule.NonZero)
+    {
+        ThrowIfDisposed();
+        if ((points.Length & 1) != 0)
+        {
+            throw new ArgumentException("Points must be x/y pairs.", nameof(points));
+        }
+
+        NativeImmutablePathHandle native;
+        unsafe
+        {
+            fixed (PathVerb* verbsPtr = verbs)
+            fixed (float* pointsPtr = points)
+            {
+                var status = NativeMethods.ImmutablePath.Create(
+                    DangerousGetHandle(),
+                    fillRule,
+                    verbsPtr,
+                    (nuint)verbs.Length,
+                    pointsPtr,
+                    (nuint)(points.Length / 2),
+                    out native);
+                status.ThrowIfFailed("Failed to create immutable path.");
+            }
+        }
+
+        if (native.Handle == 0)
+        {
+            throw new RendererException(RendererStatus.InternalError, "Native immutable path handle was null.");
+        }
+        return new ImmutableRenderPath(ImmutablePathHandleSafe.FromNative(native.Handle), fillRule);
+    }
+
     public RendererFence CreateFence()
     {
         ThrowIfDisposed();
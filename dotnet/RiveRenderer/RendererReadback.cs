@@ -0,0 +1,101 @@
+using System;
+
+namespace RiveRenderer;
+
+/// <summary>
+/// Pixels of a region of one frame, copied without stalling the render loop. Request it with
+/// <see cref="RendererContext.RequestReadback"/> between <see cref="RendererContext.BeginFrame(FrameOptions)"/> and
+/// <see cref="RendererContext.EndFrame"/>, then poll <see cref="IsReady"/> or <see cref="Wait"/> once the frame is
+/// submitted. Use it from the thread that drives its context; other threads can wait on a fence passed to
+/// <see cref="SignalFence"/>.
+/// </summary>
+public sealed class RendererReadback : IDisposable
+{
+    private readonly RendererContext _context;
+    private readonly ReadbackHandleSafe _handle;
+    private bool _disposed;
+
+    internal RendererReadback(RendererContext context, ReadbackHandleSafe handle, PixelRect rect, PixelFormat format)
+    {
+        _context = context;
+        _handle = handle;
+        Rect = rect;
+        Format = format;
+    }
+
+    public PixelRect Rect { get; }
+
+    public PixelFormat Format { get; }
+
+    public int Stride => checked((int)Rect.Width * 4);
+
+    internal NativeReadbackHandle DangerousGetHandle() => new() { Handle = _handle.DangerousGetHandle() };
+
+    public bool IsReady
+    {
+        get
+        {
+            ThrowIfDisposed();
+            NativeMethods.Readback.Poll(DangerousGetHandle(), out var ready)
+                .ThrowIfFailed("Failed to poll readback.");
+            return ready != 0;
+        }
+    }
+
+    public void Wait(ulong timeoutMilliseconds = ulong.MaxValue)
+    {
+        ThrowIfDisposed();
+        NativeMethods.Readback.Wait(DangerousGetHandle(), timeoutMilliseconds)
+            .ThrowIfFailed("Readback wait failed.");
+    }
+
+    /// <summary>
+    /// Returns the tightly packed rows of a completed readback. The span stays valid until the readback is disposed.
+    /// </summary>
+    public ReadOnlySpan<byte> Map()
+    {
+        ThrowIfDisposed();
+        NativeMethods.Readback.Map(DangerousGetHandle(), out var mapping)
+            .ThrowIfFailed("Failed to map readback.");
+        unsafe
+        {
+            return new ReadOnlySpan<byte>((void*)mapping.Data, checked((int)mapping.Length));
+        }
+    }
+
+    /// <summary>
+    /// Signals <paramref name="fence"/> with <paramref name="value"/> once the readback completes. A value of zero
+    /// signals the fence's last value plus one.
+    /// </summary>
+    public void SignalFence(RendererFence fence, ulong value = 0)
+    {
+        ThrowIfDisposed();
+        if (fence is null)
+        {
+            throw new ArgumentNullException(nameof(fence));
+        }
+
+        fence.ThrowIfDisposed();
+        NativeMethods.Readback.SignalFence(DangerousGetHandle(), fence.DangerousGetHandle(), value)
+            .ThrowIfFailed("Failed to signal fence.");
+    }
+
+    internal void ThrowIfDisposed()
+    {
+        if (_disposed)
+        {
+            throw new ObjectDisposedException(nameof(RendererReadback));
+        }
+    }
+
+    public void Dispose()
+    {
+        if (_disposed)
+        {
+            return;
+        }
+
+        _disposed = true;
+        _handle.Dispose();
+    }
+}
@@ -117,6 +117,130 @@ public struct ImageSampler
     };
 }
 
+[StructLayout(LayoutKind.Sequential)]
+public struct PathBounds
+{
+    public float Left;
+    public float Top;
+    public float Right;
+    public float Bottom;
+
+    public readonly float Width => Right - Left;
+    public readonly float Height => Bottom - Top;
+}
+
+/// <summary>
+/// Totals of picture draws replayed and skipped by culling on a context; see <see cref="RendererContext.PictureStats"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct PictureStats
+{
+    public ulong DrawsReplayed;
+    public ulong DrawsCulled;
+}
+
+/// <summary>
+/// Region of a context's target in pixels, from its top-left corner to its bottom-right corner.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DamageRect
+{
+    public float Left;
+    public float Top;
+    public float Right;
+    public float Bottom;
+
+    public DamageRect(float left, float top, float right, float bottom)
+    {
+        Left = left;
+        Top = top;
+        Right = right;
+        Bottom = bottom;
+    }
+
+    public readonly float Width => Right - Left;
+    public readonly float Height => Bottom - Top;
+    public readonly bool IsEmpty => !(Right > Left && Bottom > Top);
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct PixelRect
+{
+    public uint X;
+    public uint Y;
+    public uint Width;
+    public uint Height;
+
+    public PixelRect(uint x, uint y, uint width, uint height)
+    {
+        X = x;
+        Y = y;
+        Width = width;
+        Height = height;
+    }
+}
+
+/// <summary>
+/// Descriptor and size of a shared framebuffer region; see <see cref="RendererContext.SetSharedFramebuffer"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct SharedFramebufferInfo
+{
+    public int FileDescriptor;
+    private uint _reserved;
+    public ulong Size;
+}
+
+/// <summary>
+/// Header at the start of a shared framebuffer region. Frame n lives in slot n % <see cref="SlotCount"/>, at
+/// <see cref="SlotOffset"/> + slot * <see cref="SlotSize"/>. Readers copy a slot and keep the copy only if
+/// <see cref="GetSlotSequence"/> still returns the frame's number afterwards.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct SharedFramebufferHeader
+{
+    public const uint ExpectedMagic = 0x42465652; // "RVFB"
+    public const uint ExpectedVersion = 1;
+    public const int MaxSlots = 8;
+
+    public uint Magic;
+    public uint Version;
+    public uint Width;
+    public uint Height;
+    public uint SlotCount;
+    public PixelFormat Format;
+    private byte _reserved0;
+    private byte _reserved1;
+    private byte _reserved2;
+    public ulong Stride;
+    public ulong SlotOffset;
+    public ulong SlotSize;
+    public ulong LatestSequence;
+    private unsafe fixed ulong _slotSequences[MaxSlots];
+
+    /// <summary>
+    /// Reads the header from the start of a shared framebuffer region.
+    /// </summary>
+    public static SharedFramebufferHeader Read(ReadOnlySpan<byte> region) =>
+        MemoryMarshal.Read<SharedFramebufferHeader>(region);
+
+    /// <summary>
+    /// The frame <paramref name="slot"/> holds, or 0 while it is being rendered.
+    /// </summary>
+    public ulong GetSlotSequence(int slot)
+    {
+        if ((uint)slot >= MaxSlots)
+        {
+            throw new ArgumentOutOfRangeException(nameof(slot));
+        }
+
+        unsafe
+        {
+            return _slotSequences[slot];
+        }
+    }
+}
+
 [StructLayout(LayoutKind.Sequential, Pack = 1)]
 internal struct TextStyleOptions
 {
@@ -167,3 +291,21 @@ internal static class RendererConstants
 {
     public const int MaxAdapterName = 256;
 }
+
+[StructLayout(LayoutKind.Sequential)]
+internal unsafe struct NativeBatchRenderInfo
+{
+    public delegate* unmanaged[Cdecl]<nint, NativeRendererHandle, uint, float, RendererStatus> Scene;
+    public NativePictureHandle* Pictures;
+    public uint PictureCount;
+    public uint FrameCount;
+    public float StartTime;
+    public float TimeStep;
+    public uint MaxFramesInFlight;
+    public byte Encode;
+    public ImageEncoding Encoding;
+    public byte Quality;
+    public PixelFormat Format;
+    public delegate* unmanaged[Cdecl]<nint, uint, byte*, nuint, RendererStatus> OnFrame;
+    public nint UserData;
+}
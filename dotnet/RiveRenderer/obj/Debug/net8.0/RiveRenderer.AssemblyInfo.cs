@@ -0,0 +1,24 @@
+//------------------------------------------------------------------------------
+// <auto-generated>
+//     This code was generated by a tool.
+//
+//     Changes to this file may cause incorrect behavior and will be lost if
+//     the code is regenerated.
+// </auto-generated>
+//------------------------------------------------------------------------------
+
+using System;
+using System.Reflection;
+
+[assembly: System.Reflection.AssemblyCompanyAttribute("RiveSharp")]
+[assembly: System.Reflection.AssemblyConfigurationAttribute("Debug")]
+[assembly: System.Reflection.AssemblyDescriptionAttribute("High-performance Rive GPU renderer bindings for .NET with native interop shims.")]
+[assembly: System.Reflection.AssemblyFileVersionAttribute("0.1.0.0")]
+[assembly: System.Reflection.AssemblyInformationalVersionAttribute("0.1.0-dev+2820367bf9e4236cd87ee5e66be514576717427e")]
+[assembly: System.Reflection.AssemblyProductAttribute("RiveRenderer")]
+[assembly: System.Reflection.AssemblyTitleAttribute("RiveRenderer")]
+[assembly: System.Reflection.AssemblyVersionAttribute("0.1.0.0")]
+[assembly: System.Reflection.AssemblyMetadataAttribute("RepositoryUrl", "https://github.com/wieslawsoltes/RiveSharp")]
+
+// Generated by the MSBuild WriteCodeFragment class.
+
@@ -17,6 +17,11 @@ extern "C"
 {
 
     static constexpr std::size_t RIVE_RENDERER_MAX_ADAPTER_NAME = 256;
+    static constexpr std::uint32_t RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT = 3;
+    static constexpr std::uint32_t RIVE_RENDERER_MAX_SHARED_FRAMEBUFFER_SLOTS = 8;
+    static constexpr std::uint32_t RIVE_RENDERER_SHARED_FRAMEBUFFER_MAGIC = 0x42465652; // "RVFB"
+    static constexpr std::uint32_t RIVE_RENDERER_SHARED_FRAMEBUFFER_VERSION = 1;
+    static constexpr std::uint32_t RIVE_RENDERER_MAX_BATCH_FRAMES_IN_FLIGHT = 8;
 
     enum class rive_renderer_status_t : std::int32_t
     {
@@ -199,6 +204,16 @@ extern "C"
         void* handle;
     };
 
+    struct rive_renderer_readback_t
+    {
+        void* handle;
+    };
+
+    struct rive_renderer_encoded_image_t
+    {
+        void* handle;
+    };
+
     struct rive_renderer_mapped_memory_t
     {
         void*        data;
@@ -222,6 +237,16 @@ extern "C"
         clockwise = 2,
     };
 
+    // Path verbs for rive_renderer_path_append_commands, with the number of points each one consumes.
+    enum class rive_renderer_path_verb_t : std::uint8_t
+    {
+        move  = 0, // 1 point
+        line  = 1, // 1 point
+        quad  = 2, // 2 points: control, end
+        cubic = 4, // 3 points: out control, in control, end
+        close = 5, // no points
+    };
+
     enum class rive_renderer_paint_style_t : std::uint8_t
     {
         fill   = 0,
@@ -349,6 +374,153 @@ extern "C"
         void* handle;
     };
 
+    struct rive_renderer_immutable_path_t
+    {
+        void* handle;
+    };
+
+    struct rive_renderer_rect_t
+    {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    struct rive_renderer_pixel_rect_t
+    {
+        std::uint32_t x;
+        std::uint32_t y;
+        std::uint32_t width;
+        std::uint32_t height;
+    };
+
+    // Byte order and alpha of 8-bit pixels handed to the host. Straight formats divide color by alpha and store fully
+    // transparent pixels as zero.
+    enum class rive_renderer_pixel_format_t : std::uint8_t
+    {
+        rgba8_premultiplied = 0,
+        bgra8_premultiplied = 1,
+        rgba8_straight      = 2,
+        bgra8_straight      = 3,
+    };
+
+    enum class rive_renderer_image_encoding_t : std::uint8_t
+    {
+        png = 0,
+    };
+
+    // Start of a shared framebuffer region; see context_set_shared_framebuffer. Frame n lives in slot
+    // n % slot_count, slot_offset + slot * slot_size bytes into the region, as height rows stride bytes apart.
+    // latest_sequence is the newest published frame and slot_sequences the frame each slot holds, or 0 while the slot
+    // is being rendered. Both are written with release stores. To read frame n, load it from latest_sequence with
+    // acquire, copy its slot, issue an acquire fence, and keep the copy if slot_sequences still equals n.
+    struct rive_renderer_shared_framebuffer_header_t
+    {
+        std::uint32_t                magic;
+        std::uint32_t                version;
+        std::uint32_t                width;
+        std::uint32_t                height;
+        std::uint32_t                slot_count;
+        rive_renderer_pixel_format_t format;
+        std::uint8_t                 reserved[3];
+        std::uint64_t                stride;
+        std::uint64_t                slot_offset;
+        std::uint64_t                slot_size;
+        std::uint64_t                latest_sequence;
+        std::uint64_t                slot_sequences[RIVE_RENDERER_MAX_SHARED_FRAMEBUFFER_SLOTS];
+    };
+
+    struct rive_renderer_shared_framebuffer_t
+    {
+        std::int32_t  fd;
+        std::uint32_t reserved;
+        std::uint64_t size;
+    };
+
+    struct rive_renderer_command_buffer_t
+    {
+        void* handle;
+    };
+
+    struct rive_renderer_picture_t
+    {
+        void* handle;
+    };
+
+    // Counts of picture draws; see context_get_picture_stats.
+    struct rive_renderer_picture_stats_t
+    {
+        std::uint64_t draws_replayed;
+        std::uint64_t draws_culled;
+    };
+
+    // Draws frame frame_index of a batch, at time start_time + frame_index * time_step, into renderer. Runs on the
+    // thread that called context_render_batch; returning anything but ok stops the batch with that status.
+    typedef rive_renderer_status_t (*rive_renderer_batch_scene_callback_t)(void* user_data,
+                                                                          rive_renderer_renderer_t renderer,
+                                                                          std::uint32_t frame_index, float time);
+
+    // Receives the output of frame frame_index of a batch. Frames arrive in order on a single batch thread, and data
+    // is only valid during the call. Returning anything but ok stops the batch with that status.
+    typedef rive_renderer_status_t (*rive_renderer_batch_frame_callback_t)(void* user_data, std::uint32_t frame_index,
+                                                                          const std::uint8_t* data,
+                                                                          std::size_t         length);
+
+    // Frames come from scene, or when it is null, frame i replays pictures[i % picture_count]. With encode nonzero
+    // each frame is delivered as an image in encoding at quality, as from context_encode_framebuffer; otherwise as
+    // tightly packed rows in format. max_frames_in_flight (1 to RIVE_RENDERER_MAX_BATCH_FRAMES_IN_FLIGHT) caps the
+    // frames rendered but not yet delivered, and with it the batch's memory.
+    struct rive_renderer_batch_render_info_t
+    {
+        rive_renderer_batch_scene_callback_t scene;
+        const rive_renderer_picture_t*       pictures;
+        std::uint32_t                        picture_count;
+        std::uint32_t                        frame_count;
+        float                                start_time;
+        float                                time_step;
+        std::uint32_t                        max_frames_in_flight;
+        std::uint8_t                         encode;
+        rive_renderer_image_encoding_t       encoding;
+        std::uint8_t                         quality;
+        rive_renderer_pixel_format_t         format;
+        rive_renderer_batch_frame_callback_t on_frame;
+        void*                                user_data;
+    };
+
+    // Command buffers hold a binary stream of renderer calls that is replayed with a single submit. The stream is a
+    // sequence of records, each a 32-bit op followed by the op's payload, in native byte order. Every record is a
+    // multiple of 4 bytes. Paths, paints and images are referenced by the slot they were bound to on the buffer.
+    enum class rive_renderer_command_op_t : std::uint32_t
+    {
+        save       = 1, // no payload
+        restore    = 2, // no payload
+        transform  = 3, // rive_renderer_mat2d_t
+        clip_path  = 4, // rive_renderer_command_clip_path_t
+        draw_path  = 5, // rive_renderer_command_draw_path_t
+        draw_image = 6, // rive_renderer_command_draw_image_t
+    };
+
+    struct rive_renderer_command_clip_path_t
+    {
+        std::uint32_t path_slot;
+    };
+
+    struct rive_renderer_command_draw_path_t
+    {
+        std::uint32_t path_slot;
+        std::uint32_t paint_slot;
+    };
+
+    struct rive_renderer_command_draw_image_t
+    {
+        std::uint32_t                 image_slot;
+        rive_renderer_image_sampler_t sampler;
+        rive_renderer_blend_mode_t    blend_mode;
+        std::uint8_t                  reserved[3];
+        float                         opacity;
+    };
+
     enum class rive_renderer_text_align_t : std::uint8_t
     {
         left   = 0,
@@ -375,6 +547,10 @@ extern "C"
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
     rive_renderer_device_create(const rive_renderer_device_create_info_t* info, rive_renderer_device_t* out_device);
 
+    // Wraps a device the host created. Contexts made on it render offscreen into a context-owned R8G8B8A8 image sized
+    // to the context and submit to graphics_queue, which the host must not use concurrently with submit, wait_idle or
+    // release. Any physical device works, including software ones such as lavapipe, so this also serves as a headless
+    // GPU path. Surfaces on Vulkan devices are not implemented yet.
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
     rive_renderer_device_create_vulkan(const rive_renderer_device_create_info_vulkan_t* info,
                                        rive_renderer_device_t* out_device);
@@ -408,8 +584,62 @@ extern "C"
 
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_end_frame(rive_renderer_context_t context);
 
+    // Damage tracking. While enabled, begin_frame redraws only the region invalidated since the previous frame and
+    // keeps the rest of the target from earlier frames. Renderers are clipped to that region and pictures cull against
+    // it; a renderer kept from an earlier frame is reset by begin_frame to an identity transform and no clip besides
+    // the new region, so draw with it only after the frame has begun. The region is cleared to transparent on the null
+    // backend, while GPU backends keep its old pixels, so partial frames there should repaint an opaque background
+    // first. Frames that cannot rely on earlier contents redraw in full: the first frames after enabling or resizing,
+    // and every Metal frame.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_set_damage_tracking(rive_renderer_context_t context, std::uint8_t enabled);
+
+    // Marks a region of the target, in pixels, as changed for the next frame. A null rect invalidates everything.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_invalidate_rect(rive_renderer_context_t context, const rive_renderer_rect_t* rect);
+
+    // Marks everything a picture draws under the optional transform as changed for the next frame.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_invalidate_picture(
+        rive_renderer_context_t context, rive_renderer_picture_t picture, const rive_renderer_mat2d_t* transform);
+
+    // Marks the draws that differ between two recordings of the same scene as changed for the next frame. Draws are
+    // paired in recorded order and compared by the paths, paints and images they use, the transform and clips they
+    // draw under and where they land. A path or paint edited between or after the recordings changes every draw
+    // that uses it.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_invalidate_picture_changes(rive_renderer_context_t context, rive_renderer_picture_t previous,
+                                                     rive_renderer_picture_t      next,
+                                                     const rive_renderer_mat2d_t* transform);
+
+    // Region, in pixels, redrawn by the current or most recent frame. It is empty when nothing was invalidated.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_get_frame_damage(rive_renderer_context_t context, rive_renderer_rect_t* out_rect);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_submit(rive_renderer_context_t context);
 
+    // Number of submitted frames, 1 to RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT, that may still be running on the GPU.
+    // With the default of 1, submit waits for the GPU to finish the frame. With more, submit returns as soon as the
+    // frame is queued and begin_frame only waits once that many frames are outstanding, so recording a frame overlaps
+    // with the GPU drawing earlier ones. The count cannot change between begin_frame and submit; changing it waits for
+    // the frames in flight. The null backend renders every frame synchronously.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_set_frames_in_flight(rive_renderer_context_t context, std::uint32_t count);
+
+    // Blocks until every submitted frame has finished on the GPU.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_wait_idle(rive_renderer_context_t context);
+
+    // Number of the newest frame the GPU has finished. Frames are numbered from 1 in submission order, and 0 means
+    // none has finished yet.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_get_completed_frame(rive_renderer_context_t context, std::uint64_t* out_frame);
+
+    // GPU contexts only make their pixels available to copy_cpu_framebuffer while readback is enabled. Each frame
+    // ended with it on copies the target into a persistent staging buffer as part of the frame's own work, and
+    // copy_cpu_framebuffer returns the newest submitted such frame, waiting for it if it is still in flight.
+    // Supported on the null backend, where it has no effect, and on Vulkan.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_set_framebuffer_readback(rive_renderer_context_t context, std::uint8_t enabled);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
     rive_renderer_surface_create_d3d12_hwnd(rive_renderer_device_t device, rive_renderer_context_t context,
                                             const rive_renderer_surface_create_info_d3d12_hwnd_t* info,
@@ -455,10 +685,51 @@ extern "C"
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
     rive_renderer_fence_wait(rive_renderer_fence_t fence, std::uint64_t value, std::uint64_t timeout_ms);
 
+    // Signals fence to value once the frames submitted so far have finished. Fences on devices other than D3D12 are
+    // signaled by the context as it observes frames finish, on the thread driving it, and can be waited on from any
+    // thread. Waits and completed-value queries also ask the GPU about those frames, so they finish after that thread
+    // stops submitting.
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
     rive_renderer_context_signal_fence(rive_renderer_context_t context, rive_renderer_fence_t fence,
                                        std::uint64_t value);
 
+    // Asynchronous readback. A readback requested between begin_frame and end_frame copies rect of the frame's target,
+    // or all of it when rect is null, as that frame's last GPU work into a staging buffer from a pool owned by the
+    // context. Later frames render while it completes; poll or wait for it, then map it to read width * 4 byte rows.
+    // The mapping stays valid until the readback is released. Readbacks keep their context alive and, like it, must be
+    // used from the thread driving the context; signal_fence hands completion to other threads. Supported on the null
+    // backend and Vulkan.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_request_readback(rive_renderer_context_t context, const rive_renderer_pixel_rect_t* rect,
+                                           rive_renderer_pixel_format_t format, rive_renderer_readback_t* out_readback);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_readback_retain(rive_renderer_readback_t readback);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_readback_release(rive_renderer_readback_t readback);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_readback_poll(rive_renderer_readback_t readback, std::uint8_t* out_ready);
+
+    // Blocks until the readback's frame finishes. Times out with invalid_parameter like fence_wait, and fails if the
+    // frame has not been submitted.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_readback_wait(rive_renderer_readback_t readback, std::uint64_t timeout_ms);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_readback_map(rive_renderer_readback_t readback, rive_renderer_mapped_memory_t* out_mapping);
+
+    // Signals fence to value once the readback's pixels can be mapped.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_readback_signal_fence(rive_renderer_readback_t readback, rive_renderer_fence_t fence,
+                                        std::uint64_t value);
+
+    // With interning enabled (nonzero), paths created on the context afterwards share one backing render path per
+    // distinct fill rule, verbs and points, so identical geometry is stored and preprocessed once. A path is matched
+    // to its shared backing when drawn after an edit. Appending a path created without interning opts the
+    // destination out. Paths created earlier are unaffected.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_set_path_interning(rive_renderer_context_t context, std::uint8_t enabled);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_path_create(rive_renderer_context_t   context,
                                                                               rive_renderer_fill_rule_t fill_rule,
                                                                               rive_renderer_path_t*     out_path);
@@ -488,6 +759,34 @@ extern "C"
                                                                                 rive_renderer_path_t source,
                                                                                 const rive_renderer_mat2d_t* transform);
 
+    // Appends verb_count verbs (rive_renderer_path_verb_t values) and point_count x/y pairs in one call. points holds
+    // 2 * point_count floats and must supply exactly the points the verbs consume; on any mismatch the path is left
+    // unchanged.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_path_append_commands(rive_renderer_path_t path, const std::uint8_t* verbs, std::size_t verb_count,
+                                       const float* points, std::size_t point_count);
+
+    // Immutable paths are built once from the same verb and point arrays as rive_renderer_path_append_commands. They
+    // may be retained, released and drawn from any thread, by every context created on the device.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_immutable_path_create(
+        rive_renderer_device_t device, rive_renderer_fill_rule_t fill_rule, const std::uint8_t* verbs,
+        std::size_t verb_count, const float* points, std::size_t point_count, rive_renderer_immutable_path_t* out_path);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_immutable_path_retain(rive_renderer_immutable_path_t path);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_immutable_path_release(rive_renderer_immutable_path_t path);
+
+    // Tight bounds of the path's curves, which may be smaller than the bounds of its control points. Empty paths
+    // report an all-zero rectangle.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_immutable_path_get_bounds(rive_renderer_immutable_path_t path, rive_renderer_rect_t* out_bounds);
+
+    // 64-bit hash of the fill rule, verbs and points. Paths with identical content hash equally.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_immutable_path_get_hash(rive_renderer_immutable_path_t path, std::uint64_t* out_hash);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_paint_create(rive_renderer_context_t context,
                                                                                rive_renderer_paint_t*  out_paint);
 
@@ -537,6 +836,15 @@ extern "C"
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_renderer_clip_path(rive_renderer_renderer_t renderer,
                                                                                      rive_renderer_path_t     path);
 
+    // Draws an immutable path created on the renderer's device. Each context builds its own render path the first
+    // time it draws the immutable path and reuses it afterwards, without locking; the context drops it some time
+    // after the immutable path is destroyed, and with the context itself.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_renderer_draw_immutable_path(
+        rive_renderer_renderer_t renderer, rive_renderer_immutable_path_t path, rive_renderer_paint_t paint);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_renderer_clip_immutable_path(rive_renderer_renderer_t renderer, rive_renderer_immutable_path_t path);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_buffer_create(rive_renderer_context_t      context,
                                                                                 rive_renderer_buffer_type_t  type,
                                                                                 rive_renderer_buffer_flags_t flags,
@@ -582,6 +890,71 @@ extern "C"
         rive_renderer_buffer_t vertices, rive_renderer_buffer_t uvs, rive_renderer_buffer_t indices,
         std::uint32_t vertex_count, std::uint32_t index_count, rive_renderer_blend_mode_t blend_mode, float opacity);
 
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_command_buffer_create(rive_renderer_context_t context, rive_renderer_command_buffer_t* out_buffer);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_command_buffer_retain(rive_renderer_command_buffer_t buffer);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_command_buffer_release(rive_renderer_command_buffer_t buffer);
+
+    // Drops the recorded commands. Slot bindings are kept so steady-state frames only re-encode the stream.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_command_buffer_reset(rive_renderer_command_buffer_t buffer);
+
+    // Appends encoded records. A record may be split across writes; the stream is validated on submit.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_command_buffer_write(
+        rive_renderer_command_buffer_t buffer, const void* data, std::size_t data_length);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_command_buffer_bind_path(
+        rive_renderer_command_buffer_t buffer, std::uint32_t slot, rive_renderer_path_t path);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_command_buffer_bind_paint(
+        rive_renderer_command_buffer_t buffer, std::uint32_t slot, rive_renderer_paint_t paint);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_command_buffer_bind_image(
+        rive_renderer_command_buffer_t buffer, std::uint32_t slot, rive_renderer_image_t image);
+
+    // Replays the recorded stream on the renderer. The whole stream is validated first, so a malformed record or an
+    // unbound slot fails the call without drawing anything. The stream is kept and may be submitted again.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_renderer_submit_commands(
+        rive_renderer_renderer_t renderer, rive_renderer_command_buffer_t buffer);
+
+    // Creates a renderer that records its calls into a picture instead of drawing them. Every renderer entry point,
+    // including command buffer submits, can record. Pictures keep the paths, paints and images they draw alive.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_picture_recorder_create(rive_renderer_context_t context, rive_renderer_renderer_t* out_recorder);
+
+    // Moves the calls recorded so far into a new picture. The recorder starts over empty and may keep recording.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_picture_recorder_finish(rive_renderer_renderer_t recorder, rive_renderer_picture_t* out_picture);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_picture_retain(rive_renderer_picture_t picture);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_picture_release(rive_renderer_picture_t picture);
+
+    // Replays a picture under an optional extra transform, fading every draw by opacity in [0, 1]. The renderer's
+    // state is saved and restored around the replay. Path draws are faded through a copy of their paint rebuilt from
+    // the paint's current settings, so paints edited after recording replay with their new settings. Gradient shaders
+    // are rebuilt with every stop color faded; every shader this API creates is a gradient, and any other shader set
+    // on a paint is drawn at its own alpha. The faded copies are cached by the renderer's context until a frame
+    // begins without them having been used in the previous one.
+    //
+    // Finishing a picture indexes its draws by bounds, and replays skip the draws that fall outside the render target
+    // and the clips set on the renderer. Bounds come from the paths, stroke settings and images as they were when
+    // recorded; draws whose extent is unknown, such as image meshes, are never skipped. Paths drawn by reference
+    // keep taking their edits, as paints do, and once a path or paint is edited to reach past the bounds it was
+    // recorded with, the next use of the picture measures its draws again and refits the index to them. Paths of a
+    // context that interns paths are captured as they were when drawn.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_renderer_draw_picture(rive_renderer_renderer_t renderer, rive_renderer_picture_t picture,
+                                        const rive_renderer_mat2d_t* transform, float opacity);
+
+    // Totals of draws replayed and culled by picture replays on the context's renderers since it was created.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_context_get_picture_stats(rive_renderer_context_t context, rive_renderer_picture_stats_t* out_stats);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_font_decode(rive_renderer_context_t context,
                                                                               const std::uint8_t*     font_data,
                                                                               std::size_t             font_length,
@@ -610,9 +983,64 @@ extern "C"
         rive_renderer_context_t context, rive_renderer_font_t font, const char* utf8_text, std::size_t utf8_length,
         const rive_renderer_text_style_t* style, rive_renderer_fill_rule_t fill_rule, rive_renderer_path_t* out_path);
 
+    // Copies the last rendered frame as tightly packed, premultiplied RGBA8 rows. GPU contexts need framebuffer
+    // readback enabled.
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_copy_cpu_framebuffer(
         rive_renderer_context_t context, std::uint8_t* out_pixels, std::size_t buffer_length);
 
+    // Makes the null backend render straight into caller-owned memory instead of its internal framebuffer. Rows are
+    // stride bytes apart and length must cover the context's size, which begin_frame checks again after a resize.
+    // Frames render as premultiplied RGBA8 and are converted in place to format at end_frame. With damage tracking on,
+    // pixels outside the damaged region are kept from the previous frame, so the memory must not be modified between
+    // frames; rebind it after changing it. copy_cpu_framebuffer and readbacks read from the bound memory and need
+    // rgba8_premultiplied. Pass null pixels to go back to the internal framebuffer. Not allowed while a frame records.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_bind_cpu_framebuffer(
+        rive_renderer_context_t context, std::uint8_t* pixels, std::size_t stride, std::size_t length,
+        rive_renderer_pixel_format_t format);
+
+    // Renders null-backend frames into a ring of slot_count (2 to RIVE_RENDERER_MAX_SHARED_FRAMEBUFFER_SLOTS) slots
+    // in a memfd, or an unlinked POSIX shared memory object outside Linux, that other processes can map read-only.
+    // The region starts with a rive_renderer_shared_framebuffer_header_t and end_frame publishes each frame in it.
+    // out_info receives the descriptor and size of the region; the context owns the descriptor, so dup it before
+    // passing it on. Recreate the ring after resizing the context. A slot_count of 0 releases the ring. Not available
+    // on Windows, and not while a frame records or cpu framebuffer memory is bound.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_set_shared_framebuffer(
+        rive_renderer_context_t context, std::uint32_t slot_count, rive_renderer_pixel_format_t format,
+        rive_renderer_shared_framebuffer_t* out_info);
+
+    // Copies rect of the last rendered frame, or all of it when rect is null, converted to format. Row y of the rect
+    // is written destination_stride bytes after row y - 1, starting at out_pixels; offset out_pixels to place the rect
+    // inside a larger image. destination_stride must be at least rect width * 4 and buffer_length must cover the last
+    // row. Same backend requirements as copy_cpu_framebuffer.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_copy_cpu_framebuffer_region(
+        rive_renderer_context_t context, const rive_renderer_pixel_rect_t* rect, rive_renderer_pixel_format_t format,
+        std::uint8_t* out_pixels, std::size_t destination_stride, std::size_t buffer_length);
+
+    // Encodes the last rendered frame as a straight-alpha RGBA PNG. quality (0-100) picks the deflate effort, from
+    // stored at 0 to the smallest output at 100. Row bands are filtered and compressed concurrently and stitched into
+    // one stream. The bytes stay valid until the image is released, which hands its buffer back to the context for
+    // the next encode. Same backend requirements as copy_cpu_framebuffer.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_encode_framebuffer(
+        rive_renderer_context_t context, rive_renderer_image_encoding_t encoding, std::uint8_t quality,
+        rive_renderer_encoded_image_t* out_image);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_encoded_image_retain(rive_renderer_encoded_image_t image);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_encoded_image_release(rive_renderer_encoded_image_t image);
+
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t
+    rive_renderer_encoded_image_map(rive_renderer_encoded_image_t image, rive_renderer_mapped_memory_t* out_mapping);
+
+    // Renders frame_count frames offline and hands each to info->on_frame. The calling thread records and submits
+    // frames while a batch thread converts or encodes earlier ones and delivers them, so rendering frame n + 1
+    // overlaps the readback and encoding of frame n. Returns once every frame has been delivered or the batch stopped.
+    // Damage tracking is suspended for the batch and the context's framebuffer is left undefined. Supported on the
+    // null backend, without bound or shared cpu framebuffer memory, and on Vulkan.
+    RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_context_render_batch(
+        rive_renderer_context_t context, const rive_renderer_batch_render_info_t* info);
+
     RIVE_RENDERER_FFI_EXPORT rive_renderer_status_t rive_renderer_shader_linear_gradient_create(
         rive_renderer_context_t context, float start_x, float start_y, float end_x, float end_y,
         const rive_renderer_color_t* colors, const float* stops, std::size_t stop_count,
@@ -650,3 +1078,12 @@ static_assert(sizeof(rive_renderer_surface_create_info_vulkan_t) == 28,
               "Vulkan surface create info size mismatch");
 static_assert(sizeof(rive_renderer_frame_options_t) == 16, "Frame options size mismatch");
 static_assert(sizeof(rive_renderer_text_style_t) == 24, "Text style size mismatch");
+static_assert(sizeof(rive_renderer_rect_t) == 16, "Rect size mismatch");
+static_assert(sizeof(rive_renderer_pixel_rect_t) == 16, "Pixel rect size mismatch");
+static_assert(sizeof(rive_renderer_shared_framebuffer_header_t) == 120, "Shared framebuffer header size mismatch");
+static_assert(sizeof(rive_renderer_shared_framebuffer_t) == 16, "Shared framebuffer size mismatch");
+static_assert(sizeof(rive_renderer_picture_stats_t) == 16, "Picture stats size mismatch");
+static_assert(sizeof(rive_renderer_batch_render_info_t) == 24 + 4 * sizeof(void*), "Batch render info size mismatch");
+static_assert(sizeof(rive_renderer_command_clip_path_t) == 4, "Clip path command size mismatch");
+static_assert(sizeof(rive_renderer_command_draw_path_t) == 8, "Draw path command size mismatch");
+static_assert(sizeof(rive_renderer_command_draw_image_t) == 16, "Draw image command size mismatch");
@@ -0,0 +1,372 @@
+#include "cpu_blend.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(RIVE_RENDERER_CPU_X86_SIMD)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace rive_renderer_cpu
+{
+#if defined(RIVE_RENDERER_CPU_X86_SIMD)
+    // Defined in the per-instruction-set translation units, which are compiled with the matching target flags.
+    const BlendKernels& GetSse41BlendKernels();
+    const BlendKernels& GetAvx2BlendKernels();
+    const BlendKernels& GetAvx512BlendKernels();
+#endif
+
+    namespace
+    {
+#if defined(RIVE_RENDERER_CPU_X86_SIMD)
+        struct CpuidResult
+        {
+            std::uint32_t eax {0};
+            std::uint32_t ebx {0};
+            std::uint32_t ecx {0};
+            std::uint32_t edx {0};
+        };
+
+        CpuidResult Cpuid(std::uint32_t leaf, std::uint32_t subleaf)
+        {
+            CpuidResult result;
+#if defined(_MSC_VER)
+            int registers[4] {};
+            __cpuidex(registers, static_cast<int>(leaf), static_cast<int>(subleaf));
+            result = {static_cast<std::uint32_t>(registers[0]), static_cast<std::uint32_t>(registers[1]),
+                      static_cast<std::uint32_t>(registers[2]), static_cast<std::uint32_t>(registers[3])};
+#else
+            __cpuid_count(leaf, subleaf, result.eax, result.ebx, result.ecx, result.edx);
+#endif
+            return result;
+        }
+
+        std::uint64_t ReadXcr0()
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            std::uint32_t eax = 0;
+            std::uint32_t edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+        }
+#endif
+
+        struct Color
+        {
+            float r;
+            float g;
+            float b;
+        };
+
+        float UnpackChannel(std::uint32_t pixel, int shift)
+        {
+            return static_cast<float>((pixel >> shift) & 0xff) * (1.0f / 255.0f);
+        }
+
+        float Lum(const Color& c)
+        {
+            return 0.3f * c.r + 0.59f * c.g + 0.11f * c.b;
+        }
+
+        Color ClipColor(Color c)
+        {
+            const float l = Lum(c);
+            const float n = std::min(c.r, std::min(c.g, c.b));
+            const float x = std::max(c.r, std::max(c.g, c.b));
+            if (n < 0.0f)
+            {
+                const float scale = l / (l - n);
+                c                 = {l + (c.r - l) * scale, l + (c.g - l) * scale, l + (c.b - l) * scale};
+            }
+            if (x > 1.0f)
+            {
+                const float scale = (1.0f - l) / (x - l);
+                c                 = {l + (c.r - l) * scale, l + (c.g - l) * scale, l + (c.b - l) * scale};
+            }
+            return c;
+        }
+
+        Color SetLum(const Color& c, float l)
+        {
+            const float d = l - Lum(c);
+            return ClipColor({c.r + d, c.g + d, c.b + d});
+        }
+
+        float Sat(const Color& c)
+        {
+            return std::max(c.r, std::max(c.g, c.b)) - std::min(c.r, std::min(c.g, c.b));
+        }
+
+        Color SetSat(const Color& c, float s)
+        {
+            const float mx = std::max(c.r, std::max(c.g, c.b));
+            const float mn = std::min(c.r, std::min(c.g, c.b));
+            if (mx <= mn)
+            {
+                return {0.0f, 0.0f, 0.0f};
+            }
+            const float scale = s / (mx - mn);
+            return {(c.r - mn) * scale, (c.g - mn) * scale, (c.b - mn) * scale};
+        }
+
+        float BlendChannel(BlendMode mode, float cs, float cb)
+        {
+            switch (mode)
+            {
+            case BlendMode::screen:
+                return cb + cs - cb * cs;
+            case BlendMode::overlay:
+                return cb <= 0.5f ? cs * 2.0f * cb : 1.0f - (1.0f - cs) * (1.0f - (2.0f * cb - 1.0f));
+            case BlendMode::darken:
+                return std::min(cs, cb);
+            case BlendMode::lighten:
+                return std::max(cs, cb);
+            case BlendMode::colorDodge:
+                if (cb <= 0.0f)
+                {
+                    return 0.0f;
+                }
+                return cs >= 1.0f ? 1.0f : std::min(1.0f, cb / (1.0f - cs));
+            case BlendMode::colorBurn:
+                if (cb >= 1.0f)
+                {
+                    return 1.0f;
+                }
+                return cs <= 0.0f ? 0.0f : 1.0f - std::min(1.0f, (1.0f - cb) / cs);
+            case BlendMode::hardLight:
+                return cs <= 0.5f ? cb * 2.0f * cs : 1.0f - (1.0f - cb) * (1.0f - (2.0f * cs - 1.0f));
+            case BlendMode::softLight:
+            {
+                if (cs <= 0.5f)
+                {
+                    return cb - (1.0f - 2.0f * cs) * cb * (1.0f - cb);
+                }
+                const float d = cb <= 0.25f ? ((16.0f * cb - 12.0f) * cb + 4.0f) * cb : std::sqrt(cb);
+                return cb + (2.0f * cs - 1.0f) * (d - cb);
+            }
+            case BlendMode::difference:
+                return std::fabs(cb - cs);
+            case BlendMode::exclusion:
+                return cb + cs - 2.0f * cb * cs;
+            case BlendMode::multiply:
+                return cs * cb;
+            default:
+                return cs;
+            }
+        }
+
+        Color BlendNonSeparable(BlendMode mode, const Color& cs, const Color& cb)
+        {
+            switch (mode)
+            {
+            case BlendMode::hue:
+                return SetLum(SetSat(cs, Sat(cb)), Lum(cb));
+            case BlendMode::saturation:
+                return SetLum(SetSat(cb, Sat(cs)), Lum(cb));
+            case BlendMode::color:
+                return SetLum(cs, Lum(cb));
+            case BlendMode::luminosity:
+                return SetLum(cb, Lum(cs));
+            default:
+                return {BlendChannel(mode, cs.r, cb.r), BlendChannel(mode, cs.g, cb.g),
+                        BlendChannel(mode, cs.b, cb.b)};
+            }
+        }
+
+        std::uint32_t SrcOver(std::uint32_t dst, std::uint32_t src, std::uint32_t coverage)
+        {
+            if (coverage == 0)
+            {
+                return dst;
+            }
+            if (coverage != 255)
+            {
+                src = MulDiv255(src & 0xff, coverage) | (MulDiv255((src >> 8) & 0xff, coverage) << 8) |
+                      (MulDiv255((src >> 16) & 0xff, coverage) << 16) | (MulDiv255(src >> 24, coverage) << 24);
+            }
+            const std::uint32_t inverse = 255 - (src >> 24);
+            if (inverse == 0)
+            {
+                return src;
+            }
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                const std::uint32_t s = (src >> shift) & 0xff;
+                const std::uint32_t d = (dst >> shift) & 0xff;
+                result |= (s + MulDiv255(d, inverse)) << shift;
+            }
+            return result;
+        }
+
+        std::uint32_t BlendAdvanced(BlendMode mode, std::uint32_t dst, std::uint32_t src, std::uint32_t coverage)
+        {
+            if (coverage == 0)
+            {
+                return dst;
+            }
+            const float sa = UnpackChannel(src, 24);
+            const float da = UnpackChannel(dst, 24);
+            const Color s {UnpackChannel(src, 0), UnpackChannel(src, 8), UnpackChannel(src, 16)};
+            const Color d {UnpackChannel(dst, 0), UnpackChannel(dst, 8), UnpackChannel(dst, 16)};
+
+            // Premultiplied W3C compositing: Co = cs(1 - da) + cd(1 - sa) + sa * da * B(Cs, Cb).
+            const Color cs = sa > 0.0f ? Color {s.r / sa, s.g / sa, s.b / sa} : Color {0.0f, 0.0f, 0.0f};
+            const Color cb = da > 0.0f ? Color {d.r / da, d.g / da, d.b / da} : Color {0.0f, 0.0f, 0.0f};
+            const Color blended = BlendNonSeparable(mode, cs, cb);
+            const float both    = sa * da;
+            const float ra      = sa + da - both;
+            const float rr      = s.r * (1.0f - da) + d.r * (1.0f - sa) + both * blended.r;
+            const float rg      = s.g * (1.0f - da) + d.g * (1.0f - sa) + both * blended.g;
+            const float rb      = s.b * (1.0f - da) + d.b * (1.0f - sa) + both * blended.b;
+
+            const float t      = static_cast<float>(coverage) * (1.0f / 255.0f);
+            auto        toByte = [t](float result, float original)
+            {
+                const float v = original + (result - original) * t;
+                return static_cast<std::uint32_t>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f);
+            };
+            return toByte(rr, d.r) | (toByte(rg, d.g) << 8) | (toByte(rb, d.b) << 16) | (toByte(ra, da) << 24);
+        }
+    } // namespace
+
+    std::uint32_t BlendPixel(BlendMode mode, std::uint32_t dst, std::uint32_t src, std::uint32_t coverage)
+    {
+        if (mode == BlendMode::srcOver)
+        {
+            return SrcOver(dst, src, coverage);
+        }
+        return BlendAdvanced(mode, dst, src, coverage);
+    }
+
+    void BlendSpan(BlendMode mode, std::uint32_t* dst, const std::uint32_t* src, const std::uint8_t* coverage,
+                   std::uint8_t constantCoverage, std::int32_t count)
+    {
+        for (std::int32_t i = 0; i < count; ++i)
+        {
+            dst[i] = BlendPixel(mode, dst[i], src[i], coverage != nullptr ? coverage[i] : constantCoverage);
+        }
+    }
+
+    void BlendSolidSpan(BlendMode mode, std::uint32_t* dst, std::uint32_t color, const std::uint8_t* coverage,
+                        std::uint8_t constantCoverage, std::int32_t count)
+    {
+        if (mode == BlendMode::srcOver && coverage == nullptr && constantCoverage == 255 && (color >> 24) == 255)
+        {
+            std::fill(dst, dst + count, color);
+            return;
+        }
+        for (std::int32_t i = 0; i < count; ++i)
+        {
+            dst[i] = BlendPixel(mode, dst[i], color, coverage != nullptr ? coverage[i] : constantCoverage);
+        }
+    }
+
+    std::uint32_t ConvertPixel(std::uint32_t pixel, bool swapRedBlue, bool unpremultiply)
+    {
+        std::uint32_t       r = pixel & 0xff;
+        const std::uint32_t g = (pixel >> 8) & 0xff;
+        std::uint32_t       b = (pixel >> 16) & 0xff;
+        const std::uint32_t a = pixel >> 24;
+        if (unpremultiply)
+        {
+            if (a == 0)
+            {
+                return 0;
+            }
+            const float scale  = 255.0f / static_cast<float>(a);
+            auto        divide = [scale](std::uint32_t c)
+            { return static_cast<std::uint32_t>(std::min(static_cast<float>(c) * scale + 0.5f, 255.0f)); };
+            r = divide(r);
+            b = divide(b);
+            pixel = r | (divide(g) << 8) | (b << 16) | (a << 24);
+        }
+        if (swapRedBlue)
+        {
+            pixel = (pixel & 0xff00ff00) | (r << 16) | b;
+        }
+        return pixel;
+    }
+
+    void ConvertSpan(std::uint8_t* dst, const std::uint8_t* src, std::int32_t count, bool swapRedBlue,
+                     bool unpremultiply)
+    {
+        if (!swapRedBlue && !unpremultiply)
+        {
+            std::memmove(dst, src, static_cast<std::size_t>(count) * 4);
+            return;
+        }
+        for (std::int32_t i = 0; i < count; ++i)
+        {
+            std::uint32_t pixel;
+            std::memcpy(&pixel, src + i * 4, sizeof(pixel));
+            pixel = ConvertPixel(pixel, swapRedBlue, unpremultiply);
+            std::memcpy(dst + i * 4, &pixel, sizeof(pixel));
+        }
+    }
+
+    SimdLevel DetectSimdLevel()
+    {
+#if defined(RIVE_RENDERER_CPU_X86_SIMD)
+        const std::uint32_t maxLeaf = Cpuid(0, 0).eax;
+        if (maxLeaf < 1)
+        {
+            return SimdLevel::portable;
+        }
+        const CpuidResult features = Cpuid(1, 0);
+        if ((features.ecx & (1u << 19)) == 0)
+        {
+            return SimdLevel::portable;
+        }
+
+        // Wider registers are only usable when the OS saves them across context switches (OSXSAVE + XCR0).
+        const bool          osxsave  = (features.ecx & (1u << 27)) != 0;
+        const bool          avx      = (features.ecx & (1u << 28)) != 0;
+        const std::uint64_t xcr0     = osxsave ? ReadXcr0() : 0;
+        const bool          ymmState = (xcr0 & 0x6) == 0x6;
+        const bool          zmmState = (xcr0 & 0xe6) == 0xe6;
+        if (maxLeaf < 7 || !avx || !ymmState)
+        {
+            return SimdLevel::sse41;
+        }
+        const CpuidResult extended = Cpuid(7, 0);
+        if ((extended.ebx & (1u << 5)) == 0)
+        {
+            return SimdLevel::sse41;
+        }
+        if (zmmState && (extended.ebx & (1u << 16)) != 0)
+        {
+            return SimdLevel::avx512;
+        }
+        return SimdLevel::avx2;
+#else
+        return SimdLevel::portable;
+#endif
+    }
+
+    const BlendKernels& GetBlendKernels(SimdLevel level)
+    {
+        static const BlendKernels portable {SimdLevel::portable, &BlendSpan, &BlendSolidSpan, &ConvertSpan};
+        switch (level)
+        {
+#if defined(RIVE_RENDERER_CPU_X86_SIMD)
+        case SimdLevel::avx512:
+            return GetAvx512BlendKernels();
+        case SimdLevel::avx2:
+            return GetAvx2BlendKernels();
+        case SimdLevel::sse41:
+            return GetSse41BlendKernels();
+#endif
+        default:
+            return portable;
+        }
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "cpu_math.hpp"
+
+namespace rive_renderer_cpu
+{
+    // Instruction sets the compositing kernels are built for, in increasing order of preference.
+    enum class SimdLevel : std::uint8_t
+    {
+        portable,
+        sse41,
+        avx2,
+        avx512,
+    };
+
+    // Returns the best level supported by both this build and the running CPU (including OS register state support).
+    SimdLevel DetectSimdLevel();
+
+    // Span compositing entry points for one instruction set. Every variant produces exactly the same pixels as the
+    // portable one; wider variants just process more pixels per step.
+    struct BlendKernels
+    {
+        SimdLevel level;
+
+        // Composites count source pixels into dst. coverage may be null, in which case constantCoverage applies to
+        // the whole run.
+        void (*blendSpan)(BlendMode mode, std::uint32_t* dst, const std::uint32_t* src, const std::uint8_t* coverage,
+                          std::uint8_t constantCoverage, std::int32_t count);
+
+        // Same as blendSpan for a single premultiplied color.
+        void (*blendSolidSpan)(BlendMode mode, std::uint32_t* dst, std::uint32_t color, const std::uint8_t* coverage,
+                               std::uint8_t constantCoverage, std::int32_t count);
+
+        // Converts count premultiplied RGBA8 pixels, optionally swapping red and blue and dividing color by alpha.
+        // Neither pointer needs to be 4-byte aligned, and dst may equal src.
+        void (*convertSpan)(std::uint8_t* dst, const std::uint8_t* src, std::int32_t count, bool swapRedBlue,
+                            bool unpremultiply);
+    };
+
+    // Kernels for the requested level, falling back to the closest lower level compiled into this build.
+    const BlendKernels& GetBlendKernels(SimdLevel level);
+
+    // Blends one premultiplied source pixel into a premultiplied destination pixel. Coverage (0-255) lerps between
+    // the untouched destination and the fully blended result.
+    std::uint32_t BlendPixel(BlendMode mode, std::uint32_t dst, std::uint32_t src, std::uint32_t coverage);
+
+    // Converts one premultiplied RGBA8 pixel; see BlendKernels::convertSpan. Fully transparent pixels become zero.
+    std::uint32_t ConvertPixel(std::uint32_t pixel, bool swapRedBlue, bool unpremultiply);
+
+    // Portable span kernels; see BlendKernels.
+    void BlendSpan(BlendMode mode, std::uint32_t* dst, const std::uint32_t* src, const std::uint8_t* coverage,
+                   std::uint8_t constantCoverage, std::int32_t count);
+    void BlendSolidSpan(BlendMode mode, std::uint32_t* dst, std::uint32_t color, const std::uint8_t* coverage,
+                        std::uint8_t constantCoverage, std::int32_t count);
+    void ConvertSpan(std::uint8_t* dst, const std::uint8_t* src, std::int32_t count, bool swapRedBlue,
+                     bool unpremultiply);
+} // namespace rive_renderer_cpu
@@ -0,0 +1,182 @@
+#include <cstdint>
+
+#include <immintrin.h>
+
+#include "cpu_blend.hpp"
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kLanes = 8;
+
+        struct F
+        {
+            __m256 v;
+        };
+
+        struct I
+        {
+            __m256i v;
+        };
+
+        struct M
+        {
+            __m256 v;
+        };
+
+        F SplatF(float value)
+        {
+            return {_mm256_set1_ps(value)};
+        }
+
+        I SplatI(std::uint32_t value)
+        {
+            return {_mm256_set1_epi32(static_cast<int>(value))};
+        }
+
+        I LoadPixels(const std::uint32_t* pixels)
+        {
+            return {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels))};
+        }
+
+        void StorePixels(std::uint32_t* pixels, I value)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels), value.v);
+        }
+
+        I LoadCoverage(const std::uint8_t* coverage)
+        {
+            return {_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage)))};
+        }
+
+        F operator+(F a, F b)
+        {
+            return {_mm256_add_ps(a.v, b.v)};
+        }
+
+        F operator-(F a, F b)
+        {
+            return {_mm256_sub_ps(a.v, b.v)};
+        }
+
+        F operator*(F a, F b)
+        {
+            return {_mm256_mul_ps(a.v, b.v)};
+        }
+
+        F operator/(F a, F b)
+        {
+            return {_mm256_div_ps(a.v, b.v)};
+        }
+
+        // Operands are swapped so NaN and signed-zero handling matches std::min/std::max.
+        F Min(F a, F b)
+        {
+            return {_mm256_min_ps(b.v, a.v)};
+        }
+
+        F Max(F a, F b)
+        {
+            return {_mm256_max_ps(b.v, a.v)};
+        }
+
+        F Sqrt(F a)
+        {
+            return {_mm256_sqrt_ps(a.v)};
+        }
+
+        F Abs(F a)
+        {
+            return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)};
+        }
+
+        M operator<(F a, F b)
+        {
+            return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)};
+        }
+
+        M operator<=(F a, F b)
+        {
+            return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)};
+        }
+
+        M operator>(F a, F b)
+        {
+            return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)};
+        }
+
+        M operator>=(F a, F b)
+        {
+            return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)};
+        }
+
+        F Select(M mask, F a, F b)
+        {
+            return {_mm256_blendv_ps(b.v, a.v, mask.v)};
+        }
+
+        I operator&(I a, I b)
+        {
+            return {_mm256_and_si256(a.v, b.v)};
+        }
+
+        I operator|(I a, I b)
+        {
+            return {_mm256_or_si256(a.v, b.v)};
+        }
+
+        I operator+(I a, I b)
+        {
+            return {_mm256_add_epi32(a.v, b.v)};
+        }
+
+        I operator-(I a, I b)
+        {
+            return {_mm256_sub_epi32(a.v, b.v)};
+        }
+
+        I operator*(I a, I b)
+        {
+            return {_mm256_mullo_epi32(a.v, b.v)};
+        }
+
+        I ShiftLeft(I a, int count)
+        {
+            return {_mm256_sll_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        I ShiftRight(I a, int count)
+        {
+            return {_mm256_srl_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        M Equal(I a, I b)
+        {
+            return {_mm256_castsi256_ps(_mm256_cmpeq_epi32(a.v, b.v))};
+        }
+
+        I Select(M mask, I a, I b)
+        {
+            return {_mm256_blendv_epi8(b.v, a.v, _mm256_castps_si256(mask.v))};
+        }
+
+        F ToFloat(I a)
+        {
+            return {_mm256_cvtepi32_ps(a.v)};
+        }
+
+        I Truncate(F a)
+        {
+            return {_mm256_cvttps_epi32(a.v)};
+        }
+
+#include "cpu_blend_kernels.inl"
+    } // namespace
+
+    const BlendKernels& GetAvx2BlendKernels()
+    {
+        static const BlendKernels kernels {SimdLevel::avx2, &SimdBlendSpan, &SimdBlendSolidSpan, &SimdConvertSpan};
+        return kernels;
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,189 @@
+#include <cstdint>
+
+#include <immintrin.h>
+
+// GCC's own avx512fintrin.h reads an uninitialized __Y inside the unmasked intrinsics, which -Wall reports at every
+// inlined call site in this file. The value is never used.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include "cpu_blend.hpp"
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kLanes = 16;
+
+        struct F
+        {
+            __m512 v;
+        };
+
+        struct I
+        {
+            __m512i v;
+        };
+
+        struct M
+        {
+            __mmask16 v;
+        };
+
+        F SplatF(float value)
+        {
+            return {_mm512_set1_ps(value)};
+        }
+
+        I SplatI(std::uint32_t value)
+        {
+            return {_mm512_set1_epi32(static_cast<int>(value))};
+        }
+
+        I LoadPixels(const std::uint32_t* pixels)
+        {
+            return {_mm512_loadu_si512(pixels)};
+        }
+
+        void StorePixels(std::uint32_t* pixels, I value)
+        {
+            _mm512_storeu_si512(pixels, value.v);
+        }
+
+        I LoadCoverage(const std::uint8_t* coverage)
+        {
+            return {_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coverage)))};
+        }
+
+        F operator+(F a, F b)
+        {
+            return {_mm512_add_ps(a.v, b.v)};
+        }
+
+        F operator-(F a, F b)
+        {
+            return {_mm512_sub_ps(a.v, b.v)};
+        }
+
+        F operator*(F a, F b)
+        {
+            return {_mm512_mul_ps(a.v, b.v)};
+        }
+
+        F operator/(F a, F b)
+        {
+            return {_mm512_div_ps(a.v, b.v)};
+        }
+
+        // Operands are swapped so NaN and signed-zero handling matches std::min/std::max.
+        F Min(F a, F b)
+        {
+            return {_mm512_min_ps(b.v, a.v)};
+        }
+
+        F Max(F a, F b)
+        {
+            return {_mm512_max_ps(b.v, a.v)};
+        }
+
+        F Sqrt(F a)
+        {
+            return {_mm512_sqrt_ps(a.v)};
+        }
+
+        F Abs(F a)
+        {
+            return {_mm512_abs_ps(a.v)};
+        }
+
+        M operator<(F a, F b)
+        {
+            return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)};
+        }
+
+        M operator<=(F a, F b)
+        {
+            return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)};
+        }
+
+        M operator>(F a, F b)
+        {
+            return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)};
+        }
+
+        M operator>=(F a, F b)
+        {
+            return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)};
+        }
+
+        F Select(M mask, F a, F b)
+        {
+            return {_mm512_mask_blend_ps(mask.v, b.v, a.v)};
+        }
+
+        I operator&(I a, I b)
+        {
+            return {_mm512_and_si512(a.v, b.v)};
+        }
+
+        I operator|(I a, I b)
+        {
+            return {_mm512_or_si512(a.v, b.v)};
+        }
+
+        I operator+(I a, I b)
+        {
+            return {_mm512_add_epi32(a.v, b.v)};
+        }
+
+        I operator-(I a, I b)
+        {
+            return {_mm512_sub_epi32(a.v, b.v)};
+        }
+
+        I operator*(I a, I b)
+        {
+            return {_mm512_mullo_epi32(a.v, b.v)};
+        }
+
+        I ShiftLeft(I a, int count)
+        {
+            return {_mm512_sll_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        I ShiftRight(I a, int count)
+        {
+            return {_mm512_srl_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        M Equal(I a, I b)
+        {
+            return {_mm512_cmpeq_epi32_mask(a.v, b.v)};
+        }
+
+        I Select(M mask, I a, I b)
+        {
+            return {_mm512_mask_blend_epi32(mask.v, b.v, a.v)};
+        }
+
+        F ToFloat(I a)
+        {
+            return {_mm512_cvtepi32_ps(a.v)};
+        }
+
+        I Truncate(F a)
+        {
+            return {_mm512_cvttps_epi32(a.v)};
+        }
+
+#include "cpu_blend_kernels.inl"
+    } // namespace
+
+    const BlendKernels& GetAvx512BlendKernels()
+    {
+        static const BlendKernels kernels {SimdLevel::avx512, &SimdBlendSpan, &SimdBlendSolidSpan, &SimdConvertSpan};
+        return kernels;
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,351 @@
+// Vectorized span compositing, shared by the per-instruction-set translation units. Each includer defines, inside an
+// anonymous namespace, the lane count kLanes and the vector types F (float lanes), I (32-bit integer lanes) and M
+// (lane mask) with their operations, then includes this file in that same namespace.
+//
+// Every lane replays the exact operation sequence of the portable kernels in cpu_blend.cpp, so all variants produce
+// identical pixels as long as the includer is compiled without floating-point contraction. Do not call inline or
+// template functions from shared headers here: the linker may keep this translation unit's copy, compiled for a wider
+// instruction set, for the whole library.
+
+struct Rgb
+{
+    F r;
+    F g;
+    F b;
+};
+
+I MulDiv255(I a, I b)
+{
+    const I t = a * b + SplatI(128);
+    return ShiftRight(t + ShiftRight(t, 8), 8);
+}
+
+F Unpack(I pixel, int shift)
+{
+    return ToFloat(ShiftRight(pixel, shift) & SplatI(0xff)) * SplatF(1.0f / 255.0f);
+}
+
+Rgb Select(M mask, const Rgb& a, const Rgb& b)
+{
+    return {Select(mask, a.r, b.r), Select(mask, a.g, b.g), Select(mask, a.b, b.b)};
+}
+
+F Lum(const Rgb& c)
+{
+    return SplatF(0.3f) * c.r + SplatF(0.59f) * c.g + SplatF(0.11f) * c.b;
+}
+
+Rgb ClipColor(Rgb c)
+{
+    const F one = SplatF(1.0f);
+    const F l   = Lum(c);
+    const F n   = Min(c.r, Min(c.g, c.b));
+    const F x   = Max(c.r, Max(c.g, c.b));
+
+    const F lowScale = l / (l - n);
+    c = Select(n < SplatF(0.0f), Rgb {l + (c.r - l) * lowScale, l + (c.g - l) * lowScale, l + (c.b - l) * lowScale},
+               c);
+    const F highScale = (one - l) / (x - l);
+    c = Select(x > one, Rgb {l + (c.r - l) * highScale, l + (c.g - l) * highScale, l + (c.b - l) * highScale}, c);
+    return c;
+}
+
+Rgb SetLum(const Rgb& c, F l)
+{
+    const F d = l - Lum(c);
+    return ClipColor({c.r + d, c.g + d, c.b + d});
+}
+
+F Sat(const Rgb& c)
+{
+    return Max(c.r, Max(c.g, c.b)) - Min(c.r, Min(c.g, c.b));
+}
+
+Rgb SetSat(const Rgb& c, F s)
+{
+    const F zero  = SplatF(0.0f);
+    const F mx    = Max(c.r, Max(c.g, c.b));
+    const F mn    = Min(c.r, Min(c.g, c.b));
+    const F scale = s / (mx - mn);
+    return Select(mx <= mn, Rgb {zero, zero, zero}, Rgb {(c.r - mn) * scale, (c.g - mn) * scale, (c.b - mn) * scale});
+}
+
+template <BlendMode kMode> F BlendChannel(F cs, F cb)
+{
+    const F zero = SplatF(0.0f);
+    const F half = SplatF(0.5f);
+    const F one  = SplatF(1.0f);
+    const F two  = SplatF(2.0f);
+    if constexpr (kMode == BlendMode::screen)
+    {
+        return cb + cs - cb * cs;
+    }
+    else if constexpr (kMode == BlendMode::overlay)
+    {
+        return Select(cb <= half, cs * two * cb, one - (one - cs) * (one - (two * cb - one)));
+    }
+    else if constexpr (kMode == BlendMode::darken)
+    {
+        return Min(cs, cb);
+    }
+    else if constexpr (kMode == BlendMode::lighten)
+    {
+        return Max(cs, cb);
+    }
+    else if constexpr (kMode == BlendMode::colorDodge)
+    {
+        return Select(cb <= zero, zero, Select(cs >= one, one, Min(one, cb / (one - cs))));
+    }
+    else if constexpr (kMode == BlendMode::colorBurn)
+    {
+        return Select(cb >= one, one, Select(cs <= zero, zero, one - Min(one, (one - cb) / cs)));
+    }
+    else if constexpr (kMode == BlendMode::hardLight)
+    {
+        return Select(cs <= half, cb * two * cs, one - (one - cb) * (one - (two * cs - one)));
+    }
+    else if constexpr (kMode == BlendMode::softLight)
+    {
+        const F d = Select(cb <= SplatF(0.25f), ((SplatF(16.0f) * cb - SplatF(12.0f)) * cb + SplatF(4.0f)) * cb,
+                           Sqrt(cb));
+        return Select(cs <= half, cb - (one - two * cs) * cb * (one - cb), cb + (two * cs - one) * (d - cb));
+    }
+    else if constexpr (kMode == BlendMode::difference)
+    {
+        return Abs(cb - cs);
+    }
+    else if constexpr (kMode == BlendMode::exclusion)
+    {
+        return cb + cs - two * cb * cs;
+    }
+    else if constexpr (kMode == BlendMode::multiply)
+    {
+        return cs * cb;
+    }
+    else
+    {
+        return cs;
+    }
+}
+
+template <BlendMode kMode> Rgb BlendColors(const Rgb& cs, const Rgb& cb)
+{
+    if constexpr (kMode == BlendMode::hue)
+    {
+        return SetLum(SetSat(cs, Sat(cb)), Lum(cb));
+    }
+    else if constexpr (kMode == BlendMode::saturation)
+    {
+        return SetLum(SetSat(cb, Sat(cs)), Lum(cb));
+    }
+    else if constexpr (kMode == BlendMode::color)
+    {
+        return SetLum(cs, Lum(cb));
+    }
+    else if constexpr (kMode == BlendMode::luminosity)
+    {
+        return SetLum(cb, Lum(cs));
+    }
+    else
+    {
+        return {BlendChannel<kMode>(cs.r, cb.r), BlendChannel<kMode>(cs.g, cb.g), BlendChannel<kMode>(cs.b, cb.b)};
+    }
+}
+
+I SrcOverPixels(I dst, I src, I coverage)
+{
+    // MulDiv255(x, 255) == x and MulDiv255(x, 0) == 0, so the scalar early-outs for full and zero coverage and for
+    // opaque sources fall out of the general formula.
+    const I mask    = SplatI(0xff);
+    const I sr      = MulDiv255(src & mask, coverage);
+    const I sg      = MulDiv255(ShiftRight(src, 8) & mask, coverage);
+    const I sb      = MulDiv255(ShiftRight(src, 16) & mask, coverage);
+    const I sa      = MulDiv255(ShiftRight(src, 24), coverage);
+    const I inverse = SplatI(255) - sa;
+    const I r       = sr + MulDiv255(dst & mask, inverse);
+    const I g       = sg + MulDiv255(ShiftRight(dst, 8) & mask, inverse);
+    const I b       = sb + MulDiv255(ShiftRight(dst, 16) & mask, inverse);
+    const I a       = sa + MulDiv255(ShiftRight(dst, 24), inverse);
+    return r | ShiftLeft(g, 8) | ShiftLeft(b, 16) | ShiftLeft(a, 24);
+}
+
+template <BlendMode kMode> I BlendAdvancedPixels(I dst, I src, I coverage)
+{
+    const F   zero = SplatF(0.0f);
+    const F   one  = SplatF(1.0f);
+    const F   sa   = Unpack(src, 24);
+    const F   da   = Unpack(dst, 24);
+    const Rgb s {Unpack(src, 0), Unpack(src, 8), Unpack(src, 16)};
+    const Rgb d {Unpack(dst, 0), Unpack(dst, 8), Unpack(dst, 16)};
+
+    const M   hasSource      = sa > zero;
+    const M   hasDestination = da > zero;
+    const Rgb cs {Select(hasSource, s.r / sa, zero), Select(hasSource, s.g / sa, zero),
+                  Select(hasSource, s.b / sa, zero)};
+    const Rgb cb {Select(hasDestination, d.r / da, zero), Select(hasDestination, d.g / da, zero),
+                  Select(hasDestination, d.b / da, zero)};
+    const Rgb blended = BlendColors<kMode>(cs, cb);
+    const F   both    = sa * da;
+    const F   ra      = sa + da - both;
+    const F   rr      = s.r * (one - da) + d.r * (one - sa) + both * blended.r;
+    const F   rg      = s.g * (one - da) + d.g * (one - sa) + both * blended.g;
+    const F   rb      = s.b * (one - da) + d.b * (one - sa) + both * blended.b;
+
+    const F t      = ToFloat(coverage) * SplatF(1.0f / 255.0f);
+    auto    toByte = [&](F result, F original)
+    {
+        const F v = original + (result - original) * t;
+        return Truncate(Min(Max(v, zero), one) * SplatF(255.0f) + SplatF(0.5f));
+    };
+    const I pixels = toByte(rr, d.r) | ShiftLeft(toByte(rg, d.g), 8) | ShiftLeft(toByte(rb, d.b), 16) |
+                     ShiftLeft(toByte(ra, da), 24);
+    return Select(Equal(coverage, SplatI(0)), dst, pixels);
+}
+
+template <BlendMode kMode>
+void BlendRun(std::uint32_t* dst, const std::uint32_t* src, std::uint32_t color, const std::uint8_t* coverage,
+              std::uint8_t constantCoverage, std::int32_t count)
+{
+    const I      solid    = SplatI(color);
+    const I      constant = SplatI(constantCoverage);
+    std::int32_t i        = 0;
+    for (; i + kLanes <= count; i += kLanes)
+    {
+        const I source = src != nullptr ? LoadPixels(src + i) : solid;
+        const I alpha  = coverage != nullptr ? LoadCoverage(coverage + i) : constant;
+        if constexpr (kMode == BlendMode::srcOver)
+        {
+            StorePixels(dst + i, SrcOverPixels(LoadPixels(dst + i), source, alpha));
+        }
+        else
+        {
+            StorePixels(dst + i, BlendAdvancedPixels<kMode>(LoadPixels(dst + i), source, alpha));
+        }
+    }
+    for (; i < count; ++i)
+    {
+        dst[i] = BlendPixel(kMode, dst[i], src != nullptr ? src[i] : color,
+                            coverage != nullptr ? coverage[i] : constantCoverage);
+    }
+}
+
+using BlendRunFunction = void (*)(std::uint32_t*, const std::uint32_t*, std::uint32_t, const std::uint8_t*,
+                                  std::uint8_t, std::int32_t);
+
+BlendRunFunction SelectBlendRun(BlendMode mode)
+{
+    switch (mode)
+    {
+    case BlendMode::srcOver:
+        return &BlendRun<BlendMode::srcOver>;
+    case BlendMode::screen:
+        return &BlendRun<BlendMode::screen>;
+    case BlendMode::overlay:
+        return &BlendRun<BlendMode::overlay>;
+    case BlendMode::darken:
+        return &BlendRun<BlendMode::darken>;
+    case BlendMode::lighten:
+        return &BlendRun<BlendMode::lighten>;
+    case BlendMode::colorDodge:
+        return &BlendRun<BlendMode::colorDodge>;
+    case BlendMode::colorBurn:
+        return &BlendRun<BlendMode::colorBurn>;
+    case BlendMode::hardLight:
+        return &BlendRun<BlendMode::hardLight>;
+    case BlendMode::softLight:
+        return &BlendRun<BlendMode::softLight>;
+    case BlendMode::difference:
+        return &BlendRun<BlendMode::difference>;
+    case BlendMode::exclusion:
+        return &BlendRun<BlendMode::exclusion>;
+    case BlendMode::multiply:
+        return &BlendRun<BlendMode::multiply>;
+    case BlendMode::hue:
+        return &BlendRun<BlendMode::hue>;
+    case BlendMode::saturation:
+        return &BlendRun<BlendMode::saturation>;
+    case BlendMode::color:
+        return &BlendRun<BlendMode::color>;
+    case BlendMode::luminosity:
+        return &BlendRun<BlendMode::luminosity>;
+    }
+    return nullptr;
+}
+
+void SimdBlendSpan(BlendMode mode, std::uint32_t* dst, const std::uint32_t* src, const std::uint8_t* coverage,
+                   std::uint8_t constantCoverage, std::int32_t count)
+{
+    const BlendRunFunction run = SelectBlendRun(mode);
+    if (run == nullptr)
+    {
+        BlendSpan(mode, dst, src, coverage, constantCoverage, count);
+        return;
+    }
+    run(dst, src, 0, coverage, constantCoverage, count);
+}
+
+void SimdBlendSolidSpan(BlendMode mode, std::uint32_t* dst, std::uint32_t color, const std::uint8_t* coverage,
+                        std::uint8_t constantCoverage, std::int32_t count)
+{
+    if (mode == BlendMode::srcOver && coverage == nullptr && constantCoverage == 255 && (color >> 24) == 255)
+    {
+        for (std::int32_t i = 0; i < count; ++i)
+        {
+            dst[i] = color;
+        }
+        return;
+    }
+    const BlendRunFunction run = SelectBlendRun(mode);
+    if (run == nullptr)
+    {
+        BlendSolidSpan(mode, dst, color, coverage, constantCoverage, count);
+        return;
+    }
+    run(dst, nullptr, color, coverage, constantCoverage, count);
+}
+
+// Converts one channel of kLanes pixels; matches the rounding in ConvertPixel.
+I UnpremultiplyChannel(I channel, F scale)
+{
+    return Truncate(Min(ToFloat(channel) * scale + SplatF(0.5f), SplatF(255.0f)));
+}
+
+void SimdConvertSpan(std::uint8_t* dst, const std::uint8_t* src, std::int32_t count, bool swapRedBlue,
+                     bool unpremultiply)
+{
+    if (!swapRedBlue && !unpremultiply)
+    {
+        ConvertSpan(dst, src, count, false, false);
+        return;
+    }
+
+    const I      mask = SplatI(0xff);
+    std::int32_t i    = 0;
+    for (; i + kLanes <= count; i += kLanes)
+    {
+        const I pixels = LoadPixels(reinterpret_cast<const std::uint32_t*>(src + i * 4));
+        I       r      = pixels & mask;
+        I       g      = ShiftRight(pixels, 8) & mask;
+        I       b      = ShiftRight(pixels, 16) & mask;
+        const I a      = ShiftRight(pixels, 24);
+        if (unpremultiply)
+        {
+            // Lanes with zero alpha divide by zero here and are replaced with transparent black below.
+            const F scale = SplatF(255.0f) / ToFloat(a);
+            const M empty = Equal(a, SplatI(0));
+            const I zero  = SplatI(0);
+            r             = Select(empty, zero, UnpremultiplyChannel(r, scale));
+            g             = Select(empty, zero, UnpremultiplyChannel(g, scale));
+            b             = Select(empty, zero, UnpremultiplyChannel(b, scale));
+        }
+        if (swapRedBlue)
+        {
+            const I red = r;
+            r           = b;
+            b           = red;
+        }
+        StorePixels(reinterpret_cast<std::uint32_t*>(dst + i * 4),
+                    r | ShiftLeft(g, 8) | ShiftLeft(b, 16) | ShiftLeft(a, 24));
+    }
+    ConvertSpan(dst + i * 4, src + i * 4, count - i, swapRedBlue, unpremultiply);
+}
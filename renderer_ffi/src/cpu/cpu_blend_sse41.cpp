@@ -0,0 +1,185 @@
+#include <cstdint>
+#include <cstring>
+
+#include <smmintrin.h>
+
+#include "cpu_blend.hpp"
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kLanes = 4;
+
+        struct F
+        {
+            __m128 v;
+        };
+
+        struct I
+        {
+            __m128i v;
+        };
+
+        struct M
+        {
+            __m128 v;
+        };
+
+        F SplatF(float value)
+        {
+            return {_mm_set1_ps(value)};
+        }
+
+        I SplatI(std::uint32_t value)
+        {
+            return {_mm_set1_epi32(static_cast<int>(value))};
+        }
+
+        I LoadPixels(const std::uint32_t* pixels)
+        {
+            return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels))};
+        }
+
+        void StorePixels(std::uint32_t* pixels, I value)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), value.v);
+        }
+
+        I LoadCoverage(const std::uint8_t* coverage)
+        {
+            int bytes;
+            std::memcpy(&bytes, coverage, sizeof(bytes));
+            return {_mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes))};
+        }
+
+        F operator+(F a, F b)
+        {
+            return {_mm_add_ps(a.v, b.v)};
+        }
+
+        F operator-(F a, F b)
+        {
+            return {_mm_sub_ps(a.v, b.v)};
+        }
+
+        F operator*(F a, F b)
+        {
+            return {_mm_mul_ps(a.v, b.v)};
+        }
+
+        F operator/(F a, F b)
+        {
+            return {_mm_div_ps(a.v, b.v)};
+        }
+
+        // Operands are swapped so NaN and signed-zero handling matches std::min/std::max.
+        F Min(F a, F b)
+        {
+            return {_mm_min_ps(b.v, a.v)};
+        }
+
+        F Max(F a, F b)
+        {
+            return {_mm_max_ps(b.v, a.v)};
+        }
+
+        F Sqrt(F a)
+        {
+            return {_mm_sqrt_ps(a.v)};
+        }
+
+        F Abs(F a)
+        {
+            return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)};
+        }
+
+        M operator<(F a, F b)
+        {
+            return {_mm_cmplt_ps(a.v, b.v)};
+        }
+
+        M operator<=(F a, F b)
+        {
+            return {_mm_cmple_ps(a.v, b.v)};
+        }
+
+        M operator>(F a, F b)
+        {
+            return {_mm_cmpgt_ps(a.v, b.v)};
+        }
+
+        M operator>=(F a, F b)
+        {
+            return {_mm_cmpge_ps(a.v, b.v)};
+        }
+
+        F Select(M mask, F a, F b)
+        {
+            return {_mm_blendv_ps(b.v, a.v, mask.v)};
+        }
+
+        I operator&(I a, I b)
+        {
+            return {_mm_and_si128(a.v, b.v)};
+        }
+
+        I operator|(I a, I b)
+        {
+            return {_mm_or_si128(a.v, b.v)};
+        }
+
+        I operator+(I a, I b)
+        {
+            return {_mm_add_epi32(a.v, b.v)};
+        }
+
+        I operator-(I a, I b)
+        {
+            return {_mm_sub_epi32(a.v, b.v)};
+        }
+
+        I operator*(I a, I b)
+        {
+            return {_mm_mullo_epi32(a.v, b.v)};
+        }
+
+        I ShiftLeft(I a, int count)
+        {
+            return {_mm_sll_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        I ShiftRight(I a, int count)
+        {
+            return {_mm_srl_epi32(a.v, _mm_cvtsi32_si128(count))};
+        }
+
+        M Equal(I a, I b)
+        {
+            return {_mm_castsi128_ps(_mm_cmpeq_epi32(a.v, b.v))};
+        }
+
+        I Select(M mask, I a, I b)
+        {
+            return {_mm_blendv_epi8(b.v, a.v, _mm_castps_si128(mask.v))};
+        }
+
+        F ToFloat(I a)
+        {
+            return {_mm_cvtepi32_ps(a.v)};
+        }
+
+        I Truncate(F a)
+        {
+            return {_mm_cvttps_epi32(a.v)};
+        }
+
+#include "cpu_blend_kernels.inl"
+    } // namespace
+
+    const BlendKernels& GetSse41BlendKernels()
+    {
+        static const BlendKernels kernels {SimdLevel::sse41, &SimdBlendSpan, &SimdBlendSolidSpan, &SimdConvertSpan};
+        return kernels;
+    }
+} // namespace rive_renderer_cpu
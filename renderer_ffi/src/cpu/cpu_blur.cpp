@@ -0,0 +1,348 @@
+#include "cpu_blur.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RIVE_RENDERER_CPU_SSE2
+#endif
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        // Keeps the blurred bounds and the per-draw buffers within reason for absurd feather amounts.
+        constexpr float kMaxSigma = 1024.0f;
+
+        // One box filter over image columns: row y of dst in [rowBegin, rowEnd) becomes the rounded average of rows
+        // y - radius .. y + radius of src, with rows outside the image reading as zero. Only columns [begin, end)
+        // are written. The average is ((sum + window / 2) * (65536 / window)) >> 16, which never exceeds 255 and
+        // fits 16 bits per lane for windows up to kMaxNarrowWindow.
+        struct BoxPass
+        {
+            std::int32_t  radius;
+            std::int32_t  rowBegin;
+            std::int32_t  rowEnd;
+            std::uint32_t window;
+            std::uint32_t bias;
+            std::uint32_t scale;
+
+            BoxPass(std::int32_t radius, std::int32_t rowBegin, std::int32_t rowEnd) :
+                radius(radius), rowBegin(rowBegin), rowEnd(rowEnd), window(static_cast<std::uint32_t>(radius) * 2 + 1),
+                bias(window / 2), scale(65536 / window)
+            {
+            }
+        };
+
+        void BoxColumnsScalar(const BoxPass& pass, const std::uint8_t* src, std::uint8_t* dst, std::int32_t width,
+                              std::int32_t height, std::int32_t begin, std::int32_t end,
+                              std::vector<std::uint32_t>* sums)
+        {
+            const std::size_t count = static_cast<std::size_t>(end - begin);
+            sums->assign(count, 0);
+            std::uint32_t* sum = sums->data();
+            for (std::int32_t y = std::max(pass.rowBegin - pass.radius, 0);
+                 y < std::min(pass.rowBegin + pass.radius, height); ++y)
+            {
+                const std::uint8_t* row = src + static_cast<std::size_t>(y) * width + begin;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    sum[i] += row[i];
+                }
+            }
+
+            for (std::int32_t y = pass.rowBegin; y < pass.rowEnd; ++y)
+            {
+                const std::int32_t incoming = y + pass.radius;
+                if (incoming < height)
+                {
+                    const std::uint8_t* row = src + static_cast<std::size_t>(incoming) * width + begin;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        sum[i] += row[i];
+                    }
+                }
+                std::uint8_t* out = dst + static_cast<std::size_t>(y) * width + begin;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    out[i] = static_cast<std::uint8_t>(((sum[i] + pass.bias) * pass.scale) >> 16);
+                }
+                const std::int32_t outgoing = y - pass.radius;
+                if (outgoing >= 0)
+                {
+                    const std::uint8_t* row = src + static_cast<std::size_t>(outgoing) * width + begin;
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        sum[i] -= row[i];
+                    }
+                }
+            }
+        }
+
+#if defined(RIVE_RENDERER_CPU_SSE2)
+        // Boxes up to this width keep their running sums in 16 bits, which the SIMD path relies on.
+        constexpr std::uint32_t kMaxNarrowWindow = 255;
+
+        // BoxColumnsScalar for a block of 16 columns, with the running sums held in registers. Sums wrap modulo 2^16
+        // in between, but every sum the filter outputs is in range, so the results match the scalar path exactly.
+        void BoxColumns16(const BoxPass& pass, const std::uint8_t* src, std::uint8_t* dst, std::int32_t width,
+                          std::int32_t height, std::int32_t column)
+        {
+            const __m128i zero  = _mm_setzero_si128();
+            const __m128i bias  = _mm_set1_epi16(static_cast<short>(pass.bias));
+            const __m128i scale = _mm_set1_epi16(static_cast<short>(pass.scale));
+            __m128i       lo    = zero;
+            __m128i       hi    = zero;
+            auto load = [&](std::int32_t y)
+            {
+                return _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(src + static_cast<std::size_t>(y) * width + column));
+            };
+
+            for (std::int32_t y = std::max(pass.rowBegin - pass.radius, 0);
+                 y < std::min(pass.rowBegin + pass.radius, height); ++y)
+            {
+                const __m128i row = load(y);
+                lo                = _mm_add_epi16(lo, _mm_unpacklo_epi8(row, zero));
+                hi                = _mm_add_epi16(hi, _mm_unpackhi_epi8(row, zero));
+            }
+
+            for (std::int32_t y = pass.rowBegin; y < pass.rowEnd; ++y)
+            {
+                const std::int32_t incoming = y + pass.radius;
+                if (incoming < height)
+                {
+                    const __m128i row = load(incoming);
+                    lo                = _mm_add_epi16(lo, _mm_unpacklo_epi8(row, zero));
+                    hi                = _mm_add_epi16(hi, _mm_unpackhi_epi8(row, zero));
+                }
+                const __m128i outLo = _mm_mulhi_epu16(_mm_add_epi16(lo, bias), scale);
+                const __m128i outHi = _mm_mulhi_epu16(_mm_add_epi16(hi, bias), scale);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + static_cast<std::size_t>(y) * width + column),
+                                 _mm_packus_epi16(outLo, outHi));
+                const std::int32_t outgoing = y - pass.radius;
+                if (outgoing >= 0)
+                {
+                    const __m128i row = load(outgoing);
+                    lo                = _mm_sub_epi16(lo, _mm_unpacklo_epi8(row, zero));
+                    hi                = _mm_sub_epi16(hi, _mm_unpackhi_epi8(row, zero));
+                }
+            }
+        }
+#endif
+
+        void BoxColumns(const BoxPass& pass, const std::uint8_t* src, std::uint8_t* dst, std::int32_t width,
+                        std::int32_t height, std::vector<std::uint32_t>* sums)
+        {
+            std::int32_t column = 0;
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            // Walking 16 columns down the image keeps the sums out of memory; the rows of a block are a fixed
+            // stride apart, which the hardware prefetcher follows.
+            if (pass.window <= kMaxNarrowWindow)
+            {
+                for (; column + 16 <= width; column += 16)
+                {
+                    BoxColumns16(pass, src, dst, width, height, column);
+                }
+            }
+#endif
+            if (column < width)
+            {
+                BoxColumnsScalar(pass, src, dst, width, height, column, width, sums);
+            }
+        }
+
+        // Runs the boxes down the columns of a width x height image so that rows [rowBegin, rowEnd) of the result
+        // are exact. Each pass only computes the rows later passes read. src is clobbered; returns whichever of src
+        // and dst holds the result.
+        std::uint8_t* BlurColumns(const GaussianBoxes& boxes, std::uint8_t* src, std::uint8_t* dst, std::int32_t width,
+                                  std::int32_t height, std::int32_t rowBegin, std::int32_t rowEnd,
+                                  std::vector<std::uint32_t>* sums)
+        {
+            std::int32_t remaining = boxes.extent();
+            for (const std::int32_t radius : boxes.radii)
+            {
+                remaining -= radius;
+                if (radius == 0)
+                {
+                    continue;
+                }
+                const BoxPass pass(radius, std::max(rowBegin - remaining, 0), std::min(rowEnd + remaining, height));
+                BoxColumns(pass, src, dst, width, height, sums);
+                std::swap(src, dst);
+            }
+            return src;
+        }
+
+        // Copies rows [rowBegin, rowEnd) and columns [columnBegin, columnEnd) of src, which is srcWidth wide, into
+        // dst transposed, so dst is rowEnd - rowBegin wide.
+        void Transpose(const std::uint8_t* src, std::int32_t srcWidth, std::int32_t rowBegin, std::int32_t rowEnd,
+                       std::int32_t columnBegin, std::int32_t columnEnd, std::uint8_t* dst)
+        {
+            constexpr std::int32_t kBlock   = 16;
+            const std::size_t      dstWidth = static_cast<std::size_t>(rowEnd - rowBegin);
+            for (std::int32_t y0 = rowBegin; y0 < rowEnd; y0 += kBlock)
+            {
+                const std::int32_t y1 = std::min(y0 + kBlock, rowEnd);
+                for (std::int32_t x0 = columnBegin; x0 < columnEnd; x0 += kBlock)
+                {
+                    const std::int32_t x1 = std::min(x0 + kBlock, columnEnd);
+                    for (std::int32_t y = y0; y < y1; ++y)
+                    {
+                        const std::uint8_t* row = src + static_cast<std::size_t>(y) * srcWidth;
+                        std::uint8_t*       out = dst + (y - rowBegin);
+                        for (std::int32_t x = x0; x < x1; ++x)
+                        {
+                            out[static_cast<std::size_t>(x - columnBegin) * dstWidth] = row[x];
+                        }
+                    }
+                }
+            }
+        }
+
+        void EmitRow(const std::uint8_t* row, std::int32_t left, std::int32_t y, std::int32_t width,
+                     CoverageMask* out)
+        {
+            std::int32_t x = 0;
+            while (x < width)
+            {
+                const std::uint8_t alpha = row[x];
+                if (alpha == 0)
+                {
+                    ++x;
+                    continue;
+                }
+
+                CoverageSpan span;
+                span.x = left + x;
+                span.y = y;
+                if (alpha == 255)
+                {
+                    std::int32_t end = x + 1;
+                    while (end < width && row[end] == 255)
+                    {
+                        ++end;
+                    }
+                    span.length = end - x;
+                    span.alpha  = 255;
+                    x           = end;
+                }
+                else
+                {
+                    std::int32_t end = x + 1;
+                    while (end < width && row[end] != 0 && row[end] != 255)
+                    {
+                        ++end;
+                    }
+                    span.length      = end - x;
+                    span.alphaOffset = static_cast<std::int32_t>(out->alphas.size());
+                    out->alphas.insert(out->alphas.end(), row + x, row + end);
+                    x = end;
+                }
+                out->spans.push_back(span);
+            }
+        }
+    } // namespace
+
+    GaussianBoxes MakeGaussianBoxes(float sigma)
+    {
+        GaussianBoxes boxes;
+        if (!(sigma > 0.0f))
+        {
+            return boxes;
+        }
+        sigma = std::min(sigma, kMaxSigma);
+
+        // Three boxes of widths wl or wl + 2 (both odd), with as many of the narrower ones as brings the summed
+        // variance (w^2 - 1) / 12 closest to sigma^2.
+        constexpr int kBoxCount = 3;
+        const double  variance  = static_cast<double>(sigma) * sigma;
+        std::int32_t  wl        = static_cast<std::int32_t>(std::floor(std::sqrt(12.0 * variance / kBoxCount + 1.0)));
+        if (wl % 2 == 0)
+        {
+            --wl;
+        }
+        const double ideal =
+            (12.0 * variance - kBoxCount * wl * wl - 4.0 * kBoxCount * wl - 3.0 * kBoxCount) / (-4.0 * wl - 4.0);
+        const std::int32_t narrow = std::min(std::max(static_cast<std::int32_t>(std::lround(ideal)), 0), kBoxCount);
+        for (int i = 0; i < kBoxCount; ++i)
+        {
+            const std::int32_t window = i < narrow ? wl : wl + 2;
+            boxes.radii[i]            = (window - 1) / 2;
+        }
+        return boxes;
+    }
+
+    void FeatherCoverage(const CoverageMask& source, const IRect& sourceBounds, const IRect& visible,
+                         const GaussianBoxes& boxes, BlurScratch* scratch, CoverageMask* out)
+    {
+        out->clear();
+        if (source.empty() || visible.empty())
+        {
+            return;
+        }
+
+        const std::int32_t width  = sourceBounds.width();
+        const std::int32_t height = sourceBounds.height();
+        const std::size_t  size   = static_cast<std::size_t>(width) * height;
+        scratch->image.assign(size, 0);
+        scratch->temp.resize(size);
+        for (const CoverageSpan& span : source.spans)
+        {
+            std::uint8_t* row = scratch->image.data() + static_cast<std::size_t>(span.y - sourceBounds.top) * width +
+                                (span.x - sourceBounds.left);
+            if (span.alphaOffset >= 0)
+            {
+                std::memcpy(row, source.alphas.data() + span.alphaOffset, static_cast<std::size_t>(span.length));
+            }
+            else
+            {
+                std::memset(row, span.alpha, static_cast<std::size_t>(span.length));
+            }
+        }
+
+        // Both directions run as column passes, which vectorize across a row; the horizontal passes see the image
+        // transposed. Only the visible rows go through the transpose and only the visible columns come back.
+        const std::int32_t rowBegin    = visible.top - sourceBounds.top;
+        const std::int32_t rowEnd      = visible.bottom - sourceBounds.top;
+        const std::int32_t columnBegin = visible.left - sourceBounds.left;
+        const std::int32_t columnEnd   = visible.right - sourceBounds.left;
+        std::uint8_t*      a           = scratch->image.data();
+        std::uint8_t*      b           = scratch->temp.data();
+
+        std::uint8_t* blurred = BlurColumns(boxes, a, b, width, height, rowBegin, rowEnd, &scratch->sums);
+        std::uint8_t* spare   = blurred == a ? b : a;
+        Transpose(blurred, width, rowBegin, rowEnd, 0, width, spare);
+
+        const std::int32_t rows = rowEnd - rowBegin;
+        blurred = BlurColumns(boxes, spare, blurred, rows, width, columnBegin, columnEnd, &scratch->sums);
+        spare   = blurred == a ? b : a;
+        Transpose(blurred, rows, columnBegin, columnEnd, 0, rows, spare);
+
+        const std::int32_t columns = columnEnd - columnBegin;
+        std::int32_t       minX    = visible.right;
+        std::int32_t       maxX    = visible.left;
+        std::int32_t       minY    = visible.bottom;
+        std::int32_t       maxY    = visible.top;
+        for (std::int32_t row = 0; row < rows; ++row)
+        {
+            const std::int32_t y         = visible.top + row;
+            const std::size_t  spanStart = out->spans.size();
+            EmitRow(spare + static_cast<std::size_t>(row) * columns, visible.left, y, columns, out);
+            if (out->spans.size() != spanStart)
+            {
+                minY = std::min(minY, y);
+                maxY = y + 1;
+                minX = std::min(minX, out->spans[spanStart].x);
+                maxX = std::max(maxX, out->spans.back().x + out->spans.back().length);
+            }
+        }
+        if (!out->spans.empty())
+        {
+            out->bounds = {minX, minY, maxX, maxY};
+        }
+    }
+} // namespace rive_renderer_cpu
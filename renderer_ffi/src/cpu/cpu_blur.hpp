@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu_math.hpp"
+#include "cpu_raster.hpp"
+
+namespace rive_renderer_cpu
+{
+    // Three successive box filters approximating a Gaussian. Each box spans 2 * radii[i] + 1 pixels; the blurred
+    // result reaches extent() pixels past the source coverage in every direction.
+    struct GaussianBoxes
+    {
+        std::int32_t radii[3] {0, 0, 0};
+
+        std::int32_t extent() const
+        {
+            return radii[0] + radii[1] + radii[2];
+        }
+
+        bool empty() const
+        {
+            return extent() == 0;
+        }
+    };
+
+    // Box radii whose combined variance is closest to sigma^2 (in device pixels).
+    GaussianBoxes MakeGaussianBoxes(float sigma);
+
+    // Per-thread buffers reused across FeatherCoverage calls.
+    struct BlurScratch
+    {
+        std::vector<std::uint8_t>  image;
+        std::vector<std::uint8_t>  temp;
+        std::vector<std::uint32_t> sums;
+    };
+
+    // Blurs the coverage of source, which was rasterized over sourceBounds, and writes the part inside visible to
+    // out. sourceBounds must contain visible outset by boxes.extent() so every pixel of visible sees all of the
+    // coverage that reaches it. The blur runs in integer arithmetic, so the result does not depend on the SIMD level.
+    void FeatherCoverage(const CoverageMask& source, const IRect& sourceBounds, const IRect& visible,
+                         const GaussianBoxes& boxes, BlurScratch* scratch, CoverageMask* out);
+} // namespace rive_renderer_cpu
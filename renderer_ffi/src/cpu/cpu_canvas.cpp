@@ -0,0 +1,864 @@
+#include "cpu_canvas.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kTileSize = 64;
+
+        // The rasterizer snaps vertices to 1/256 of a pixel.
+        constexpr float kSubpixelScale     = 256.0f;
+        constexpr float kMaxRectCoordinate = 1 << 22;
+
+        // Pixel boundary a coordinate lands on after subpixel snapping.
+        bool SnapToPixel(float value, std::int32_t* out)
+        {
+            if (!(std::fabs(value) <= kMaxRectCoordinate))
+            {
+                return false;
+            }
+            const float pixel = std::round(value);
+            *out              = static_cast<std::int32_t>(pixel);
+            return std::floor(value * kSubpixelScale + 0.5f) == pixel * kSubpixelScale;
+        }
+
+        // True when geometry is a single axis-aligned rectangle whose corners snap to pixel boundaries, so it covers
+        // whole pixels only and clipping to it is the same as scissoring to its bounds.
+        bool PixelAlignedRect(const Polyline& geometry, IRect* out)
+        {
+            if (geometry.contours.size() != 1)
+            {
+                return false;
+            }
+            const Contour& contour = geometry.contours[0];
+            const Vec2*    points  = geometry.points.data() + contour.begin;
+            std::uint32_t  count   = contour.end - contour.begin;
+            if (count == 5 && points[4].x == points[0].x && points[4].y == points[0].y)
+            {
+                count = 4;
+            }
+            if (count != 4)
+            {
+                return false;
+            }
+
+            std::int32_t x[4];
+            std::int32_t y[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                if (!SnapToPixel(points[i].x, &x[i]) || !SnapToPixel(points[i].y, &y[i]))
+                {
+                    return false;
+                }
+            }
+            // Edges alternate between horizontal and vertical, starting with either.
+            const bool horizontalFirst = y[0] == y[1];
+            for (int i = 0; i < 4; ++i)
+            {
+                const int  j          = (i + 1) % 4;
+                const bool horizontal = (i % 2 == 0) == horizontalFirst;
+                if (horizontal ? y[i] != y[j] : x[i] != x[j])
+                {
+                    return false;
+                }
+            }
+            *out = IRect {std::min(x[0], x[2]), std::min(y[0], y[2]), std::max(x[0], x[2]), std::max(y[0], y[2])};
+            return !out->empty();
+        }
+
+        std::uint64_t HashClip(const ClipNode* parent, FillRule fillRule, const Polyline& geometry)
+        {
+            std::uint64_t hash = 14695981039346656037ull;
+            auto          mix  = [&hash](const void* data, std::size_t size)
+            {
+                const auto* bytes = static_cast<const std::uint8_t*>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+                }
+            };
+            mix(&parent, sizeof(parent));
+            mix(&fillRule, sizeof(fillRule));
+            mix(geometry.points.data(), geometry.points.size() * sizeof(Vec2));
+            for (const Contour& contour : geometry.contours)
+            {
+                mix(&contour.end, sizeof(contour.end));
+            }
+            return hash;
+        }
+
+        bool SameGeometry(const Polyline& a, const Polyline& b)
+        {
+            if (a.points.size() != b.points.size() || a.contours.size() != b.contours.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < a.contours.size(); ++i)
+            {
+                if (a.contours[i].begin != b.contours[i].begin || a.contours[i].end != b.contours[i].end)
+                {
+                    return false;
+                }
+            }
+            return std::memcmp(a.points.data(), b.points.data(), a.points.size() * sizeof(Vec2)) == 0;
+        }
+
+        // How a clip's own coverage relates to a tile.
+        enum class TileCoverage
+        {
+            none,
+            partial,
+            full,
+        };
+
+        // rows indexes the first span of each row of coverage, as in Canvas::Shape.
+        TileCoverage ClassifyTile(const CoverageMask& coverage, const std::vector<std::uint32_t>& rows,
+                                  const IRect& tile)
+        {
+            const IRect& covered = coverage.bounds;
+            if (Intersect(covered, tile).empty())
+            {
+                return TileCoverage::none;
+            }
+            if (!covered.contains(tile))
+            {
+                return TileCoverage::partial;
+            }
+            for (std::int32_t y = tile.top; y < tile.bottom; ++y)
+            {
+                // Spans are sorted and disjoint, so the row is full when they tile [left, right) at alpha 255.
+                std::int32_t x = tile.left;
+                for (std::uint32_t s = rows[y - covered.top]; s < rows[y - covered.top + 1] && x < tile.right; ++s)
+                {
+                    const CoverageSpan& span = coverage.spans[s];
+                    const std::int32_t  end  = span.x + span.length;
+                    if (end <= x)
+                    {
+                        continue;
+                    }
+                    if (span.x > x)
+                    {
+                        return TileCoverage::partial;
+                    }
+                    if (span.alphaOffset >= 0)
+                    {
+                        const std::uint8_t* alphas = coverage.alphas.data() + span.alphaOffset;
+                        for (std::int32_t i = x; i < std::min(end, tile.right); ++i)
+                        {
+                            if (alphas[i - span.x] != 255)
+                            {
+                                return TileCoverage::partial;
+                            }
+                        }
+                    }
+                    else if (span.alpha != 255)
+                    {
+                        return TileCoverage::partial;
+                    }
+                    x = end;
+                }
+                if (x < tile.right)
+                {
+                    return TileCoverage::partial;
+                }
+            }
+            return TileCoverage::full;
+        }
+    } // namespace
+
+    void Canvas::beginFrame(std::uint32_t frameWidth, std::uint32_t frameHeight)
+    {
+        width       = frameWidth;
+        height      = frameHeight;
+        isRecording = true;
+        commands.clear();
+    }
+
+    void Canvas::endFrame(std::uint8_t* pixels, std::uint32_t targetWidth, std::uint32_t targetHeight,
+                          std::size_t stride)
+    {
+        const IRect target {0, 0, static_cast<std::int32_t>(std::min(width, targetWidth)),
+                            static_cast<std::int32_t>(std::min(height, targetHeight))};
+        if (!target.empty() && !commands.empty())
+        {
+            scratch.resize(pool != nullptr ? pool->slotCount() : 1);
+            collectClips();
+            rasterizeShapes(target);
+            binShapes(target);
+            forEach(binOffsets.size() - 1, [&](std::size_t tileIndex, std::size_t slot)
+                    { compositeTile(tileIndex, target, pixels, stride, scratch[slot]); });
+        }
+        commands.clear();
+        clipNodes.clear();
+        clipParents.clear();
+        clipIndices.clear();
+        clipCache.clear();
+        isRecording = false;
+    }
+
+    void Canvas::clipPath(CanvasState* state, const PathData& path)
+    {
+        if (state->clipEmpty)
+        {
+            return;
+        }
+
+        auto node      = std::make_shared<ClipNode>();
+        node->parent   = state->clip;
+        node->fillRule = path.fillRule;
+        FlattenPath(path, state->matrix, kDefaultTolerance, &node->geometry);
+
+        const std::uint64_t hash  = HashClip(node->parent.get(), node->fillRule, node->geometry);
+        const auto          range = clipCache.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const ClipNode& cached = *it->second;
+            if (cached.parent == node->parent && cached.fillRule == node->fillRule &&
+                SameGeometry(cached.geometry, node->geometry))
+            {
+                state->clipEmpty = cached.bounds.empty();
+                state->clip      = it->second;
+                return;
+            }
+        }
+
+        IRect limit {0, 0, static_cast<std::int32_t>(width), static_cast<std::int32_t>(height)};
+        if (state->clip)
+        {
+            limit = state->clip->bounds;
+        }
+        // A clockwise rectangle wound the other way covers nothing, so only the orientation-free rules qualify.
+        IRect rect;
+        if (node->fillRule != FillRule::clockwise && PixelAlignedRect(node->geometry, &rect))
+        {
+            node->isRect = true;
+            node->bounds = Intersect(rect, limit);
+        }
+        else
+        {
+            node->bounds = Intersect(RoundOut(node->geometry.bounds()), limit);
+        }
+        state->clipEmpty = node->bounds.empty();
+        state->clip      = node;
+        clipCache.emplace(hash, std::move(node));
+    }
+
+    void Canvas::drawPath(const CanvasState& state, const PathData& path, const Paint& paint,
+                          StrokeCache* strokeCache)
+    {
+        if (state.clipEmpty)
+        {
+            return;
+        }
+
+        DrawCommand command;
+        if (paint.style == PaintStyle::stroke)
+        {
+            // Stroke in local space so joins and caps follow the transform (including non-uniform scale).
+            const float scale = state.matrix.maxScale();
+            if (!(scale > 0.0f))
+            {
+                return;
+            }
+            const float tolerance = kDefaultTolerance / scale;
+            if (strokeCache != nullptr)
+            {
+                strokeCache->stroke(path, paint.stroke, tolerance, &command.geometry);
+            }
+            else
+            {
+                Polyline centerline;
+                FlattenPath(path, Mat2D {}, tolerance, &centerline);
+                StrokePolyline(centerline, paint.stroke, tolerance, &command.geometry);
+            }
+            command.geometry.transform(state.matrix);
+            command.fillRule = FillRule::nonZero;
+        }
+        else
+        {
+            FlattenPath(path, state.matrix, kDefaultTolerance, &command.geometry);
+            command.fillRule = path.fillRule;
+        }
+
+        // The feather amount is the width of the soft edge in local space, taken as two standard deviations of the
+        // Gaussian the edge is blurred with.
+        if (paint.feather > 0.0f)
+        {
+            command.feather = MakeGaussianBoxes(0.5f * paint.feather * state.matrix.maxScale());
+        }
+        command.blendMode = paint.blendMode;
+        if (paint.shader)
+        {
+            if (!state.matrix.invert(&command.deviceToLocal))
+            {
+                return;
+            }
+            command.shader = paint.shader;
+        }
+        else
+        {
+            command.color = PremultiplyColorInt(paint.color);
+        }
+        record(state, std::move(command));
+    }
+
+    void Canvas::drawImage(const CanvasState& state, const std::shared_ptr<const ImageData>& image,
+                           const ImageSampler& sampler, BlendMode blendMode, float opacity)
+    {
+        if (state.clipEmpty || !image || image->width == 0 || image->height == 0 || !(opacity > 0.0f))
+        {
+            return;
+        }
+
+        DrawCommand command;
+        if (!state.matrix.invert(&command.deviceToLocal))
+        {
+            return;
+        }
+        const float w = static_cast<float>(image->width);
+        const float h = static_cast<float>(image->height);
+        command.geometry.points   = {state.matrix.map({0.0f, 0.0f}), state.matrix.map({w, 0.0f}),
+                                     state.matrix.map({w, h}), state.matrix.map({0.0f, h})};
+        command.geometry.contours = {Contour {0, 4, true}};
+        command.fillRule          = FillRule::nonZero;
+        command.blendMode         = blendMode;
+        command.image             = image;
+        command.sampler           = sampler;
+        command.opacity           = std::min(opacity, 1.0f);
+        record(state, std::move(command));
+    }
+
+    void Canvas::drawImageMesh(const CanvasState& state, const std::shared_ptr<const ImageData>& image,
+                               const ImageSampler& sampler, const Vec2* vertices, const Vec2* uvs,
+                               std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount,
+                               BlendMode blendMode, float opacity)
+    {
+        if (state.clipEmpty || !image || image->width == 0 || image->height == 0 || !(opacity > 0.0f))
+        {
+            return;
+        }
+
+        DrawCommand command;
+        const float w = static_cast<float>(image->width);
+        const float h = static_cast<float>(image->height);
+        command.triangles.reserve(indexCount / 3);
+        for (std::uint32_t i = 0; i + 3 <= indexCount; i += 3)
+        {
+            Vec2 points[3];
+            Vec2 texels[3];
+            bool valid = true;
+            for (int corner = 0; corner < 3 && valid; ++corner)
+            {
+                const std::uint16_t vertex = indices[i + corner];
+                valid                      = vertex < vertexCount;
+                if (valid)
+                {
+                    points[corner] = state.matrix.map(vertices[vertex]);
+                    texels[corner] = {uvs[vertex].x * w, uvs[vertex].y * h};
+                }
+            }
+            MeshTriangle triangle;
+            if (!valid || !SetupMeshTriangle(points, texels, &triangle))
+            {
+                continue;
+            }
+
+            // Setup gives every triangle the same winding, so the non-zero fill of all outlines is their union and
+            // edges shared by neighbouring triangles cancel instead of leaving anti-aliased seams.
+            const auto begin = static_cast<std::uint32_t>(command.geometry.points.size());
+            command.geometry.points.insert(command.geometry.points.end(), points, points + 3);
+            command.geometry.contours.push_back(Contour {begin, begin + 3, true});
+            command.triangles.push_back(triangle);
+        }
+
+        command.fillRule  = FillRule::nonZero;
+        command.blendMode = blendMode;
+        command.image     = image;
+        command.sampler   = sampler;
+        command.opacity   = std::min(opacity, 1.0f);
+        record(state, std::move(command));
+    }
+
+    void Canvas::record(const CanvasState& state, DrawCommand&& command)
+    {
+        if (command.geometry.empty())
+        {
+            return;
+        }
+        command.clip = state.clip;
+        commands.push_back(std::move(command));
+    }
+
+    void Canvas::forEach(std::size_t count, const WorkerPool::Task& task)
+    {
+        if (pool != nullptr)
+        {
+            pool->parallelFor(count, task);
+            return;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            task(i, 0);
+        }
+    }
+
+    void Canvas::collectClips()
+    {
+        // Parents are registered before their children so a clip's index is always greater than its parent's.
+        // Rectangle clips are fully applied by the scissor, so draws and child clips skip to the nearest ancestor
+        // that needs a mask.
+        auto add = [this](const ClipNode* node, auto& self) -> std::int32_t
+        {
+            while (node != nullptr && node->isRect)
+            {
+                node = node->parent.get();
+            }
+            if (node == nullptr)
+            {
+                return -1;
+            }
+            auto found = clipIndices.find(node);
+            if (found != clipIndices.end())
+            {
+                return found->second;
+            }
+            const std::int32_t parent = self(node->parent.get(), self);
+            const std::int32_t index  = static_cast<std::int32_t>(clipNodes.size());
+            clipNodes.push_back(node);
+            clipParents.push_back(parent);
+            clipIndices.emplace(node, index);
+            return index;
+        };
+        for (DrawCommand& command : commands)
+        {
+            command.clipIndex = add(command.clip.get(), add);
+        }
+    }
+
+    void Canvas::rasterizeShapes(const IRect& target)
+    {
+        const std::size_t clipCount = clipNodes.size();
+        shapes.resize(clipCount + commands.size());
+        forEach(shapes.size(),
+                [&](std::size_t index, std::size_t slot)
+                {
+                    Shape&               shape = shapes[index];
+                    const Polyline*      geometry;
+                    FillRule             fillRule;
+                    const GaussianBoxes* feather = nullptr;
+                    IRect                bounds  = target;
+                    if (index < clipCount)
+                    {
+                        const ClipNode* node = clipNodes[index];
+                        geometry             = &node->geometry;
+                        fillRule             = node->fillRule;
+                        bounds               = Intersect(bounds, node->bounds);
+                    }
+                    else
+                    {
+                        const DrawCommand& command = commands[index - clipCount];
+                        geometry                   = &command.geometry;
+                        fillRule                   = command.fillRule;
+                        feather                    = &command.feather;
+                        if (command.clip)
+                        {
+                            bounds = Intersect(bounds, command.clip->bounds);
+                        }
+                    }
+
+                    shape.coverage.clear();
+                    shape.rows.clear();
+                    shape.triangleOffsets.clear();
+                    shape.triangleEntries.clear();
+                    if (bounds.empty())
+                    {
+                        return;
+                    }
+                    WorkerScratch& worker = scratch[slot];
+                    if (feather != nullptr && !feather->empty())
+                    {
+                        // Blur only over the feathered bounds; the sharp coverage is rasterized far enough past
+                        // them that everything reaching a visible pixel is included.
+                        const IRect visible =
+                            Intersect(bounds, Outset(RoundOut(geometry->bounds()), feather->extent()));
+                        if (visible.empty())
+                        {
+                            return;
+                        }
+                        const IRect source = Outset(visible, feather->extent());
+                        worker.rasterizer.reset(source);
+                        worker.rasterizer.addPolyline(*geometry);
+                        worker.rasterizer.rasterize(fillRule, &worker.featherSource);
+                        FeatherCoverage(worker.featherSource, source, visible, *feather, &worker.blur,
+                                        &shape.coverage);
+                    }
+                    else
+                    {
+                        worker.rasterizer.reset(bounds);
+                        worker.rasterizer.addPolyline(*geometry);
+                        worker.rasterizer.rasterize(fillRule, &shape.coverage);
+                    }
+                    if (shape.coverage.empty())
+                    {
+                        return;
+                    }
+
+                    const IRect& covered = shape.coverage.bounds;
+                    shape.rows.assign(static_cast<std::size_t>(covered.height()) + 1, 0);
+                    for (const CoverageSpan& span : shape.coverage.spans)
+                    {
+                        ++shape.rows[span.y - covered.top + 1];
+                    }
+                    for (std::size_t row = 1; row < shape.rows.size(); ++row)
+                    {
+                        shape.rows[row] += shape.rows[row - 1];
+                    }
+                    if (index >= clipCount)
+                    {
+                        binTriangles(commands[index - clipCount], &shape);
+                    }
+                });
+    }
+
+    void Canvas::binTriangles(const DrawCommand& command, Shape* shape)
+    {
+        if (command.triangles.empty())
+        {
+            return;
+        }
+
+        // Same two-pass fill as binShapes, over the tiles spanned by the mesh's coverage.
+        const IRect&       covered = shape->coverage.bounds;
+        const std::int32_t left    = covered.left / kTileSize;
+        const std::int32_t top     = covered.top / kTileSize;
+        const std::int32_t columns = (covered.right - 1) / kTileSize - left + 1;
+        const std::int32_t rows    = (covered.bottom - 1) / kTileSize - top + 1;
+        auto&              offsets = shape->triangleOffsets;
+        auto&              entries = shape->triangleEntries;
+        offsets.assign(static_cast<std::size_t>(columns) * rows + 1, 0);
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (std::size_t i = 0; i < command.triangles.size(); ++i)
+            {
+                const IRect b = Intersect(command.triangles[i].bounds, covered);
+                if (b.empty())
+                {
+                    continue;
+                }
+                for (std::int32_t ty = b.top / kTileSize; ty <= (b.bottom - 1) / kTileSize; ++ty)
+                {
+                    for (std::int32_t tx = b.left / kTileSize; tx <= (b.right - 1) / kTileSize; ++tx)
+                    {
+                        const std::size_t tile = static_cast<std::size_t>(ty - top) * columns + (tx - left);
+                        if (pass == 0)
+                        {
+                            ++offsets[tile + 1];
+                        }
+                        else
+                        {
+                            entries[offsets[tile]++] = static_cast<std::uint32_t>(i);
+                        }
+                    }
+                }
+            }
+
+            if (pass == 0)
+            {
+                for (std::size_t tile = 1; tile < offsets.size(); ++tile)
+                {
+                    offsets[tile] += offsets[tile - 1];
+                }
+                entries.resize(offsets.back());
+            }
+            else
+            {
+                for (std::size_t tile = offsets.size() - 1; tile > 0; --tile)
+                {
+                    offsets[tile] = offsets[tile - 1];
+                }
+                offsets[0] = 0;
+            }
+        }
+    }
+
+    void Canvas::binShapes(const IRect& target)
+    {
+        tileColumns = (target.width() + kTileSize - 1) / kTileSize;
+        tileRows    = (target.height() + kTileSize - 1) / kTileSize;
+        binOffsets.assign(static_cast<std::size_t>(tileColumns) * tileRows + 1, 0);
+
+        // Two passes over the draws: count entries per tile, then fill them in submission order.
+        const std::size_t clipCount = clipNodes.size();
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            for (std::size_t i = 0; i < commands.size(); ++i)
+            {
+                const CoverageMask& coverage = shapes[clipCount + i].coverage;
+                if (coverage.empty())
+                {
+                    continue;
+                }
+                const IRect& b = coverage.bounds;
+                for (std::int32_t ty = b.top / kTileSize; ty <= (b.bottom - 1) / kTileSize; ++ty)
+                {
+                    for (std::int32_t tx = b.left / kTileSize; tx <= (b.right - 1) / kTileSize; ++tx)
+                    {
+                        const std::size_t tile = static_cast<std::size_t>(ty) * tileColumns + tx;
+                        if (pass == 0)
+                        {
+                            ++binOffsets[tile + 1];
+                        }
+                        else
+                        {
+                            binEntries[binOffsets[tile]++] = static_cast<std::uint32_t>(i);
+                        }
+                    }
+                }
+            }
+
+            if (pass == 0)
+            {
+                for (std::size_t tile = 1; tile < binOffsets.size(); ++tile)
+                {
+                    binOffsets[tile] += binOffsets[tile - 1];
+                }
+                binEntries.resize(binOffsets.back());
+            }
+            else
+            {
+                // The fill pass advanced each offset to the start of the next tile; shift them back.
+                for (std::size_t tile = binOffsets.size() - 1; tile > 0; --tile)
+                {
+                    binOffsets[tile] = binOffsets[tile - 1];
+                }
+                binOffsets[0] = 0;
+            }
+        }
+    }
+
+    void Canvas::compositeTile(std::size_t tileIndex, const IRect& target, std::uint8_t* pixels, std::size_t stride,
+                               WorkerScratch& scratch)
+    {
+        const std::uint32_t first = binOffsets[tileIndex];
+        const std::uint32_t last  = binOffsets[tileIndex + 1];
+        if (first == last)
+        {
+            return;
+        }
+
+        const std::int32_t tx = static_cast<std::int32_t>(tileIndex % tileColumns) * kTileSize;
+        const std::int32_t ty = static_cast<std::int32_t>(tileIndex / tileColumns) * kTileSize;
+        const IRect        tile = Intersect(target, IRect {tx, ty, tx + kTileSize, ty + kTileSize});
+
+        scratch.clipOffsets.resize(clipNodes.size(), kClipUnresolved);
+        for (std::uint32_t entry = first; entry < last; ++entry)
+        {
+            const std::uint32_t index   = binEntries[entry];
+            const DrawCommand&  command = commands[index];
+            const std::uint8_t* mask    = nullptr;
+            if (command.clipIndex >= 0)
+            {
+                const std::int32_t clip = tileClip(command.clipIndex, tile, scratch);
+                if (clip == kClipHidesTile)
+                {
+                    continue;
+                }
+                if (clip >= 0)
+                {
+                    mask = scratch.clipStorage.data() + clip;
+                }
+            }
+            compositeDraw(command, shapes[clipNodes.size() + index], tile, mask, pixels, stride, scratch);
+        }
+
+        for (const std::int32_t clip : scratch.usedClips)
+        {
+            scratch.clipOffsets[clip] = kClipUnresolved;
+        }
+        scratch.usedClips.clear();
+        scratch.clipStorage.clear();
+    }
+
+    std::int32_t Canvas::tileClip(std::int32_t clipIndex, const IRect& tile, WorkerScratch& scratch)
+    {
+        if (scratch.clipOffsets[clipIndex] != kClipUnresolved)
+        {
+            return scratch.clipOffsets[clipIndex];
+        }
+
+        const std::int32_t parentIndex = clipParents[clipIndex];
+        const std::int32_t parent      = parentIndex >= 0 ? tileClip(parentIndex, tile, scratch) : kClipCoversTile;
+        const Shape&       shape       = shapes[clipIndex];
+        const TileCoverage coverage    = parent == kClipHidesTile ? TileCoverage::none
+                                                                  : ClassifyTile(shape.coverage, shape.rows, tile);
+
+        // Tiles entirely inside the clip take the parent's state as is, so interiors of nested clips never build or
+        // apply a mask; only tiles crossing a clip edge get one.
+        std::int32_t result;
+        if (coverage == TileCoverage::none)
+        {
+            result = kClipHidesTile;
+        }
+        else if (coverage == TileCoverage::full)
+        {
+            result = parent;
+        }
+        else
+        {
+            const std::size_t maskSize = static_cast<std::size_t>(kTileSize) * kTileSize;
+            const std::size_t offset   = scratch.clipStorage.size();
+            scratch.clipStorage.resize(offset + maskSize, 0);
+            result = static_cast<std::int32_t>(offset);
+
+            std::uint8_t*       mask       = scratch.clipStorage.data() + offset;
+            const std::uint8_t* parentMask = parent >= 0 ? scratch.clipStorage.data() + parent : nullptr;
+            const IRect&        covered    = shape.coverage.bounds;
+            const std::int32_t  top        = std::max(tile.top, covered.top);
+            const std::int32_t  bottom     = std::min(tile.bottom, covered.bottom);
+            for (std::int32_t y = top; y < bottom; ++y)
+            {
+                const std::uint32_t spanEnd = shape.rows[y - covered.top + 1];
+                for (std::uint32_t s = shape.rows[y - covered.top]; s < spanEnd; ++s)
+                {
+                    const CoverageSpan& span = shape.coverage.spans[s];
+                    const std::int32_t  x0   = std::max(span.x, tile.left);
+                    const std::int32_t  x1   = std::min(span.x + span.length, tile.right);
+                    const std::size_t   row  = static_cast<std::size_t>(y - tile.top) * kTileSize;
+                    for (std::int32_t x = x0; x < x1; ++x)
+                    {
+                        const std::size_t   index = row + (x - tile.left);
+                        const std::uint32_t alpha = span.alphaOffset >= 0
+                                                        ? shape.coverage.alphas[span.alphaOffset + (x - span.x)]
+                                                        : span.alpha;
+                        mask[index] = static_cast<std::uint8_t>(parentMask ? MulDiv255(alpha, parentMask[index])
+                                                                           : alpha);
+                    }
+                }
+            }
+        }
+        scratch.clipOffsets[clipIndex] = result;
+        scratch.usedClips.push_back(clipIndex);
+        return result;
+    }
+
+    void Canvas::compositeDraw(const DrawCommand& command, const Shape& shape, const IRect& tile,
+                               const std::uint8_t* mask, std::uint8_t* pixels, std::size_t stride,
+                               WorkerScratch& scratch) const
+    {
+        const CoverageMask& coverage = shape.coverage;
+        const IRect&        covered  = coverage.bounds;
+        const std::int32_t  top      = std::max(tile.top, covered.top);
+        const std::int32_t  bottom   = std::min(tile.bottom, covered.bottom);
+        const std::int32_t* owners   = command.triangles.empty() ? nullptr
+                                                                 : tileMeshOwners(command, shape, tile, scratch);
+        for (std::int32_t y = top; y < bottom; ++y)
+        {
+            // Spans within a row are sorted and disjoint, so skip straight to the first one reaching into the tile.
+            const auto rowBegin = coverage.spans.begin() + shape.rows[y - covered.top];
+            const auto rowEnd   = coverage.spans.begin() + shape.rows[y - covered.top + 1];
+            auto       it       = std::partition_point(rowBegin, rowEnd, [&tile](const CoverageSpan& span)
+                                                       { return span.x + span.length <= tile.left; });
+            for (; it != rowEnd && it->x < tile.right; ++it)
+            {
+                const CoverageSpan& span   = *it;
+                const std::int32_t  x      = std::max(span.x, tile.left);
+                const std::int32_t  length = std::min(span.x + span.length, tile.right) - x;
+
+                auto* dst = reinterpret_cast<std::uint32_t*>(pixels + static_cast<std::size_t>(y) * stride) + x;
+                const std::uint8_t* spanCoverage =
+                    span.alphaOffset >= 0 ? &coverage.alphas[span.alphaOffset + (x - span.x)] : nullptr;
+                if (mask != nullptr)
+                {
+                    const std::uint8_t* maskRow =
+                        mask + static_cast<std::size_t>(y - tile.top) * kTileSize + (x - tile.left);
+                    scratch.coverageRow.resize(length);
+                    for (std::int32_t i = 0; i < length; ++i)
+                    {
+                        const std::uint32_t alpha = spanCoverage != nullptr ? spanCoverage[i] : span.alpha;
+                        scratch.coverageRow[i]    = static_cast<std::uint8_t>(MulDiv255(alpha, maskRow[i]));
+                    }
+                    spanCoverage = scratch.coverageRow.data();
+                }
+
+                if (owners != nullptr)
+                {
+                    const std::int32_t* ownerRow =
+                        owners + static_cast<std::size_t>(y - tile.top) * kTileSize + (x - tile.left);
+                    compositeMeshSpan(command, ownerRow, x, y, length, spanCoverage, span.alpha, dst, scratch);
+                }
+                else if (command.image)
+                {
+                    scratch.colorRow.resize(length);
+                    ShadeImageSpan(*command.image, command.sampler, command.opacity, command.deviceToLocal, x, y,
+                                   length, scratch.colorRow.data());
+                    blend->blendSpan(command.blendMode, dst, scratch.colorRow.data(), spanCoverage, span.alpha,
+                                     length);
+                }
+                else if (command.shader)
+                {
+                    scratch.colorRow.resize(length);
+                    command.shader->shadeSpan(command.deviceToLocal, x, y, length, scratch.colorRow.data());
+                    blend->blendSpan(command.blendMode, dst, scratch.colorRow.data(), spanCoverage, span.alpha,
+                                     length);
+                }
+                else
+                {
+                    blend->blendSolidSpan(command.blendMode, dst, command.color, spanCoverage, span.alpha, length);
+                }
+            }
+        }
+    }
+
+    const std::int32_t* Canvas::tileMeshOwners(const DrawCommand& command, const Shape& shape, const IRect& tile,
+                                               WorkerScratch& scratch) const
+    {
+        std::vector<std::int32_t>& owners = scratch.meshOwners;
+        owners.assign(static_cast<std::size_t>(kTileSize) * kTileSize, kNoMeshOwner);
+
+        const IRect&       covered = shape.coverage.bounds;
+        const std::int32_t left    = covered.left / kTileSize;
+        const std::int32_t top     = covered.top / kTileSize;
+        const std::int32_t columns = (covered.right - 1) / kTileSize - left + 1;
+        const std::size_t  bin =
+            static_cast<std::size_t>(tile.top / kTileSize - top) * columns + (tile.left / kTileSize - left);
+        for (std::uint32_t entry = shape.triangleOffsets[bin]; entry < shape.triangleOffsets[bin + 1]; ++entry)
+        {
+            const std::uint32_t index = shape.triangleEntries[entry];
+            RasterizeMeshTriangle(command.triangles[index], static_cast<std::int32_t>(index), tile, owners.data(),
+                                  kTileSize);
+        }
+        return owners.data();
+    }
+
+    void Canvas::compositeMeshSpan(const DrawCommand& command, const std::int32_t* owners, std::int32_t x,
+                                   std::int32_t y, std::int32_t length, const std::uint8_t* coverage,
+                                   std::uint8_t constantCoverage, std::uint32_t* dst, WorkerScratch& scratch) const
+    {
+        // Each run of pixels owned by one triangle samples through that triangle's UV mapping. Covered pixels that no
+        // triangle claims (possible only along the outline, from rounding) are left untouched.
+        scratch.colorRow.resize(length);
+        std::int32_t start = 0;
+        while (start < length)
+        {
+            const std::int32_t triangle = MeshOwnerTriangle(owners[start]);
+            std::int32_t       end      = start + 1;
+            while (end < length && MeshOwnerTriangle(owners[end]) == triangle)
+            {
+                ++end;
+            }
+            if (triangle != kNoMeshOwner)
+            {
+                const std::int32_t count = end - start;
+                ShadeImageSpan(*command.image, command.sampler, command.opacity,
+                               command.triangles[triangle].deviceToImage, x + start, y, count, scratch.colorRow.data());
+                blend->blendSpan(command.blendMode, dst + start, scratch.colorRow.data(),
+                                 coverage != nullptr ? coverage + start : nullptr, constantCoverage, count);
+            }
+            start = end;
+        }
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "cpu_blend.hpp"
+#include "cpu_blur.hpp"
+#include "cpu_math.hpp"
+#include "cpu_mesh.hpp"
+#include "cpu_path.hpp"
+#include "cpu_raster.hpp"
+#include "cpu_shader.hpp"
+#include "cpu_worker_pool.hpp"
+
+namespace rive_renderer_cpu
+{
+    struct Paint
+    {
+        PaintStyle              style {PaintStyle::fill};
+        std::uint32_t           color {0xff000000};
+        StrokeStyle             stroke;
+        float                   feather {0.0f};
+        BlendMode               blendMode {BlendMode::srcOver};
+        std::shared_ptr<Shader> shader;
+    };
+
+    // Device-space clip geometry. Nodes form a chain through their parents; a draw is clipped by the intersection of
+    // every node on its chain. bounds already includes the parent's bounds and acts as a scissor for everything drawn
+    // under the node. Rectangles that only cover whole pixels are marked isRect and need no mask beyond that scissor.
+    struct ClipNode
+    {
+        std::shared_ptr<const ClipNode> parent;
+        Polyline                        geometry;
+        FillRule                        fillRule {FillRule::nonZero};
+        IRect                           bounds;
+        bool                            isRect {false};
+    };
+
+    // Transform and clip in effect for a draw. Renderers own their state stacks; the canvas only reads them.
+    struct CanvasState
+    {
+        Mat2D                           matrix;
+        std::shared_ptr<const ClipNode> clip;
+        bool                            clipEmpty {false};
+    };
+
+    // Records one frame of draws and rasterizes them into a premultiplied RGBA8 framebuffer when the frame ends.
+    // Geometry is flattened and transformed to device space at record time, so paths and paints may be mutated or
+    // released as soon as a draw call returns.
+    //
+    // Ending a frame runs in two parallel passes: every draw and clip is rasterized to sparse coverage, then the
+    // coverage is binned into fixed-size tiles and each tile composites its draws in submission order. Pixels only
+    // depend on the draws that touch them, so the output is identical for any worker count.
+    class Canvas
+    {
+    public:
+        // pool may be null, in which case frames are rasterized on the calling thread. simdLevel selects the
+        // compositing kernels and should come from DetectSimdLevel().
+        explicit Canvas(WorkerPool* pool = nullptr, SimdLevel simdLevel = SimdLevel::portable) :
+            pool(pool), blend(&GetBlendKernels(simdLevel))
+        {
+        }
+
+        void beginFrame(std::uint32_t width, std::uint32_t height);
+
+        // Rasterizes every recorded draw, in order, into a targetWidth x targetHeight RGBA8 image with the given row
+        // stride. Draws are clipped to the smaller of the frame and target sizes.
+        void endFrame(std::uint8_t* pixels, std::uint32_t targetWidth, std::uint32_t targetHeight, std::size_t stride);
+
+        bool recording() const
+        {
+            return isRecording;
+        }
+
+        // Clipping the same geometry under the same parent again within a frame reuses the existing node, so clips
+        // repeated around save/restore pairs are rasterized and masked once.
+        void clipPath(CanvasState* state, const PathData& path);
+        // strokeCache, when given, must belong to path; stroked draws then reuse its outline while it is current.
+        void drawPath(const CanvasState& state, const PathData& path, const Paint& paint,
+                      StrokeCache* strokeCache = nullptr);
+        void drawImage(const CanvasState& state, const std::shared_ptr<const ImageData>& image,
+                       const ImageSampler& sampler, BlendMode blendMode, float opacity);
+
+        // Draws indexed triangles of the image. vertices are in local space and uvs are normalized image coordinates;
+        // triangles referencing vertices past vertexCount are skipped.
+        void drawImageMesh(const CanvasState& state, const std::shared_ptr<const ImageData>& image,
+                           const ImageSampler& sampler, const Vec2* vertices, const Vec2* uvs,
+                           std::uint32_t vertexCount, const std::uint16_t* indices, std::uint32_t indexCount,
+                           BlendMode blendMode, float opacity);
+
+    private:
+        struct DrawCommand
+        {
+            Polyline                         geometry;
+            FillRule                         fillRule {FillRule::nonZero};
+            std::shared_ptr<const ClipNode>  clip;
+            BlendMode                        blendMode {BlendMode::srcOver};
+            std::uint32_t                    color {0};
+            std::shared_ptr<const Shader>    shader;
+            std::shared_ptr<const ImageData> image;
+            ImageSampler                     sampler;
+            float                            opacity {1.0f};
+            Mat2D                            deviceToLocal;
+            std::vector<MeshTriangle>        triangles;
+            GaussianBoxes                    feather;
+            std::int32_t                     clipIndex {-1};
+        };
+
+        // Rasterized coverage of one clip or draw. rows[i] is the first span on row coverage.bounds.top + i. Image
+        // meshes also bin their triangles over the tiles of the coverage bounds: triangleEntries lists each tile's
+        // triangle indices in draw order, starting at triangleOffsets[tile].
+        struct Shape
+        {
+            CoverageMask               coverage;
+            std::vector<std::uint32_t> rows;
+            std::vector<std::uint32_t> triangleOffsets;
+            std::vector<std::uint32_t> triangleEntries;
+        };
+
+        // Per-worker scratch. Clip masks are built per tile on demand; clipOffsets maps a clip index to its mask in
+        // clipStorage or to one of the kClip* states below. meshOwners holds the triangle
+        // owning each pixel of the tile for the image mesh being composited. Feathered draws rasterize into
+        // featherSource before it is blurred into the shape.
+        struct WorkerScratch
+        {
+            Rasterizer                 rasterizer;
+            CoverageMask               featherSource;
+            BlurScratch                blur;
+            std::vector<std::uint8_t>  coverageRow;
+            std::vector<std::uint32_t> colorRow;
+            std::vector<std::int32_t>  meshOwners;
+            std::vector<std::uint8_t>  clipStorage;
+            std::vector<std::int32_t>  clipOffsets;
+            std::vector<std::int32_t>  usedClips;
+        };
+
+        // Per-tile clip states stored in WorkerScratch::clipOffsets in place of a mask offset.
+        static constexpr std::int32_t kClipUnresolved = -1;
+        static constexpr std::int32_t kClipCoversTile = -2;
+        static constexpr std::int32_t kClipHidesTile  = -3;
+
+        void                record(const CanvasState& state, DrawCommand&& command);
+        void                forEach(std::size_t count, const WorkerPool::Task& task);
+        void                collectClips();
+        void                rasterizeShapes(const IRect& target);
+        void                binShapes(const IRect& target);
+        static void         binTriangles(const DrawCommand& command, Shape* shape);
+        void                compositeTile(std::size_t tileIndex, const IRect& target, std::uint8_t* pixels,
+                                          std::size_t stride, WorkerScratch& scratch);
+        std::int32_t        tileClip(std::int32_t clipIndex, const IRect& tile, WorkerScratch& scratch);
+        void                compositeDraw(const DrawCommand& command, const Shape& shape, const IRect& tile,
+                                          const std::uint8_t* mask, std::uint8_t* pixels, std::size_t stride,
+                                          WorkerScratch& scratch) const;
+        const std::int32_t* tileMeshOwners(const DrawCommand& command, const Shape& shape, const IRect& tile,
+                                           WorkerScratch& scratch) const;
+        void                compositeMeshSpan(const DrawCommand& command, const std::int32_t* owners, std::int32_t x,
+                                              std::int32_t y, std::int32_t length, const std::uint8_t* coverage,
+                                              std::uint8_t constantCoverage, std::uint32_t* dst,
+                                              WorkerScratch& scratch) const;
+
+        WorkerPool*              pool;
+        const BlendKernels*      blend;
+        std::uint32_t            width {0};
+        std::uint32_t            height {0};
+        bool                     isRecording {false};
+        std::vector<DrawCommand> commands;
+
+        // Clip nodes created this frame, keyed by a hash of their parent and geometry.
+        std::unordered_multimap<std::uint64_t, std::shared_ptr<const ClipNode>> clipCache;
+
+        // Per-frame state, kept across frames so allocations are reused. Shapes hold the clips that need masks first,
+        // then one entry per draw; tile bins list draw indices in submission order.
+        std::vector<const ClipNode*>                      clipNodes;
+        std::vector<std::int32_t>                         clipParents;
+        std::unordered_map<const ClipNode*, std::int32_t> clipIndices;
+        std::vector<Shape>                                shapes;
+        std::int32_t                                      tileColumns {0};
+        std::int32_t                                      tileRows {0};
+        std::vector<std::uint32_t>                        binOffsets;
+        std::vector<std::uint32_t>                        binEntries;
+        std::vector<WorkerScratch>                        scratch;
+    };
+} // namespace rive_renderer_cpu
@@ -0,0 +1,333 @@
+#include "cpu_encode.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include <zlib.h>
+
+namespace rive_renderer_cpu
+{
+    struct EncodeScratch::Band
+    {
+        z_stream                  stream {};
+        bool                      streamReady {false};
+        int                       level {-1};
+        // Unpremultiplied rows of the band, preceded by the row above it when there is one.
+        std::vector<std::uint8_t> rows;
+        std::vector<std::uint8_t> candidates;
+        std::vector<std::uint8_t> filtered;
+        std::vector<std::uint8_t> compressed;
+        uLong                     adler {0};
+        bool                      ok {false};
+
+        ~Band()
+        {
+            if (streamReady)
+            {
+                deflateEnd(&stream);
+            }
+        }
+    };
+
+    EncodeScratch::EncodeScratch()  = default;
+    EncodeScratch::~EncodeScratch() = default;
+
+    namespace
+    {
+        // Bands shorter than this cost more in flush overhead and lost matches than they gain in parallelism.
+        constexpr std::uint32_t kMinBandRows = 32;
+
+        // Deflate matches reach at most 32 KiB back, so that much of the previous band primes each band's stream.
+        constexpr std::size_t kDictionarySize = 32768;
+
+        void ForEach(WorkerPool* pool, std::size_t count, const WorkerPool::Task& task)
+        {
+            if (pool != nullptr)
+            {
+                pool->parallelFor(count, task);
+                return;
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                task(i, 0);
+            }
+        }
+
+        std::uint32_t BandCount(WorkerPool* pool, std::uint32_t height)
+        {
+            const std::size_t workers = pool != nullptr ? pool->slotCount() : 1;
+            const std::size_t bands   = std::min<std::size_t>(workers, (height + kMinBandRows - 1) / kMinBandRows);
+            return static_cast<std::uint32_t>(std::max<std::size_t>(bands, 1));
+        }
+
+        std::uint32_t BandStart(std::uint32_t band, std::uint32_t bandCount, std::uint32_t height)
+        {
+            return static_cast<std::uint32_t>(static_cast<std::uint64_t>(height) * band / bandCount);
+        }
+
+        void PrepareBands(EncodeScratch* scratch, std::uint32_t bandCount)
+        {
+            while (scratch->bands.size() < bandCount)
+            {
+                scratch->bands.push_back(std::make_unique<EncodeScratch::Band>());
+            }
+        }
+
+        std::uint8_t PaethPredictor(int a, int b, int c)
+        {
+            const int p  = a + b - c;
+            const int pa = std::abs(p - a);
+            const int pb = std::abs(p - b);
+            const int pc = std::abs(p - c);
+            if (pa <= pb && pa <= pc)
+            {
+                return static_cast<std::uint8_t>(a);
+            }
+            return static_cast<std::uint8_t>(pb <= pc ? b : c);
+        }
+
+        // Writes the filter type byte and the filtered bytes of one RGBA8 row, picking the None, Sub, Up or Paeth
+        // filter whose output has the smallest sum of absolute values, as libpng does. above is null on the first row.
+        void FilterRow(const std::uint8_t* row, const std::uint8_t* above, std::size_t length,
+                       std::uint8_t* candidates, std::uint8_t* out)
+        {
+            std::uint8_t* sub   = candidates;
+            std::uint8_t* up    = candidates + length;
+            std::uint8_t* paeth = candidates + length * 2;
+            std::uint64_t sums[4] {0, 0, 0, 0};
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                const int left      = i >= 4 ? row[i - 4] : 0;
+                const int upper     = above != nullptr ? above[i] : 0;
+                const int upperLeft = above != nullptr && i >= 4 ? above[i - 4] : 0;
+                sub[i]              = static_cast<std::uint8_t>(row[i] - left);
+                up[i]               = static_cast<std::uint8_t>(row[i] - upper);
+                paeth[i]            = static_cast<std::uint8_t>(row[i] - PaethPredictor(left, upper, upperLeft));
+                sums[0] += static_cast<std::uint64_t>(std::abs(static_cast<std::int8_t>(row[i])));
+                sums[1] += static_cast<std::uint64_t>(std::abs(static_cast<std::int8_t>(sub[i])));
+                sums[2] += static_cast<std::uint64_t>(std::abs(static_cast<std::int8_t>(up[i])));
+                sums[3] += static_cast<std::uint64_t>(std::abs(static_cast<std::int8_t>(paeth[i])));
+            }
+
+            // PNG filter types: 0 None, 1 Sub, 2 Up, 4 Paeth.
+            static constexpr std::uint8_t kTypes[4] {0, 1, 2, 4};
+            const std::uint8_t*           sources[4] {row, sub, up, paeth};
+            const std::size_t             best = static_cast<std::size_t>(std::min_element(sums, sums + 4) - sums);
+            out[0]                              = kTypes[best];
+            std::memcpy(out + 1, sources[best], length);
+        }
+
+        // Unpremultiplies rows [begin, end) of the image into dst, rowBytes apart.
+        void UnpremultiplyRows(const std::uint8_t* pixels, std::size_t stride, std::uint32_t width, std::uint32_t begin,
+                               std::uint32_t end, const BlendKernels& kernels, std::uint8_t* dst)
+        {
+            const std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+            for (std::uint32_t y = begin; y < end; ++y)
+            {
+                kernels.convertSpan(dst + (y - begin) * rowBytes, pixels + y * stride, static_cast<std::int32_t>(width),
+                                    false, true);
+            }
+        }
+
+        // Deflates band's filtered rows as raw deflate data that ends on a byte boundary, finishing the stream on the
+        // last band. dictionary, when not null, is the tail of the previous band's input.
+        bool DeflateBand(EncodeScratch::Band& band, int level, const std::uint8_t* dictionary,
+                         std::size_t dictionaryLength, bool last)
+        {
+            if (band.streamReady && band.level != level)
+            {
+                deflateEnd(&band.stream);
+                band.streamReady = false;
+            }
+            if (!band.streamReady)
+            {
+                band.stream = {};
+                if (deflateInit2(&band.stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    return false;
+                }
+                band.streamReady = true;
+                band.level       = level;
+            }
+            else if (deflateReset(&band.stream) != Z_OK)
+            {
+                return false;
+            }
+
+            if (dictionary != nullptr &&
+                deflateSetDictionary(&band.stream, dictionary, static_cast<uInt>(dictionaryLength)) != Z_OK)
+            {
+                return false;
+            }
+
+            const std::size_t inputLength = band.filtered.size();
+            if (inputLength > std::numeric_limits<uInt>::max())
+            {
+                return false;
+            }
+            band.compressed.resize(deflateBound(&band.stream, static_cast<uLong>(inputLength)) + 64);
+            band.stream.next_in   = band.filtered.data();
+            band.stream.avail_in  = static_cast<uInt>(inputLength);
+            const int   flush     = last ? Z_FINISH : Z_SYNC_FLUSH;
+            std::size_t written   = 0;
+            for (;;)
+            {
+                if (written == band.compressed.size())
+                {
+                    band.compressed.resize(band.compressed.size() * 2);
+                }
+                const std::size_t available =
+                    std::min<std::size_t>(band.compressed.size() - written, std::numeric_limits<uInt>::max());
+                band.stream.next_out  = band.compressed.data() + written;
+                band.stream.avail_out = static_cast<uInt>(available);
+                const int result      = deflate(&band.stream, flush);
+                written += available - band.stream.avail_out;
+                if (result == Z_STREAM_END)
+                {
+                    break;
+                }
+                if (result != Z_OK && !(result == Z_BUF_ERROR && band.stream.avail_out == 0))
+                {
+                    return false;
+                }
+                // A sync flush is complete once deflate stops filling the output.
+                if (!last && band.stream.avail_in == 0 && band.stream.avail_out != 0)
+                {
+                    break;
+                }
+            }
+            band.compressed.resize(written);
+            return true;
+        }
+
+        void AppendBigEndian(std::vector<std::uint8_t>* out, std::uint32_t value)
+        {
+            const std::uint8_t bytes[4] {static_cast<std::uint8_t>(value >> 24), static_cast<std::uint8_t>(value >> 16),
+                                         static_cast<std::uint8_t>(value >> 8), static_cast<std::uint8_t>(value)};
+            out->insert(out->end(), bytes, bytes + 4);
+        }
+
+        // Appends a chunk header and returns its offset; EndChunk fills in the length and appends the CRC once the
+        // chunk data has been appended.
+        std::size_t BeginChunk(std::vector<std::uint8_t>* out, const char* type)
+        {
+            const std::size_t offset = out->size();
+            AppendBigEndian(out, 0);
+            out->insert(out->end(), type, type + 4);
+            return offset;
+        }
+
+        bool EndChunk(std::vector<std::uint8_t>* out, std::size_t offset)
+        {
+            const std::size_t length = out->size() - offset - 8;
+            if (length > 0x7fffffffu)
+            {
+                return false;
+            }
+            std::uint8_t* header = out->data() + offset;
+            header[0]            = static_cast<std::uint8_t>(length >> 24);
+            header[1]            = static_cast<std::uint8_t>(length >> 16);
+            header[2]            = static_cast<std::uint8_t>(length >> 8);
+            header[3]            = static_cast<std::uint8_t>(length);
+            const uLong crc      = crc32(crc32(0, nullptr, 0), header + 4, static_cast<uInt>(length + 4));
+            AppendBigEndian(out, static_cast<std::uint32_t>(crc));
+            return true;
+        }
+    } // namespace
+
+    bool EncodePng(const std::uint8_t* pixels, std::size_t stride, std::uint32_t width, std::uint32_t height, int level,
+                   const BlendKernels& kernels, WorkerPool* pool, EncodeScratch* scratch,
+                   std::vector<std::uint8_t>* out)
+    {
+        if (width == 0 || height == 0 || width > 0x7fffffffu / 4 || height > 0x7fffffffu)
+        {
+            return false;
+        }
+
+        const std::size_t   rowBytes  = static_cast<std::size_t>(width) * 4;
+        const std::uint32_t bandCount = BandCount(pool, height);
+        PrepareBands(scratch, bandCount);
+
+        // Unpremultiply and filter every band, then deflate them once all filtered data is available as dictionaries.
+        ForEach(pool, bandCount,
+                [&](std::size_t index, std::size_t)
+                {
+                    auto&               band  = *scratch->bands[index];
+                    const std::uint32_t begin = BandStart(static_cast<std::uint32_t>(index), bandCount, height);
+                    const std::uint32_t end   = BandStart(static_cast<std::uint32_t>(index) + 1, bandCount, height);
+                    const std::uint32_t first = begin > 0 ? begin - 1 : 0;
+                    band.rows.resize((end - first) * rowBytes);
+                    band.candidates.resize(rowBytes * 3);
+                    band.filtered.resize((end - begin) * (rowBytes + 1));
+                    UnpremultiplyRows(pixels, stride, width, first, end, kernels, band.rows.data());
+                    for (std::uint32_t y = begin; y < end; ++y)
+                    {
+                        const std::uint8_t* row   = band.rows.data() + (y - first) * rowBytes;
+                        const std::uint8_t* above = y > 0 ? row - rowBytes : nullptr;
+                        FilterRow(row, above, rowBytes, band.candidates.data(),
+                                  band.filtered.data() + (y - begin) * (rowBytes + 1));
+                    }
+                    band.adler = adler32(adler32(0, nullptr, 0), band.filtered.data(),
+                                         static_cast<uInt>(band.filtered.size()));
+                });
+        ForEach(pool, bandCount,
+                [&](std::size_t index, std::size_t)
+                {
+                    auto&               band       = *scratch->bands[index];
+                    const std::uint8_t* dictionary = nullptr;
+                    std::size_t         length     = 0;
+                    if (index > 0)
+                    {
+                        const auto& previous = scratch->bands[index - 1]->filtered;
+                        length               = std::min(previous.size(), kDictionarySize);
+                        dictionary           = previous.data() + previous.size() - length;
+                    }
+                    band.ok = DeflateBand(band, level, dictionary, length, index + 1 == bandCount);
+                });
+
+        static constexpr std::uint8_t kSignature[8] {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+        out->insert(out->end(), kSignature, kSignature + 8);
+
+        std::size_t chunk = BeginChunk(out, "IHDR");
+        AppendBigEndian(out, width);
+        AppendBigEndian(out, height);
+        // 8 bits per channel, RGBA, deflate, adaptive filtering, no interlacing.
+        static constexpr std::uint8_t kFormat[5] {8, 6, 0, 0, 0};
+        out->insert(out->end(), kFormat, kFormat + 5);
+        EndChunk(out, chunk);
+
+        // Each band becomes one IDAT chunk; the zlib header opens the first and the combined Adler-32 closes the last.
+        uLong adler = adler32(0, nullptr, 0);
+        for (std::uint32_t index = 0; index < bandCount; ++index)
+        {
+            const auto& band = *scratch->bands[index];
+            if (!band.ok)
+            {
+                return false;
+            }
+            adler = adler32_combine(adler, band.adler, static_cast<z_off_t>(band.filtered.size()));
+
+            chunk = BeginChunk(out, "IDAT");
+            if (index == 0)
+            {
+                static constexpr std::uint8_t kZlibHeader[2] {0x78, 0x9c};
+                out->insert(out->end(), kZlibHeader, kZlibHeader + 2);
+            }
+            out->insert(out->end(), band.compressed.begin(), band.compressed.end());
+            if (index + 1 == bandCount)
+            {
+                AppendBigEndian(out, static_cast<std::uint32_t>(adler));
+            }
+            if (!EndChunk(out, chunk))
+            {
+                return false;
+            }
+        }
+
+        chunk = BeginChunk(out, "IEND");
+        EndChunk(out, chunk);
+        return true;
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cpu_blend.hpp"
+#include "cpu_worker_pool.hpp"
+
+namespace rive_renderer_cpu
+{
+    // Buffers and deflate streams reused across encodes. One scratch must not be used by two encodes at once.
+    struct EncodeScratch
+    {
+        // Per-band state, defined in cpu_encode.cpp.
+        struct Band;
+
+        EncodeScratch();
+        ~EncodeScratch();
+
+        std::vector<std::unique_ptr<Band>> bands;
+    };
+
+    // Encodes width x height premultiplied RGBA8 pixels, whose rows are stride bytes apart, as a straight-alpha RGBA
+    // PNG appended to out. Row bands are unpremultiplied, filtered and deflated concurrently on pool, each band using
+    // the end of the previous one as its dictionary, and are stitched into a single zlib stream; level is the zlib
+    // level (0-9). pool may be null to encode on the calling thread.
+    bool EncodePng(const std::uint8_t* pixels, std::size_t stride, std::uint32_t width, std::uint32_t height, int level,
+                   const BlendKernels& kernels, WorkerPool* pool, EncodeScratch* scratch,
+                   std::vector<std::uint8_t>* out);
+} // namespace rive_renderer_cpu
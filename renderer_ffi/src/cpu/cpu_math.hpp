@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Plain value types shared by the software rasterizer. The CPU backend keeps its own copies of the rive enums so the
+// rasterization core can be built and reasoned about without pulling in the rive headers; the enumerator values mirror
+// rive::FillRule, rive::BlendMode, rive::StrokeJoin, rive::StrokeCap and rive::ImageWrap/ImageFilter one-to-one.
+namespace rive_renderer_cpu
+{
+    struct Vec2
+    {
+        float x {0.0f};
+        float y {0.0f};
+    };
+
+    inline Vec2 operator+(Vec2 a, Vec2 b)
+    {
+        return {a.x + b.x, a.y + b.y};
+    }
+
+    inline Vec2 operator-(Vec2 a, Vec2 b)
+    {
+        return {a.x - b.x, a.y - b.y};
+    }
+
+    inline Vec2 operator*(Vec2 a, float s)
+    {
+        return {a.x * s, a.y * s};
+    }
+
+    inline float Dot(Vec2 a, Vec2 b)
+    {
+        return a.x * b.x + a.y * b.y;
+    }
+
+    inline float Cross(Vec2 a, Vec2 b)
+    {
+        return a.x * b.y - a.y * b.x;
+    }
+
+    inline float Length(Vec2 v)
+    {
+        return std::sqrt(v.x * v.x + v.y * v.y);
+    }
+
+    // Affine matrix laid out like rive::Mat2D: [xx, xy, yx, yy, tx, ty].
+    struct Mat2D
+    {
+        float xx {1.0f};
+        float xy {0.0f};
+        float yx {0.0f};
+        float yy {1.0f};
+        float tx {0.0f};
+        float ty {0.0f};
+
+        Vec2 map(Vec2 p) const
+        {
+            return {xx * p.x + yx * p.y + tx, xy * p.x + yy * p.y + ty};
+        }
+
+        Vec2 mapVector(Vec2 v) const
+        {
+            return {xx * v.x + yx * v.y, xy * v.x + yy * v.y};
+        }
+
+        bool isIdentity() const
+        {
+            return xx == 1.0f && xy == 0.0f && yx == 0.0f && yy == 1.0f && tx == 0.0f && ty == 0.0f;
+        }
+
+        // Largest factor by which the matrix can stretch a unit vector. Used to pick flattening tolerances in local
+        // space that stay sub-pixel once mapped to the device.
+        float maxScale() const
+        {
+            const float a  = xx * xx + xy * xy;
+            const float b  = xx * yx + xy * yy;
+            const float c  = yx * yx + yy * yy;
+            const float tr = 0.5f * (a + c);
+            const float d  = std::sqrt(std::max(0.0f, 0.25f * (a - c) * (a - c) + b * b));
+            return std::sqrt(std::max(0.0f, tr + d));
+        }
+
+        bool invert(Mat2D* out) const
+        {
+            const float det = xx * yy - xy * yx;
+            if (det == 0.0f || !std::isfinite(det))
+            {
+                return false;
+            }
+            const float inv = 1.0f / det;
+            out->xx         = yy * inv;
+            out->xy         = -xy * inv;
+            out->yx         = -yx * inv;
+            out->yy         = xx * inv;
+            out->tx         = (yx * ty - yy * tx) * inv;
+            out->ty         = (xy * tx - xx * ty) * inv;
+            return true;
+        }
+    };
+
+    // Returns a * b, i.e. b is applied first.
+    inline Mat2D Multiply(const Mat2D& a, const Mat2D& b)
+    {
+        Mat2D r;
+        r.xx = a.xx * b.xx + a.yx * b.xy;
+        r.xy = a.xy * b.xx + a.yy * b.xy;
+        r.yx = a.xx * b.yx + a.yx * b.yy;
+        r.yy = a.xy * b.yx + a.yy * b.yy;
+        r.tx = a.xx * b.tx + a.yx * b.ty + a.tx;
+        r.ty = a.xy * b.tx + a.yy * b.ty + a.ty;
+        return r;
+    }
+
+    struct Rect
+    {
+        float left {std::numeric_limits<float>::max()};
+        float top {std::numeric_limits<float>::max()};
+        float right {std::numeric_limits<float>::lowest()};
+        float bottom {std::numeric_limits<float>::lowest()};
+
+        bool empty() const
+        {
+            return !(left < right && top < bottom);
+        }
+
+        void add(Vec2 p)
+        {
+            left   = std::min(left, p.x);
+            top    = std::min(top, p.y);
+            right  = std::max(right, p.x);
+            bottom = std::max(bottom, p.y);
+        }
+    };
+
+    // Half-open integer pixel rectangle [left, right) x [top, bottom).
+    struct IRect
+    {
+        std::int32_t left {0};
+        std::int32_t top {0};
+        std::int32_t right {0};
+        std::int32_t bottom {0};
+
+        bool empty() const
+        {
+            return left >= right || top >= bottom;
+        }
+
+        std::int32_t width() const
+        {
+            return right - left;
+        }
+
+        std::int32_t height() const
+        {
+            return bottom - top;
+        }
+
+        bool contains(const IRect& other) const
+        {
+            return other.left >= left && other.top >= top && other.right <= right && other.bottom <= bottom;
+        }
+    };
+
+    inline IRect Intersect(const IRect& a, const IRect& b)
+    {
+        IRect r {std::max(a.left, b.left), std::max(a.top, b.top), std::min(a.right, b.right),
+                 std::min(a.bottom, b.bottom)};
+        if (r.empty())
+        {
+            return IRect {};
+        }
+        return r;
+    }
+
+    // Grows a non-empty rect by amount pixels on every side.
+    inline IRect Outset(const IRect& r, std::int32_t amount)
+    {
+        if (r.empty())
+        {
+            return IRect {};
+        }
+        return IRect {r.left - amount, r.top - amount, r.right + amount, r.bottom + amount};
+    }
+
+    // Rounds a float rect outwards to the pixels it touches, clamped to a sane range for fixed point rasterization.
+    inline IRect RoundOut(const Rect& r)
+    {
+        if (r.empty())
+        {
+            return IRect {};
+        }
+        auto clamp = [](float v)
+        {
+            constexpr float kLimit = 1 << 22;
+            return v < -kLimit ? -kLimit : (v > kLimit ? kLimit : v);
+        };
+        return IRect {static_cast<std::int32_t>(std::floor(clamp(r.left))),
+                      static_cast<std::int32_t>(std::floor(clamp(r.top))),
+                      static_cast<std::int32_t>(std::ceil(clamp(r.right))),
+                      static_cast<std::int32_t>(std::ceil(clamp(r.bottom)))};
+    }
+
+    enum class FillRule : std::uint8_t
+    {
+        nonZero   = 0,
+        evenOdd   = 1,
+        clockwise = 2,
+    };
+
+    enum class PaintStyle : std::uint8_t
+    {
+        stroke = 0,
+        fill   = 1,
+    };
+
+    enum class StrokeJoin : std::uint8_t
+    {
+        miter = 0,
+        round = 1,
+        bevel = 2,
+    };
+
+    enum class StrokeCap : std::uint8_t
+    {
+        butt   = 0,
+        round  = 1,
+        square = 2,
+    };
+
+    enum class BlendMode : std::uint8_t
+    {
+        srcOver    = 3,
+        screen     = 14,
+        overlay    = 15,
+        darken     = 16,
+        lighten    = 17,
+        colorDodge = 18,
+        colorBurn  = 19,
+        hardLight  = 20,
+        softLight  = 21,
+        difference = 22,
+        exclusion  = 23,
+        multiply   = 24,
+        hue        = 25,
+        saturation = 26,
+        color      = 27,
+        luminosity = 28,
+    };
+
+    enum class ImageWrap : std::uint8_t
+    {
+        clamp  = 0,
+        repeat = 1,
+        mirror = 2,
+    };
+
+    enum class ImageFilter : std::uint8_t
+    {
+        bilinear = 0,
+        nearest  = 1,
+    };
+
+    struct ImageSampler
+    {
+        ImageWrap   wrapX {ImageWrap::clamp};
+        ImageWrap   wrapY {ImageWrap::clamp};
+        ImageFilter filter {ImageFilter::bilinear};
+    };
+
+    // Packs straight-alpha 0xAARRGGBB (rive::ColorInt) into premultiplied RGBA8 stored as little-endian 0xAABBGGRR, the
+    // byte order of the CPU framebuffer.
+    inline std::uint32_t PremultiplyColorInt(std::uint32_t argb)
+    {
+        const std::uint32_t a = (argb >> 24) & 0xff;
+        const std::uint32_t r = (argb >> 16) & 0xff;
+        const std::uint32_t g = (argb >> 8) & 0xff;
+        const std::uint32_t b = argb & 0xff;
+        auto                mul = [a](std::uint32_t c)
+        {
+            const std::uint32_t t = c * a + 128;
+            return (t + (t >> 8)) >> 8;
+        };
+        return mul(r) | (mul(g) << 8) | (mul(b) << 16) | (a << 24);
+    }
+
+    // (a * b) / 255 with correct rounding for 8-bit operands.
+    inline std::uint32_t MulDiv255(std::uint32_t a, std::uint32_t b)
+    {
+        const std::uint32_t t = a * b + 128;
+        return (t + (t >> 8)) >> 8;
+    }
+} // namespace rive_renderer_cpu
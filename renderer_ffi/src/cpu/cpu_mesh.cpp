@@ -0,0 +1,154 @@
+#include "cpu_mesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kSubpixelShift = 8;
+        constexpr std::int64_t kSubpixelScale = 1 << kSubpixelShift;
+        constexpr float        kMaxCoordinate = 1 << 20;
+
+        // Same rounding as the coverage rasterizer, so mesh edges and the mesh outline agree on every vertex.
+        std::int64_t ToFixed(float value)
+        {
+            const float clamped = std::min(std::max(value, -kMaxCoordinate), kMaxCoordinate);
+            return static_cast<std::int64_t>(std::floor(clamped * static_cast<float>(kSubpixelScale) + 0.5f));
+        }
+
+        // Subpixel position of the center of pixel i.
+        std::int64_t PixelCenter(std::int32_t i)
+        {
+            return static_cast<std::int64_t>(i) * kSubpixelScale + kSubpixelScale / 2;
+        }
+    } // namespace
+
+    bool SetupMeshTriangle(Vec2 points[3], Vec2 texels[3], MeshTriangle* out)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y) || !std::isfinite(texels[i].x) ||
+                !std::isfinite(texels[i].y))
+            {
+                return false;
+            }
+        }
+
+        std::int64_t x[3] {ToFixed(points[0].x), ToFixed(points[1].x), ToFixed(points[2].x)};
+        std::int64_t y[3] {ToFixed(points[0].y), ToFixed(points[1].y), ToFixed(points[2].y)};
+        const std::int64_t area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        if (area == 0)
+        {
+            return false;
+        }
+        if (area < 0)
+        {
+            std::swap(points[1], points[2]);
+            std::swap(texels[1], texels[2]);
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+        }
+
+        // Edge i runs from corner i to the next corner; with positive area the interior is on its non-negative side.
+        for (int i = 0; i < 3; ++i)
+        {
+            const int j = (i + 1) % 3;
+            out->a[i]   = y[i] - y[j];
+            out->b[i]   = x[j] - x[i];
+            out->c[i]   = -(out->a[i] * x[i] + out->b[i] * y[i]);
+        }
+        const std::int64_t left   = std::min({x[0], x[1], x[2]});
+        const std::int64_t top    = std::min({y[0], y[1], y[2]});
+        const std::int64_t right  = std::max({x[0], x[1], x[2]});
+        const std::int64_t bottom = std::max({y[0], y[1], y[2]});
+        out->bounds               = IRect {static_cast<std::int32_t>(left >> kSubpixelShift),
+                                           static_cast<std::int32_t>(top >> kSubpixelShift),
+                                           static_cast<std::int32_t>(right >> kSubpixelShift) + 1,
+                                           static_cast<std::int32_t>(bottom >> kSubpixelShift) + 1};
+
+        // Solve deviceToImage * points[i] = texels[i] in double; the float corners are more precise than the snapped
+        // fixed point ones and the map has to stay consistent along edges shared with neighbouring triangles.
+        const double dx1 = static_cast<double>(points[1].x) - points[0].x;
+        const double dy1 = static_cast<double>(points[1].y) - points[0].y;
+        const double dx2 = static_cast<double>(points[2].x) - points[0].x;
+        const double dy2 = static_cast<double>(points[2].y) - points[0].y;
+        const double det = dx1 * dy2 - dy1 * dx2;
+        if (det == 0.0)
+        {
+            return false;
+        }
+        const double du1 = static_cast<double>(texels[1].x) - texels[0].x;
+        const double dv1 = static_cast<double>(texels[1].y) - texels[0].y;
+        const double du2 = static_cast<double>(texels[2].x) - texels[0].x;
+        const double dv2 = static_cast<double>(texels[2].y) - texels[0].y;
+        const double xx  = (du1 * dy2 - du2 * dy1) / det;
+        const double yx  = (du2 * dx1 - du1 * dx2) / det;
+        const double xy  = (dv1 * dy2 - dv2 * dy1) / det;
+        const double yy  = (dv2 * dx1 - dv1 * dx2) / det;
+
+        Mat2D& m = out->deviceToImage;
+        m.xx     = static_cast<float>(xx);
+        m.xy     = static_cast<float>(xy);
+        m.yx     = static_cast<float>(yx);
+        m.yy     = static_cast<float>(yy);
+        m.tx     = static_cast<float>(texels[0].x - (xx * points[0].x + yx * points[0].y));
+        m.ty     = static_cast<float>(texels[0].y - (xy * points[0].x + yy * points[0].y));
+        return std::isfinite(m.xx) && std::isfinite(m.xy) && std::isfinite(m.yx) && std::isfinite(m.yy) &&
+               std::isfinite(m.tx) && std::isfinite(m.ty);
+    }
+
+    void RasterizeMeshTriangle(const MeshTriangle& triangle, std::int32_t index, const IRect& area,
+                               std::int32_t* owners, std::size_t stride)
+    {
+        const IRect rect = Intersect(triangle.bounds, area);
+        if (rect.empty())
+        {
+            return;
+        }
+
+        // Owners keep the triangle index in the upper bits and whether the triangle contains the pixel center in
+        // bit 0. A pixel square touches an edge's half plane when the edge function at its center is at least minus
+        // half the square's extent along the edge normal.
+        const std::int32_t inside = index * 2 + 1;
+        const std::int32_t grazed = index * 2;
+        std::int64_t       row[3];
+        std::int64_t       stepX[3];
+        std::int64_t       stepY[3];
+        std::int64_t       slack[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            stepX[i] = triangle.a[i] * kSubpixelScale;
+            stepY[i] = triangle.b[i] * kSubpixelScale;
+            slack[i] = (std::abs(triangle.a[i]) + std::abs(triangle.b[i])) * (kSubpixelScale / 2);
+            row[i]   = triangle.a[i] * PixelCenter(rect.left) + triangle.b[i] * PixelCenter(rect.top) + triangle.c[i];
+        }
+
+        for (std::int32_t y = rect.top; y < rect.bottom; ++y)
+        {
+            std::int32_t* out = owners + static_cast<std::size_t>(y - area.top) * stride + (rect.left - area.left);
+            std::int64_t  e0  = row[0];
+            std::int64_t  e1  = row[1];
+            std::int64_t  e2  = row[2];
+            for (std::int32_t x = rect.left; x < rect.right; ++x, ++out)
+            {
+                if ((e0 | e1 | e2) >= 0)
+                {
+                    *out = inside;
+                }
+                else if (e0 >= -slack[0] && e1 >= -slack[1] && e2 >= -slack[2] && (*out < 0 || (*out & 1) == 0))
+                {
+                    *out = grazed;
+                }
+                e0 += stepX[0];
+                e1 += stepX[1];
+                e2 += stepX[2];
+            }
+            row[0] += stepY[0];
+            row[1] += stepY[1];
+            row[2] += stepY[2];
+        }
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "cpu_math.hpp"
+
+namespace rive_renderer_cpu
+{
+    // One image mesh triangle in device space, set up for half-space rasterization. Edge functions are exact integers
+    // in 24.8 fixed point, so stepping them across a tile never drifts and a pixel's result does not depend on which
+    // tile evaluates it.
+    struct MeshTriangle
+    {
+        // E[i](x, y) = a[i] * x + b[i] * y + c[i] in subpixel units; all three are >= 0 inside the triangle.
+        std::int64_t a[3];
+        std::int64_t b[3];
+        std::int64_t c[3];
+
+        // Pixels touched by the triangle.
+        IRect bounds;
+
+        // Maps device positions to texel coordinates. UVs are affine over a triangle, so one matrix covers all of it.
+        Mat2D deviceToImage;
+    };
+
+    // Sets up the triangle with device-space corners points and texel-space corners texels. Both arrays are reordered
+    // in place so the corners wind the same way for every triangle. Returns false for triangles that cover no area or
+    // have non-finite coordinates. Corners are clamped to +/-2^20 pixels so the edge functions fit in 64 bits.
+    bool SetupMeshTriangle(Vec2 points[3], Vec2 texels[3], MeshTriangle* out);
+
+    // Owner value for pixels no triangle touches.
+    constexpr std::int32_t kNoMeshOwner = -1;
+
+    // Index of the triangle an owner value refers to, or kNoMeshOwner.
+    inline std::int32_t MeshOwnerTriangle(std::int32_t owner)
+    {
+        return owner < 0 ? kNoMeshOwner : owner >> 1;
+    }
+
+    // Records which triangle supplies the color of each pixel of area that the triangle touches. owners has one entry
+    // per pixel of area, stride entries per row. Rasterizing triangles in draw order leaves every pixel whose center
+    // lies inside the mesh with the last triangle containing that center; pixels only grazed by edges along the mesh
+    // border fall back to the last triangle touching them.
+    void RasterizeMeshTriangle(const MeshTriangle& triangle, std::int32_t index, const IRect& area,
+                               std::int32_t* owners, std::size_t stride);
+} // namespace rive_renderer_cpu
@@ -0,0 +1,521 @@
+#include "cpu_path.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr float kPi                = 3.14159265358979323846f;
+        constexpr int   kMaxCurveSegments  = 1024;
+        constexpr float kDegenerateEpsilon = 1e-6f;
+
+        int CurveSegmentCount(float secondDifference, float factor, float tolerance)
+        {
+            // Wang's formula: the number of uniform segments that keeps a polynomial curve within the tolerance.
+            const float n = std::ceil(std::sqrt(factor * secondDifference / tolerance));
+            if (!(n >= 1.0f))
+            {
+                return 1;
+            }
+            return static_cast<int>(std::min(n, static_cast<float>(kMaxCurveSegments)));
+        }
+
+        void FlattenQuad(Vec2 p0, Vec2 p1, Vec2 p2, float tolerance, std::vector<Vec2>* out)
+        {
+            const int   count = CurveSegmentCount(Length(p0 - p1 * 2.0f + p2), 0.25f, tolerance);
+            const float step  = 1.0f / static_cast<float>(count);
+            for (int i = 1; i < count; ++i)
+            {
+                const float t  = step * static_cast<float>(i);
+                const float mt = 1.0f - t;
+                out->push_back(p0 * (mt * mt) + p1 * (2.0f * mt * t) + p2 * (t * t));
+            }
+            out->push_back(p2);
+        }
+
+        void FlattenCubic(Vec2 p0, Vec2 p1, Vec2 p2, Vec2 p3, float tolerance, std::vector<Vec2>* out)
+        {
+            const float d0    = Length(p0 - p1 * 2.0f + p2);
+            const float d1    = Length(p1 - p2 * 2.0f + p3);
+            const int   count = CurveSegmentCount(std::max(d0, d1), 0.75f, tolerance);
+            const float step  = 1.0f / static_cast<float>(count);
+            for (int i = 1; i < count; ++i)
+            {
+                const float t  = step * static_cast<float>(i);
+                const float mt = 1.0f - t;
+                out->push_back(p0 * (mt * mt * mt) + p1 * (3.0f * mt * mt * t) + p2 * (3.0f * mt * t * t) +
+                               p3 * (t * t * t));
+            }
+            out->push_back(p3);
+        }
+
+        float SignedArea(const Vec2* points, std::size_t count)
+        {
+            float area = 0.0f;
+            for (std::size_t i = 0, j = count - 1; i < count; j = i++)
+            {
+                area += Cross(points[j], points[i]);
+            }
+            return area * 0.5f;
+        }
+
+        // Appends a closed polygon, flipping it when needed so every piece of a stroke outline winds the same way.
+        void AddPolygon(Polyline* out, std::vector<Vec2>& points)
+        {
+            if (points.size() < 3)
+            {
+                return;
+            }
+            const float area = SignedArea(points.data(), points.size());
+            if (std::fabs(area) <= kDegenerateEpsilon)
+            {
+                return;
+            }
+            if (area > 0.0f)
+            {
+                std::reverse(points.begin(), points.end());
+            }
+            Contour contour;
+            contour.begin = static_cast<std::uint32_t>(out->points.size());
+            out->points.insert(out->points.end(), points.begin(), points.end());
+            contour.end    = static_cast<std::uint32_t>(out->points.size());
+            contour.closed = true;
+            out->contours.push_back(contour);
+        }
+
+        // Appends points along an arc around center, starting at center + from and sweeping by the signed angle.
+        void AppendArc(Vec2 center, Vec2 from, float sweep, float tolerance, std::vector<Vec2>* out)
+        {
+            const float radius = Length(from);
+            float       step   = kPi * 0.5f;
+            if (radius > tolerance)
+            {
+                step = 2.0f * std::acos(std::max(-1.0f, 1.0f - tolerance / radius));
+            }
+            const int   count = std::max(1, static_cast<int>(std::ceil(std::fabs(sweep) / std::max(step, 1e-3f))));
+            const float delta = sweep / static_cast<float>(count);
+            for (int i = 0; i <= count; ++i)
+            {
+                const float angle = delta * static_cast<float>(i);
+                const float c     = std::cos(angle);
+                const float s     = std::sin(angle);
+                out->push_back(center + Vec2 {from.x * c - from.y * s, from.x * s + from.y * c});
+            }
+        }
+
+        Vec2 Normal(Vec2 direction)
+        {
+            return {-direction.y, direction.x};
+        }
+
+        class Stroker
+        {
+        public:
+            Stroker(const StrokeStyle& style, float tolerance, Polyline* out) :
+                halfWidth(style.thickness * 0.5f), join(style.join), cap(style.cap), tolerance(tolerance), out(out)
+            {
+            }
+
+            void strokeContour(const Vec2* points, std::size_t count, bool closed)
+            {
+                if (count == 1)
+                {
+                    strokePoint(points[0]);
+                    return;
+                }
+
+                const std::size_t segmentCount = closed ? count : count - 1;
+                for (std::size_t i = 0; i < segmentCount; ++i)
+                {
+                    strokeSegment(points[i], points[(i + 1) % count]);
+                }
+
+                if (closed)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const Vec2 previous = points[(i + count - 1) % count];
+                        const Vec2 next     = points[(i + 1) % count];
+                        addJoin(points[i], Direction(previous, points[i]), Direction(points[i], next));
+                    }
+                    return;
+                }
+
+                for (std::size_t i = 1; i + 1 < count; ++i)
+                {
+                    addJoin(points[i], Direction(points[i - 1], points[i]), Direction(points[i], points[i + 1]));
+                }
+                addCap(points[0], Direction(points[1], points[0]));
+                addCap(points[count - 1], Direction(points[count - 2], points[count - 1]));
+            }
+
+        private:
+            static Vec2 Direction(Vec2 from, Vec2 to)
+            {
+                const Vec2  delta  = to - from;
+                const float length = Length(delta);
+                return length > 0.0f ? delta * (1.0f / length) : Vec2 {1.0f, 0.0f};
+            }
+
+            void strokeSegment(Vec2 from, Vec2 to)
+            {
+                const Vec2 normal = Normal(Direction(from, to)) * halfWidth;
+                scratch.assign({from + normal, to + normal, to - normal, from - normal});
+                AddPolygon(out, scratch);
+            }
+
+            void strokePoint(Vec2 point)
+            {
+                scratch.clear();
+                if (cap == StrokeCap::round)
+                {
+                    AppendArc(point, {halfWidth, 0.0f}, 2.0f * kPi, tolerance, &scratch);
+                    scratch.pop_back();
+                }
+                else if (cap == StrokeCap::square)
+                {
+                    scratch.assign({point + Vec2 {-halfWidth, -halfWidth}, point + Vec2 {halfWidth, -halfWidth},
+                                    point + Vec2 {halfWidth, halfWidth}, point + Vec2 {-halfWidth, halfWidth}});
+                }
+                AddPolygon(out, scratch);
+            }
+
+            void addCap(Vec2 point, Vec2 outward)
+            {
+                const Vec2 normal = Normal(outward) * halfWidth;
+                scratch.clear();
+                if (cap == StrokeCap::round)
+                {
+                    const float sweep = Cross(normal, outward) < 0.0f ? -kPi : kPi;
+                    AppendArc(point, normal, sweep, tolerance, &scratch);
+                }
+                else if (cap == StrokeCap::square)
+                {
+                    const Vec2 extent = outward * halfWidth;
+                    scratch.assign({point + normal, point + normal + extent, point - normal + extent, point - normal});
+                }
+                AddPolygon(out, scratch);
+            }
+
+            void addJoin(Vec2 pivot, Vec2 incoming, Vec2 outgoing)
+            {
+                const float cross = Cross(incoming, outgoing);
+                const float dot   = Dot(incoming, outgoing);
+                if (std::fabs(cross) <= kDegenerateEpsilon && dot > 0.0f)
+                {
+                    return;
+                }
+
+                // The outer side of the turn is opposite to the direction the path bends towards.
+                Vec2 outer0 = Normal(incoming);
+                Vec2 outer1 = Normal(outgoing);
+                if (cross > 0.0f)
+                {
+                    outer0 = outer0 * -1.0f;
+                    outer1 = outer1 * -1.0f;
+                }
+                const Vec2 a = pivot + outer0 * halfWidth;
+                const Vec2 b = pivot + outer1 * halfWidth;
+
+                scratch.clear();
+                switch (join)
+                {
+                case StrokeJoin::round:
+                {
+                    scratch.push_back(pivot);
+                    const float sweep = std::atan2(Cross(outer0, outer1), Dot(outer0, outer1));
+                    AppendArc(pivot, outer0 * halfWidth, sweep, tolerance, &scratch);
+                    break;
+                }
+                case StrokeJoin::miter:
+                {
+                    const Vec2  bisector = outer0 + outer1;
+                    const float length   = Length(bisector);
+                    if (length > kDegenerateEpsilon)
+                    {
+                        const Vec2  unit    = bisector * (1.0f / length);
+                        const float cosHalf = Dot(unit, outer0);
+                        if (cosHalf > 0.0f && 1.0f / cosHalf <= kMiterLimit)
+                        {
+                            scratch.assign({pivot, a, pivot + unit * (halfWidth / cosHalf), b});
+                            break;
+                        }
+                    }
+                    scratch.assign({pivot, a, b});
+                    break;
+                }
+                case StrokeJoin::bevel:
+                    scratch.assign({pivot, a, b});
+                    break;
+                }
+                AddPolygon(out, scratch);
+            }
+
+            float             halfWidth;
+            StrokeJoin        join;
+            StrokeCap         cap;
+            float             tolerance;
+            Polyline*         out;
+            std::vector<Vec2> scratch;
+        };
+    } // namespace
+
+    void PathData::addPath(const PathData& other, const Mat2D& transform)
+    {
+        verbs.insert(verbs.end(), other.verbs.begin(), other.verbs.end());
+        points.reserve(points.size() + other.points.size());
+        for (const Vec2& point : other.points)
+        {
+            points.push_back(transform.map(point));
+        }
+        touch();
+    }
+
+    void PathData::addPathReversed(const PathData& other, const Mat2D& transform)
+    {
+        std::vector<std::size_t> offsets(other.verbs.size() + 1, 0);
+        for (std::size_t i = 0; i < other.verbs.size(); ++i)
+        {
+            offsets[i + 1] = offsets[i] + PointCount(other.verbs[i]);
+        }
+        if (offsets.back() > other.points.size())
+        {
+            return;
+        }
+
+        std::size_t contourBegin = 0;
+        while (contourBegin < other.verbs.size())
+        {
+            std::size_t contourEnd = contourBegin + 1;
+            while (contourEnd < other.verbs.size() && other.verbs[contourEnd] != PathVerb::move)
+            {
+                ++contourEnd;
+            }
+            if (other.verbs[contourBegin] != PathVerb::move || offsets[contourEnd] == offsets[contourBegin])
+            {
+                contourBegin = contourEnd;
+                continue;
+            }
+
+            bool       closed = false;
+            const Vec2 last   = transform.map(other.points[offsets[contourEnd] - 1]);
+            moveTo(last.x, last.y);
+            for (std::size_t i = contourEnd; i-- > contourBegin + 1;)
+            {
+                const PathVerb    verb  = other.verbs[i];
+                const std::size_t first = offsets[i];
+                if (verb == PathVerb::close)
+                {
+                    closed = true;
+                    continue;
+                }
+                // Each segment ends where it started in the forward direction; control points swap order.
+                const Vec2 start = transform.map(other.points[first - 1]);
+                switch (verb)
+                {
+                case PathVerb::line:
+                    lineTo(start.x, start.y);
+                    break;
+                case PathVerb::quad:
+                {
+                    const Vec2 c = transform.map(other.points[first]);
+                    quadTo(c.x, c.y, start.x, start.y);
+                    break;
+                }
+                case PathVerb::cubic:
+                {
+                    const Vec2 c0 = transform.map(other.points[first + 1]);
+                    const Vec2 c1 = transform.map(other.points[first]);
+                    cubicTo(c0.x, c0.y, c1.x, c1.y, start.x, start.y);
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            if (closed)
+            {
+                close();
+            }
+            contourBegin = contourEnd;
+        }
+    }
+
+    Rect Polyline::bounds() const
+    {
+        Rect result;
+        for (const Vec2& point : points)
+        {
+            result.add(point);
+        }
+        return result;
+    }
+
+    void Polyline::transform(const Mat2D& matrix)
+    {
+        if (matrix.isIdentity())
+        {
+            return;
+        }
+        for (Vec2& point : points)
+        {
+            point = matrix.map(point);
+        }
+    }
+
+    void Polyline::append(const Polyline& other)
+    {
+        const std::uint32_t offset = static_cast<std::uint32_t>(points.size());
+        points.insert(points.end(), other.points.begin(), other.points.end());
+        for (Contour contour : other.contours)
+        {
+            contour.begin += offset;
+            contour.end += offset;
+            contours.push_back(contour);
+        }
+    }
+
+    void FlattenPath(const PathData& path, const Mat2D& transform, float tolerance, Polyline* out)
+    {
+        const std::vector<Vec2>& src = path.points;
+        std::size_t              pointIndex = 0;
+        Vec2                     current {0.0f, 0.0f};
+        Vec2                     start {0.0f, 0.0f};
+        bool                     open       = false;
+        bool                     hasSegment = false;
+        Contour                  contour;
+
+        auto finish = [&](bool closed)
+        {
+            if (open && hasSegment)
+            {
+                contour.end    = static_cast<std::uint32_t>(out->points.size());
+                contour.closed = closed;
+                out->contours.push_back(contour);
+            }
+            else if (open)
+            {
+                out->points.resize(contour.begin);
+            }
+            open       = false;
+            hasSegment = false;
+        };
+
+        auto begin = [&](Vec2 point)
+        {
+            contour.begin = static_cast<std::uint32_t>(out->points.size());
+            out->points.push_back(point);
+            open = true;
+        };
+
+        for (PathVerb verb : path.verbs)
+        {
+            const std::size_t needed = PointCount(verb);
+            if (pointIndex + needed > src.size())
+            {
+                break;
+            }
+            if (verb != PathVerb::move && verb != PathVerb::close && !open)
+            {
+                begin(start);
+            }
+            switch (verb)
+            {
+            case PathVerb::move:
+                finish(false);
+                current = start = transform.map(src[pointIndex]);
+                begin(current);
+                break;
+            case PathVerb::line:
+                current = transform.map(src[pointIndex]);
+                out->points.push_back(current);
+                hasSegment = true;
+                break;
+            case PathVerb::quad:
+            {
+                const Vec2 p1 = transform.map(src[pointIndex]);
+                const Vec2 p2 = transform.map(src[pointIndex + 1]);
+                FlattenQuad(current, p1, p2, tolerance, &out->points);
+                current    = p2;
+                hasSegment = true;
+                break;
+            }
+            case PathVerb::cubic:
+            {
+                const Vec2 p1 = transform.map(src[pointIndex]);
+                const Vec2 p2 = transform.map(src[pointIndex + 1]);
+                const Vec2 p3 = transform.map(src[pointIndex + 2]);
+                FlattenCubic(current, p1, p2, p3, tolerance, &out->points);
+                current    = p3;
+                hasSegment = true;
+                break;
+            }
+            case PathVerb::close:
+                if (open)
+                {
+                    hasSegment = true;
+                }
+                finish(true);
+                current = start;
+                break;
+            }
+            pointIndex += needed;
+        }
+        finish(false);
+    }
+
+    void StrokePolyline(const Polyline& centerline, const StrokeStyle& style, float tolerance, Polyline* out)
+    {
+        if (!(style.thickness > 0.0f))
+        {
+            return;
+        }
+
+        Stroker           stroker(style, tolerance, out);
+        std::vector<Vec2> unique;
+        for (const Contour& contour : centerline.contours)
+        {
+            unique.clear();
+            for (std::uint32_t i = contour.begin; i < contour.end; ++i)
+            {
+                const Vec2 point = centerline.points[i];
+                if (unique.empty() || Length(point - unique.back()) > kDegenerateEpsilon)
+                {
+                    unique.push_back(point);
+                }
+            }
+            const bool closed = contour.closed;
+            if (closed && unique.size() > 1 && Length(unique.back() - unique.front()) <= kDegenerateEpsilon)
+            {
+                unique.pop_back();
+            }
+            if (unique.empty())
+            {
+                continue;
+            }
+            stroker.strokeContour(unique.data(), unique.size(), closed);
+        }
+    }
+
+    void StrokeCache::stroke(const PathData& path, const StrokeStyle& strokeStyle, float strokeTolerance, Polyline* out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const bool hit = valid && generation == path.generation && style.thickness == strokeStyle.thickness &&
+                         style.join == strokeStyle.join && style.cap == strokeStyle.cap &&
+                         tolerance == strokeTolerance;
+        if (!hit)
+        {
+            Polyline centerline;
+            FlattenPath(path, Mat2D {}, strokeTolerance, &centerline);
+            outline.clear();
+            StrokePolyline(centerline, strokeStyle, strokeTolerance, &outline);
+            valid      = true;
+            generation = path.generation;
+            style      = strokeStyle;
+            tolerance  = strokeTolerance;
+        }
+        *out = outline;
+    }
+} // namespace rive_renderer_cpu
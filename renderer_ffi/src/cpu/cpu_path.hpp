@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "cpu_math.hpp"
+
+namespace rive_renderer_cpu
+{
+    // Verb values match rive::PathVerb so raw verb streams can be copied across without translation.
+    enum class PathVerb : std::uint8_t
+    {
+        move  = 0,
+        line  = 1,
+        quad  = 2,
+        cubic = 4,
+        close = 5,
+    };
+
+    // Mutable path geometry in the caller's local coordinate space. generation changes with every geometry edit made
+    // through the member functions; code that modifies verbs or points directly must call touch().
+    struct PathData
+    {
+        std::vector<PathVerb> verbs;
+        std::vector<Vec2>     points;
+        FillRule              fillRule {FillRule::nonZero};
+        std::uint64_t         generation {0};
+
+        void touch()
+        {
+            ++generation;
+        }
+
+        void rewind()
+        {
+            verbs.clear();
+            points.clear();
+            touch();
+        }
+
+        void moveTo(float x, float y)
+        {
+            verbs.push_back(PathVerb::move);
+            points.push_back({x, y});
+            touch();
+        }
+
+        void lineTo(float x, float y)
+        {
+            verbs.push_back(PathVerb::line);
+            points.push_back({x, y});
+            touch();
+        }
+
+        void quadTo(float cx, float cy, float x, float y)
+        {
+            verbs.push_back(PathVerb::quad);
+            points.push_back({cx, cy});
+            points.push_back({x, y});
+            touch();
+        }
+
+        void cubicTo(float c0x, float c0y, float c1x, float c1y, float x, float y)
+        {
+            verbs.push_back(PathVerb::cubic);
+            points.push_back({c0x, c0y});
+            points.push_back({c1x, c1y});
+            points.push_back({x, y});
+            touch();
+        }
+
+        void close()
+        {
+            verbs.push_back(PathVerb::close);
+            touch();
+        }
+
+        // Appends another path with every point mapped through the given matrix.
+        void addPath(const PathData& other, const Mat2D& transform);
+
+        // Same as addPath, but every contour is appended in reverse direction.
+        void addPathReversed(const PathData& other, const Mat2D& transform);
+    };
+
+    // Returns how many points a verb consumes from the point stream.
+    inline std::size_t PointCount(PathVerb verb)
+    {
+        switch (verb)
+        {
+        case PathVerb::move:
+        case PathVerb::line:
+            return 1;
+        case PathVerb::quad:
+            return 2;
+        case PathVerb::cubic:
+            return 3;
+        case PathVerb::close:
+            return 0;
+        }
+        return 0;
+    }
+
+    struct Contour
+    {
+        std::uint32_t begin {0};
+        std::uint32_t end {0};
+        bool          closed {false};
+    };
+
+    // Flattened line geometry. Each contour covers points [begin, end); filling treats every contour as closed.
+    struct Polyline
+    {
+        std::vector<Vec2>    points;
+        std::vector<Contour> contours;
+
+        void clear()
+        {
+            points.clear();
+            contours.clear();
+        }
+
+        bool empty() const
+        {
+            return contours.empty();
+        }
+
+        Rect bounds() const;
+
+        void transform(const Mat2D& matrix);
+
+        void append(const Polyline& other);
+    };
+
+    struct StrokeStyle
+    {
+        float      thickness {1.0f};
+        StrokeJoin join {StrokeJoin::miter};
+        StrokeCap  cap {StrokeCap::butt};
+    };
+
+    constexpr float kDefaultTolerance = 0.25f;
+    constexpr float kMiterLimit       = 4.0f;
+
+    // Flattens curves into line segments. Points are mapped through the matrix first so the tolerance is measured in
+    // the destination space.
+    void FlattenPath(const PathData& path, const Mat2D& transform, float tolerance, Polyline* out);
+
+    // Expands a flattened centerline into fillable outline geometry. Every emitted polygon shares one orientation, so
+    // the outline must be filled with the non-zero rule.
+    void StrokePolyline(const Polyline& centerline, const StrokeStyle& style, float tolerance, Polyline* out);
+
+    // Remembers the stroke outline of one path so unchanged strokes are not expanded again on every draw. The outline
+    // is kept in the path's local space and keyed by the path generation, the stroke style and the flattening
+    // tolerance. Safe to use from several threads.
+    class StrokeCache
+    {
+    public:
+        // Replaces out with the outline of path flattened at tolerance and stroked with style.
+        void stroke(const PathData& path, const StrokeStyle& style, float tolerance, Polyline* out);
+
+    private:
+        std::mutex    mutex;
+        bool          valid {false};
+        std::uint64_t generation {0};
+        StrokeStyle   style;
+        float         tolerance {0.0f};
+        Polyline      outline;
+    };
+} // namespace rive_renderer_cpu
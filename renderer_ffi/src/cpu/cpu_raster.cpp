@@ -0,0 +1,521 @@
+#include "cpu_raster.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        constexpr std::int32_t kSubpixelShift = 8;
+        constexpr std::int32_t kSubpixelScale = 1 << kSubpixelShift;
+        constexpr std::int32_t kSubpixelMask  = kSubpixelScale - 1;
+        constexpr std::int32_t kDxLimit       = 16384 << kSubpixelShift;
+
+        std::int32_t ToFixed(float value)
+        {
+            return static_cast<std::int32_t>(std::floor(value * static_cast<float>(kSubpixelScale) + 0.5f));
+        }
+
+        // Converts accumulated signed area (in units of 2 * subpixel^2) to an 8-bit coverage for the fill rule.
+        std::uint8_t CoverageToAlpha(std::int32_t area, FillRule fillRule)
+        {
+            std::int32_t cover = area >> (kSubpixelShift * 2 + 1 - 8);
+            if (fillRule == FillRule::clockwise)
+            {
+                // Clockwise contours in y-down device space accumulate negative area.
+                cover = -cover;
+                if (cover < 0)
+                {
+                    return 0;
+                }
+            }
+            else if (cover < 0)
+            {
+                cover = -cover;
+            }
+            if (fillRule == FillRule::evenOdd)
+            {
+                cover &= 511;
+                if (cover > 256)
+                {
+                    cover = 512 - cover;
+                }
+            }
+            return static_cast<std::uint8_t>(std::min<std::int32_t>(cover, 255));
+        }
+
+        void EmitStripPixel(CoverageMask* out, std::int32_t x, std::int32_t y, std::uint8_t alpha)
+        {
+            if (!out->spans.empty())
+            {
+                CoverageSpan& last = out->spans.back();
+                if (last.alphaOffset >= 0 && last.y == y && last.x + last.length == x)
+                {
+                    out->alphas.push_back(alpha);
+                    ++last.length;
+                    return;
+                }
+            }
+            CoverageSpan span;
+            span.x           = x;
+            span.y           = y;
+            span.length      = 1;
+            span.alphaOffset = static_cast<std::int32_t>(out->alphas.size());
+            out->alphas.push_back(alpha);
+            out->spans.push_back(span);
+        }
+
+        void EmitFill(CoverageMask* out, std::int32_t x, std::int32_t y, std::int32_t length, std::uint8_t alpha)
+        {
+            CoverageSpan span;
+            span.x      = x;
+            span.y      = y;
+            span.length = length;
+            span.alpha  = alpha;
+            out->spans.push_back(span);
+        }
+    } // namespace
+
+    void Rasterizer::reset(const IRect& clipRect)
+    {
+        clip       = clipRect;
+        hasCurrent = false;
+        cells.clear();
+    }
+
+    void Rasterizer::addPolyline(const Polyline& polyline)
+    {
+        for (const Contour& contour : polyline.contours)
+        {
+            if (contour.end - contour.begin < 2)
+            {
+                continue;
+            }
+            Vec2 previous = polyline.points[contour.end - 1];
+            for (std::uint32_t i = contour.begin; i < contour.end; ++i)
+            {
+                addLine(previous, polyline.points[i]);
+                previous = polyline.points[i];
+            }
+        }
+    }
+
+    void Rasterizer::addLine(Vec2 from, Vec2 to)
+    {
+        if (clip.empty() || from.y == to.y)
+        {
+            return;
+        }
+        if (!std::isfinite(from.x) || !std::isfinite(from.y) || !std::isfinite(to.x) || !std::isfinite(to.y))
+        {
+            return;
+        }
+
+        const float top    = static_cast<float>(clip.top);
+        const float bottom = static_cast<float>(clip.bottom);
+        if ((from.y <= top && to.y <= top) || (from.y >= bottom && to.y >= bottom))
+        {
+            return;
+        }
+
+        // Clip against the top and bottom rows; geometry outside them never contributes coverage.
+        const float dx = to.x - from.x;
+        const float dy = to.y - from.y;
+        float       t0 = 0.0f;
+        float       t1 = 1.0f;
+        const float tTop    = (top - from.y) / dy;
+        const float tBottom = (bottom - from.y) / dy;
+        t0                  = std::max(t0, std::min(tTop, tBottom));
+        t1                  = std::min(t1, std::max(tTop, tBottom));
+        if (t0 >= t1)
+        {
+            return;
+        }
+        float x0 = t0 > 0.0f ? from.x + dx * t0 : from.x;
+        float y0 = t0 > 0.0f ? from.y + dy * t0 : from.y;
+        float x1 = t1 < 1.0f ? from.x + dx * t1 : to.x;
+        float y1 = t1 < 1.0f ? from.y + dy * t1 : to.y;
+        y0       = std::min(std::max(y0, top), bottom);
+        y1       = std::min(std::max(y1, top), bottom);
+
+        // Split at the left and right edges. Pieces left of the clip collapse onto it so they keep their winding,
+        // pieces right of it only affect pixels that are never swept.
+        const float left  = static_cast<float>(clip.left);
+        const float right = static_cast<float>(clip.right);
+        float       splits[4];
+        int         splitCount = 0;
+        splits[splitCount++]   = 0.0f;
+        if (x0 != x1)
+        {
+            const float tl = (left - x0) / (x1 - x0);
+            const float tr = (right - x0) / (x1 - x0);
+            if (tl > 0.0f && tl < 1.0f)
+            {
+                splits[splitCount++] = tl;
+            }
+            if (tr > 0.0f && tr < 1.0f)
+            {
+                splits[splitCount++] = tr;
+            }
+            if (splitCount == 3 && splits[1] > splits[2])
+            {
+                std::swap(splits[1], splits[2]);
+            }
+        }
+        splits[splitCount++] = 1.0f;
+
+        float px = x0;
+        float py = y0;
+        for (int i = 1; i < splitCount; ++i)
+        {
+            const float t  = splits[i];
+            const float nx = i + 1 == splitCount ? x1 : x0 + (x1 - x0) * t;
+            const float ny = i + 1 == splitCount ? y1 : y0 + (y1 - y0) * t;
+            addClippedLine(px, py, nx, ny);
+            px = nx;
+            py = ny;
+        }
+    }
+
+    void Rasterizer::addClippedLine(float x0, float y0, float x1, float y1)
+    {
+        const float left  = static_cast<float>(clip.left);
+        const float right = static_cast<float>(clip.right);
+        const float mid   = (x0 + x1) * 0.5f;
+        if (mid >= right)
+        {
+            return;
+        }
+        if (mid <= left)
+        {
+            x0 = x1 = left;
+        }
+        else
+        {
+            x0 = std::min(std::max(x0, left), right);
+            x1 = std::min(std::max(x1, left), right);
+        }
+        line(ToFixed(x0), ToFixed(y0), ToFixed(x1), ToFixed(y1));
+    }
+
+    void Rasterizer::flushCell()
+    {
+        if (hasCurrent && (current.cover | current.area) != 0)
+        {
+            cells.push_back(current);
+        }
+    }
+
+    void Rasterizer::setCell(std::int32_t x, std::int32_t y)
+    {
+        if (!hasCurrent || current.x != x || current.y != y)
+        {
+            flushCell();
+            current    = {x, y, 0, 0};
+            hasCurrent = true;
+        }
+    }
+
+    void Rasterizer::renderHline(std::int32_t ey, std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2)
+    {
+        std::int32_t       ex1 = x1 >> kSubpixelShift;
+        const std::int32_t ex2 = x2 >> kSubpixelShift;
+        const std::int32_t fx1 = x1 & kSubpixelMask;
+        const std::int32_t fx2 = x2 & kSubpixelMask;
+
+        if (y1 == y2)
+        {
+            setCell(ex2, ey);
+            return;
+        }
+
+        if (ex1 == ex2)
+        {
+            const std::int32_t delta = y2 - y1;
+            current.cover += delta;
+            current.area += (fx1 + fx2) * delta;
+            return;
+        }
+
+        std::int64_t p     = static_cast<std::int64_t>(kSubpixelScale - fx1) * (y2 - y1);
+        std::int32_t first = kSubpixelScale;
+        std::int32_t incr  = 1;
+        std::int32_t dx    = x2 - x1;
+        if (dx < 0)
+        {
+            p     = static_cast<std::int64_t>(fx1) * (y2 - y1);
+            first = 0;
+            incr  = -1;
+            dx    = -dx;
+        }
+
+        std::int32_t delta = static_cast<std::int32_t>(p / dx);
+        std::int32_t mod   = static_cast<std::int32_t>(p % dx);
+        if (mod < 0)
+        {
+            --delta;
+            mod += dx;
+        }
+
+        current.cover += delta;
+        current.area += (fx1 + first) * delta;
+        ex1 += incr;
+        setCell(ex1, ey);
+        y1 += delta;
+
+        if (ex1 != ex2)
+        {
+            p                 = static_cast<std::int64_t>(kSubpixelScale) * (y2 - y1 + delta);
+            std::int32_t lift = static_cast<std::int32_t>(p / dx);
+            std::int32_t rem  = static_cast<std::int32_t>(p % dx);
+            if (rem < 0)
+            {
+                --lift;
+                rem += dx;
+            }
+            mod -= dx;
+
+            while (ex1 != ex2)
+            {
+                delta = lift;
+                mod += rem;
+                if (mod >= 0)
+                {
+                    mod -= dx;
+                    ++delta;
+                }
+                current.cover += delta;
+                current.area += kSubpixelScale * delta;
+                y1 += delta;
+                ex1 += incr;
+                setCell(ex1, ey);
+            }
+        }
+
+        delta = y2 - y1;
+        current.cover += delta;
+        current.area += (fx2 + kSubpixelScale - first) * delta;
+    }
+
+    void Rasterizer::line(std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2)
+    {
+        const std::int32_t dx = x2 - x1;
+        if (dx >= kDxLimit || dx <= -kDxLimit)
+        {
+            const std::int32_t cx = (x1 + x2) >> 1;
+            const std::int32_t cy = (y1 + y2) >> 1;
+            line(x1, y1, cx, cy);
+            line(cx, cy, x2, y2);
+            return;
+        }
+
+        std::int32_t       dy  = y2 - y1;
+        const std::int32_t ex1 = x1 >> kSubpixelShift;
+        std::int32_t       ey1 = y1 >> kSubpixelShift;
+        const std::int32_t ey2 = y2 >> kSubpixelShift;
+        const std::int32_t fy1 = y1 & kSubpixelMask;
+        const std::int32_t fy2 = y2 & kSubpixelMask;
+
+        setCell(ex1, ey1);
+
+        if (ey1 == ey2)
+        {
+            renderHline(ey1, x1, fy1, x2, fy2);
+            return;
+        }
+
+        std::int32_t incr = 1;
+        if (dx == 0)
+        {
+            // Vertical lines touch exactly one cell per row.
+            const std::int32_t twoFx = (x1 - (ex1 << kSubpixelShift)) << 1;
+            std::int32_t       first = kSubpixelScale;
+            if (dy < 0)
+            {
+                first = 0;
+                incr  = -1;
+            }
+
+            std::int32_t delta = first - fy1;
+            current.cover += delta;
+            current.area += twoFx * delta;
+            ey1 += incr;
+            setCell(ex1, ey1);
+
+            delta                   = first + first - kSubpixelScale;
+            const std::int32_t area = twoFx * delta;
+            while (ey1 != ey2)
+            {
+                current.cover = delta;
+                current.area  = area;
+                ey1 += incr;
+                setCell(ex1, ey1);
+            }
+            delta = fy2 - kSubpixelScale + first;
+            current.cover += delta;
+            current.area += twoFx * delta;
+            return;
+        }
+
+        std::int64_t p     = static_cast<std::int64_t>(kSubpixelScale - fy1) * dx;
+        std::int32_t first = kSubpixelScale;
+        if (dy < 0)
+        {
+            p     = static_cast<std::int64_t>(fy1) * dx;
+            first = 0;
+            incr  = -1;
+            dy    = -dy;
+        }
+
+        std::int32_t delta = static_cast<std::int32_t>(p / dy);
+        std::int32_t mod   = static_cast<std::int32_t>(p % dy);
+        if (mod < 0)
+        {
+            --delta;
+            mod += dy;
+        }
+
+        std::int32_t xFrom = x1 + delta;
+        renderHline(ey1, x1, fy1, xFrom, first);
+        ey1 += incr;
+        setCell(xFrom >> kSubpixelShift, ey1);
+
+        if (ey1 != ey2)
+        {
+            p                 = static_cast<std::int64_t>(kSubpixelScale) * dx;
+            std::int32_t lift = static_cast<std::int32_t>(p / dy);
+            std::int32_t rem  = static_cast<std::int32_t>(p % dy);
+            if (rem < 0)
+            {
+                --lift;
+                rem += dy;
+            }
+            mod -= dy;
+
+            while (ey1 != ey2)
+            {
+                delta = lift;
+                mod += rem;
+                if (mod >= 0)
+                {
+                    mod -= dy;
+                    ++delta;
+                }
+                const std::int32_t xTo = xFrom + delta;
+                renderHline(ey1, xFrom, kSubpixelScale - first, xTo, first);
+                xFrom = xTo;
+                ey1 += incr;
+                setCell(xFrom >> kSubpixelShift, ey1);
+            }
+        }
+        renderHline(ey1, xFrom, kSubpixelScale - first, x2, fy2);
+    }
+
+    void Rasterizer::rasterize(FillRule fillRule, CoverageMask* out)
+    {
+        flushCell();
+        hasCurrent = false;
+        out->clear();
+        if (cells.empty() || clip.empty())
+        {
+            cells.clear();
+            return;
+        }
+
+        // Bucket cells by row, then order each row by x.
+        const std::int32_t rows = clip.height();
+        rowCounts.assign(static_cast<std::size_t>(rows) + 1, 0);
+        for (const Cell& cell : cells)
+        {
+            if (cell.y >= clip.top && cell.y < clip.bottom)
+            {
+                ++rowCounts[cell.y - clip.top + 1];
+            }
+        }
+        for (std::int32_t row = 0; row < rows; ++row)
+        {
+            rowCounts[row + 1] += rowCounts[row];
+        }
+        sorted.resize(rowCounts[rows]);
+        {
+            std::vector<int> cursor(rowCounts.begin(), rowCounts.end() - 1);
+            for (const Cell& cell : cells)
+            {
+                if (cell.y >= clip.top && cell.y < clip.bottom)
+                {
+                    sorted[cursor[cell.y - clip.top]++] = cell;
+                }
+            }
+        }
+        cells.clear();
+
+        std::int32_t minX = clip.right;
+        std::int32_t maxX = clip.left;
+        std::int32_t minY = clip.bottom;
+        std::int32_t maxY = clip.top;
+
+        for (std::int32_t row = 0; row < rows; ++row)
+        {
+            const int begin = rowCounts[row];
+            const int end   = rowCounts[row + 1];
+            if (begin == end)
+            {
+                continue;
+            }
+            std::sort(sorted.begin() + begin, sorted.begin() + end,
+                      [](const Cell& a, const Cell& b) { return a.x < b.x; });
+
+            const std::int32_t y         = clip.top + row;
+            const std::size_t  spanStart = out->spans.size();
+            std::int32_t       cover     = 0;
+            int                i         = begin;
+            while (i < end)
+            {
+                std::int32_t x    = sorted[i].x;
+                std::int32_t area = 0;
+                while (i < end && sorted[i].x == x)
+                {
+                    area += sorted[i].area;
+                    cover += sorted[i].cover;
+                    ++i;
+                }
+                if (x >= clip.right)
+                {
+                    break;
+                }
+                if (area != 0)
+                {
+                    const std::uint8_t alpha = CoverageToAlpha((cover << (kSubpixelShift + 1)) - area, fillRule);
+                    if (alpha != 0)
+                    {
+                        EmitStripPixel(out, x, y, alpha);
+                    }
+                    ++x;
+                }
+                const std::int32_t nextX = i < end ? std::min(sorted[i].x, clip.right) : clip.right;
+                if (nextX > x)
+                {
+                    const std::uint8_t alpha = CoverageToAlpha(cover << (kSubpixelShift + 1), fillRule);
+                    if (alpha != 0)
+                    {
+                        EmitFill(out, x, y, nextX - x, alpha);
+                    }
+                }
+            }
+
+            if (out->spans.size() != spanStart)
+            {
+                minY = std::min(minY, y);
+                maxY = y + 1;
+                minX = std::min(minX, out->spans[spanStart].x);
+                maxX = std::max(maxX, out->spans.back().x + out->spans.back().length);
+            }
+        }
+
+        if (!out->spans.empty())
+        {
+            out->bounds = {minX, minY, maxX, maxY};
+        }
+    }
+} // namespace rive_renderer_cpu
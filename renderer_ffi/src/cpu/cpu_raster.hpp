@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "cpu_math.hpp"
+#include "cpu_path.hpp"
+
+namespace rive_renderer_cpu
+{
+    // One horizontal run of coverage. Runs with alphaOffset >= 0 are strips whose per-pixel coverage lives in
+    // CoverageMask::alphas; the remaining runs are solid fills with a single alpha value.
+    struct CoverageSpan
+    {
+        std::int32_t x {0};
+        std::int32_t y {0};
+        std::int32_t length {0};
+        std::int32_t alphaOffset {-1};
+        std::uint8_t alpha {0};
+    };
+
+    // Sparse coverage for one draw: spans sorted by row, then by x, never overlapping.
+    struct CoverageMask
+    {
+        IRect                     bounds;
+        std::vector<CoverageSpan> spans;
+        std::vector<std::uint8_t> alphas;
+
+        void clear()
+        {
+            bounds = IRect {};
+            spans.clear();
+            alphas.clear();
+        }
+
+        bool empty() const
+        {
+            return spans.empty();
+        }
+    };
+
+    // Analytic area-coverage scanline rasterizer in 24.8 fixed point. Edges accumulate signed cover/area cells that
+    // are swept once per row into sparse strips (pixels touched by an edge) and fills (interior runs between edges).
+    class Rasterizer
+    {
+    public:
+        void reset(const IRect& clip);
+
+        void addPolyline(const Polyline& polyline);
+
+        void addLine(Vec2 from, Vec2 to);
+
+        void rasterize(FillRule fillRule, CoverageMask* out);
+
+    private:
+        struct Cell
+        {
+            std::int32_t x;
+            std::int32_t y;
+            std::int32_t cover;
+            std::int32_t area;
+        };
+
+        void addClippedLine(float x0, float y0, float x1, float y1);
+        void line(std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2);
+        void renderHline(std::int32_t ey, std::int32_t x1, std::int32_t y1, std::int32_t x2, std::int32_t y2);
+        void setCell(std::int32_t x, std::int32_t y);
+        void flushCell();
+
+        IRect             clip;
+        Cell              current {0, 0, 0, 0};
+        bool              hasCurrent {false};
+        std::vector<Cell> cells;
+        std::vector<Cell> sorted;
+        std::vector<int>  rowCounts;
+    };
+} // namespace rive_renderer_cpu
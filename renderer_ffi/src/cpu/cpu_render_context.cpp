@@ -0,0 +1,349 @@
+#include "cpu_render_context.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "rive/decoders/bitmap_decoder.hpp"
+#include "rive/math/path_types.hpp"
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        Mat2D ToCpuMatrix(const rive::Mat2D& m)
+        {
+            Mat2D result;
+            result.xx = m.xx();
+            result.xy = m.xy();
+            result.yx = m.yx();
+            result.yy = m.yy();
+            result.tx = m.tx();
+            result.ty = m.ty();
+            return result;
+        }
+
+        // The conversions in this file cast rive enums straight to the CPU enums, so each value has to match.
+        template <typename CpuEnum, typename RiveEnum> constexpr bool SameValue(CpuEnum cpu, RiveEnum value)
+        {
+            return static_cast<int>(cpu) == static_cast<int>(value);
+        }
+
+        static_assert(SameValue(FillRule::nonZero, rive::FillRule::nonZero) &&
+                          SameValue(FillRule::evenOdd, rive::FillRule::evenOdd) &&
+                          SameValue(FillRule::clockwise, rive::FillRule::clockwise),
+                      "FillRule must match rive::FillRule");
+        static_assert(SameValue(PathVerb::move, rive::PathVerb::move) &&
+                          SameValue(PathVerb::line, rive::PathVerb::line) &&
+                          SameValue(PathVerb::quad, rive::PathVerb::quad) &&
+                          SameValue(PathVerb::cubic, rive::PathVerb::cubic) &&
+                          SameValue(PathVerb::close, rive::PathVerb::close),
+                      "PathVerb must match rive::PathVerb");
+        static_assert(SameValue(StrokeJoin::miter, rive::StrokeJoin::miter) &&
+                          SameValue(StrokeJoin::round, rive::StrokeJoin::round) &&
+                          SameValue(StrokeJoin::bevel, rive::StrokeJoin::bevel),
+                      "StrokeJoin must match rive::StrokeJoin");
+        static_assert(SameValue(StrokeCap::butt, rive::StrokeCap::butt) &&
+                          SameValue(StrokeCap::round, rive::StrokeCap::round) &&
+                          SameValue(StrokeCap::square, rive::StrokeCap::square),
+                      "StrokeCap must match rive::StrokeCap");
+        static_assert(SameValue(BlendMode::srcOver, rive::BlendMode::srcOver) &&
+                          SameValue(BlendMode::screen, rive::BlendMode::screen) &&
+                          SameValue(BlendMode::overlay, rive::BlendMode::overlay) &&
+                          SameValue(BlendMode::darken, rive::BlendMode::darken) &&
+                          SameValue(BlendMode::lighten, rive::BlendMode::lighten) &&
+                          SameValue(BlendMode::colorDodge, rive::BlendMode::colorDodge) &&
+                          SameValue(BlendMode::colorBurn, rive::BlendMode::colorBurn) &&
+                          SameValue(BlendMode::hardLight, rive::BlendMode::hardLight) &&
+                          SameValue(BlendMode::softLight, rive::BlendMode::softLight) &&
+                          SameValue(BlendMode::difference, rive::BlendMode::difference) &&
+                          SameValue(BlendMode::exclusion, rive::BlendMode::exclusion) &&
+                          SameValue(BlendMode::multiply, rive::BlendMode::multiply) &&
+                          SameValue(BlendMode::hue, rive::BlendMode::hue) &&
+                          SameValue(BlendMode::saturation, rive::BlendMode::saturation) &&
+                          SameValue(BlendMode::color, rive::BlendMode::color) &&
+                          SameValue(BlendMode::luminosity, rive::BlendMode::luminosity),
+                      "BlendMode must match rive::BlendMode");
+        static_assert(SameValue(ImageWrap::clamp, rive::ImageWrap::clamp) &&
+                          SameValue(ImageWrap::repeat, rive::ImageWrap::repeat) &&
+                          SameValue(ImageWrap::mirror, rive::ImageWrap::mirror),
+                      "ImageWrap must match rive::ImageWrap");
+        static_assert(SameValue(ImageFilter::bilinear, rive::ImageFilter::bilinear) &&
+                          SameValue(ImageFilter::nearest, rive::ImageFilter::nearest),
+                      "ImageFilter must match rive::ImageFilter");
+
+        ImageSampler ToCpuSampler(const rive::ImageSampler& sampler)
+        {
+            ImageSampler result;
+            result.wrapX  = static_cast<ImageWrap>(sampler.wrapX);
+            result.wrapY  = static_cast<ImageWrap>(sampler.wrapY);
+            result.filter = static_cast<ImageFilter>(sampler.filter);
+            return result;
+        }
+    } // namespace
+
+    CpuRenderPath::CpuRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule)
+    {
+        addRawPath(rawPath);
+        pathData.fillRule = static_cast<FillRule>(fillRule);
+    }
+
+    void CpuRenderPath::rewind()
+    {
+        pathData.rewind();
+    }
+
+    void CpuRenderPath::fillRule(rive::FillRule value)
+    {
+        pathData.fillRule = static_cast<FillRule>(value);
+    }
+
+    void CpuRenderPath::moveTo(float x, float y)
+    {
+        pathData.moveTo(x, y);
+    }
+
+    void CpuRenderPath::lineTo(float x, float y)
+    {
+        pathData.lineTo(x, y);
+    }
+
+    void CpuRenderPath::cubicTo(float ox, float oy, float ix, float iy, float x, float y)
+    {
+        pathData.cubicTo(ox, oy, ix, iy, x, y);
+    }
+
+    void CpuRenderPath::close()
+    {
+        pathData.close();
+    }
+
+    void CpuRenderPath::addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform)
+    {
+        auto* other = rive::lite_rtti_cast<CpuRenderPath*>(path);
+        if (other != nullptr)
+        {
+            pathData.addPath(other->pathData, ToCpuMatrix(transform));
+        }
+    }
+
+    void CpuRenderPath::addRenderPathBackwards(rive::RenderPath* path, const rive::Mat2D& transform)
+    {
+        auto* other = rive::lite_rtti_cast<CpuRenderPath*>(path);
+        if (other != nullptr)
+        {
+            pathData.addPathReversed(other->pathData, ToCpuMatrix(transform));
+        }
+    }
+
+    void CpuRenderPath::addRawPath(const rive::RawPath& path)
+    {
+        const auto verbs  = path.verbs();
+        const auto points = path.points();
+        pathData.verbs.reserve(pathData.verbs.size() + verbs.size());
+        pathData.points.reserve(pathData.points.size() + points.size());
+        for (const rive::PathVerb verb : verbs)
+        {
+            pathData.verbs.push_back(static_cast<PathVerb>(verb));
+        }
+        for (const rive::Vec2D& point : points)
+        {
+            pathData.points.push_back({point.x, point.y});
+        }
+        pathData.touch();
+    }
+
+    void CpuRenderPaint::style(rive::RenderPaintStyle value)
+    {
+        state.style = value == rive::RenderPaintStyle::stroke ? PaintStyle::stroke : PaintStyle::fill;
+    }
+
+    void CpuRenderPaint::color(rive::ColorInt value)
+    {
+        state.color = value;
+    }
+
+    void CpuRenderPaint::thickness(float value)
+    {
+        state.stroke.thickness = value;
+    }
+
+    void CpuRenderPaint::join(rive::StrokeJoin value)
+    {
+        state.stroke.join = static_cast<StrokeJoin>(value);
+    }
+
+    void CpuRenderPaint::cap(rive::StrokeCap value)
+    {
+        state.stroke.cap = static_cast<StrokeCap>(value);
+    }
+
+    void CpuRenderPaint::feather(float value)
+    {
+        state.feather = value;
+    }
+
+    void CpuRenderPaint::blendMode(rive::BlendMode value)
+    {
+        state.blendMode = static_cast<BlendMode>(value);
+    }
+
+    void CpuRenderPaint::shader(rive::rcp<rive::RenderShader> value)
+    {
+        auto* cpuShader = rive::lite_rtti_cast<CpuRenderShader*>(value.get());
+        state.shader    = cpuShader != nullptr ? cpuShader->get() : nullptr;
+    }
+
+    CpuRenderImage::CpuRenderImage(std::shared_ptr<const ImageData> image) : imageData(std::move(image))
+    {
+        m_Width  = static_cast<int>(imageData->width);
+        m_Height = static_cast<int>(imageData->height);
+    }
+
+    CpuRenderBuffer::CpuRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags,
+                                     std::size_t sizeInBytes) :
+        lite_rtti_override(type, flags, sizeInBytes), storage(sizeInBytes, 0)
+    {
+    }
+
+    void* CpuRenderBuffer::onMap()
+    {
+        return storage.data();
+    }
+
+    void CpuRenderBuffer::onUnmap()
+    {
+    }
+
+    rive::rcp<rive::RenderBuffer> CpuRenderContext::makeRenderBuffer(rive::RenderBufferType type,
+                                                                     rive::RenderBufferFlags flags,
+                                                                     std::size_t sizeInBytes)
+    {
+        return rive::make_rcp<CpuRenderBuffer>(type, flags, sizeInBytes);
+    }
+
+    rive::rcp<rive::RenderShader> CpuRenderContext::makeLinearGradient(float sx, float sy, float ex, float ey,
+                                                                       const rive::ColorInt colors[],
+                                                                       const float stops[], std::size_t count)
+    {
+        return rive::make_rcp<CpuRenderShader>(GradientShader::MakeLinear(sx, sy, ex, ey, colors, stops, count));
+    }
+
+    rive::rcp<rive::RenderShader> CpuRenderContext::makeRadialGradient(float cx, float cy, float radius,
+                                                                       const rive::ColorInt colors[],
+                                                                       const float stops[], std::size_t count)
+    {
+        return rive::make_rcp<CpuRenderShader>(GradientShader::MakeRadial(cx, cy, radius, colors, stops, count));
+    }
+
+    rive::rcp<rive::RenderPath> CpuRenderContext::makeRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule)
+    {
+        return rive::make_rcp<CpuRenderPath>(rawPath, fillRule);
+    }
+
+    rive::rcp<rive::RenderPath> CpuRenderContext::makeEmptyRenderPath()
+    {
+        return rive::make_rcp<CpuRenderPath>();
+    }
+
+    rive::rcp<rive::RenderPaint> CpuRenderContext::makeRenderPaint()
+    {
+        return rive::make_rcp<CpuRenderPaint>();
+    }
+
+    rive::rcp<rive::RenderImage> CpuRenderContext::decodeImage(rive::Span<const std::uint8_t> encodedBytes)
+    {
+        auto bitmap = rive::Bitmap::decode(encodedBytes.data(), encodedBytes.size());
+        if (bitmap == nullptr || bitmap->width() == 0 || bitmap->height() == 0)
+        {
+            return nullptr;
+        }
+        // The framebuffer is premultiplied RGBA8, so convert once here instead of per sample.
+        bitmap->pixelFormat(rive::Bitmap::PixelFormat::RGBAPremul);
+
+        auto image    = std::make_shared<ImageData>();
+        image->width  = bitmap->width();
+        image->height = bitmap->height();
+        image->pixels.resize(static_cast<std::size_t>(image->width) * image->height);
+        std::memcpy(image->pixels.data(), bitmap->bytes(), image->pixels.size() * sizeof(std::uint32_t));
+        return rive::make_rcp<CpuRenderImage>(std::move(image));
+    }
+
+    void CpuRenderer::save()
+    {
+        stack.push_back(state);
+    }
+
+    void CpuRenderer::restore()
+    {
+        if (stack.empty())
+        {
+            return;
+        }
+        state = std::move(stack.back());
+        stack.pop_back();
+    }
+
+    void CpuRenderer::transform(const rive::Mat2D& matrix)
+    {
+        state.matrix = Multiply(state.matrix, ToCpuMatrix(matrix));
+    }
+
+    void CpuRenderer::drawPath(rive::RenderPath* path, rive::RenderPaint* paint)
+    {
+        auto* cpuPath  = rive::lite_rtti_cast<CpuRenderPath*>(path);
+        auto* cpuPaint = rive::lite_rtti_cast<CpuRenderPaint*>(paint);
+        if (cpuPath == nullptr || cpuPaint == nullptr)
+        {
+            return;
+        }
+        context->canvas.drawPath(state, cpuPath->data(), cpuPaint->paint(), &cpuPath->strokeCache());
+    }
+
+    void CpuRenderer::clipPath(rive::RenderPath* path)
+    {
+        auto* cpuPath = rive::lite_rtti_cast<CpuRenderPath*>(path);
+        if (cpuPath == nullptr)
+        {
+            return;
+        }
+        context->canvas.clipPath(&state, cpuPath->data());
+    }
+
+    void CpuRenderer::drawImage(const rive::RenderImage* image, rive::ImageSampler sampler, rive::BlendMode blendMode,
+                                float opacity)
+    {
+        auto* cpuImage = rive::lite_rtti_cast<const CpuRenderImage*>(image);
+        if (cpuImage == nullptr)
+        {
+            return;
+        }
+        context->canvas.drawImage(state, cpuImage->image(), ToCpuSampler(sampler), static_cast<BlendMode>(blendMode),
+                                  opacity);
+    }
+
+    void CpuRenderer::drawImageMesh(const rive::RenderImage* image, rive::ImageSampler sampler,
+                                    rive::rcp<rive::RenderBuffer> vertices, rive::rcp<rive::RenderBuffer> uvCoords,
+                                    rive::rcp<rive::RenderBuffer> indices, std::uint32_t vertexCount,
+                                    std::uint32_t indexCount, rive::BlendMode blendMode, float opacity)
+    {
+        auto* cpuImage    = rive::lite_rtti_cast<const CpuRenderImage*>(image);
+        auto* cpuVertices = rive::lite_rtti_cast<CpuRenderBuffer*>(vertices.get());
+        auto* cpuUvs      = rive::lite_rtti_cast<CpuRenderBuffer*>(uvCoords.get());
+        auto* cpuIndices  = rive::lite_rtti_cast<CpuRenderBuffer*>(indices.get());
+        if (cpuImage == nullptr || cpuVertices == nullptr || cpuUvs == nullptr || cpuIndices == nullptr)
+        {
+            return;
+        }
+
+        // Counts are clamped to what the buffers hold so a mismatched count can never read past their storage.
+        const std::size_t vertexCapacity = std::min(cpuVertices->size(), cpuUvs->size()) / sizeof(Vec2);
+        const std::size_t indexCapacity  = cpuIndices->size() / sizeof(std::uint16_t);
+        context->canvas.drawImageMesh(
+            state, cpuImage->image(), ToCpuSampler(sampler), reinterpret_cast<const Vec2*>(cpuVertices->contents()),
+            reinterpret_cast<const Vec2*>(cpuUvs->contents()),
+            static_cast<std::uint32_t>(std::min<std::size_t>(vertexCount, vertexCapacity)),
+            reinterpret_cast<const std::uint16_t*>(cpuIndices->contents()),
+            static_cast<std::uint32_t>(std::min<std::size_t>(indexCount, indexCapacity)),
+            static_cast<BlendMode>(blendMode), opacity);
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "rive/factory.hpp"
+#include "rive/renderer.hpp"
+#include "rive/math/mat2d.hpp"
+#include "rive/math/raw_path.hpp"
+#include "rive/shapes/paint/blend_mode.hpp"
+#include "rive/shapes/paint/color.hpp"
+#include "rive/shapes/paint/image_sampler.hpp"
+
+#include "cpu_canvas.hpp"
+
+// rive::Factory / rive::Renderer implementation for the null backend. Resources are plain CPU objects and each frame is
+// rasterized in software into the context's framebuffer when it ends.
+namespace rive_renderer_cpu
+{
+    class CpuRenderPath final : public LITE_RTTI_OVERRIDE(rive::RenderPath, CpuRenderPath)
+    {
+    public:
+        CpuRenderPath() = default;
+        CpuRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule);
+
+        void rewind() override;
+        void fillRule(rive::FillRule value) override;
+        void moveTo(float x, float y) override;
+        void lineTo(float x, float y) override;
+        void cubicTo(float ox, float oy, float ix, float iy, float x, float y) override;
+        void close() override;
+        void addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform) override;
+        void addRenderPathBackwards(rive::RenderPath* path, const rive::Mat2D& transform);
+        void addRawPath(const rive::RawPath& path) override;
+
+        const PathData& data() const
+        {
+            return pathData;
+        }
+
+        // Stroke outline of this path from the last stroked draw; see StrokeCache.
+        StrokeCache& strokeCache()
+        {
+            return strokes;
+        }
+
+    private:
+        PathData    pathData;
+        StrokeCache strokes;
+    };
+
+    class CpuRenderShader final : public LITE_RTTI_OVERRIDE(rive::RenderShader, CpuRenderShader)
+    {
+    public:
+        explicit CpuRenderShader(std::shared_ptr<Shader> shader) : shader(std::move(shader))
+        {
+        }
+
+        const std::shared_ptr<Shader>& get() const
+        {
+            return shader;
+        }
+
+    private:
+        std::shared_ptr<Shader> shader;
+    };
+
+    class CpuRenderPaint final : public LITE_RTTI_OVERRIDE(rive::RenderPaint, CpuRenderPaint)
+    {
+    public:
+        void style(rive::RenderPaintStyle value) override;
+        void color(rive::ColorInt value) override;
+        void thickness(float value) override;
+        void join(rive::StrokeJoin value) override;
+        void cap(rive::StrokeCap value) override;
+        void feather(float value) override;
+        void blendMode(rive::BlendMode value) override;
+        void shader(rive::rcp<rive::RenderShader> value) override;
+        void invalidateStroke() override
+        {
+        }
+
+        const Paint& paint() const
+        {
+            return state;
+        }
+
+    private:
+        Paint state;
+    };
+
+    class CpuRenderImage final : public LITE_RTTI_OVERRIDE(rive::RenderImage, CpuRenderImage)
+    {
+    public:
+        explicit CpuRenderImage(std::shared_ptr<const ImageData> image);
+
+        const std::shared_ptr<const ImageData>& image() const
+        {
+            return imageData;
+        }
+
+    private:
+        std::shared_ptr<const ImageData> imageData;
+    };
+
+    class CpuRenderBuffer final : public LITE_RTTI_OVERRIDE(rive::RenderBuffer, CpuRenderBuffer)
+    {
+    public:
+        CpuRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags, std::size_t sizeInBytes);
+
+        const std::uint8_t* contents() const
+        {
+            return storage.data();
+        }
+
+        std::size_t size() const
+        {
+            return storage.size();
+        }
+
+    protected:
+        void* onMap() override;
+        void  onUnmap() override;
+
+    private:
+        std::vector<std::uint8_t> storage;
+    };
+
+    class CpuRenderContext final : public rive::Factory
+    {
+    public:
+        explicit CpuRenderContext(SimdLevel simdLevel = SimdLevel::portable) :
+            canvas(&WorkerPool::Shared(), simdLevel)
+        {
+        }
+
+        rive::rcp<rive::RenderBuffer> makeRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags,
+                                                       std::size_t sizeInBytes) override;
+
+        rive::rcp<rive::RenderShader> makeLinearGradient(float sx, float sy, float ex, float ey,
+                                                         const rive::ColorInt colors[], const float stops[],
+                                                         std::size_t count) override;
+
+        rive::rcp<rive::RenderShader> makeRadialGradient(float cx, float cy, float radius,
+                                                         const rive::ColorInt colors[], const float stops[],
+                                                         std::size_t count) override;
+
+        rive::rcp<rive::RenderPath> makeRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule) override;
+
+        rive::rcp<rive::RenderPath> makeEmptyRenderPath() override;
+
+        rive::rcp<rive::RenderPaint> makeRenderPaint() override;
+
+        rive::rcp<rive::RenderImage> decodeImage(rive::Span<const std::uint8_t> encodedBytes) override;
+
+        void beginFrame(std::uint32_t width, std::uint32_t height)
+        {
+            canvas.beginFrame(width, height);
+        }
+
+        void endFrame(std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, std::size_t stride)
+        {
+            canvas.endFrame(pixels, width, height, stride);
+        }
+
+        bool recording() const
+        {
+            return canvas.recording();
+        }
+
+    private:
+        friend class CpuRenderer;
+
+        Canvas canvas;
+    };
+
+    class CpuRenderer final : public rive::Renderer
+    {
+    public:
+        explicit CpuRenderer(CpuRenderContext* context) : context(context)
+        {
+        }
+
+        void save() override;
+        void restore() override;
+        void transform(const rive::Mat2D& matrix) override;
+        void drawPath(rive::RenderPath* path, rive::RenderPaint* paint) override;
+        void clipPath(rive::RenderPath* path) override;
+        void drawImage(const rive::RenderImage* image, rive::ImageSampler sampler, rive::BlendMode blendMode,
+                       float opacity) override;
+        void drawImageMesh(const rive::RenderImage* image, rive::ImageSampler sampler,
+                           rive::rcp<rive::RenderBuffer> vertices, rive::rcp<rive::RenderBuffer> uvCoords,
+                           rive::rcp<rive::RenderBuffer> indices, std::uint32_t vertexCount, std::uint32_t indexCount,
+                           rive::BlendMode blendMode, float opacity) override;
+
+    private:
+        CpuRenderContext*        context;
+        CanvasState              state;
+        std::vector<CanvasState> stack;
+    };
+} // namespace rive_renderer_cpu
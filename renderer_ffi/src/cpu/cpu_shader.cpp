@@ -0,0 +1,609 @@
+#include "cpu_shader.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RIVE_RENDERER_CPU_SSE2
+#endif
+
+namespace rive_renderer_cpu
+{
+    namespace
+    {
+        // Ramps use the small size unless two stops are closer than a few entries apart, where a coarse ramp would
+        // visibly soften hard transitions.
+        constexpr std::size_t kSmallRampSize  = 256;
+        constexpr std::size_t kLargeRampSize  = 1024;
+        constexpr float       kMinStopSpacing = 4.0f / static_cast<float>(kSmallRampSize);
+
+        // Maps a gradient parameter to its ramp entry. NaN and values below 0 clamp to the first entry.
+        std::int32_t RampIndex(float t, float rampScale)
+        {
+            const float clamped = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+            return static_cast<std::int32_t>(clamped * rampScale + 0.5f);
+        }
+
+#if defined(RIVE_RENDERER_CPU_SSE2)
+        // Vector form of RampIndex; max/min operand order reproduces its NaN and clamping behavior exactly.
+        __m128i RampIndex4(__m128 t, __m128 rampScale)
+        {
+            const __m128 clamped = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+            return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, rampScale), _mm_set1_ps(0.5f)));
+        }
+
+        // Device x coordinates of the pixel centers x .. x + 3.
+        __m128 PixelCenters4(std::int32_t x)
+        {
+            const __m128i lanes = _mm_add_epi32(_mm_set1_epi32(x), _mm_setr_epi32(0, 1, 2, 3));
+            return _mm_add_ps(_mm_cvtepi32_ps(lanes), _mm_set1_ps(0.5f));
+        }
+
+        void LookupRamp4(const std::uint32_t* ramp, __m128i indices, std::uint32_t* out)
+        {
+            alignas(16) std::int32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), indices);
+            out[0] = ramp[lanes[0]];
+            out[1] = ramp[lanes[1]];
+            out[2] = ramp[lanes[2]];
+            out[3] = ramp[lanes[3]];
+        }
+#endif
+
+        std::uint32_t PackPremultiplied(float r, float g, float b, float a)
+        {
+            a           = std::min(std::max(a, 0.0f), 1.0f);
+            auto toByte = [a](float c)
+            { return static_cast<std::uint32_t>(std::min(std::max(c, 0.0f), 1.0f) * a * 255.0f + 0.5f); };
+            const std::uint32_t alpha = static_cast<std::uint32_t>(a * 255.0f + 0.5f);
+            return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (alpha << 24);
+        }
+
+        std::int32_t WrapCoordinate(std::int32_t i, std::int32_t size, ImageWrap wrap)
+        {
+            switch (wrap)
+            {
+            case ImageWrap::repeat:
+            {
+                const std::int32_t m = i % size;
+                return m < 0 ? m + size : m;
+            }
+            case ImageWrap::mirror:
+            {
+                const std::int32_t period = size * 2;
+                std::int32_t       m      = i % period;
+                if (m < 0)
+                {
+                    m += period;
+                }
+                return m < size ? m : period - 1 - m;
+            }
+            case ImageWrap::clamp:
+                break;
+            }
+            return std::min(std::max(i, 0), size - 1);
+        }
+
+        std::uint32_t Lerp4(std::uint32_t a, std::uint32_t b, std::uint32_t weight)
+        {
+            // weight is in [0, 256].
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                const std::uint32_t ca = (a >> shift) & 0xff;
+                const std::uint32_t cb = (b >> shift) & 0xff;
+                result |= (((ca * (256 - weight) + cb * weight) >> 8) & 0xff) << shift;
+            }
+            return result;
+        }
+
+        // Bilinear blend of the texels a (top left), b (top right), c (bottom left) and d (bottom right). Same result
+        // as lerping both rows by wx and then lerping between them by wy.
+        std::uint32_t Bilerp(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d, std::int32_t wx,
+                             std::int32_t wy)
+        {
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            // Both rows are lerped at once in 16-bit lanes; no channel sum exceeds 255 * 256, so nothing wraps.
+            auto lerp16 = [](__m128i first, __m128i second, std::int32_t weight)
+            {
+                const __m128i keep = _mm_mullo_epi16(first, _mm_set1_epi16(static_cast<short>(256 - weight)));
+                const __m128i take = _mm_mullo_epi16(second, _mm_set1_epi16(static_cast<short>(weight)));
+                return _mm_srli_epi16(_mm_add_epi16(keep, take), 8);
+            };
+            const __m128i zero   = _mm_setzero_si128();
+            const __m128i left   = _mm_setr_epi32(static_cast<int>(a), static_cast<int>(c), 0, 0);
+            const __m128i right  = _mm_setr_epi32(static_cast<int>(b), static_cast<int>(d), 0, 0);
+            const __m128i rows   = lerp16(_mm_unpacklo_epi8(left, zero), _mm_unpacklo_epi8(right, zero), wx);
+            const __m128i result = lerp16(rows, _mm_unpackhi_epi64(rows, rows), wy);
+            return static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(result, result)));
+#else
+            const auto weightX = static_cast<std::uint32_t>(wx);
+            return Lerp4(Lerp4(a, b, weightX), Lerp4(c, d, weightX), static_cast<std::uint32_t>(wy));
+#endif
+        }
+
+        // Lerps two texel rows by a shared weight.
+        void LerpRows(const std::uint32_t* row0, const std::uint32_t* row1, std::int32_t weight, std::int32_t count,
+                      std::uint32_t* out)
+        {
+            if (weight == 0)
+            {
+                std::copy(row0, row0 + count, out);
+                return;
+            }
+            std::int32_t i = 0;
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            const __m128i zero   = _mm_setzero_si128();
+            const __m128i keep   = _mm_set1_epi16(static_cast<short>(256 - weight));
+            const __m128i take   = _mm_set1_epi16(static_cast<short>(weight));
+            auto          lerp16 = [&](__m128i a, __m128i b)
+            { return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, keep), _mm_mullo_epi16(b, take)), 8); };
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + i));
+                const __m128i low  = lerp16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                const __m128i high = lerp16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                out[i] = Lerp4(row0[i], row1[i], static_cast<std::uint32_t>(weight));
+            }
+        }
+
+        std::uint32_t ScaleColor(std::uint32_t color, std::uint32_t scale)
+        {
+            std::uint32_t result = 0;
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                result |= MulDiv255((color >> shift) & 0xff, scale) << shift;
+            }
+            return result;
+        }
+
+        void ScaleColors(std::uint32_t* colors, std::int32_t count, std::uint32_t scale)
+        {
+            std::int32_t i = 0;
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            // MulDiv255 in 16-bit lanes; its intermediate sums stay below 2^16.
+            const __m128i zero    = _mm_setzero_si128();
+            const __m128i factor  = _mm_set1_epi16(static_cast<short>(scale));
+            const __m128i half    = _mm_set1_epi16(128);
+            auto          scale16 = [&](__m128i channels)
+            {
+                const __m128i t = _mm_add_epi16(_mm_mullo_epi16(channels, factor), half);
+                return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+            };
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colors + i));
+                const __m128i low    = scale16(_mm_unpacklo_epi8(pixels, zero));
+                const __m128i high   = scale16(_mm_unpackhi_epi8(pixels, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(colors + i), _mm_packus_epi16(low, high));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                colors[i] = ScaleColor(colors[i], scale);
+            }
+        }
+
+        // Texel coordinates are clamped to +/-2^24, where floats still hold every integer and the conversion to int
+        // cannot overflow.
+        constexpr float kMaxTexelCoordinate = 16777216.0f;
+
+        // Splits a texel space coordinate into its floor and the 8-bit weight (0-256) of the following texel. NaN
+        // clamps to the lower bound.
+        void SplitTexelCoordinate(float c, std::int32_t* whole, std::int32_t* weight)
+        {
+            const float k       = kMaxTexelCoordinate;
+            const float clamped = c > -k ? (c < k ? c : k) : -k;
+            const float floored = std::floor(clamped);
+            *whole              = static_cast<std::int32_t>(floored);
+            *weight             = static_cast<std::int32_t>((clamped - floored) * 256.0f + 0.5f);
+        }
+
+        // Splits the coordinates slope * px + offset at the pixel centers px of x .. x + count - 1 (count <= 4).
+        void SplitTexelCoordinates(float slope, float offset, std::int32_t x, std::int32_t count, std::int32_t* whole,
+                                   std::int32_t* weight)
+        {
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            if (count == 4)
+            {
+                // Max/min operand order matches the scalar clamp, NaN included. Truncation rounds negative fractions
+                // up, so lanes that ended above the coordinate step back down by adding the all-ones compare mask.
+                const __m128  k         = _mm_set1_ps(kMaxTexelCoordinate);
+                const __m128  c         = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(slope), PixelCenters4(x)),
+                                                     _mm_set1_ps(offset));
+                const __m128  clamped   = _mm_min_ps(_mm_max_ps(c, _mm_sub_ps(_mm_setzero_ps(), k)), k);
+                const __m128i truncated = _mm_cvttps_epi32(clamped);
+                const __m128i floored =
+                    _mm_add_epi32(truncated, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(truncated), clamped)));
+                const __m128 fraction = _mm_sub_ps(clamped, _mm_cvtepi32_ps(floored));
+                const __m128 scaled   = _mm_add_ps(_mm_mul_ps(fraction, _mm_set1_ps(256.0f)), _mm_set1_ps(0.5f));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(whole), floored);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(weight), _mm_cvttps_epi32(scaled));
+                return;
+            }
+#endif
+            for (std::int32_t i = 0; i < count; ++i)
+            {
+                SplitTexelCoordinate(slope * (static_cast<float>(x + i) + 0.5f) + offset, &whole[i], &weight[i]);
+            }
+        }
+
+        // Texel coordinates and weights for up to four consecutive pixels of a row.
+        struct TexelQuad
+        {
+            std::int32_t x[4];
+            std::int32_t y[4];
+            std::int32_t wx[4];
+            std::int32_t wy[4];
+        };
+
+        // A row span mapped into an image: pixel center px samples at (xx * px + rowU, xy * px + rowV).
+        struct ImageSpan
+        {
+            const ImageData&    image;
+            const ImageSampler& sampler;
+            const Mat2D&        deviceToImage;
+            float               rowU;
+            float               rowV;
+        };
+
+        // Coordinates are monotonic along a row, so the first and last pixels bound every texel the span reads.
+        // footprint is how many texels past the sampled one the filter reads.
+        bool SpanInsideImage(const ImageSpan& span, std::int32_t x, std::int32_t count, std::int32_t footprint)
+        {
+            const Mat2D& m     = span.deviceToImage;
+            const float  first = static_cast<float>(x) + 0.5f;
+            const float  last  = static_cast<float>(x + count - 1) + 0.5f;
+            std::int32_t u0;
+            std::int32_t u1;
+            std::int32_t v0;
+            std::int32_t v1;
+            std::int32_t weight;
+            SplitTexelCoordinate(m.xx * first + span.rowU, &u0, &weight);
+            SplitTexelCoordinate(m.xx * last + span.rowU, &u1, &weight);
+            SplitTexelCoordinate(m.xy * first + span.rowV, &v0, &weight);
+            SplitTexelCoordinate(m.xy * last + span.rowV, &v1, &weight);
+            const auto width  = static_cast<std::int32_t>(span.image.width);
+            const auto height = static_cast<std::int32_t>(span.image.height);
+            return std::min(u0, u1) >= 0 && std::max(u0, u1) + footprint < width && std::min(v0, v1) >= 0 &&
+                   std::max(v0, v1) + footprint < height;
+        }
+
+        // Detects unit-scale spans that land on whole texel columns, where pixel x reads column x + (rowU + alignment).
+        // The offset is checked in double so that it is exact; past 2^22 the float coordinate sums would round.
+        bool UnitScaleColumns(const Mat2D& m, float rowU, float alignment, std::int32_t x, std::int32_t count,
+                              std::int32_t* column)
+        {
+            constexpr double kMaxExact = 4194304.0;
+            const double     offset    = static_cast<double>(rowU) + alignment;
+            if (m.xx != 1.0f || m.xy != 0.0f || offset != std::floor(offset) || std::fabs(offset) >= kMaxExact ||
+                std::fabs(static_cast<double>(x)) + count >= kMaxExact)
+            {
+                return false;
+            }
+            *column = x + static_cast<std::int32_t>(offset);
+            return true;
+        }
+
+        template <bool kWrap> std::int32_t ResolveTexel(std::int32_t i, std::int32_t size, ImageWrap wrap)
+        {
+            return kWrap ? WrapCoordinate(i, size, wrap) : i;
+        }
+
+        template <bool kWrap>
+        void SampleNearest(const ImageSpan& span, std::int32_t x, std::int32_t count, std::uint32_t* out)
+        {
+            const ImageSampler&  sampler = span.sampler;
+            const std::int32_t   width   = static_cast<std::int32_t>(span.image.width);
+            const std::int32_t   height  = static_cast<std::int32_t>(span.image.height);
+            const std::uint32_t* pixels  = span.image.pixels.data();
+            const Mat2D&         m       = span.deviceToImage;
+            TexelQuad            quad;
+            if (m.xy != 0.0f)
+            {
+                for (std::int32_t i = 0; i < count; i += 4)
+                {
+                    const std::int32_t lanes = std::min(count - i, 4);
+                    SplitTexelCoordinates(m.xx, span.rowU, x + i, lanes, quad.x, quad.wx);
+                    SplitTexelCoordinates(m.xy, span.rowV, x + i, lanes, quad.y, quad.wy);
+                    for (std::int32_t lane = 0; lane < lanes; ++lane)
+                    {
+                        const std::int32_t sx = ResolveTexel<kWrap>(quad.x[lane], width, sampler.wrapX);
+                        const std::int32_t sy = ResolveTexel<kWrap>(quad.y[lane], height, sampler.wrapY);
+                        out[i + lane]         = pixels[static_cast<std::size_t>(sy) * width + sx];
+                    }
+                }
+                return;
+            }
+
+            // The whole span reads a single texel row.
+            std::int32_t iy;
+            std::int32_t wy;
+            SplitTexelCoordinate(span.rowV, &iy, &wy);
+            const std::uint32_t* row =
+                pixels + static_cast<std::size_t>(ResolveTexel<kWrap>(iy, height, sampler.wrapY)) * width;
+            std::int32_t column;
+            if (UnitScaleColumns(m, span.rowU, 0.0f, x, count, &column))
+            {
+                if (!kWrap)
+                {
+                    std::copy(row + column, row + column + count, out);
+                    return;
+                }
+                for (std::int32_t i = 0; i < count; ++i)
+                {
+                    out[i] = row[WrapCoordinate(column + i, width, sampler.wrapX)];
+                }
+                return;
+            }
+            for (std::int32_t i = 0; i < count; i += 4)
+            {
+                const std::int32_t lanes = std::min(count - i, 4);
+                SplitTexelCoordinates(m.xx, span.rowU, x + i, lanes, quad.x, quad.wx);
+                for (std::int32_t lane = 0; lane < lanes; ++lane)
+                {
+                    out[i + lane] = row[ResolveTexel<kWrap>(quad.x[lane], width, sampler.wrapX)];
+                }
+            }
+        }
+
+        template <bool kWrap>
+        void SampleBilinear(const ImageSpan& span, std::int32_t x, std::int32_t count, std::uint32_t* out)
+        {
+            const ImageSampler&  sampler = span.sampler;
+            const std::int32_t   width   = static_cast<std::int32_t>(span.image.width);
+            const std::int32_t   height  = static_cast<std::int32_t>(span.image.height);
+            const std::uint32_t* pixels  = span.image.pixels.data();
+            const Mat2D&         m       = span.deviceToImage;
+            TexelQuad            quad;
+            if (m.xy != 0.0f)
+            {
+                for (std::int32_t i = 0; i < count; i += 4)
+                {
+                    const std::int32_t lanes = std::min(count - i, 4);
+                    SplitTexelCoordinates(m.xx, span.rowU, x + i, lanes, quad.x, quad.wx);
+                    SplitTexelCoordinates(m.xy, span.rowV, x + i, lanes, quad.y, quad.wy);
+                    for (std::int32_t lane = 0; lane < lanes; ++lane)
+                    {
+                        const std::int32_t   sx0  = ResolveTexel<kWrap>(quad.x[lane], width, sampler.wrapX);
+                        const std::int32_t   sx1  = ResolveTexel<kWrap>(quad.x[lane] + 1, width, sampler.wrapX);
+                        const std::int32_t   sy0  = ResolveTexel<kWrap>(quad.y[lane], height, sampler.wrapY);
+                        const std::int32_t   sy1  = ResolveTexel<kWrap>(quad.y[lane] + 1, height, sampler.wrapY);
+                        const std::uint32_t* row0 = pixels + static_cast<std::size_t>(sy0) * width;
+                        const std::uint32_t* row1 = pixels + static_cast<std::size_t>(sy1) * width;
+                        out[i + lane] =
+                            Bilerp(row0[sx0], row0[sx1], row1[sx0], row1[sx1], quad.wx[lane], quad.wy[lane]);
+                    }
+                }
+                return;
+            }
+
+            // The whole span reads the same two texel rows with the same vertical weight.
+            std::int32_t iy;
+            std::int32_t wy;
+            SplitTexelCoordinate(span.rowV, &iy, &wy);
+            const std::uint32_t* row0 =
+                pixels + static_cast<std::size_t>(ResolveTexel<kWrap>(iy, height, sampler.wrapY)) * width;
+            const std::uint32_t* row1 =
+                pixels + static_cast<std::size_t>(ResolveTexel<kWrap>(iy + 1, height, sampler.wrapY)) * width;
+            std::int32_t column;
+            if (UnitScaleColumns(m, span.rowU, 0.5f, x, count, &column))
+            {
+                // Pixel centers land exactly on texel centers, so the horizontal weight is zero everywhere.
+                if (!kWrap)
+                {
+                    LerpRows(row0 + column, row1 + column, wy, count, out);
+                    return;
+                }
+                for (std::int32_t i = 0; i < count; ++i)
+                {
+                    const std::int32_t sx = WrapCoordinate(column + i, width, sampler.wrapX);
+                    out[i]                = Lerp4(row0[sx], row1[sx], static_cast<std::uint32_t>(wy));
+                }
+                return;
+            }
+            for (std::int32_t i = 0; i < count; i += 4)
+            {
+                const std::int32_t lanes = std::min(count - i, 4);
+                SplitTexelCoordinates(m.xx, span.rowU, x + i, lanes, quad.x, quad.wx);
+                for (std::int32_t lane = 0; lane < lanes; ++lane)
+                {
+                    const std::int32_t sx0 = ResolveTexel<kWrap>(quad.x[lane], width, sampler.wrapX);
+                    const std::int32_t sx1 = ResolveTexel<kWrap>(quad.x[lane] + 1, width, sampler.wrapX);
+                    out[i + lane]          = Bilerp(row0[sx0], row0[sx1], row1[sx0], row1[sx1], quad.wx[lane], wy);
+                }
+            }
+        }
+    } // namespace
+
+    std::shared_ptr<GradientShader> GradientShader::MakeLinear(float sx, float sy, float ex, float ey,
+                                                               const std::uint32_t colors[], const float stops[],
+                                                               std::size_t count)
+    {
+        std::shared_ptr<GradientShader> shader(new GradientShader());
+        shader->start = {sx, sy};
+        shader->end   = {ex, ey};
+        shader->setStops(colors, stops, count);
+        return shader;
+    }
+
+    std::shared_ptr<GradientShader> GradientShader::MakeRadial(float cx, float cy, float radius,
+                                                               const std::uint32_t colors[], const float stops[],
+                                                               std::size_t count)
+    {
+        std::shared_ptr<GradientShader> shader(new GradientShader());
+        shader->radial = true;
+        shader->start  = {cx, cy};
+        shader->radius = radius;
+        shader->setStops(colors, stops, count);
+        return shader;
+    }
+
+    void GradientShader::setStops(const std::uint32_t colors[], const float positions[], std::size_t count)
+    {
+        stops.reserve(count);
+        float previous = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // Stops are expected to be sorted; clamp instead of rejecting so malformed input still renders.
+            const float position = std::max(previous, std::min(std::max(positions[i], 0.0f), 1.0f));
+            const std::uint32_t c = colors[i];
+            stops.push_back({position, static_cast<float>((c >> 16) & 0xff) / 255.0f,
+                             static_cast<float>((c >> 8) & 0xff) / 255.0f, static_cast<float>(c & 0xff) / 255.0f,
+                             static_cast<float>((c >> 24) & 0xff) / 255.0f});
+            previous = position;
+        }
+        bakeRamp();
+    }
+
+    void GradientShader::bakeRamp()
+    {
+        std::size_t size = kSmallRampSize;
+        for (std::size_t i = 1; i < stops.size(); ++i)
+        {
+            if (stops[i].position - stops[i - 1].position < kMinStopSpacing)
+            {
+                size = kLargeRampSize;
+                break;
+            }
+        }
+
+        ramp.resize(size);
+        rampScale              = static_cast<float>(size - 1);
+        const float inverseMax = 1.0f / rampScale;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            ramp[i] = evaluate(static_cast<float>(i) * inverseMax);
+        }
+    }
+
+    std::uint32_t GradientShader::evaluate(float t) const
+    {
+        if (stops.empty())
+        {
+            return 0;
+        }
+        if (!(t > stops.front().position))
+        {
+            const Stop& s = stops.front();
+            return PackPremultiplied(s.r, s.g, s.b, s.a);
+        }
+        if (t >= stops.back().position)
+        {
+            const Stop& s = stops.back();
+            return PackPremultiplied(s.r, s.g, s.b, s.a);
+        }
+        std::size_t index = 1;
+        while (index < stops.size() && stops[index].position < t)
+        {
+            ++index;
+        }
+        const Stop& a    = stops[index - 1];
+        const Stop& b    = stops[index];
+        const float span = b.position - a.position;
+        const float f    = span > 0.0f ? (t - a.position) / span : 1.0f;
+        return PackPremultiplied(a.r + (b.r - a.r) * f, a.g + (b.g - a.g) * f, a.b + (b.b - a.b) * f,
+                                 a.a + (b.a - a.a) * f);
+    }
+
+    void GradientShader::shadeSpan(const Mat2D& deviceToLocal, std::int32_t x, std::int32_t y, std::int32_t count,
+                                   std::uint32_t* out) const
+    {
+        const std::uint32_t* table = ramp.data();
+        const float          py    = static_cast<float>(y) + 0.5f;
+        std::int32_t         i     = 0;
+        if (radial)
+        {
+            // Offset from the center in gradient space, affine in device x along the row.
+            const float inverseRadius = radius > 0.0f ? 1.0f / radius : 0.0f;
+            const float rowX          = deviceToLocal.yx * py + deviceToLocal.tx - start.x;
+            const float rowY          = deviceToLocal.yy * py + deviceToLocal.ty - start.y;
+#if defined(RIVE_RENDERER_CPU_SSE2)
+            const __m128 xx    = _mm_set1_ps(deviceToLocal.xx);
+            const __m128 xy    = _mm_set1_ps(deviceToLocal.xy);
+            const __m128 baseX = _mm_set1_ps(rowX);
+            const __m128 baseY = _mm_set1_ps(rowY);
+            const __m128 scale = _mm_set1_ps(inverseRadius);
+            const __m128 size  = _mm_set1_ps(rampScale);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 px = PixelCenters4(x + i);
+                const __m128 dx = _mm_add_ps(_mm_mul_ps(xx, px), baseX);
+                const __m128 dy = _mm_add_ps(_mm_mul_ps(xy, px), baseY);
+                const __m128 t  = _mm_mul_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))), scale);
+                LookupRamp4(table, RampIndex4(t, size), out + i);
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                const float px = static_cast<float>(x + i) + 0.5f;
+                const float dx = deviceToLocal.xx * px + rowX;
+                const float dy = deviceToLocal.xy * px + rowY;
+                out[i]         = table[RampIndex(std::sqrt(dx * dx + dy * dy) * inverseRadius, rampScale)];
+            }
+            return;
+        }
+
+        // t is affine in device space: t = ax * px + ay * py + c.
+        const Vec2  axis       = end - start;
+        const float lengthSq   = Dot(axis, axis);
+        const Vec2  scaledAxis = lengthSq > 0.0f ? axis * (1.0f / lengthSq) : Vec2 {0.0f, 0.0f};
+        const float ax         = Dot(deviceToLocal.mapVector({1.0f, 0.0f}), scaledAxis);
+        const float ay         = Dot(deviceToLocal.mapVector({0.0f, 1.0f}), scaledAxis);
+        const float c          = Dot(deviceToLocal.map({0.0f, 0.0f}) - start, scaledAxis);
+        const float rowT       = ay * py + c;
+#if defined(RIVE_RENDERER_CPU_SSE2)
+        const __m128 slope = _mm_set1_ps(ax);
+        const __m128 base  = _mm_set1_ps(rowT);
+        const __m128 size  = _mm_set1_ps(rampScale);
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128 t = _mm_add_ps(_mm_mul_ps(slope, PixelCenters4(x + i)), base);
+            LookupRamp4(table, RampIndex4(t, size), out + i);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            out[i] = table[RampIndex(ax * (static_cast<float>(x + i) + 0.5f) + rowT, rampScale)];
+        }
+    }
+
+    void ShadeImageSpan(const ImageData& image, const ImageSampler& sampler, float opacity, const Mat2D& deviceToImage,
+                        std::int32_t x, std::int32_t y, std::int32_t count, std::uint32_t* out)
+    {
+        if (count <= 0)
+        {
+            return;
+        }
+
+        // Bilinear coordinates are measured from texel centers, so they are shifted back by half a texel.
+        const bool      bilinear = sampler.filter != ImageFilter::nearest;
+        const float     bias     = bilinear ? 0.5f : 0.0f;
+        const float     py       = static_cast<float>(y) + 0.5f;
+        const ImageSpan span {image, sampler, deviceToImage, deviceToImage.yx * py + deviceToImage.tx - bias,
+                              deviceToImage.yy * py + deviceToImage.ty - bias};
+        const bool      inside = SpanInsideImage(span, x, count, bilinear ? 1 : 0);
+        if (bilinear)
+        {
+            inside ? SampleBilinear<false>(span, x, count, out) : SampleBilinear<true>(span, x, count, out);
+        }
+        else
+        {
+            inside ? SampleNearest<false>(span, x, count, out) : SampleNearest<true>(span, x, count, out);
+        }
+
+        const float         alpha = std::min(std::max(opacity, 0.0f), 1.0f);
+        const std::uint32_t scale = static_cast<std::uint32_t>(alpha * 255.0f + 0.5f);
+        if (scale != 255)
+        {
+            ScaleColors(out, count, scale);
+        }
+    }
+} // namespace rive_renderer_cpu
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "cpu_math.hpp"
+
+namespace rive_renderer_cpu
+{
+    // Decoded image pixels, premultiplied RGBA8 packed as little-endian 0xAABBGGRR.
+    struct ImageData
+    {
+        std::uint32_t              width {0};
+        std::uint32_t              height {0};
+        std::vector<std::uint32_t> pixels;
+    };
+
+    class Shader
+    {
+    public:
+        virtual ~Shader() = default;
+
+        // Writes premultiplied colors for the pixel centers of [x, x + count) on row y. deviceToLocal maps device
+        // pixels back into the shader's coordinate space. Each color depends only on its pixel, not on where the span
+        // starts, so a row may be shaded in pieces.
+        virtual void shadeSpan(const Mat2D& deviceToLocal, std::int32_t x, std::int32_t y, std::int32_t count,
+                               std::uint32_t* out) const = 0;
+    };
+
+    // Linear or radial gradient with clamped ends. The stops are baked once into a premultiplied color ramp, so
+    // shading a pixel is one affine (or distance) evaluation plus a table lookup.
+    class GradientShader final : public Shader
+    {
+    public:
+        static std::shared_ptr<GradientShader> MakeLinear(float sx, float sy, float ex, float ey,
+                                                          const std::uint32_t colors[], const float stops[],
+                                                          std::size_t count);
+
+        static std::shared_ptr<GradientShader> MakeRadial(float cx, float cy, float radius,
+                                                          const std::uint32_t colors[], const float stops[],
+                                                          std::size_t count);
+
+        void shadeSpan(const Mat2D& deviceToLocal, std::int32_t x, std::int32_t y, std::int32_t count,
+                       std::uint32_t* out) const override;
+
+    private:
+        struct Stop
+        {
+            float position;
+            float r;
+            float g;
+            float b;
+            float a;
+        };
+
+        GradientShader() = default;
+
+        void          setStops(const std::uint32_t colors[], const float stops[], std::size_t count);
+        void          bakeRamp();
+        std::uint32_t evaluate(float t) const;
+
+        bool                       radial {false};
+        Vec2                       start;
+        Vec2                       end;
+        float                      radius {0.0f};
+        std::vector<Stop>          stops;
+        std::vector<std::uint32_t> ramp;
+        float                      rampScale {0.0f};
+    };
+
+    // Samples an image drawn over its local rect [0, width] x [0, height], scaled by opacity. Axis-aligned spans fetch
+    // from fixed texel rows, unit-scale blits copy (or lerp) whole rows, and spans that stay inside the image skip
+    // wrapping. Every path produces the same pixels as the general per-pixel lookup.
+    void ShadeImageSpan(const ImageData& image, const ImageSampler& sampler, float opacity, const Mat2D& deviceToImage,
+                        std::int32_t x, std::int32_t y, std::int32_t count, std::uint32_t* out);
+} // namespace rive_renderer_cpu
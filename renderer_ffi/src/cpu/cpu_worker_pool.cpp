@@ -0,0 +1,120 @@
+#include "cpu_worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace rive_renderer_cpu
+{
+    struct WorkerPool::Job
+    {
+        const Task*              task {nullptr};
+        std::size_t              count {0};
+        std::atomic<std::size_t> next {0};
+        std::atomic<std::size_t> remaining {0};
+        std::mutex               mutex;
+        std::condition_variable  finished;
+    };
+
+    WorkerPool::WorkerPool(std::size_t threadCount)
+    {
+        threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back(&WorkerPool::workerMain, this, i + 1);
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    WorkerPool& WorkerPool::Shared()
+    {
+        // The caller participates in every loop, so one hardware thread is left for it. The pool is intentionally
+        // leaked: joining threads from static destructors can deadlock while the library is being unloaded.
+        static WorkerPool* pool = new WorkerPool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+        return *pool;
+    }
+
+    void WorkerPool::parallelFor(std::size_t count, const Task& task)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (count == 1 || threads.empty())
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                task(i, 0);
+            }
+            return;
+        }
+
+        auto job       = std::make_shared<Job>();
+        job->task      = &task;
+        job->count     = count;
+        job->remaining = count;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+        }
+        wake.notify_all();
+
+        runJob(*job, 0);
+
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->finished.wait(lock, [&job] { return job->remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    void WorkerPool::workerMain(std::size_t slot)
+    {
+        for (;;)
+        {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                {
+                    return;
+                }
+                job = jobs.front();
+                // Every index has been claimed once the counter passes the end, so later workers skip the job.
+                if (job->next.load(std::memory_order_relaxed) >= job->count)
+                {
+                    jobs.pop_front();
+                    continue;
+                }
+            }
+            runJob(*job, slot);
+        }
+    }
+
+    void WorkerPool::runJob(Job& job, std::size_t slot)
+    {
+        for (;;)
+        {
+            const std::size_t index = job.next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= job.count)
+            {
+                return;
+            }
+            (*job.task)(index, slot);
+            if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.finished.notify_all();
+            }
+        }
+    }
+} // namespace rive_renderer_cpu
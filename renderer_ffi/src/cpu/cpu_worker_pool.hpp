@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rive_renderer_cpu
+{
+    // Fixed set of worker threads that run data-parallel loops. The calling thread always takes part in its own loop,
+    // so a pool with zero threads degrades to running inline. Several threads may run loops on one pool at once.
+    class WorkerPool
+    {
+    public:
+        using Task = std::function<void(std::size_t index, std::size_t slot)>;
+
+        explicit WorkerPool(std::size_t threadCount);
+        ~WorkerPool();
+
+        WorkerPool(const WorkerPool&)            = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        // Process-wide pool sized to the hardware, created on first use.
+        static WorkerPool& Shared();
+
+        // Number of distinct slot values a task can observe: one per worker thread plus the caller's slot 0.
+        std::size_t slotCount() const
+        {
+            return threads.size() + 1;
+        }
+
+        // Runs task(index, slot) for every index in [0, count) and returns once all of them have finished. Tasks that
+        // run concurrently always see different slots, so per-slot scratch needs no locking.
+        void parallelFor(std::size_t count, const Task& task);
+
+    private:
+        struct Job;
+
+        void workerMain(std::size_t slot);
+        static void runJob(Job& job, std::size_t slot);
+
+        std::vector<std::thread>         threads;
+        std::mutex                       mutex;
+        std::condition_variable          wake;
+        std::deque<std::shared_ptr<Job>> jobs;
+        bool                             stopping {false};
+    };
+} // namespace rive_renderer_cpu
@@ -8,6 +8,7 @@
 #import <UIKit/UIKit.h>
 #endif
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -25,6 +26,8 @@ namespace
         id<MTLCommandQueue> commandQueue;
     };
 
+    // Each frame takes one of framesInFlight slots from inFlightSemaphore when it begins and hands it back once its
+    // command buffer completes, at which point completedFrame advances to its frame number.
     struct RiveMetalContext
     {
         RiveMetalDevice*                        device {nullptr};
@@ -32,6 +35,10 @@ namespace
         id<MTLCommandBuffer>                    commandBuffer {nil};
         bool                                    hasActiveFrame {false};
         rive::rcp<rive::gpu::RenderTarget>      offscreenTarget;
+        dispatch_semaphore_t                    inFlightSemaphore {nil};
+        std::uint32_t                           framesInFlight {1};
+        std::uint64_t                           recordingFrame {0};
+        std::atomic<std::uint64_t>              completedFrame {0};
     };
 
     struct RiveMetalSurface
@@ -58,6 +65,44 @@ namespace
     {
         return CGSizeMake(static_cast<CGFloat>(width), static_cast<CGFloat>(height));
     }
+
+    void RecordCompletedFrame(std::atomic<std::uint64_t>* completed, std::uint64_t frame)
+    {
+        std::uint64_t previous = completed->load(std::memory_order_relaxed);
+        while (previous < frame && !completed->compare_exchange_weak(previous, frame, std::memory_order_release))
+        {
+        }
+    }
+
+    bool HoldsUncommittedFrame(RiveMetalContext* context)
+    {
+        return context->commandBuffer != nil && context->commandBuffer.status == MTLCommandBufferStatusNotEnqueued;
+    }
+
+    // A frame that failed between begin_frame and commit never completes, so its slot is handed back here.
+    void ReclaimAbandonedFrame(RiveMetalContext* context)
+    {
+        if (!context->hasActiveFrame && HoldsUncommittedFrame(context))
+        {
+            context->commandBuffer = nil;
+            dispatch_semaphore_signal(context->inFlightSemaphore);
+        }
+    }
+
+    // Waits for every committed frame by taking all slots, except the one held by a frame still being recorded.
+    void WaitForMetalFrames(RiveMetalContext* context)
+    {
+        const std::uint32_t held  = HoldsUncommittedFrame(context) ? 1u : 0u;
+        const std::uint32_t slots = context->framesInFlight - held;
+        for (std::uint32_t i = 0; i < slots; ++i)
+        {
+            dispatch_semaphore_wait(context->inFlightSemaphore, DISPATCH_TIME_FOREVER);
+        }
+        for (std::uint32_t i = 0; i < slots; ++i)
+        {
+            dispatch_semaphore_signal(context->inFlightSemaphore);
+        }
+    }
 } // namespace
 
 extern "C" void* rive_metal_device_new(rive_renderer_capabilities_t* caps)
@@ -170,6 +215,7 @@ rive_metal_context_create(void* device, std::uint32_t width, std::uint32_t heigh
         metalContext->offscreenTarget.reset();
         metalContext->commandBuffer = nil;
         metalContext->hasActiveFrame = false;
+        metalContext->inFlightSemaphore = dispatch_semaphore_create(metalContext->framesInFlight);
 
         *out_context        = metalContext;
         *out_render_context = std::move(renderContext);
@@ -190,7 +236,11 @@ extern "C" void rive_metal_context_destroy(void* context)
         {
             return;
         }
+        metalContext->hasActiveFrame = false;
+        ReclaimAbandonedFrame(metalContext);
+        WaitForMetalFrames(metalContext);
         metalContext->commandBuffer  = nil;
+        metalContext->inFlightSemaphore = nil;
         metalContext->offscreenTarget.reset();
         metalContext->impl           = nullptr;
         metalContext->device         = nullptr;
@@ -200,7 +250,8 @@ extern "C" void rive_metal_context_destroy(void* context)
 
 extern "C" rive_renderer_status_t
 rive_metal_context_begin_frame(void* context, rive::gpu::RenderContext* render_context, std::uint32_t* width,
-                               std::uint32_t* height, const rive_renderer_frame_options_t* options, void* surface)
+                               std::uint32_t* height, const rive_renderer_frame_options_t* options, void* surface,
+                               std::uint64_t frame_number)
 {
     if (context == nullptr || render_context == nullptr || width == nullptr || height == nullptr)
     {
@@ -237,14 +288,27 @@ rive_metal_context_begin_frame(void* context, rive::gpu::RenderContext* render_c
             return rive_renderer_status_t::invalid_parameter;
         }
 
+        // Only blocks once framesInFlight earlier frames are still on the GPU.
+        ReclaimAbandonedFrame(metalContext);
+        dispatch_semaphore_t semaphore = metalContext->inFlightSemaphore;
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+
         id<MTLCommandBuffer> commandBuffer = [metalContext->device->commandQueue commandBuffer];
         if (commandBuffer == nil)
         {
+            dispatch_semaphore_signal(semaphore);
             rive_renderer_set_last_error("failed to create Metal command buffer");
             return rive_renderer_status_t::internal_error;
         }
 
-        metalContext->commandBuffer = commandBuffer;
+        std::atomic<std::uint64_t>* completed = &metalContext->completedFrame;
+        [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer>) {
+          RecordCompletedFrame(completed, frame_number);
+          dispatch_semaphore_signal(semaphore);
+        }];
+
+        metalContext->commandBuffer  = commandBuffer;
+        metalContext->recordingFrame = frame_number;
 
         rive::rcp<rive::gpu::RenderTarget> target;
 
@@ -333,7 +397,8 @@ rive_metal_context_begin_frame(void* context, rive::gpu::RenderContext* render_c
 }
 
 extern "C" rive_renderer_status_t
-rive_metal_context_end_frame(void* context, rive::gpu::RenderContext* render_context, void* surface)
+rive_metal_context_end_frame(void* context, rive::gpu::RenderContext* render_context, void* surface,
+                             std::uint64_t frame_number, std::uint64_t safe_frame_number)
 {
     if (context == nullptr || render_context == nullptr)
     {
@@ -372,6 +437,8 @@ rive_metal_context_end_frame(void* context, rive::gpu::RenderContext* render_con
         }
 
         resources.externalCommandBuffer = (__bridge void*)metalContext->commandBuffer;
+        resources.currentFrameNumber    = frame_number;
+        resources.safeFrameNumber       = safe_frame_number;
         render_context->flush(resources);
         metalContext->hasActiveFrame = false;
         return rive_renderer_status_t::ok;
@@ -394,7 +461,12 @@ extern "C" rive_renderer_status_t rive_metal_context_submit(void* context, bool
             if (metalContext->commandBuffer != nil)
             {
                 [metalContext->commandBuffer commit];
-                [metalContext->commandBuffer waitUntilCompleted];
+                // A single frame in flight keeps submit synchronous, as callers may read the target right after it.
+                if (metalContext->framesInFlight == 1)
+                {
+                    [metalContext->commandBuffer waitUntilCompleted];
+                    RecordCompletedFrame(&metalContext->completedFrame, metalContext->recordingFrame);
+                }
                 metalContext->commandBuffer = nil;
             }
         }
@@ -403,6 +475,38 @@ extern "C" rive_renderer_status_t rive_metal_context_submit(void* context, bool
     }
 }
 
+extern "C" rive_renderer_status_t rive_metal_context_set_frames_in_flight(void* context, std::uint32_t count)
+{
+    auto* metalContext = static_cast<RiveMetalContext*>(context);
+    if (metalContext == nullptr)
+    {
+        rive_renderer_set_last_error("Metal context handle is null");
+        return rive_renderer_status_t::invalid_handle;
+    }
+
+    // The semaphore may only be released once every slot is back, which waiting for the frames guarantees.
+    ReclaimAbandonedFrame(metalContext);
+    WaitForMetalFrames(metalContext);
+    metalContext->inFlightSemaphore = dispatch_semaphore_create(count);
+    metalContext->framesInFlight    = count;
+    return rive_renderer_status_t::ok;
+}
+
+extern "C" void rive_metal_context_wait_idle(void* context)
+{
+    auto* metalContext = static_cast<RiveMetalContext*>(context);
+    if (metalContext != nullptr)
+    {
+        WaitForMetalFrames(metalContext);
+    }
+}
+
+extern "C" std::uint64_t rive_metal_context_completed_frame(void* context)
+{
+    auto* metalContext = static_cast<RiveMetalContext*>(context);
+    return metalContext != nullptr ? metalContext->completedFrame.load(std::memory_order_acquire) : 0;
+}
+
 extern "C" rive_renderer_status_t
 rive_metal_surface_create(void* device, void* context, const rive_renderer_surface_create_info_metal_layer_t* info,
                           void** out_surface)
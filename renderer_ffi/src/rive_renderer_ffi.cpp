@@ -3,12 +3,19 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <new>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include <limits>
 
@@ -19,18 +26,28 @@
 #include "rive/math/mat2d.hpp"
 #include "rive/math/transform_components.hpp"
 #include "rive/math/path_types.hpp"
+#include "rive/math/raw_path.hpp"
 #include "rive/shapes/paint/color.hpp"
 #include "rive/shapes/paint/stroke_cap.hpp"
 #include "rive/shapes/paint/stroke_join.hpp"
 #include "rive/shapes/paint/blend_mode.hpp"
 #include "rive/shapes/paint/image_sampler.hpp"
 #include "rive/span.hpp"
+#include "cpu/cpu_encode.hpp"
+#include "cpu/cpu_render_context.hpp"
 #if defined(WITH_RIVE_TEXT)
 #include "rive/text/utf.hpp"
 #include "rive/text/text.hpp"
 #include "rive/text_engine.hpp"
 #endif
 
+#if !defined(_WIN32)
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
 #define NOMINMAX
 #define WIN32_LEAN_AND_MEAN
@@ -54,10 +71,15 @@ extern "C"
     void rive_metal_context_destroy(void* context);
     rive_renderer_status_t rive_metal_context_begin_frame(void* context, rive::gpu::RenderContext* render_context,
                                                           std::uint32_t* width, std::uint32_t* height,
-                                                          const rive_renderer_frame_options_t* options, void* surface);
+                                                          const rive_renderer_frame_options_t* options, void* surface,
+                                                          std::uint64_t frame_number);
     rive_renderer_status_t rive_metal_context_end_frame(void* context, rive::gpu::RenderContext* render_context,
-                                                        void* surface);
+                                                        void* surface, std::uint64_t frame_number,
+                                                        std::uint64_t safe_frame_number);
     rive_renderer_status_t rive_metal_context_submit(void* context, bool has_surface);
+    rive_renderer_status_t rive_metal_context_set_frames_in_flight(void* context, std::uint32_t count);
+    void                   rive_metal_context_wait_idle(void* context);
+    std::uint64_t          rive_metal_context_completed_frame(void* context);
     rive_renderer_status_t rive_metal_surface_create(void* device, void* context,
                                                      const rive_renderer_surface_create_info_metal_layer_t* info,
                                                      void** out_surface);
@@ -290,16 +312,6 @@ namespace
     }
 #endif
 
-#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-    rive::gpu::RenderContextVulkanImpl* GetVulkanImpl(ContextHandle* context)
-    {
-        if (context == nullptr || context->renderContext == nullptr)
-        {
-            return nullptr;
-        }
-        return context->renderContext->static_impl_cast<rive::gpu::RenderContextVulkanImpl>();
-    }
-#endif
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
 
     HRESULT CreateRenderTargetTexture(ID3D12Device* device, std::uint32_t width, std::uint32_t height,
@@ -376,8 +388,13 @@ namespace
         context->renderTargetTexture.Reset();
         context->directCommandList.Reset();
         context->copyCommandList.Reset();
-        context->directAllocator.Reset();
-        context->copyAllocator.Reset();
+        for (auto& slot : context->frameSlots)
+        {
+            slot.directAllocator.Reset();
+            slot.copyAllocator.Reset();
+            slot.fenceValue  = 0;
+            slot.frameNumber = 0;
+        }
         context->directFence.Reset();
         context->copyFence.Reset();
         if (context->fenceEvent != nullptr)
@@ -386,6 +403,7 @@ namespace
             context->fenceEvent = nullptr;
         }
         context->cpuRenderTarget.reset();
+        context->cpuContext.reset();
         context->cpuFramebuffer.clear();
         context->cpuFrameRecording  = false;
         context->commandListsClosed = false;
@@ -394,8 +412,9 @@ namespace
     rive_renderer_status_t InitializeD3D12Context(DeviceHandle* device, ContextHandle* context, std::uint32_t width,
                                                   std::uint32_t height)
     {
-        HRESULT hr = device->d3d12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
-                                                                 IID_PPV_ARGS(&context->directAllocator));
+        auto&   slot = context->frameSlots[0];
+        HRESULT hr   = device->d3d12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                                   IID_PPV_ARGS(&slot.directAllocator));
         if (FAILED(hr))
         {
             SetLastError("CreateCommandAllocator (direct) failed");
@@ -403,14 +422,14 @@ namespace
         }
 
         hr = device->d3d12Device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY,
-                                                         IID_PPV_ARGS(&context->copyAllocator));
+                                                         IID_PPV_ARGS(&slot.copyAllocator));
         if (FAILED(hr))
         {
             SetLastError("CreateCommandAllocator (copy) failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        hr = device->d3d12Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, context->directAllocator.Get(),
+        hr = device->d3d12Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, slot.directAllocator.Get(),
                                                     nullptr, IID_PPV_ARGS(&context->directCommandList));
         if (FAILED(hr))
         {
@@ -418,7 +437,7 @@ namespace
             return rive_renderer_status_t::internal_error;
         }
 
-        hr = device->d3d12Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, context->copyAllocator.Get(),
+        hr = device->d3d12Device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, slot.copyAllocator.Get(),
                                                     nullptr, IID_PPV_ARGS(&context->copyCommandList));
         if (FAILED(hr))
         {
@@ -458,6 +477,7 @@ namespace
         std::atomic<std::uint32_t>   ref_count {1};
         rive_renderer_backend_t      backend {rive_renderer_backend_t::unknown};
         rive_renderer_capabilities_t capabilities {};
+        rive_renderer_cpu::SimdLevel cpuSimdLevel {rive_renderer_cpu::SimdLevel::portable};
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
         Microsoft::WRL::ComPtr<IDXGIAdapter1>      adapter;
         Microsoft::WRL::ComPtr<ID3D12Device>       d3d12Device;
@@ -505,22 +525,269 @@ namespace
             PFN_vkCreateImageView                          createImageView = nullptr;
             PFN_vkDestroyImageView                         destroyImageView = nullptr;
             PFN_vkCmdPipelineBarrier                       cmdPipelineBarrier = nullptr;
+            PFN_vkGetFenceStatus                           getFenceStatus = nullptr;
+            PFN_vkCreateImage                              createImage = nullptr;
+            PFN_vkDestroyImage                             destroyImage = nullptr;
+            PFN_vkGetImageMemoryRequirements               getImageMemoryRequirements = nullptr;
+            PFN_vkAllocateMemory                           allocateMemory = nullptr;
+            PFN_vkFreeMemory                               freeMemory = nullptr;
+            PFN_vkBindImageMemory                          bindImageMemory = nullptr;
+            PFN_vkGetPhysicalDeviceMemoryProperties        getPhysicalDeviceMemoryProperties = nullptr;
+            PFN_vkCreateBuffer                             createBuffer = nullptr;
+            PFN_vkDestroyBuffer                            destroyBuffer = nullptr;
+            PFN_vkGetBufferMemoryRequirements              getBufferMemoryRequirements = nullptr;
+            PFN_vkBindBufferMemory                         bindBufferMemory = nullptr;
+            PFN_vkMapMemory                                mapMemory = nullptr;
+            PFN_vkUnmapMemory                              unmapMemory = nullptr;
+            PFN_vkInvalidateMappedMemoryRanges             invalidateMappedMemoryRanges = nullptr;
+            PFN_vkCmdCopyImageToBuffer                     cmdCopyImageToBuffer = nullptr;
         } vk {};
 #endif
     };
 
     struct SurfaceHandle;
 
+    // Rectangles with left > right hold nothing. kUnboundedRect stands in for draws whose extent is unknown.
+    constexpr float                kRectInfinity = std::numeric_limits<float>::infinity();
+    constexpr rive_renderer_rect_t kEmptyRect {kRectInfinity, kRectInfinity, -kRectInfinity, -kRectInfinity};
+    constexpr rive_renderer_rect_t kUnboundedRect {-kRectInfinity, -kRectInfinity, kRectInfinity, kRectInfinity};
+
+    bool IsEmptyRect(const rive_renderer_rect_t& rect)
+    {
+        return rect.left > rect.right || rect.top > rect.bottom;
+    }
+
+    bool IsUnboundedRect(const rive_renderer_rect_t& rect)
+    {
+        return !IsEmptyRect(rect) && (std::isinf(rect.left) || std::isinf(rect.top) || std::isinf(rect.right) ||
+                                      std::isinf(rect.bottom));
+    }
+
+    void IncludePoint(rive_renderer_rect_t* rect, float x, float y)
+    {
+        rect->left   = std::min(rect->left, x);
+        rect->top    = std::min(rect->top, y);
+        rect->right  = std::max(rect->right, x);
+        rect->bottom = std::max(rect->bottom, y);
+    }
+
+    void IncludeRect(rive_renderer_rect_t* rect, const rive_renderer_rect_t& other)
+    {
+        if (!IsEmptyRect(other))
+        {
+            IncludePoint(rect, other.left, other.top);
+            IncludePoint(rect, other.right, other.bottom);
+        }
+    }
+
+    rive_renderer_rect_t IntersectRects(const rive_renderer_rect_t& a, const rive_renderer_rect_t& b)
+    {
+        return {std::max(a.left, b.left), std::max(a.top, b.top), std::min(a.right, b.right),
+                std::min(a.bottom, b.bottom)};
+    }
+
+    bool RectContains(const rive_renderer_rect_t& outer, const rive_renderer_rect_t& inner)
+    {
+        return IsEmptyRect(inner) || (inner.left >= outer.left && inner.top >= outer.top &&
+                                      inner.right <= outer.right && inner.bottom <= outer.bottom);
+    }
+
+    bool RectsOverlap(const rive_renderer_rect_t& a, const rive_renderer_rect_t& b)
+    {
+        return !IsEmptyRect(a) && !IsEmptyRect(b) && a.left <= b.right && b.left <= a.right && a.top <= b.bottom &&
+               b.top <= a.bottom;
+    }
+
+    rive_renderer_rect_t OutsetRect(const rive_renderer_rect_t& rect, float amount)
+    {
+        if (IsEmptyRect(rect))
+        {
+            return rect;
+        }
+        return {rect.left - amount, rect.top - amount, rect.right + amount, rect.bottom + amount};
+    }
+
+    // Bounds of rect's corners under matrix.
+    rive_renderer_rect_t TransformRect(const rive::Mat2D& matrix, const rive_renderer_rect_t& rect)
+    {
+        if (IsEmptyRect(rect) || IsUnboundedRect(rect))
+        {
+            return rect;
+        }
+        rive_renderer_rect_t result = kEmptyRect;
+        for (const rive::Vec2D corner : {rive::Vec2D {rect.left, rect.top}, rive::Vec2D {rect.right, rect.top},
+                                         rive::Vec2D {rect.right, rect.bottom}, rive::Vec2D {rect.left, rect.bottom}})
+        {
+            const rive::Vec2D mapped = matrix * corner;
+            IncludePoint(&result, mapped.x, mapped.y);
+        }
+        return result;
+    }
+
+    // Render paths shared by the paths of a context with interning enabled, keyed by a hash of their content. Each
+    // entry counts the path handles resolved to it and is dropped when the last one moves on. Handles may be released
+    // from any thread, so the table is locked; factory is cleared when the context goes away.
+    struct PathInternTable
+    {
+        struct Entry
+        {
+            rive::FillRule              fillRule {rive::FillRule::nonZero};
+            rive::RawPath               rawPath;
+            rive::rcp<rive::RenderPath> path;
+            std::uint32_t               users {0};
+        };
+
+        std::mutex                                    mutex;
+        rive::Factory*                                factory {nullptr};
+        std::unordered_multimap<std::uint64_t, Entry> entries;
+    };
+
+    // Render path a context built for an immutable path on first draw. owner expires once the immutable path is
+    // destroyed, after which the entry is only waiting to be swept.
+    struct ContextImmutablePath
+    {
+        std::weak_ptr<const void>   owner;
+        rive::rcp<rive::RenderPath> renderPath;
+    };
+
+    // Keyed by immutable path id.
+    using ImmutablePathCache = std::unordered_map<std::uint64_t, ContextImmutablePath>;
+
+    constexpr std::size_t kMinImmutablePathSweepSize = 64;
+
+    // Immutable paths are identified by a serial rather than their address, which a later path may reuse.
+    std::uint64_t NextImmutablePathId()
+    {
+        static std::atomic<std::uint64_t> next {1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct FenceHandle;
+    struct ReadbackHandle;
+    struct PaintHandle;
+    struct RendererHandle;
+
+    // Faded copy of a paint handle's paint, built when a picture replays below full opacity. The context keeps a
+    // reference to the paint handle while the entry exists; entries not used in the previous frame are dropped when
+    // the next one begins.
+    struct FadedPaint
+    {
+        rive::rcp<rive::RenderPaint> paint;
+        float                        opacity {1.0f};
+        std::uint32_t                version {0};
+        std::uint64_t                lastFrame {0};
+    };
+
+    using FadedPaintCache = std::unordered_map<PaintHandle*, FadedPaint>;
+
+    // Mapping of a shared framebuffer ring; see context_set_shared_framebuffer. sequence is the frame being rendered
+    // into its slot, or 0 between frames.
+    struct SharedFramebuffer
+    {
+        int           fd {-1};
+        std::uint8_t* base {nullptr};
+        std::size_t   size {0};
+        std::uint64_t sequence {0};
+        std::uint64_t lastSequence {0};
+
+        SharedFramebuffer() = default;
+        SharedFramebuffer(const SharedFramebuffer&)            = delete;
+        SharedFramebuffer& operator=(const SharedFramebuffer&) = delete;
+
+        ~SharedFramebuffer()
+        {
+#if !defined(_WIN32)
+            if (base != nullptr)
+            {
+                munmap(base, size);
+            }
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+#endif
+        }
+
+        rive_renderer_shared_framebuffer_header_t* header() const
+        {
+            return reinterpret_cast<rive_renderer_shared_framebuffer_header_t*>(base);
+        }
+    };
+
+    // Fence signal waiting for frame to finish on the GPU. The pending signal holds a reference to fence.
+    struct PendingFenceSignal
+    {
+        FenceHandle*  fence {nullptr};
+        std::uint64_t value {0};
+        std::uint64_t frame {0};
+    };
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+    // Host-visible buffer frames copy their target into for readback. pixels stays mapped while the buffer lives.
+    struct VulkanStagingBuffer
+    {
+        VkBuffer       buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void*          pixels {nullptr};
+        VkDeviceSize   capacity {0};
+        bool           coherent {false};
+        bool           inUse {false};
+        std::uint64_t  lastFrame {0}; // last frame that copied into the buffer
+    };
+#endif
+
+    // With damage tracking on, pendingDamage collects invalidations until begin_frame turns them into frameDamage.
+    // When that is smaller than the target, damageClip clips every renderer of the context to it.
+    //
+    // Up to framesInFlight submitted frames may still be running on the GPU. frameCounter is the number of the frame
+    // being recorded and lastCompletedFrame the newest one the GPU has finished; it is passed to rive as the safe frame
+    // number, so buffers used by later frames are not recycled early. readbacks lists the live readbacks of the
+    // context and fenceSignals the CPU fence signals still waiting on their frames. Fence waits on other threads also
+    // ask the GPU whether those frames are done, under completionMutex.
     struct ContextHandle
     {
         std::atomic<std::uint32_t>                ref_count {1};
+        std::shared_ptr<PathInternTable>          pathInterning;
+        // Render paths of the immutable paths drawn on this context. Only the thread driving the context touches
+        // them, so draws look them up without locking.
+        ImmutablePathCache                        immutablePaths;
+        std::size_t                               immutablePathSweepSize {kMinImmutablePathSweepSize};
+        // Paints of picture replays below full opacity. Kept here rather than in the picture, which any number of
+        // contexts and threads may replay at once.
+        FadedPaintCache                           fadedPaints;
+        // Totals for context_get_picture_stats. Renderers of the context may replay pictures from any thread.
+        std::atomic<std::uint64_t>                pictureDrawsReplayed {0};
+        std::atomic<std::uint64_t>                pictureDrawsCulled {0};
+        bool                                      internPaths {false};
+        bool                                      damageTracking {false};
+        std::uint32_t                             trackedFrames {0};
+        rive_renderer_rect_t                      pendingDamage {kEmptyRect};
+        rive_renderer_rect_t                      frameDamage {kUnboundedRect};
+        std::vector<rive_renderer_rect_t>         damageHistory;
+        rive::rcp<rive::RenderPath>               damageClip;
+        // Renderers created on the context, which begin_frame clips to the new damage. Renderers may be released from
+        // any thread, so the list is locked.
+        std::mutex                                renderersMutex;
+        std::vector<RendererHandle*>              renderers;
+        std::uint32_t                             framesInFlight {1};
+        bool                                      framebufferReadback {false};
+        std::vector<ReadbackHandle*>              readbacks;
+        std::vector<PendingFenceSignal>           fenceSignals;
+        std::mutex                                completionMutex;
         DeviceHandle*                             device {nullptr};
         std::uint32_t                             width {0};
         std::uint32_t                             height {0};
         std::unique_ptr<rive::gpu::RenderContext> renderContext;
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator>    directAllocator;
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator>    copyAllocator;
+        // Allocators of one frame in the ring. They can be reset once directFence reaches fenceValue.
+        struct FrameSlot
+        {
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator> directAllocator;
+            Microsoft::WRL::ComPtr<ID3D12CommandAllocator> copyAllocator;
+            UINT64                                         fenceValue {0};
+            std::uint64_t                                  frameNumber {0};
+        };
+        FrameSlot                                         frameSlots[RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT];
         Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> directCommandList;
         Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> copyCommandList;
         Microsoft::WRL::ComPtr<ID3D12Resource>            renderTargetTexture;
@@ -534,18 +801,56 @@ namespace
         void*           metalContext {nullptr};
         SurfaceHandle*  surface {nullptr};
 #elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        // Command buffer of one frame in the ring. fence is pending from submit until the GPU finishes frameNumber.
+        // With framebuffer readback on, the frame also copies the target into the slot's persistently mapped staging
+        // buffer, which holds readbackWidth x readbackHeight tightly packed pixels once the fence signals.
+        struct FrameSlot
+        {
+            VkCommandBuffer     commandBuffer = VK_NULL_HANDLE;
+            VkFence             fence = VK_NULL_HANDLE;
+            std::uint64_t       frameNumber {0};
+            bool                submitted {false};
+            VulkanStagingBuffer readback;
+            bool                readbackRecorded {false};
+            std::uint32_t       readbackWidth {0};
+            std::uint32_t       readbackHeight {0};
+        };
         SurfaceHandle*  surface {nullptr};
         VkCommandPool   commandPool = VK_NULL_HANDLE;
         bool            needsSwapchainRecreation {false};
+        FrameSlot       frameSlots[RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT];
+        FrameSlot*      readbackSlot {nullptr}; // newest submitted frame that copied the target
+        std::uint64_t   recycledFrame {0};      // newest frame whose slot was reused, under completionMutex
+        // Staging buffers of readback requests, reused once their readbacks are released.
+        std::vector<std::unique_ptr<VulkanStagingBuffer>> stagingPool;
+        // Offscreen target owned by the context. targetAccess is how the last flushed frame left the image.
+        VkImage                                      targetImage = VK_NULL_HANDLE;
+        VkDeviceMemory                               targetMemory = VK_NULL_HANDLE;
+        VkImageView                                  targetView = VK_NULL_HANDLE;
+        rive::gpu::vkutil::ImageAccess               targetAccess {};
+        rive::rcp<rive::gpu::RenderTargetVulkanImpl> renderTarget;
+#else
+        SurfaceHandle* surface {nullptr};
 #endif
-        std::unique_ptr<rive::gpu::RenderTarget> cpuRenderTarget;
-        std::vector<uint8_t>                     cpuFramebuffer;
-        std::uint64_t                            frameCounter {1};
-        std::uint64_t                            lastCompletedFrame {0};
-        std::uint64_t                            pendingFrameNumber {0};
-        bool                                     hasActiveFrame {false};
-        bool                                     commandListsClosed {false};
-        bool                                     cpuFrameRecording = false;
+        std::unique_ptr<rive::gpu::RenderTarget>             cpuRenderTarget;
+        std::unique_ptr<rive_renderer_cpu::CpuRenderContext> cpuContext;
+        std::vector<uint8_t>                                 cpuFramebuffer;
+        // Caller-owned memory the null backend renders into instead of cpuFramebuffer while it is bound.
+        std::uint8_t*                                        externalFramebuffer {nullptr};
+        std::size_t                                          externalStride {0};
+        std::size_t                                          externalLength {0};
+        rive_renderer_pixel_format_t                         externalFormat {};
+        std::unique_ptr<SharedFramebuffer>                   sharedFramebuffer;
+        // Encoder state reused across encode_framebuffer calls, and output buffers handed back by released images.
+        std::unique_ptr<rive_renderer_cpu::EncodeScratch>    encodeScratch;
+        std::mutex                                           encodedBuffersMutex;
+        std::vector<std::vector<std::uint8_t>>               encodedBuffers;
+        std::uint64_t                                        frameCounter {1};
+        std::uint64_t                                        lastCompletedFrame {0};
+        std::uint64_t                                        pendingFrameNumber {0};
+        bool                                                 hasActiveFrame {false};
+        bool                                                 commandListsClosed {false};
+        bool                                                 cpuFrameRecording = false;
     };
 
     DeviceHandle* ToDevice(const rive_renderer_device_t& device)
@@ -558,23 +863,231 @@ namespace
         return static_cast<ContextHandle*>(context.handle);
     }
 
+    // Slot of the frame ring used by the frame being recorded, on the backends that keep one. A template since only
+    // those backends declare ContextHandle::FrameSlot.
+    template <typename Context> auto* CurrentFrameSlot(Context* context)
+    {
+        return &context->frameSlots[context->frameCounter % context->framesInFlight];
+    }
+
+    // Premultiplied RGBA8 pixels the null backend renders into.
+    struct CpuFramebufferView
+    {
+        std::uint8_t* pixels;
+        std::size_t   stride;
+    };
+
+    CpuFramebufferView GetCpuFramebuffer(ContextHandle* context)
+    {
+        if (context->externalFramebuffer != nullptr)
+        {
+            return {context->externalFramebuffer, context->externalStride};
+        }
+        return {context->cpuFramebuffer.data(), static_cast<std::size_t>(context->width) * 4};
+    }
+
+    // True when length bytes of rows stride bytes apart hold a width x height RGBA8 image.
+    bool FitsPixelRows(std::size_t length, std::size_t stride, std::uint32_t width, std::uint32_t height)
+    {
+        const std::size_t rowBytes = static_cast<std::size_t>(width) * 4;
+        return stride >= rowBytes && length >= rowBytes && (length - rowBytes) / stride >= height - 1;
+    }
+
+    static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t) &&
+                      std::atomic<std::uint64_t>::is_always_lock_free,
+                  "shared framebuffer sequences are accessed as lock-free atomics");
+
+    // Sequence numbers in a shared framebuffer header, which other processes read concurrently.
+    std::atomic<std::uint64_t>& SharedSequence(std::uint64_t& value)
+    {
+        return *reinterpret_cast<std::atomic<std::uint64_t>*>(&value);
+    }
+
+    // Maps a ring of slotCount width x height frames in new anonymous shared memory and fills in its header.
+    rive_renderer_status_t CreateSharedFramebuffer(std::uint32_t width, std::uint32_t height, std::uint32_t slotCount,
+                                                   rive_renderer_pixel_format_t        format,
+                                                   std::unique_ptr<SharedFramebuffer>* out_framebuffer)
+    {
+#if defined(_WIN32)
+        (void)width;
+        (void)height;
+        (void)slotCount;
+        (void)format;
+        (void)out_framebuffer;
+        SetLastError("shared framebuffers are not supported on Windows");
+        return rive_renderer_status_t::unsupported;
+#else
+        // Slots start on page boundaries so readers can map them individually.
+        constexpr std::size_t kPageSize = 4096;
+        const std::size_t     stride    = static_cast<std::size_t>(width) * 4;
+        const std::size_t     slotSize  = (stride * height + kPageSize - 1) / kPageSize * kPageSize;
+        const std::size_t     size      = kPageSize + slotSize * slotCount;
+
+        auto framebuffer = std::make_unique<SharedFramebuffer>();
+#if defined(__linux__)
+        framebuffer->fd = memfd_create("rive-renderer-framebuffer", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+        // shm_open needs a name; unlinking it right away leaves the descriptor as the only way to the memory.
+        static std::atomic<std::uint32_t> counter {0};
+        char                              name[64];
+        std::snprintf(name, sizeof(name), "/rive-renderer-%d-%u", static_cast<int>(getpid()),
+                      counter.fetch_add(1, std::memory_order_relaxed));
+        framebuffer->fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (framebuffer->fd >= 0)
+        {
+            shm_unlink(name);
+        }
+#endif
+        if (framebuffer->fd < 0)
+        {
+            SetLastError("failed to create shared framebuffer memory");
+            return rive_renderer_status_t::internal_error;
+        }
+        if (ftruncate(framebuffer->fd, static_cast<off_t>(size)) != 0)
+        {
+            SetLastError("failed to size shared framebuffer memory");
+            return rive_renderer_status_t::out_of_memory;
+        }
+#if defined(F_ADD_SEALS)
+        // A reader that shrinks the memory would make the renderer fault on its next frame.
+        if (fcntl(framebuffer->fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0)
+        {
+            SetLastError("failed to seal shared framebuffer memory");
+            return rive_renderer_status_t::internal_error;
+        }
+#endif
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, framebuffer->fd, 0);
+        if (base == MAP_FAILED)
+        {
+            SetLastError("failed to map shared framebuffer memory");
+            return rive_renderer_status_t::out_of_memory;
+        }
+        framebuffer->base = static_cast<std::uint8_t*>(base);
+        framebuffer->size = size;
+
+        auto* header        = framebuffer->header();
+        header->magic       = RIVE_RENDERER_SHARED_FRAMEBUFFER_MAGIC;
+        header->version     = RIVE_RENDERER_SHARED_FRAMEBUFFER_VERSION;
+        header->width       = width;
+        header->height      = height;
+        header->slot_count  = slotCount;
+        header->format      = format;
+        header->stride      = stride;
+        header->slot_offset = kPageSize;
+        header->slot_size   = slotSize;
+        *out_framebuffer    = std::move(framebuffer);
+        return rive_renderer_status_t::ok;
+#endif
+    }
+
+    // Points the context's bound framebuffer at the next slot of its shared ring and marks the slot as being written.
+    void BeginSharedFrame(ContextHandle* context)
+    {
+        auto&         shared = *context->sharedFramebuffer;
+        auto*         header = shared.header();
+        std::uint64_t slot   = (shared.lastSequence + 1) % header->slot_count;
+        shared.sequence      = shared.lastSequence + 1;
+        SharedSequence(header->slot_sequences[slot]).store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        context->externalFramebuffer = shared.base + header->slot_offset + slot * header->slot_size;
+        context->externalStride      = header->stride;
+        context->externalLength      = header->slot_size;
+        context->externalFormat      = header->format;
+    }
+
+    // Publishes the frame rendered since BeginSharedFrame to readers of the ring.
+    void PublishSharedFrame(ContextHandle* context)
+    {
+        auto& shared = *context->sharedFramebuffer;
+        auto* header = shared.header();
+        SharedSequence(header->slot_sequences[shared.sequence % header->slot_count])
+            .store(shared.sequence, std::memory_order_release);
+        SharedSequence(header->latest_sequence).store(shared.sequence, std::memory_order_release);
+        shared.lastSequence = shared.sequence;
+        shared.sequence     = 0;
+    }
+
+    // Resources are created by the GPU render context when there is one; the null backend falls back to the
+    // software rasterizer so paths, paints and renderers work without a GPU.
+    rive::Factory* GetFactory(ContextHandle* context)
+    {
+        if (context->renderContext)
+        {
+            return context->renderContext.get();
+        }
+        return context->cpuContext.get();
+    }
+
+    // Paths created while their context interns paths record edits into rawPath instead of a render path of their
+    // own. ResolvePath then points path at the shared render path with the same content before it is drawn. bounds
+    // covers every point and control point added since the last rewind; pictures cull their draws with it. version
+    // changes with every edit.
     struct PathHandle
     {
-        std::atomic<std::uint32_t>  ref_count {1};
-        rive::rcp<rive::RenderPath> path;
+        std::atomic<std::uint32_t>       ref_count {1};
+        rive::rcp<rive::RenderPath>      path;
+        std::shared_ptr<PathInternTable> interning;
+        rive::RawPath                    rawPath;
+        rive::FillRule                   fillRule {rive::FillRule::nonZero};
+        bool                             dirty {true};
+        PathInternTable::Entry*          entry {nullptr};
+        std::uint64_t                    entryHash {0};
+        rive_renderer_rect_t             bounds {kEmptyRect};
+        std::uint32_t                    version {0};
+    };
+
+    // Definition a gradient shader was created from, kept so pictures can rebuild it with faded colors.
+    struct GradientSpec
+    {
+        bool                        radial {false};
+        float                       coords[4] {}; // start and end for linear, center and radius for radial
+        std::vector<rive::ColorInt> colors;
+        std::vector<float>          stops;
+    };
+
+    // Mirror of the state last set on a paint. RenderPaint has no getters, so pictures replayed below full opacity
+    // build their faded paints from this. version changes with every setter.
+    struct PaintState
+    {
+        rive::RenderPaintStyle              style {rive::RenderPaintStyle::fill};
+        rive::ColorInt                      color {0xff000000};
+        float                               thickness {1.0f};
+        rive::StrokeJoin                    join {rive::StrokeJoin::miter};
+        rive::StrokeCap                     cap {rive::StrokeCap::butt};
+        float                               feather {0.0f};
+        rive::BlendMode                     blendMode {rive::BlendMode::srcOver};
+        rive::rcp<rive::RenderShader>       shader;
+        std::shared_ptr<const GradientSpec> gradient;
+        std::uint32_t                       version {0};
     };
 
     struct PaintHandle
     {
         std::atomic<std::uint32_t>   ref_count {1};
         rive::rcp<rive::RenderPaint> paint;
+        PaintState                   state;
     };
 
+    class PictureRecorder;
+
+    // Transform and device-space clip bounds of a renderer. rive::Renderer cannot be queried, so calls made through
+    // the FFI keep a copy to cull picture draws against.
+    struct RendererState
+    {
+        rive::Mat2D          matrix;
+        rive_renderer_rect_t clipBounds {kUnboundedRect};
+    };
+
+    // recorder is set when renderer is a PictureRecorder, which then records every call instead of drawing it.
     struct RendererHandle
     {
         std::atomic<std::uint32_t>          ref_count {1};
         ContextHandle*                      context {nullptr};
-        std::unique_ptr<rive::RiveRenderer> renderer;
+        std::unique_ptr<rive::Renderer>     renderer;
+        PictureRecorder*                    recorder {nullptr};
+        RendererState                       state;
+        std::vector<RendererState>          stateStack;
+        bool                                damageClipped {false};
     };
 
     PathHandle* ToPath(const rive_renderer_path_t& path)
@@ -582,6 +1095,163 @@ namespace
         return static_cast<PathHandle*>(path.handle);
     }
 
+    bool IsValidPath(const PathHandle* handle)
+    {
+        return handle != nullptr && (handle->path || handle->interning);
+    }
+
+    // FNV-1a over the fill rule, verbs and raw point bits.
+    std::uint64_t HashPathCommands(std::uint8_t fillRule, const std::uint8_t* verbs, std::size_t verbCount,
+                                   const float* points, std::size_t pointCount)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        auto          mix  = [&hash](const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const std::uint8_t*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+            }
+        };
+        const std::uint64_t count = verbCount;
+        mix(&fillRule, sizeof(fillRule));
+        mix(&count, sizeof(count));
+        mix(verbs, verbCount);
+        mix(points, pointCount * 2 * sizeof(float));
+        return hash;
+    }
+
+    std::uint64_t HashRawPath(rive::FillRule fillRule, const rive::RawPath& rawPath)
+    {
+        const auto verbs  = rawPath.verbs();
+        const auto points = rawPath.points();
+        return HashPathCommands(static_cast<std::uint8_t>(fillRule),
+                                reinterpret_cast<const std::uint8_t*>(verbs.data()), verbs.size(),
+                                reinterpret_cast<const float*>(points.data()), points.size());
+    }
+
+    bool SameRawPath(const rive::RawPath& a, const rive::RawPath& b)
+    {
+        const auto aVerbs  = a.verbs();
+        const auto bVerbs  = b.verbs();
+        const auto aPoints = a.points();
+        const auto bPoints = b.points();
+        return aVerbs.size() == bVerbs.size() && aPoints.size() == bPoints.size() &&
+               std::memcmp(aVerbs.data(), bVerbs.data(), aVerbs.size() * sizeof(rive::PathVerb)) == 0 &&
+               std::memcmp(aPoints.data(), bPoints.data(), aPoints.size() * sizeof(rive::Vec2D)) == 0;
+    }
+
+    // Drops the handle's use of its intern entry. The table must be locked.
+    void LeaveInternEntry(PathInternTable& table, PathHandle* handle)
+    {
+        if (handle->entry == nullptr)
+        {
+            return;
+        }
+        if (--handle->entry->users == 0)
+        {
+            auto range = table.entries.equal_range(handle->entryHash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (&it->second == handle->entry)
+                {
+                    table.entries.erase(it);
+                    break;
+                }
+            }
+        }
+        handle->entry = nullptr;
+    }
+
+    // Returns the render path to draw for a path handle. Interned paths edited since they were last drawn are matched
+    // to the table entry with the same content, which is created on a miss; a path rebuilt with unchanged content
+    // every frame therefore keeps the shared render path and whatever it has cached.
+    rive::RenderPath* ResolvePath(PathHandle* handle)
+    {
+        if (!handle->interning || !handle->dirty)
+        {
+            return handle->path.get();
+        }
+
+        PathInternTable&            table = *handle->interning;
+        std::lock_guard<std::mutex> lock(table.mutex);
+        const std::uint64_t         hash  = HashRawPath(handle->fillRule, handle->rawPath);
+        PathInternTable::Entry*     entry = nullptr;
+        auto                        range = table.entries.equal_range(hash);
+        for (auto it = range.first; it != range.second && entry == nullptr; ++it)
+        {
+            if (it->second.fillRule == handle->fillRule && SameRawPath(it->second.rawPath, handle->rawPath))
+            {
+                entry = &it->second;
+            }
+        }
+
+        if (entry == nullptr)
+        {
+            if (table.factory == nullptr)
+            {
+                return nullptr;
+            }
+            rive::rcp<rive::RenderPath> path = table.factory->makeEmptyRenderPath();
+            if (!path)
+            {
+                return nullptr;
+            }
+            path->fillRule(handle->fillRule);
+            path->addRawPath(handle->rawPath);
+            entry           = &table.entries.emplace(hash, PathInternTable::Entry())->second;
+            entry->fillRule = handle->fillRule;
+            entry->rawPath  = handle->rawPath;
+            entry->path     = std::move(path);
+        }
+
+        // Join the new entry before leaving the old one so an unchanged path never drops its own entry.
+        ++entry->users;
+        LeaveInternEntry(table, handle);
+        handle->entry     = entry;
+        handle->entryHash = hash;
+        handle->path      = entry->path;
+        handle->dirty     = false;
+        return handle->path.get();
+    }
+
+    // Returns the raw path to edit when the handle is interned, marking it for re-resolution, or null when edits go
+    // to the handle's own render path.
+    rive::RawPath* EditInternedPath(PathHandle* handle)
+    {
+        if (!handle->interning)
+        {
+            return nullptr;
+        }
+        handle->dirty = true;
+        return &handle->rawPath;
+    }
+
+    // Moves an interned handle's current content into a render path of its own and stops interning it.
+    bool DetachInternedPath(PathHandle* handle)
+    {
+        {
+            PathInternTable&            table = *handle->interning;
+            std::lock_guard<std::mutex> lock(table.mutex);
+            if (table.factory == nullptr)
+            {
+                return false;
+            }
+            rive::rcp<rive::RenderPath> path = table.factory->makeEmptyRenderPath();
+            if (!path)
+            {
+                return false;
+            }
+            path->fillRule(handle->fillRule);
+            path->addRawPath(handle->rawPath);
+            LeaveInternEntry(table, handle);
+            handle->path = std::move(path);
+        }
+        handle->interning.reset();
+        handle->rawPath.rewind();
+        return true;
+    }
+
     PaintHandle* ToPaint(const rive_renderer_paint_t& paint)
     {
         return static_cast<PaintHandle*>(paint.handle);
@@ -615,8 +1285,9 @@ namespace
 
     struct ShaderHandle
     {
-        std::atomic<std::uint32_t>    ref_count {1};
-        rive::rcp<rive::RenderShader> shader;
+        std::atomic<std::uint32_t>          ref_count {1};
+        rive::rcp<rive::RenderShader>       shader;
+        std::shared_ptr<const GradientSpec> gradient;
     };
 
     BufferHandle* ToBuffer(const rive_renderer_buffer_t& buffer)
@@ -639,1184 +1310,5976 @@ namespace
         return static_cast<ShaderHandle*>(shader.handle);
     }
 
-    struct FenceHandle
+    // Geometry shared by every context on a device, fixed at creation and read without locking. Each context keeps
+    // the render path it builds from it in ContextHandle::immutablePaths, watching lifetime to know when to drop it.
+    struct ImmutablePathHandle
     {
-        std::atomic<std::uint32_t> ref_count {1};
-        DeviceHandle*              device {nullptr};
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        Microsoft::WRL::ComPtr<ID3D12Fence> fence;
-        HANDLE                                   eventHandle {nullptr};
-        std::atomic<std::uint64_t>              lastValue {0};
-#endif
+        std::atomic<std::uint32_t>  ref_count {1};
+        std::uint64_t               id {NextImmutablePathId()};
+        std::shared_ptr<const void> lifetime {std::make_shared<std::uint8_t>()};
+        DeviceHandle*               device {nullptr};
+        rive::FillRule              fillRule {rive::FillRule::nonZero};
+        rive::RawPath               rawPath;
+        rive_renderer_rect_t        bounds {};
+        std::uint64_t               hash {0};
     };
 
-    FenceHandle* ToFence(const rive_renderer_fence_t& fence)
+    ImmutablePathHandle* ToImmutablePath(const rive_renderer_immutable_path_t& path)
     {
-        return static_cast<FenceHandle*>(fence.handle);
+        return static_cast<ImmutablePathHandle*>(path.handle);
     }
 
-    struct SurfaceHandle
+    // Slots are indices into per-buffer tables; the cap keeps a bad slot from allocating unbounded memory.
+    constexpr std::uint32_t kMaxCommandSlots = 1u << 20;
+
+    struct CommandBufferHandle
     {
-        std::atomic<std::uint32_t>        ref_count {1};
-        DeviceHandle*                     device {nullptr};
-        ContextHandle*                    context {nullptr};
-        rive_renderer_backend_t           backend {rive_renderer_backend_t::unknown};
-        std::uint32_t                     width {0};
-        std::uint32_t                     height {0};
-        std::uint32_t                     buffer_count {0};
-        rive_renderer_surface_flags_t     flags {rive_renderer_surface_flags_t::none};
-        std::uint32_t                     present_interval {1};
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        void* hwnd {nullptr};
-        Microsoft::WRL::ComPtr<IDXGISwapChain3> swapChain;
-        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> backBuffers;
-        std::vector<rive::rcp<rive::gpu::RenderTarget>>     renderTargets;
-        UINT borrowedIndex {std::numeric_limits<UINT>::max()};
-        bool supportsTearing {false};
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-        void* metalSurface {nullptr};
-#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-        VkSurfaceKHR                              vkSurface {VK_NULL_HANDLE};
-        VkSwapchainKHR                            swapchain {VK_NULL_HANDLE};
-        VkFormat                                  imageFormat {VK_FORMAT_UNDEFINED};
-        VkExtent2D                                extent {0, 0};
-        VkPresentModeKHR                          presentMode {VK_PRESENT_MODE_FIFO_KHR};
-        std::vector<VkImage>                      swapchainImages;
-        std::vector<VkImageView>                  imageViews;
-        struct VulkanFrame
-        {
-            VkCommandBuffer                        commandBuffer = VK_NULL_HANDLE;
-            VkFence                                inFlightFence = VK_NULL_HANDLE;
-            VkSemaphore                            imageAvailable = VK_NULL_HANDLE;
-            VkSemaphore                            renderFinished = VK_NULL_HANDLE;
-            rive::gpu::vkutil::ImageAccess         imageAccess {};
-            rive::rcp<rive::gpu::RenderTarget>     renderTarget;
-        };
-        std::vector<VulkanFrame>                  frames;
-        uint32_t                                  currentImageIndex {0};
-        bool                                      swapchainOutOfDate {false};
-        bool                                      suboptimal {false};
-#endif
+        std::atomic<std::uint32_t>                ref_count {1};
+        ContextHandle*                            context {nullptr};
+        std::vector<std::uint8_t>                 commands;
+        std::vector<PathHandle*>                  paths;
+        std::vector<PaintHandle*>                 paints;
+        std::vector<rive::rcp<rive::RenderImage>> images;
     };
 
-    SurfaceHandle* ToSurface(const rive_renderer_surface_t& surface)
+    CommandBufferHandle* ToCommandBuffer(const rive_renderer_command_buffer_t& buffer)
     {
-        return static_cast<SurfaceHandle*>(surface.handle);
+        return static_cast<CommandBufferHandle*>(buffer.handle);
     }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-    bool CheckTearingSupport()
+    template <typename T> void BindCommandSlot(std::vector<rive::rcp<T>>* slots, std::uint32_t slot, rive::rcp<T> value)
     {
-        Microsoft::WRL::ComPtr<IDXGIFactory5> factory5;
-        if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory5))))
+        if (slot >= slots->size())
         {
-            return false;
+            slots->resize(static_cast<std::size_t>(slot) + 1);
         }
+        (*slots)[slot] = std::move(value);
+    }
 
-        BOOL allowTearing = FALSE;
-        if (FAILED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing,
-                                                 sizeof(allowTearing))))
-        {
-            return false;
-        }
-        return allowTearing == TRUE;
+    template <typename T> T* LookupCommandSlot(const std::vector<rive::rcp<T>>& slots, std::uint32_t slot)
+    {
+        return slot < slots.size() ? slots[slot].get() : nullptr;
     }
 
-    void ReturnSurfaceRenderTarget(ContextHandle* context)
+    template <typename T> T* LookupCommandHandle(const std::vector<T*>& slots, std::uint32_t slot)
     {
-        if (context == nullptr || context->surface == nullptr)
+        return slot < slots.size() ? slots[slot] : nullptr;
+    }
+
+    // One recorded renderer call. Draws keep their resources alive. paintHandle is retained for path draws recorded
+    // through a paint handle, whose mirrored state lets replays below full opacity build a faded paint; ops are shared
+    // by every replay, so the replaying context caches those. pathHandle is retained when the recorded render path is
+    // the handle's own and so still takes its edits; replays read the path's current bounds from it. pathBounds
+    // holds the local bounds of a clip or draw path, paintOutset how far paintHandle reached past them, and bounds the
+    // picture-space bounds of a draw after clipping, either unbounded when unknown. All three are as recorded, as are
+    // pathVersion and paintVersion, the versions of pathHandle and paintHandle.
+    struct PictureOp
+    {
+        enum class Kind : std::uint8_t
         {
-            return;
-        }
+            save,
+            restore,
+            transform,
+            clipPath,
+            drawPath,
+            drawImage,
+            drawImageMesh,
+        };
 
-        auto* surface = context->surface;
-        if (surface->borrowedIndex != std::numeric_limits<UINT>::max() && surface->borrowedIndex <
-                                                                        surface->renderTargets.size())
+        Kind                          kind {Kind::save};
+        rive::Mat2D                   matrix;
+        rive::rcp<rive::RenderPath>   path;
+        rive::rcp<rive::RenderPaint>  paint;
+        PaintHandle*                  paintHandle {nullptr};
+        PathHandle*                   pathHandle {nullptr};
+        rive::rcp<rive::RenderImage>  image;
+        rive::ImageSampler            sampler;
+        rive::BlendMode               blendMode {rive::BlendMode::srcOver};
+        float                         opacity {1.0f};
+        rive::rcp<rive::RenderBuffer> vertices;
+        rive::rcp<rive::RenderBuffer> uvCoords;
+        rive::rcp<rive::RenderBuffer> indices;
+        std::uint32_t                 vertexCount {0};
+        std::uint32_t                 indexCount {0};
+        rive_renderer_rect_t          pathBounds {kUnboundedRect};
+        float                         paintOutset {0.0f};
+        rive_renderer_rect_t          bounds {kUnboundedRect};
+        std::uint32_t                 pathVersion {0};
+        std::uint32_t                 paintVersion {0};
+    };
+
+    bool IsDrawOp(PictureOp::Kind kind)
+    {
+        return kind == PictureOp::Kind::drawPath || kind == PictureOp::Kind::drawImage ||
+               kind == PictureOp::Kind::drawImageMesh;
+    }
+
+    void ReleasePictureOps(std::vector<PictureOp>* ops)
+    {
+        for (PictureOp& op : *ops)
         {
-            if (context->renderTarget)
+            if (op.paintHandle != nullptr)
             {
-                surface->renderTargets[surface->borrowedIndex] = std::move(context->renderTarget);
+                rive_renderer_paint_release({op.paintHandle});
+            }
+            if (op.pathHandle != nullptr)
+            {
+                rive_renderer_path_release({op.pathHandle});
             }
-            context->renderTargetTexture.Reset();
         }
-        else if (context->renderTarget)
+        ops->clear();
+    }
+
+    // How far paint reaches past the bounds of the path it draws: up to twice the stroke width for mitered joins (half
+    // the width times the miter limit of 4), the full width otherwise, and three standard deviations of the feather
+    // blur.
+    float PaintOutset(const PaintState& paint)
+    {
+        float outset = 1.5f * paint.feather;
+        if (paint.style == rive::RenderPaintStyle::stroke)
         {
-            context->renderTarget.reset();
-            context->renderTargetTexture.Reset();
+            outset += paint.thickness * (paint.join == rive::StrokeJoin::miter ? 2.0f : 1.0f);
         }
-        surface->borrowedIndex = std::numeric_limits<UINT>::max();
+        return outset;
     }
 
-    rive_renderer_status_t CreateSurfaceRenderTargets(SurfaceHandle* surface, std::uint32_t width,
-                                                      std::uint32_t height)
+    // Returns the path handle a picture must retain to follow later edits of path, or null when the render path
+    // drawn is shared or immutable and so cannot change under the picture.
+    PathHandle* EditablePath(PathHandle* path)
     {
-        if (surface == nullptr || surface->context == nullptr || surface->device == nullptr)
+        return path != nullptr && !path->interning ? path : nullptr;
+    }
+
+    // Renderer that records calls for a picture instead of drawing them. Path draws and clips that come through the
+    // FFI go through recordPath and recordClip so the picture can fade and cull them on replay. The recorder tracks
+    // its own transform and clip bounds to place every draw in picture space.
+    class PictureRecorder final : public rive::Renderer
+    {
+    public:
+        ~PictureRecorder() override
         {
-            SetLastError("surface context or device is null");
-            return rive_renderer_status_t::internal_error;
+            ReleasePictureOps(&ops);
         }
 
-        auto* context = surface->context;
-        auto* impl    = GetD3D12Impl(context);
-        if (impl == nullptr)
+        void save() override
         {
-            SetLastError("render context not initialized");
-            return rive_renderer_status_t::internal_error;
+            push(PictureOp::Kind::save);
+            stack.push_back(state);
         }
 
-        surface->backBuffers.clear();
-        surface->renderTargets.clear();
-
-        surface->backBuffers.reserve(surface->buffer_count);
-        surface->renderTargets.reserve(surface->buffer_count);
-
-        for (std::uint32_t i = 0; i < surface->buffer_count; ++i)
+        void restore() override
         {
-            Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
-            HRESULT hr = surface->swapChain->GetBuffer(i, IID_PPV_ARGS(&buffer));
-            if (FAILED(hr))
+            push(PictureOp::Kind::restore);
+            if (!stack.empty())
             {
-                SetLastError("swapchain get buffer failed");
-                return rive_renderer_status_t::internal_error;
+                state = stack.back();
+                stack.pop_back();
             }
+        }
 
-            auto renderTarget = impl->makeRenderTarget(width, height);
-            if (!renderTarget)
-            {
-                SetLastError("makeRenderTarget failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            renderTarget->setTargetTexture(buffer);
+        void transform(const rive::Mat2D& matrix) override
+        {
+            push(PictureOp::Kind::transform).matrix = matrix;
+            state.matrix                            = state.matrix * matrix;
+        }
 
-            surface->backBuffers.emplace_back(std::move(buffer));
-            surface->renderTargets.emplace_back(std::move(renderTarget));
+        void clipPath(rive::RenderPath* path) override
+        {
+            push(PictureOp::Kind::clipPath).path = rive::ref_rcp(path);
         }
 
-        surface->borrowedIndex = std::numeric_limits<UINT>::max();
-        return rive_renderer_status_t::ok;
-    }
+        void recordClip(rive::RenderPath* path, PathHandle* source, const rive_renderer_rect_t& pathBounds)
+        {
+            clipPath(path);
+            retain(source);
+            ops.back().pathBounds = pathBounds;
+            state.clipBounds      = IntersectRects(state.clipBounds, TransformRect(state.matrix, pathBounds));
+        }
 
-    rive_renderer_status_t EnsureD3D12SurfaceRenderTarget(ContextHandle* context)
-    {
-        auto* surface = context->surface;
-        if (surface == nullptr || surface->swapChain == nullptr)
+        void drawPath(rive::RenderPath* path, rive::RenderPaint* paint) override
         {
-            SetLastError("surface not initialized");
-            return rive_renderer_status_t::invalid_handle;
+            PictureOp& op = push(PictureOp::Kind::drawPath);
+            op.path       = rive::ref_rcp(path);
+            op.paint      = rive::ref_rcp(paint);
+            op.bounds     = state.clipBounds;
         }
 
-        UINT backIndex = surface->swapChain->GetCurrentBackBufferIndex();
-        if (backIndex >= surface->renderTargets.size())
+        void recordPath(rive::RenderPath* path, PathHandle* source, PaintHandle* paint,
+                        const rive_renderer_rect_t& pathBounds)
         {
-            SetLastError("swapchain buffer index out of range");
-            return rive_renderer_status_t::internal_error;
+            drawPath(path, paint->paint.get());
+            retain(source);
+            paint->ref_count.fetch_add(1, std::memory_order_relaxed);
+            PictureOp& op = ops.back();
+            op.paintHandle  = paint;
+            op.paintVersion = paint->state.version;
+            op.pathBounds   = pathBounds;
+            op.paintOutset  = PaintOutset(paint->state);
+            op.bounds       = place(OutsetRect(pathBounds, op.paintOutset));
         }
 
-        context->width  = surface->width;
-        context->height = surface->height;
+        void drawImage(const rive::RenderImage* image, rive::ImageSampler sampler, rive::BlendMode blendMode,
+                       float opacity) override
+        {
+            const rive_renderer_rect_t imageBounds {0.0f, 0.0f, static_cast<float>(image->width()),
+                                                    static_cast<float>(image->height())};
+            PictureOp& op = push(PictureOp::Kind::drawImage);
+            op.image      = rive::ref_rcp(const_cast<rive::RenderImage*>(image));
+            op.sampler    = sampler;
+            op.blendMode  = blendMode;
+            op.opacity    = opacity;
+            op.bounds     = place(imageBounds);
+        }
 
-        if (surface->borrowedIndex == backIndex && context->renderTarget)
+        void drawImageMesh(const rive::RenderImage* image, rive::ImageSampler sampler,
+                           rive::rcp<rive::RenderBuffer> vertices, rive::rcp<rive::RenderBuffer> uvCoords,
+                           rive::rcp<rive::RenderBuffer> indices, std::uint32_t vertexCount, std::uint32_t indexCount,
+                           rive::BlendMode blendMode, float opacity) override
         {
-            context->renderTargetTexture = surface->backBuffers[backIndex];
-            return rive_renderer_status_t::ok;
+            PictureOp& op  = push(PictureOp::Kind::drawImageMesh);
+            op.image       = rive::ref_rcp(const_cast<rive::RenderImage*>(image));
+            op.sampler     = sampler;
+            op.vertices    = std::move(vertices);
+            op.uvCoords    = std::move(uvCoords);
+            op.indices     = std::move(indices);
+            op.vertexCount = vertexCount;
+            op.indexCount  = indexCount;
+            op.blendMode   = blendMode;
+            op.opacity     = opacity;
+            op.bounds      = state.clipBounds;
         }
 
-        if (surface->borrowedIndex != std::numeric_limits<UINT>::max() && context->renderTarget)
+        // Hands over the recorded calls and starts a new recording.
+        std::vector<PictureOp> finish()
         {
-            // Return previously borrowed target before switching to a new one.
-            ReturnSurfaceRenderTarget(context);
+            std::vector<PictureOp> recorded = std::move(ops);
+            ops.clear();
+            state = {};
+            stack.clear();
+            return recorded;
         }
 
-        if (!surface->renderTargets[backIndex])
+        std::vector<PictureOp> ops;
+
+    private:
+        PictureOp& push(PictureOp::Kind kind)
         {
-            auto* impl = GetD3D12Impl(context);
-            if (impl == nullptr)
-            {
-                SetLastError("render context not initialized");
-                return rive_renderer_status_t::internal_error;
-            }
-            auto renderTarget = impl->makeRenderTarget(surface->width, surface->height);
-            if (!renderTarget)
+            ops.emplace_back();
+            ops.back().kind = kind;
+            return ops.back();
+        }
+
+        void retain(PathHandle* source)
+        {
+            if (PathHandle* editable = EditablePath(source))
             {
-                SetLastError("makeRenderTarget failed");
-                return rive_renderer_status_t::internal_error;
+                editable->ref_count.fetch_add(1, std::memory_order_relaxed);
+                ops.back().pathHandle  = editable;
+                ops.back().pathVersion = editable->version;
             }
-            renderTarget->setTargetTexture(surface->backBuffers[backIndex]);
-            surface->renderTargets[backIndex] = std::move(renderTarget);
         }
 
-        if (!surface->renderTargets[backIndex])
+        rive_renderer_rect_t place(const rive_renderer_rect_t& localBounds) const
         {
-            SetLastError("render target unavailable");
-            return rive_renderer_status_t::internal_error;
+            return IntersectRects(TransformRect(state.matrix, localBounds), state.clipBounds);
         }
 
-        context->renderTarget        = std::move(surface->renderTargets[backIndex]);
-        context->renderTargetTexture = surface->backBuffers[backIndex];
-        surface->borrowedIndex       = backIndex;
-        return rive_renderer_status_t::ok;
+        RendererState              state;
+        std::vector<RendererState> stack;
+    };
+
+    // Packed R-tree over the bounds of a picture's draws. Level 0 holds the draws in sort-tile-recursive order, and
+    // each box of the next level covers up to kPictureIndexFanout consecutive boxes of the level below. levelStarts
+    // holds the offset of every level in boxes followed by the total box count.
+    constexpr std::size_t kPictureIndexFanout = 16;
+
+    struct PictureIndex
+    {
+        std::vector<rive_renderer_rect_t> boxes;
+        std::vector<std::uint32_t>        ops;
+        std::vector<std::size_t>          levelStarts;
+    };
+
+    // skipTo holds, for a save, the op after its matching restore and, for a draw, the next op that is not a draw.
+    // Replays use it to step over draws and whole save/restore groups that culling left nothing to draw in.
+    // unboundedDraws lists the draws whose extent is unknown, which every replay draws. drawBounds holds the
+    // picture-space bounds of every draw the index was last fitted to, and editablePaths and paintOutsets the path
+    // bounds and paint outsets they were measured with for the handles ops retain, so replays can tell when edits
+    // made since have outgrown them. Replays on other threads may refit the index, so indexMutex guards all four.
+    struct PictureHandle
+    {
+        std::atomic<std::uint32_t>                                      ref_count {1};
+        ContextHandle*                                                  context {nullptr};
+        std::vector<PictureOp>                                          ops;
+        std::vector<std::uint32_t>                                      skipTo;
+        std::vector<std::uint32_t>                                      unboundedDraws;
+        std::uint32_t                                                   drawCount {0};
+        std::mutex                                                      indexMutex;
+        PictureIndex                                                    index;
+        std::vector<rive_renderer_rect_t>                               drawBounds;
+        std::vector<std::pair<const PathHandle*, rive_renderer_rect_t>> editablePaths;
+        std::vector<std::pair<const PaintHandle*, float>>               paintOutsets;
+    };
+
+    PictureHandle* ToPicture(const rive_renderer_picture_t& picture)
+    {
+        return static_cast<PictureHandle*>(picture.handle);
     }
-#endif
-#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-    rive::gpu::VulkanFeatures ConvertVulkanFeatures(const rive_renderer_vulkan_features_t& features)
+
+    void SaveRenderer(RendererHandle* renderer)
     {
-        rive::gpu::VulkanFeatures out {};
-        out.apiVersion = features.api_version;
-        out.independentBlend = features.independent_blend != 0;
-        out.fillModeNonSolid = features.fill_mode_non_solid != 0;
-        out.fragmentStoresAndAtomics = features.fragment_stores_and_atomics != 0;
-        out.shaderClipDistance = features.shader_clip_distance != 0;
-        out.rasterizationOrderColorAttachmentAccess =
-            features.rasterization_order_color_attachment_access != 0;
-        out.fragmentShaderPixelInterlock = features.fragment_shader_pixel_interlock != 0;
-        out.VK_KHR_portability_subset = features.portability_subset != 0;
-        return out;
+        renderer->renderer->save();
+        renderer->stateStack.push_back(renderer->state);
     }
-#endif
-    bool ConvertFillRule(rive_renderer_fill_rule_t value, rive::FillRule* out)
+
+    void RestoreRenderer(RendererHandle* renderer)
     {
-        switch (value)
+        renderer->renderer->restore();
+        if (!renderer->stateStack.empty())
         {
-        case rive_renderer_fill_rule_t::non_zero:
-            *out = rive::FillRule::nonZero;
-            return true;
-        case rive_renderer_fill_rule_t::even_odd:
-            *out = rive::FillRule::evenOdd;
-            return true;
-        case rive_renderer_fill_rule_t::clockwise:
-            *out = rive::FillRule::clockwise;
-            return true;
+            renderer->state = renderer->stateStack.back();
+            renderer->stateStack.pop_back();
         }
-        return false;
     }
 
-    bool ConvertPaintStyle(rive_renderer_paint_style_t value, rive::RenderPaintStyle* out)
+    void TransformRenderer(RendererHandle* renderer, const rive::Mat2D& matrix)
     {
-        switch (value)
+        renderer->renderer->transform(matrix);
+        renderer->state.matrix = renderer->state.matrix * matrix;
+    }
+
+    // source is the path handle path came from, if any.
+    void ClipRendererPath(RendererHandle* renderer, rive::RenderPath* path, PathHandle* source,
+                          const rive_renderer_rect_t& pathBounds)
+    {
+        if (renderer->recorder != nullptr)
         {
-        case rive_renderer_paint_style_t::fill:
-            *out = rive::RenderPaintStyle::fill;
-            return true;
-        case rive_renderer_paint_style_t::stroke:
-            *out = rive::RenderPaintStyle::stroke;
-            return true;
+            renderer->recorder->recordClip(path, source, pathBounds);
         }
-        return false;
+        else
+        {
+            renderer->renderer->clipPath(path);
+        }
+        const rive_renderer_rect_t deviceBounds = TransformRect(renderer->state.matrix, pathBounds);
+        renderer->state.clipBounds              = IntersectRects(renderer->state.clipBounds, deviceBounds);
     }
 
-    bool ConvertStrokeCap(rive_renderer_stroke_cap_t value, rive::StrokeCap* out)
+    // Draws through the paint handle so that a recording renderer can fade and cull the draw when its picture is
+    // replayed. source is the path handle path came from, if any.
+    void DrawPathWithPaint(RendererHandle* renderer, rive::RenderPath* path, PathHandle* source, PaintHandle* paint,
+                           const rive_renderer_rect_t& pathBounds)
     {
-        switch (value)
+        if (renderer->recorder != nullptr)
         {
-        case rive_renderer_stroke_cap_t::butt:
-            *out = rive::StrokeCap::butt;
-            return true;
-        case rive_renderer_stroke_cap_t::round:
-            *out = rive::StrokeCap::round;
-            return true;
-        case rive_renderer_stroke_cap_t::square:
-            *out = rive::StrokeCap::square;
-            return true;
+            renderer->recorder->recordPath(path, source, paint, pathBounds);
+        }
+        else
+        {
+            renderer->renderer->drawPath(path, paint->paint.get());
         }
-        return false;
     }
 
-    bool ConvertStrokeJoin(rive_renderer_stroke_join_t value, rive::StrokeJoin* out)
+    // D3D12 devices back fences with ID3D12Fence. Elsewhere a fence is a CPU timeline: contexts raise completedValue
+    // as they see the frames a signal waits on finish, and waiters on any thread block on the condition variable.
+    // pendingFrames lists those frames per context, so waiters can also ask the GPU themselves and need no thread to
+    // keep driving the context.
+    struct FenceHandle
     {
-        switch (value)
+        struct PendingFrame
         {
-        case rive_renderer_stroke_join_t::miter:
-            *out = rive::StrokeJoin::miter;
-            return true;
-        case rive_renderer_stroke_join_t::round:
-            *out = rive::StrokeJoin::round;
-            return true;
-        case rive_renderer_stroke_join_t::bevel:
-            *out = rive::StrokeJoin::bevel;
-            return true;
+            ContextHandle* context {nullptr};
+            std::uint64_t  value {0};
+            std::uint64_t  frame {0};
+        };
+
+        std::atomic<std::uint32_t> ref_count {1};
+        DeviceHandle*              device {nullptr};
+        std::atomic<std::uint64_t> lastValue {0};
+        std::mutex                 mutex;
+        std::condition_variable    signaled;
+        std::uint64_t              completedValue {0};
+        std::vector<PendingFrame>  pendingFrames;
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        Microsoft::WRL::ComPtr<ID3D12Fence> fence;
+        HANDLE                              eventHandle {nullptr};
+#endif
+    };
+
+    FenceHandle* ToFence(const rive_renderer_fence_t& fence)
+    {
+        return static_cast<FenceHandle*>(fence.handle);
+    }
+
+    void SignalCpuFence(FenceHandle* fence, std::uint64_t value)
+    {
+        {
+            std::lock_guard<std::mutex> lock(fence->mutex);
+            fence->completedValue = std::max(fence->completedValue, value);
         }
-        return false;
+        fence->signaled.notify_all();
     }
 
-    bool ConvertBlendMode(rive_renderer_blend_mode_t value, rive::BlendMode* out)
+    // Claims the next value of a CPU fence: value itself, or one past the last claimed value when it is 0.
+    bool ClaimCpuFenceValue(FenceHandle* fence, std::uint64_t* value)
     {
-        switch (value)
+        std::uint64_t previous = fence->lastValue.load(std::memory_order_acquire);
+        std::uint64_t target   = *value == 0 ? previous + 1 : *value;
+        if (target <= previous)
         {
-        case rive_renderer_blend_mode_t::src_over:
-            *out = rive::BlendMode::srcOver;
-            return true;
-        case rive_renderer_blend_mode_t::screen:
-            *out = rive::BlendMode::screen;
-            return true;
-        case rive_renderer_blend_mode_t::overlay:
-            *out = rive::BlendMode::overlay;
-            return true;
-        case rive_renderer_blend_mode_t::darken:
-            *out = rive::BlendMode::darken;
-            return true;
-        case rive_renderer_blend_mode_t::lighten:
-            *out = rive::BlendMode::lighten;
-            return true;
-        case rive_renderer_blend_mode_t::color_dodge:
-            *out = rive::BlendMode::colorDodge;
-            return true;
-        case rive_renderer_blend_mode_t::color_burn:
-            *out = rive::BlendMode::colorBurn;
-            return true;
-        case rive_renderer_blend_mode_t::hard_light:
-            *out = rive::BlendMode::hardLight;
-            return true;
-        case rive_renderer_blend_mode_t::soft_light:
-            *out = rive::BlendMode::softLight;
-            return true;
-        case rive_renderer_blend_mode_t::difference:
-            *out = rive::BlendMode::difference;
-            return true;
-        case rive_renderer_blend_mode_t::exclusion:
-            *out = rive::BlendMode::exclusion;
-            return true;
-        case rive_renderer_blend_mode_t::multiply:
-            *out = rive::BlendMode::multiply;
-            return true;
-        case rive_renderer_blend_mode_t::hue:
-            *out = rive::BlendMode::hue;
-            return true;
-        case rive_renderer_blend_mode_t::saturation:
-            *out = rive::BlendMode::saturation;
-            return true;
-        case rive_renderer_blend_mode_t::color:
-            *out = rive::BlendMode::color;
-            return true;
-        case rive_renderer_blend_mode_t::luminosity:
-            *out = rive::BlendMode::luminosity;
-            return true;
+            return false;
         }
-        return false;
+        fence->lastValue.store(target, std::memory_order_release);
+        *value = target;
+        return true;
     }
 
-    bool ConvertBufferType(rive_renderer_buffer_type_t value, rive::RenderBufferType* out)
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+    rive_renderer_status_t WaitForD3D12FenceHandle(FenceHandle* handle, std::uint64_t value, std::uint64_t timeoutMs)
     {
-        switch (value)
+        if (handle->fence->GetCompletedValue() >= value)
         {
-        case rive_renderer_buffer_type_t::index:
-            *out = rive::RenderBufferType::index;
-            return true;
-        case rive_renderer_buffer_type_t::vertex:
-            *out = rive::RenderBufferType::vertex;
-            return true;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
         }
-        return false;
-    }
 
-    rive::RenderBufferFlags ConvertBufferFlags(rive_renderer_buffer_flags_t value)
-    {
-        rive::RenderBufferFlags flags = rive::RenderBufferFlags::none;
-        const std::uint32_t     bits  = static_cast<std::uint32_t>(value);
-        if ((bits & static_cast<std::uint32_t>(rive_renderer_buffer_flags_t::mapped_once_at_initialization)) != 0)
+        if (value == 0)
         {
-            flags |= rive::RenderBufferFlags::mappedOnceAtInitialization;
+            SetLastError("fence wait value must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
         }
-        return flags;
-    }
 
-    rive::ImageSampler ConvertImageSampler(const rive_renderer_image_sampler_t* sampler)
-    {
-        if (sampler == nullptr)
+        if (timeoutMs == 0)
         {
-            return rive::ImageSampler::LinearClamp();
+            SetLastError("fence wait timed out");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::ImageSampler result;
-        result.wrapX  = static_cast<rive::ImageWrap>(static_cast<std::uint8_t>(sampler->wrap_x));
-        result.wrapY  = static_cast<rive::ImageWrap>(static_cast<std::uint8_t>(sampler->wrap_y));
-        result.filter = static_cast<rive::ImageFilter>(static_cast<std::uint8_t>(sampler->filter));
-        return result;
-    }
+        HRESULT hr = handle->fence->SetEventOnCompletion(value, handle->eventHandle);
+        if (FAILED(hr))
+        {
+            SetLastError("SetEventOnCompletion failed");
+            return rive_renderer_status_t::internal_error;
+        }
 
-#if defined(WITH_RIVE_TEXT)
-    bool ConvertTextAlign(rive_renderer_text_align_t value, rive::TextAlign* out)
-    {
-        switch (value)
+        DWORD timeoutValue = INFINITE;
+        if (timeoutMs != std::numeric_limits<std::uint64_t>::max())
         {
-        case rive_renderer_text_align_t::left:
-            *out = rive::TextAlign::left;
-            return true;
-        case rive_renderer_text_align_t::right:
-            *out = rive::TextAlign::right;
-            return true;
-        case rive_renderer_text_align_t::center:
-            *out = rive::TextAlign::center;
-            return true;
+            timeoutValue = timeoutMs >= static_cast<std::uint64_t>(INFINITE - 1)
+                               ? INFINITE
+                               : static_cast<DWORD>(timeoutMs);
         }
-        return false;
-    }
 
-    bool ConvertTextWrap(rive_renderer_text_wrap_t value, rive::TextWrap* out)
-    {
-        switch (value)
+        DWORD waitResult = WaitForSingleObject(handle->eventHandle, timeoutValue);
+        if (waitResult == WAIT_OBJECT_0)
         {
-        case rive_renderer_text_wrap_t::wrap:
-            *out = rive::TextWrap::wrap;
-            return true;
-        case rive_renderer_text_wrap_t::no_wrap:
-            *out = rive::TextWrap::noWrap;
-            return true;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
         }
-        return false;
+        if (waitResult == WAIT_TIMEOUT)
+        {
+            SetLastError("fence wait timed out");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        SetLastError("fence wait failed");
+        return rive_renderer_status_t::internal_error;
     }
 
-    std::uint8_t DirectionLevelFromStyle(rive_renderer_text_direction_t value)
+    rive_renderer_status_t SignalD3D12FenceHandle(ContextHandle* context, FenceHandle* fence, std::uint64_t value)
     {
-        switch (value)
+        if (context->device->backend != rive_renderer_backend_t::d3d12)
         {
-        case rive_renderer_text_direction_t::rtl:
-            return 1;
-        case rive_renderer_text_direction_t::ltr:
-        case rive_renderer_text_direction_t::automatic:
-        default:
-            return 0;
+            SetLastError("fence signaling not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        auto* device = context->device;
+        if (!device->directQueue)
+        {
+            SetLastError("direct queue unavailable");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        std::uint64_t previousValue = fence->lastValue.load(std::memory_order_acquire);
+        std::uint64_t targetValue   = value;
+        if (targetValue == 0)
+        {
+            targetValue = previousValue + 1;
+        }
+        else if (targetValue <= previousValue)
+        {
+            SetLastError("fence signal value must be greater than the last signaled value");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        fence->lastValue.store(targetValue, std::memory_order_release);
+
+        HRESULT hr = device->directQueue->Signal(fence->fence.Get(), targetValue);
+        if (FAILED(hr))
+        {
+            fence->lastValue.store(previousValue, std::memory_order_release);
+            SetLastError("queue signal failed");
+            return rive_renderer_status_t::internal_error;
         }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 #endif
-    rive::Mat2D ToMat2D(const rive_renderer_mat2d_t* mat)
+
+    // Signals fence to value once context has finished frame, holding a reference to the fence until then.
+    void QueueCpuFenceSignal(ContextHandle* context, FenceHandle* fence, std::uint64_t value, std::uint64_t frame)
     {
-        if (mat == nullptr)
+        if (frame <= context->lastCompletedFrame)
         {
-            return rive::Mat2D();
+            SignalCpuFence(fence, value);
+            return;
         }
-        return rive::Mat2D(mat->xx, mat->xy, mat->yx, mat->yy, mat->tx, mat->ty);
+        fence->ref_count.fetch_add(1, std::memory_order_relaxed);
+        context->fenceSignals.push_back({fence, value, frame});
+        std::lock_guard<std::mutex> lock(fence->mutex);
+        fence->pendingFrames.push_back({context, value, frame});
     }
 
-    rive_renderer_adapter_desc_t MakeNullAdapter()
+    // Stops waiters on signal's fence asking context about its frame, signaling the fence first when complete.
+    void RemovePendingFrame(ContextHandle* context, const PendingFenceSignal& signal, bool complete)
     {
-        rive_renderer_adapter_desc_t desc {};
-        desc.backend                = rive_renderer_backend_t::null;
-        desc.backend_padding        = 0;
-        desc.vendor_id              = 0xffff;
-        desc.device_id              = 0xffff;
-        desc.subsys_id              = 0;
-        desc.revision               = 1;
-        desc.dedicated_video_memory = 0;
-        desc.shared_system_memory   = 0;
-        desc.flags                  = static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
-        desc.reserved               = 0;
-        const char name[]           = "Null Renderer";
-        std::memcpy(desc.name, name, sizeof(name));
-        std::memset(desc.reserved_padding, 0, sizeof(desc.reserved_padding));
-        return desc;
+        {
+            std::lock_guard<std::mutex> lock(signal.fence->mutex);
+            auto&                       pending = signal.fence->pendingFrames;
+            pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                         [&](const FenceHandle::PendingFrame& entry)
+                                         {
+                                             return entry.context == context && entry.value == signal.value &&
+                                                    entry.frame == signal.frame;
+                                         }),
+                          pending.end());
+            if (complete)
+            {
+                signal.fence->completedValue = std::max(signal.fence->completedValue, signal.value);
+            }
+        }
+        if (complete)
+        {
+            signal.fence->signaled.notify_all();
+        }
     }
 
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-    rive_renderer_adapter_desc_t MakeMetalAdapter()
+    // Request to copy part of a frame's target back to the CPU. frameNumber is 0 until end_frame records the copy of
+    // the frame the readback was requested in. Pixels land in staging on Vulkan and in pixels otherwise; pixels also
+    // holds staging converted to format once mapped. A fence signal requested before end_frame waits in fence.
+    struct ReadbackHandle
     {
-        rive_renderer_adapter_desc_t desc {};
-        desc.backend                = rive_renderer_backend_t::metal;
-        desc.backend_padding        = 0;
-        desc.vendor_id              = 0;
-        desc.device_id              = 0;
-        desc.subsys_id              = 0;
-        desc.revision               = 1;
-        desc.dedicated_video_memory = 0;
-        desc.shared_system_memory   = 0;
-        desc.flags                  = static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
-        desc.reserved               = 0;
-        const char name[]           = "Metal Default Device";
-        std::memcpy(desc.name, name, sizeof(name));
-        std::memset(desc.reserved_padding, 0, sizeof(desc.reserved_padding));
-        return desc;
-    }
+        std::atomic<std::uint32_t>   ref_count {1};
+        ContextHandle*               context {nullptr};
+        rive_renderer_pixel_rect_t   rect {};
+        rive_renderer_pixel_format_t format {rive_renderer_pixel_format_t::rgba8_premultiplied};
+        std::uint64_t                frameNumber {0};
+        bool                         ready {false};
+        bool                         mapped {false};
+        std::vector<std::uint8_t>    pixels;
+        FenceHandle*                 fence {nullptr};
+        std::uint64_t                fenceValue {0};
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        VulkanStagingBuffer* staging {nullptr};
 #endif
+    };
 
-    bool ValidateContextSize(std::uint32_t width, std::uint32_t height)
+    ReadbackHandle* ToReadback(const rive_renderer_readback_t& readback)
     {
-        return width > 0 && height > 0;
+        return static_cast<ReadbackHandle*>(readback.handle);
     }
 
-} // namespace
-
-extern "C"
-{
-
-    rive_renderer_status_t rive_renderer_enumerate_adapters(rive_renderer_adapter_desc_t* adapters,
-                                                            std::size_t capacity, std::size_t* count)
+    // Gives readbacks requested during the frame being ended the number it will be submitted as.
+    void RecordFrameReadbacks(ContextHandle* context)
     {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (count == nullptr)
+        for (auto* readback : context->readbacks)
         {
-            SetLastError("count pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            if (readback->frameNumber != 0)
+            {
+                continue;
+            }
+            readback->frameNumber = context->frameCounter;
+            if (readback->fence != nullptr)
+            {
+                QueueCpuFenceSignal(context, readback->fence, readback->fenceValue, readback->frameNumber);
+                rive_renderer_fence_release({readback->fence});
+                readback->fence = nullptr;
+            }
         }
+    }
 
-        auto status = EnsureD3D12Adapters();
-        if (status != rive_renderer_status_t::ok)
+    // Completes readbacks and CPU fence signals whose frames are at or below lastCompletedFrame.
+    void NotifyCompletedFrames(ContextHandle* context)
+    {
+        for (auto* readback : context->readbacks)
         {
-            return status;
+            if (readback->frameNumber != 0 && readback->frameNumber <= context->lastCompletedFrame)
+            {
+                readback->ready = true;
+            }
         }
 
-        std::scoped_lock  lock(g_adapterMutex);
-        const std::size_t adapterCount = g_d3d12Adapters.size();
-        const std::size_t total        = adapterCount + 1; // include null adapter
-        *count                         = total;
-
-        if (adapters != nullptr && capacity > 0)
+        auto& signals = context->fenceSignals;
+        auto  due     = std::stable_partition(signals.begin(), signals.end(),
+                                              [context](const PendingFenceSignal& signal)
+                                              { return signal.frame > context->lastCompletedFrame; });
+        for (auto it = due; it != signals.end(); ++it)
         {
-            const std::size_t to_copy = std::min(capacity, adapterCount);
-            for (std::size_t i = 0; i < to_copy; ++i)
-            {
-                adapters[i] = g_d3d12Adapters[i].desc;
-            }
-            if (capacity > to_copy)
-            {
-                adapters[to_copy] = MakeNullAdapter();
-            }
+            RemovePendingFrame(context, *it, true);
+            rive_renderer_fence_release({it->fence});
         }
+        signals.erase(due, signals.end());
+    }
 
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-#else
-        if (count == nullptr)
+    bool IsValidPixelFormat(rive_renderer_pixel_format_t format)
+    {
+        return static_cast<std::uint8_t>(format) <=
+               static_cast<std::uint8_t>(rive_renderer_pixel_format_t::bgra8_straight);
+    }
+
+    // Copies height rows of premultiplied RGBA8 pixels into format with the device's vectorized kernels.
+    void ConvertPixelRows(const DeviceHandle& device, const std::uint8_t* src, std::size_t srcStride, std::uint8_t* dst,
+                          std::size_t dstStride, std::uint32_t width, std::uint32_t height,
+                          rive_renderer_pixel_format_t format)
+    {
+        const auto& kernels     = rive_renderer_cpu::GetBlendKernels(device.cpuSimdLevel);
+        const bool  swapRedBlue = format == rive_renderer_pixel_format_t::bgra8_premultiplied ||
+                                 format == rive_renderer_pixel_format_t::bgra8_straight;
+        const bool unpremultiply = format == rive_renderer_pixel_format_t::rgba8_straight ||
+                                   format == rive_renderer_pixel_format_t::bgra8_straight;
+        for (std::uint32_t y = 0; y < height; ++y)
         {
-            SetLastError("count pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            kernels.convertSpan(dst + y * dstStride, src + y * srcStride, static_cast<std::int32_t>(width), swapRedBlue,
+                                unpremultiply);
         }
+    }
 
-        const rive_renderer_adapter_desc_t candidates[] = {
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-            MakeMetalAdapter(),
+    struct SurfaceHandle
+    {
+        std::atomic<std::uint32_t>        ref_count {1};
+        DeviceHandle*                     device {nullptr};
+        ContextHandle*                    context {nullptr};
+        rive_renderer_backend_t           backend {rive_renderer_backend_t::unknown};
+        std::uint32_t                     width {0};
+        std::uint32_t                     height {0};
+        std::uint32_t                     buffer_count {0};
+        rive_renderer_surface_flags_t     flags {rive_renderer_surface_flags_t::none};
+        std::uint32_t                     present_interval {1};
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        void* hwnd {nullptr};
+        Microsoft::WRL::ComPtr<IDXGISwapChain3> swapChain;
+        std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> backBuffers;
+        std::vector<rive::rcp<rive::gpu::RenderTarget>>     renderTargets;
+        UINT borrowedIndex {std::numeric_limits<UINT>::max()};
+        bool supportsTearing {false};
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+        void* metalSurface {nullptr};
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        VkSurfaceKHR                              vkSurface {VK_NULL_HANDLE};
+        VkSwapchainKHR                            swapchain {VK_NULL_HANDLE};
+        VkFormat                                  imageFormat {VK_FORMAT_UNDEFINED};
+        VkExtent2D                                extent {0, 0};
+        VkPresentModeKHR                          presentMode {VK_PRESENT_MODE_FIFO_KHR};
+        std::vector<VkImage>                      swapchainImages;
+        std::vector<VkImageView>                  imageViews;
+        struct VulkanFrame
+        {
+            VkCommandBuffer                        commandBuffer = VK_NULL_HANDLE;
+            VkFence                                inFlightFence = VK_NULL_HANDLE;
+            VkSemaphore                            imageAvailable = VK_NULL_HANDLE;
+            VkSemaphore                            renderFinished = VK_NULL_HANDLE;
+            rive::gpu::vkutil::ImageAccess         imageAccess {};
+            rive::rcp<rive::gpu::RenderTarget>     renderTarget;
+        };
+        std::vector<VulkanFrame>                  frames;
+        uint32_t                                  currentImageIndex {0};
+        bool                                      swapchainOutOfDate {false};
+        bool                                      suboptimal {false};
 #endif
-            MakeNullAdapter()};
-        const std::size_t                  total        = sizeof(candidates) / sizeof(candidates[0]);
-        *count                                          = total;
+    };
 
-        if (adapters != nullptr && capacity > 0)
+    SurfaceHandle* ToSurface(const rive_renderer_surface_t& surface)
+    {
+        return static_cast<SurfaceHandle*>(surface.handle);
+    }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+    bool CheckTearingSupport()
+    {
+        Microsoft::WRL::ComPtr<IDXGIFactory5> factory5;
+        if (FAILED(CreateDXGIFactory1(IID_PPV_ARGS(&factory5))))
         {
-            const std::size_t to_copy = capacity < total ? capacity : total;
-            std::memcpy(adapters, candidates, sizeof(rive_renderer_adapter_desc_t) * to_copy);
+            return false;
         }
 
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-#endif
+        BOOL allowTearing = FALSE;
+        if (FAILED(factory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing,
+                                                 sizeof(allowTearing))))
+        {
+            return false;
+        }
+        return allowTearing == TRUE;
     }
 
-    rive_renderer_status_t rive_renderer_device_create(const rive_renderer_device_create_info_t* info,
-                                                       rive_renderer_device_t*                   out_device)
+    void ReturnSurfaceRenderTarget(ContextHandle* context)
     {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (info != nullptr && info->backend == rive_renderer_backend_t::d3d12)
+        if (context == nullptr || context->surface == nullptr)
         {
-            auto ensureStatus = EnsureD3D12Adapters();
-            if (ensureStatus != rive_renderer_status_t::ok)
-            {
-                return ensureStatus;
-            }
-
-            std::scoped_lock lock(g_adapterMutex);
-            if (info->adapter_index >= g_d3d12Adapters.size())
-            {
-                SetLastError("adapter index out of range");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-
-            auto& record = g_d3d12Adapters[info->adapter_index];
+            return;
+        }
 
-            Microsoft::WRL::ComPtr<ID3D12Device> device;
-            HRESULT hr = D3D12CreateDevice(record.adapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device));
-            if (FAILED(hr))
+        auto* surface = context->surface;
+        if (surface->borrowedIndex != std::numeric_limits<UINT>::max() && surface->borrowedIndex <
+                                                                        surface->renderTargets.size())
+        {
+            if (context->renderTarget)
             {
-                SetLastError("D3D12CreateDevice failed");
-                return rive_renderer_status_t::unsupported;
+                surface->renderTargets[surface->borrowedIndex] = std::move(context->renderTarget);
             }
+            context->renderTargetTexture.Reset();
+        }
+        else if (context->renderTarget)
+        {
+            context->renderTarget.reset();
+            context->renderTargetTexture.Reset();
+        }
+        surface->borrowedIndex = std::numeric_limits<UINT>::max();
+    }
 
-            D3D12_COMMAND_QUEUE_DESC queueDesc {};
-            queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
-            Microsoft::WRL::ComPtr<ID3D12CommandQueue> directQueue;
-            hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&directQueue));
-            if (FAILED(hr))
+    // Raises lastCompletedFrame to the newest frame whose fence the GPU has passed.
+    void RetireD3D12Frames(ContextHandle* context)
+    {
+        const UINT64 completed = context->directFence->GetCompletedValue();
+        for (const auto& slot : context->frameSlots)
+        {
+            if (slot.fenceValue != 0 && slot.fenceValue <= completed)
             {
-                SetLastError("Failed to create direct command queue");
-                return rive_renderer_status_t::internal_error;
+                context->lastCompletedFrame = std::max(context->lastCompletedFrame, slot.frameNumber);
             }
+        }
+    }
 
-            queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
-            Microsoft::WRL::ComPtr<ID3D12CommandQueue> copyQueue;
-            hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&copyQueue));
+    rive_renderer_status_t WaitForD3D12Fence(ContextHandle* context, UINT64 value)
+    {
+        if (context->directFence->GetCompletedValue() < value)
+        {
+            HRESULT hr = context->directFence->SetEventOnCompletion(value, context->fenceEvent);
             if (FAILED(hr))
             {
-                SetLastError("Failed to create copy command queue");
+                SetLastError("direct fence wait failed");
                 return rive_renderer_status_t::internal_error;
             }
-
-            auto* handle = new (std::nothrow) DeviceHandle();
-            if (handle == nullptr)
-            {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
-            }
-
-            handle->backend     = rive_renderer_backend_t::d3d12;
-            handle->adapter     = record.adapter;
-            handle->d3d12Device = device;
-            handle->directQueue = directQueue;
-            handle->copyQueue   = copyQueue;
-            handle->isIntel     = record.isIntel;
-            PopulateCapabilitiesFromD3D12(device.Get(), handle->capabilities, record.isIntel);
-
-            out_device->handle = handle;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            WaitForSingleObject(context->fenceEvent, INFINITE);
         }
-#endif
+        RetireD3D12Frames(context);
+        return rive_renderer_status_t::ok;
+    }
 
-        if (info != nullptr && info->backend == rive_renderer_backend_t::metal)
+    // The direct queue waits for the copy queue before running a frame, so the direct fence covers both.
+    rive_renderer_status_t WaitForD3D12Idle(ContextHandle* context)
+    {
+        if (context->directFence == nullptr)
         {
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-            auto* handle = new (std::nothrow) DeviceHandle();
-            if (handle == nullptr)
-            {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
-            }
-
-            rive_renderer_capabilities_t caps {};
-            void* metalDevice = rive_metal_device_new(&caps);
-            if (metalDevice == nullptr)
-            {
-                delete handle;
-                if (g_lastError.empty())
-                {
-                    SetLastError("Metal device creation failed");
-                }
-                return rive_renderer_status_t::internal_error;
-            }
-
-            handle->backend      = rive_renderer_backend_t::metal;
-            handle->metalDevice  = metalDevice;
-            handle->capabilities = caps;
-
-            out_device->handle = handle;
-            ClearLastError();
             return rive_renderer_status_t::ok;
-#else
-            SetLastError("requested backend is not yet implemented");
-            return rive_renderer_status_t::unsupported;
-#endif
         }
 
-        if (info == nullptr || out_device == nullptr)
+        UINT64 latest = 0;
+        for (const auto& slot : context->frameSlots)
         {
-            SetLastError("device_create received null pointer");
-            return rive_renderer_status_t::null_pointer;
+            latest = std::max(latest, slot.fenceValue);
         }
+        return WaitForD3D12Fence(context, latest);
+    }
 
-        if (info->backend == rive_renderer_backend_t::unknown)
+    // Waits for the frame that last recorded into slot, which only blocks once the ring is full, and resets its
+    // allocators for the frame about to be recorded. Slots past the first get their allocators on first use.
+    rive_renderer_status_t AcquireD3D12FrameSlot(ContextHandle* context, ContextHandle::FrameSlot* slot)
+    {
+        auto status = WaitForD3D12Fence(context, slot->fenceValue);
+        if (status != rive_renderer_status_t::ok)
         {
-            SetLastError("backend must be specified");
-            return rive_renderer_status_t::invalid_parameter;
+            return status;
         }
 
-        if (info->backend != rive_renderer_backend_t::null)
+        ID3D12Device* device = context->device->d3d12Device.Get();
+        if (slot->directAllocator == nullptr &&
+            FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT,
+                                                  IID_PPV_ARGS(&slot->directAllocator))))
         {
-            SetLastError("requested backend is not yet implemented");
-            return rive_renderer_status_t::unsupported;
+            SetLastError("CreateCommandAllocator (direct) failed");
+            return rive_renderer_status_t::internal_error;
         }
-
-        auto* device = new (std::nothrow) DeviceHandle();
-        if (device == nullptr)
+        if (slot->copyAllocator == nullptr &&
+            FAILED(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&slot->copyAllocator))))
         {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
+            SetLastError("CreateCommandAllocator (copy) failed");
+            return rive_renderer_status_t::internal_error;
         }
 
-        device->backend                               = info->backend;
-        device->capabilities.backend                  = info->backend;
-        device->capabilities.feature_flags            = rive_renderer_feature_flags_t::headless_supported;
-        device->capabilities.max_buffer_size          = 256ull * 1024ull * 1024ull;
-        device->capabilities.max_texture_dimension    = 4096;
-        device->capabilities.max_texture_array_layers = 1;
-        device->capabilities.max_sampler_anisotropy   = 1.0f;
-        device->capabilities.supports_hdr             = 0;
-        device->capabilities.supports_presentation    = 0;
-
-        out_device->handle = device;
-        ClearLastError();
+        if (FAILED(slot->directAllocator->Reset()))
+        {
+            SetLastError("Reset direct allocator failed");
+            return rive_renderer_status_t::internal_error;
+        }
+        if (FAILED(slot->copyAllocator->Reset()))
+        {
+            SetLastError("Reset copy allocator failed");
+            return rive_renderer_status_t::internal_error;
+        }
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_device_create_vulkan(const rive_renderer_device_create_info_vulkan_t* info,
-                                                              rive_renderer_device_t* out_device)
+    rive_renderer_status_t CreateSurfaceRenderTargets(SurfaceHandle* surface, std::uint32_t width,
+                                                      std::uint32_t height)
     {
-        if (out_device == nullptr)
+        if (surface == nullptr || surface->context == nullptr || surface->device == nullptr)
         {
-            SetLastError("device output pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("surface context or device is null");
+            return rive_renderer_status_t::internal_error;
         }
 
-        out_device->handle = nullptr;
-
-        if (info == nullptr)
+        auto* context = surface->context;
+        auto* impl    = GetD3D12Impl(context);
+        if (impl == nullptr)
         {
-            SetLastError("device create info is null");
-            return rive_renderer_status_t::null_pointer;
-        }
+            SetLastError("render context not initialized");
+            return rive_renderer_status_t::internal_error;
+        }
 
-#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-        if (info->instance == nullptr || info->physical_device == nullptr || info->device == nullptr ||
-            info->graphics_queue == nullptr)
+        surface->backBuffers.clear();
+        surface->renderTargets.clear();
+
+        surface->backBuffers.reserve(surface->buffer_count);
+        surface->renderTargets.reserve(surface->buffer_count);
+
+        for (std::uint32_t i = 0; i < surface->buffer_count; ++i)
         {
-            SetLastError("Vulkan device create info is missing required handles");
-            return rive_renderer_status_t::invalid_parameter;
+            Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+            HRESULT hr = surface->swapChain->GetBuffer(i, IID_PPV_ARGS(&buffer));
+            if (FAILED(hr))
+            {
+                SetLastError("swapchain get buffer failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            auto renderTarget = impl->makeRenderTarget(width, height);
+            if (!renderTarget)
+            {
+                SetLastError("makeRenderTarget failed");
+                return rive_renderer_status_t::internal_error;
+            }
+            renderTarget->setTargetTexture(buffer);
+
+            surface->backBuffers.emplace_back(std::move(buffer));
+            surface->renderTargets.emplace_back(std::move(renderTarget));
         }
 
-        auto* handle = new (std::nothrow) DeviceHandle();
-        if (handle == nullptr)
+        surface->borrowedIndex = std::numeric_limits<UINT>::max();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t EnsureD3D12SurfaceRenderTarget(ContextHandle* context)
+    {
+        auto* surface = context->surface;
+        if (surface == nullptr || surface->swapChain == nullptr)
         {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
+            SetLastError("surface not initialized");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->backend                   = rive_renderer_backend_t::vulkan;
-        handle->vkInstance                = reinterpret_cast<VkInstance>(info->instance);
-        handle->vkPhysicalDevice          = reinterpret_cast<VkPhysicalDevice>(info->physical_device);
-        handle->vkDevice                  = reinterpret_cast<VkDevice>(info->device);
-        handle->graphicsQueue             = reinterpret_cast<VkQueue>(info->graphics_queue);
-        handle->graphicsQueueFamilyIndex  = info->graphics_queue_family_index;
-        handle->presentQueue              = info->present_queue != nullptr
-                                                ? reinterpret_cast<VkQueue>(info->present_queue)
-                                                : handle->graphicsQueue;
-        handle->presentQueueFamilyIndex =
-            info->present_queue != nullptr ? info->present_queue_family_index : handle->graphicsQueueFamilyIndex;
-        handle->getInstanceProcAddr =
-            reinterpret_cast<PFN_vkGetInstanceProcAddr>(info->get_instance_proc_addr);
-        handle->vkFeatures = ConvertVulkanFeatures(info->features);
+        UINT backIndex = surface->swapChain->GetCurrentBackBufferIndex();
+        if (backIndex >= surface->renderTargets.size())
+        {
+            SetLastError("swapchain buffer index out of range");
+            return rive_renderer_status_t::internal_error;
+        }
 
-        handle->capabilities.backend = rive_renderer_backend_t::vulkan;
-        auto featureFlags =
-            static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
-        auto setFlag = [&](rive_renderer_feature_flags_t flag)
+        context->width  = surface->width;
+        context->height = surface->height;
+
+        if (surface->borrowedIndex == backIndex && context->renderTarget)
         {
-            featureFlags |= static_cast<std::uint32_t>(flag);
-        };
-        if (handle->vkFeatures.fragmentStoresAndAtomics)
+            context->renderTargetTexture = surface->backBuffers[backIndex];
+            return rive_renderer_status_t::ok;
+        }
+
+        if (surface->borrowedIndex != std::numeric_limits<UINT>::max() && context->renderTarget)
         {
-            setFlag(rive_renderer_feature_flags_t::atomic_path_rendering);
+            // Return previously borrowed target before switching to a new one.
+            ReturnSurfaceRenderTarget(context);
         }
-        if (handle->vkFeatures.rasterizationOrderColorAttachmentAccess ||
-            handle->vkFeatures.fragmentShaderPixelInterlock)
+
+        if (!surface->renderTargets[backIndex])
         {
-            setFlag(rive_renderer_feature_flags_t::raster_ordering);
+            auto* impl = GetD3D12Impl(context);
+            if (impl == nullptr)
+            {
+                SetLastError("render context not initialized");
+                return rive_renderer_status_t::internal_error;
+            }
+            auto renderTarget = impl->makeRenderTarget(surface->width, surface->height);
+            if (!renderTarget)
+            {
+                SetLastError("makeRenderTarget failed");
+                return rive_renderer_status_t::internal_error;
+            }
+            renderTarget->setTargetTexture(surface->backBuffers[backIndex]);
+            surface->renderTargets[backIndex] = std::move(renderTarget);
         }
-        handle->capabilities.feature_flags =
-            static_cast<rive_renderer_feature_flags_t>(featureFlags);
-        handle->capabilities.max_buffer_size          = 0;
-        handle->capabilities.max_texture_dimension    = 0;
-        handle->capabilities.max_texture_array_layers = 0;
-        handle->capabilities.max_sampler_anisotropy   = 1.0f;
-        handle->capabilities.supports_hdr             = 0;
-        handle->capabilities.supports_presentation =
-            handle->presentQueue != VK_NULL_HANDLE ? 1 : 0;
 
-        out_device->handle = handle;
-        ClearLastError();
+        if (!surface->renderTargets[backIndex])
+        {
+            SetLastError("render target unavailable");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        context->renderTarget        = std::move(surface->renderTargets[backIndex]);
+        context->renderTargetTexture = surface->backBuffers[backIndex];
+        surface->borrowedIndex       = backIndex;
         return rive_renderer_status_t::ok;
-#else
-        (void)info;
-        SetLastError("Vulkan backend is not available in this build");
-        return rive_renderer_status_t::unsupported;
+    }
 #endif
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+    rive::gpu::VulkanFeatures ConvertVulkanFeatures(const rive_renderer_vulkan_features_t& features)
+    {
+        rive::gpu::VulkanFeatures out {};
+        out.apiVersion = features.api_version;
+        out.independentBlend = features.independent_blend != 0;
+        out.fillModeNonSolid = features.fill_mode_non_solid != 0;
+        out.fragmentStoresAndAtomics = features.fragment_stores_and_atomics != 0;
+        out.shaderClipDistance = features.shader_clip_distance != 0;
+        out.rasterizationOrderColorAttachmentAccess =
+            features.rasterization_order_color_attachment_access != 0;
+        out.fragmentShaderPixelInterlock = features.fragment_shader_pixel_interlock != 0;
+        out.VK_KHR_portability_subset = features.portability_subset != 0;
+        return out;
     }
 
-    rive_renderer_status_t rive_renderer_device_retain(rive_renderer_device_t device)
+    rive::gpu::RenderContextVulkanImpl* GetVulkanImpl(ContextHandle* context)
     {
-        auto* handle = ToDevice(device);
-        if (handle == nullptr)
+        if (context == nullptr || context->renderContext == nullptr)
         {
-            SetLastError("device handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            return nullptr;
         }
-
-        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-        ClearLastError();
-        return rive_renderer_status_t::ok;
+        return context->renderContext->static_impl_cast<rive::gpu::RenderContextVulkanImpl>();
     }
 
-    rive_renderer_status_t rive_renderer_device_release(rive_renderer_device_t device)
+    // Resolves the entry points the frame loop calls directly. Swapchain entry points are optional so headless
+    // devices without VK_KHR_swapchain still load.
+    bool LoadVulkanDispatch(DeviceHandle* device)
     {
-        auto* handle = ToDevice(device);
-        if (handle == nullptr)
+        device->getDeviceProcAddr = reinterpret_cast<PFN_vkGetDeviceProcAddr>(
+            device->getInstanceProcAddr(device->vkInstance, "vkGetDeviceProcAddr"));
+        if (device->getDeviceProcAddr == nullptr)
         {
-            SetLastError("device handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            return false;
         }
 
-        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
-        if (previous == 0)
+        bool loaded       = true;
+        auto loadInstance = [&](auto& function, const char* name, bool required = true)
         {
-            SetLastError("device handle refcount underflow");
-            return rive_renderer_status_t::internal_error;
-        }
-
-        if (previous == 1)
+            function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(
+                device->getInstanceProcAddr(device->vkInstance, name));
+            loaded = loaded && (function != nullptr || !required);
+        };
+        auto loadDevice = [&](auto& function, const char* name, bool required = true)
         {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-            handle->adapter.Reset();
-            handle->d3d12Device.Reset();
-            handle->directQueue.Reset();
-            handle->copyQueue.Reset();
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-            if (handle->metalDevice != nullptr)
+            function = reinterpret_cast<std::remove_reference_t<decltype(function)>>(
+                device->getDeviceProcAddr(device->vkDevice, name));
+            loaded = loaded && (function != nullptr || !required);
+        };
+
+        auto& vk = device->vk;
+        loadInstance(vk.getPhysicalDeviceSurfaceCapabilitiesKHR, "vkGetPhysicalDeviceSurfaceCapabilitiesKHR", false);
+        loadInstance(vk.getPhysicalDeviceSurfaceFormatsKHR, "vkGetPhysicalDeviceSurfaceFormatsKHR", false);
+        loadInstance(vk.getPhysicalDeviceSurfacePresentModesKHR, "vkGetPhysicalDeviceSurfacePresentModesKHR", false);
+        loadInstance(vk.getPhysicalDeviceMemoryProperties, "vkGetPhysicalDeviceMemoryProperties");
+        loadDevice(vk.createSwapchainKHR, "vkCreateSwapchainKHR", false);
+        loadDevice(vk.destroySwapchainKHR, "vkDestroySwapchainKHR", false);
+        loadDevice(vk.getSwapchainImagesKHR, "vkGetSwapchainImagesKHR", false);
+        loadDevice(vk.acquireNextImageKHR, "vkAcquireNextImageKHR", false);
+        loadDevice(vk.queuePresentKHR, "vkQueuePresentKHR", false);
+        loadDevice(vk.createCommandPool, "vkCreateCommandPool");
+        loadDevice(vk.destroyCommandPool, "vkDestroyCommandPool");
+        loadDevice(vk.allocateCommandBuffers, "vkAllocateCommandBuffers");
+        loadDevice(vk.freeCommandBuffers, "vkFreeCommandBuffers");
+        loadDevice(vk.resetCommandBuffer, "vkResetCommandBuffer");
+        loadDevice(vk.beginCommandBuffer, "vkBeginCommandBuffer");
+        loadDevice(vk.endCommandBuffer, "vkEndCommandBuffer");
+        loadDevice(vk.createFence, "vkCreateFence");
+        loadDevice(vk.destroyFence, "vkDestroyFence");
+        loadDevice(vk.waitForFences, "vkWaitForFences");
+        loadDevice(vk.resetFences, "vkResetFences");
+        loadDevice(vk.getFenceStatus, "vkGetFenceStatus");
+        loadDevice(vk.createSemaphore, "vkCreateSemaphore");
+        loadDevice(vk.destroySemaphore, "vkDestroySemaphore");
+        loadDevice(vk.queueSubmit, "vkQueueSubmit");
+        loadDevice(vk.deviceWaitIdle, "vkDeviceWaitIdle");
+        loadDevice(vk.createImage, "vkCreateImage");
+        loadDevice(vk.destroyImage, "vkDestroyImage");
+        loadDevice(vk.getImageMemoryRequirements, "vkGetImageMemoryRequirements");
+        loadDevice(vk.allocateMemory, "vkAllocateMemory");
+        loadDevice(vk.freeMemory, "vkFreeMemory");
+        loadDevice(vk.bindImageMemory, "vkBindImageMemory");
+        loadDevice(vk.createImageView, "vkCreateImageView");
+        loadDevice(vk.destroyImageView, "vkDestroyImageView");
+        loadDevice(vk.cmdPipelineBarrier, "vkCmdPipelineBarrier");
+        loadDevice(vk.createBuffer, "vkCreateBuffer");
+        loadDevice(vk.destroyBuffer, "vkDestroyBuffer");
+        loadDevice(vk.getBufferMemoryRequirements, "vkGetBufferMemoryRequirements");
+        loadDevice(vk.bindBufferMemory, "vkBindBufferMemory");
+        loadDevice(vk.mapMemory, "vkMapMemory");
+        loadDevice(vk.unmapMemory, "vkUnmapMemory");
+        loadDevice(vk.invalidateMappedMemoryRanges, "vkInvalidateMappedMemoryRanges");
+        loadDevice(vk.cmdCopyImageToBuffer, "vkCmdCopyImageToBuffer");
+        return loaded;
+    }
+
+    std::uint32_t FindVulkanMemoryType(DeviceHandle* device, std::uint32_t typeBits, VkMemoryPropertyFlags properties)
+    {
+        VkPhysicalDeviceMemoryProperties memory {};
+        device->vk.getPhysicalDeviceMemoryProperties(device->vkPhysicalDevice, &memory);
+        for (std::uint32_t i = 0; i < memory.memoryTypeCount; ++i)
+        {
+            if ((typeBits & (1u << i)) != 0 && (memory.memoryTypes[i].propertyFlags & properties) == properties)
             {
-                rive_metal_device_release(handle->metalDevice);
-                handle->metalDevice = nullptr;
+                return i;
             }
-#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-            handle->vkInstance               = VK_NULL_HANDLE;
-            handle->vkPhysicalDevice         = VK_NULL_HANDLE;
-            handle->vkDevice                 = VK_NULL_HANDLE;
-            handle->graphicsQueue            = VK_NULL_HANDLE;
-            handle->presentQueue             = VK_NULL_HANDLE;
-            handle->graphicsQueueFamilyIndex = 0;
-            handle->presentQueueFamilyIndex  = 0;
-            handle->getInstanceProcAddr      = nullptr;
-#endif
-            delete handle;
         }
+        return std::numeric_limits<std::uint32_t>::max();
+    }
 
-        ClearLastError();
-        return rive_renderer_status_t::ok;
+    constexpr VkFormat          kVulkanTargetFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    constexpr VkImageUsageFlags kVulkanTargetUsage  = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+                                                     VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT |
+                                                     VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+
+    void DestroyVulkanTarget(ContextHandle* context)
+    {
+        auto&    vk     = context->device->vk;
+        VkDevice device = context->device->vkDevice;
+        context->renderTarget = nullptr;
+        if (context->targetView != VK_NULL_HANDLE)
+        {
+            vk.destroyImageView(device, context->targetView, nullptr);
+            context->targetView = VK_NULL_HANDLE;
+        }
+        if (context->targetImage != VK_NULL_HANDLE)
+        {
+            vk.destroyImage(device, context->targetImage, nullptr);
+            context->targetImage = VK_NULL_HANDLE;
+        }
+        if (context->targetMemory != VK_NULL_HANDLE)
+        {
+            vk.freeMemory(device, context->targetMemory, nullptr);
+            context->targetMemory = VK_NULL_HANDLE;
+        }
     }
 
-    rive_renderer_status_t rive_renderer_device_capabilities(rive_renderer_device_t        device,
-                                                             rive_renderer_capabilities_t* out_capabilities)
+    // Creates the offscreen image frames render into, sized to the context.
+    rive_renderer_status_t CreateVulkanTarget(ContextHandle* context)
     {
-        if (out_capabilities == nullptr)
+        auto* device = context->device;
+        auto& vk     = device->vk;
+        auto* impl   = GetVulkanImpl(context);
+        if (impl == nullptr)
         {
-            SetLastError("capabilities pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("render context not initialized");
+            return rive_renderer_status_t::internal_error;
         }
 
-        auto* handle = ToDevice(device);
-        if (handle == nullptr)
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = kVulkanTargetFormat;
+        imageInfo.extent        = {context->width, context->height, 1};
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = kVulkanTargetUsage;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        if (vk.createImage(device->vkDevice, &imageInfo, nullptr, &context->targetImage) != VK_SUCCESS)
+        {
+            SetLastError("failed to create Vulkan render target image");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        VkMemoryRequirements requirements {};
+        vk.getImageMemoryRequirements(device->vkDevice, context->targetImage, &requirements);
+        VkMemoryAllocateInfo allocateInfo {};
+        allocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.allocationSize  = requirements.size;
+        allocateInfo.memoryTypeIndex =
+            FindVulkanMemoryType(device, requirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        if (allocateInfo.memoryTypeIndex == std::numeric_limits<std::uint32_t>::max() ||
+            vk.allocateMemory(device->vkDevice, &allocateInfo, nullptr, &context->targetMemory) != VK_SUCCESS ||
+            vk.bindImageMemory(device->vkDevice, context->targetImage, context->targetMemory, 0) != VK_SUCCESS)
         {
-            SetLastError("device handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            DestroyVulkanTarget(context);
+            SetLastError("failed to allocate Vulkan render target memory");
+            return rive_renderer_status_t::out_of_memory;
         }
 
-        *out_capabilities = handle->capabilities;
-        ClearLastError();
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                       = context->targetImage;
+        viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                      = kVulkanTargetFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        if (vk.createImageView(device->vkDevice, &viewInfo, nullptr, &context->targetView) != VK_SUCCESS)
+        {
+            DestroyVulkanTarget(context);
+            SetLastError("failed to create Vulkan render target view");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        context->renderTarget =
+            impl->makeRenderTarget(context->width, context->height, kVulkanTargetFormat, kVulkanTargetUsage);
+        if (!context->renderTarget)
+        {
+            DestroyVulkanTarget(context);
+            SetLastError("makeRenderTarget failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        context->targetAccess                = {};
+        context->targetAccess.pipelineStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+        context->targetAccess.accessMask     = 0;
+        context->targetAccess.layout         = VK_IMAGE_LAYOUT_UNDEFINED;
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_create(rive_renderer_device_t device, std::uint32_t width,
-                                                        std::uint32_t height, rive_renderer_context_t* out_context)
+    // Allocates one command buffer and fence per ring slot from a pool on the graphics queue family.
+    rive_renderer_status_t InitializeVulkanContext(ContextHandle* context)
     {
-        if (out_context == nullptr)
+        auto* device = context->device;
+        auto& vk     = device->vk;
+
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = device->graphicsQueueFamilyIndex;
+        if (vk.createCommandPool(device->vkDevice, &poolInfo, nullptr, &context->commandPool) != VK_SUCCESS)
         {
-            SetLastError("context output pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("failed to create Vulkan command pool");
+            return rive_renderer_status_t::internal_error;
         }
 
-        auto* device_handle = ToDevice(device);
-        if (device_handle == nullptr)
+        VkCommandBuffer             commandBuffers[RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT] {};
+        VkCommandBufferAllocateInfo allocateInfo {};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = context->commandPool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT;
+        if (vk.allocateCommandBuffers(device->vkDevice, &allocateInfo, commandBuffers) != VK_SUCCESS)
         {
-            SetLastError("device handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("failed to allocate Vulkan command buffers");
+            return rive_renderer_status_t::internal_error;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (device_handle->backend == rive_renderer_backend_t::d3d12)
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        for (std::uint32_t i = 0; i < RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT; ++i)
         {
-            if (!ValidateContextSize(width, height))
+            auto& slot         = context->frameSlots[i];
+            slot.commandBuffer = commandBuffers[i];
+            if (vk.createFence(device->vkDevice, &fenceInfo, nullptr, &slot.fence) != VK_SUCCESS)
             {
-                SetLastError("context dimensions must be non-zero");
-                return rive_renderer_status_t::invalid_parameter;
+                SetLastError("failed to create Vulkan fence");
+                return rive_renderer_status_t::internal_error;
             }
+        }
+        return rive_renderer_status_t::ok;
+    }
 
-            auto* contextHandle = new (std::nothrow) ContextHandle();
-            if (contextHandle == nullptr)
-            {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
+    // Raises lastCompletedFrame to the newest submitted frame whose fence has signaled.
+    void RetireVulkanFrames(ContextHandle* context)
+    {
+        auto& vk = context->device->vk;
+        for (const auto& slot : context->frameSlots)
+        {
+            if (slot.submitted && vk.getFenceStatus(context->device->vkDevice, slot.fence) == VK_SUCCESS)
+            {
+                context->lastCompletedFrame = std::max(context->lastCompletedFrame, slot.frameNumber);
             }
+        }
+        NotifyCompletedFrames(context);
+    }
 
-            contextHandle->device = device_handle;
-
-            auto initStatus = InitializeD3D12Context(device_handle, contextHandle, width, height);
-            if (initStatus != rive_renderer_status_t::ok)
+    rive_renderer_status_t WaitForVulkanSlot(ContextHandle* context, const ContextHandle::FrameSlot& slot)
+    {
+        if (slot.submitted)
+        {
+            VkResult result = context->device->vk.waitForFences(context->device->vkDevice, 1, &slot.fence, VK_TRUE,
+                                                                std::numeric_limits<std::uint64_t>::max());
+            if (result != VK_SUCCESS)
             {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                return initStatus;
+                SetLastError("Vulkan fence wait failed");
+                return result == VK_ERROR_DEVICE_LOST ? rive_renderer_status_t::device_lost
+                                                      : rive_renderer_status_t::internal_error;
             }
+        }
+        RetireVulkanFrames(context);
+        return rive_renderer_status_t::ok;
+    }
 
-            rive::gpu::D3DContextOptions contextOptions;
-            contextOptions.isIntel = device_handle->isIntel;
-
-            auto renderContext = rive::gpu::RenderContextD3D12Impl::MakeContext(
-                device_handle->d3d12Device, contextHandle->copyCommandList.Get(), contextOptions);
-            if (!renderContext)
+    rive_renderer_status_t WaitForVulkanIdle(ContextHandle* context)
+    {
+        for (const auto& slot : context->frameSlots)
+        {
+            auto status = WaitForVulkanSlot(context, slot);
+            if (status != rive_renderer_status_t::ok)
             {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                SetLastError("RenderContextD3D12Impl::MakeContext failed");
-                return rive_renderer_status_t::internal_error;
+                return status;
             }
+        }
+        return rive_renderer_status_t::ok;
+    }
 
-            contextHandle->renderContext = std::move(renderContext);
+    // Waits for the frame that last used slot, which only blocks once the ring is full, and starts recording its
+    // command buffer again.
+    rive_renderer_status_t AcquireVulkanFrameSlot(ContextHandle* context, ContextHandle::FrameSlot* slot)
+    {
+        auto status = WaitForVulkanSlot(context, *slot);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
 
-            HRESULT hr = contextHandle->copyCommandList->Close();
-            if (FAILED(hr))
+        auto&    vk     = context->device->vk;
+        VkDevice device = context->device->vkDevice;
+        if (slot->submitted)
+        {
+            std::lock_guard<std::mutex> lock(context->completionMutex);
+            if (vk.resetFences(device, 1, &slot->fence) != VK_SUCCESS)
             {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                SetLastError("copy command list close failed");
+                SetLastError("Vulkan fence reset failed");
                 return rive_renderer_status_t::internal_error;
             }
+            context->recycledFrame = std::max(context->recycledFrame, slot->frameNumber);
+            slot->submitted        = false;
+        }
+        slot->readbackRecorded = false;
 
-            ID3D12CommandList* copyLists[] = {contextHandle->copyCommandList.Get()};
-            device_handle->copyQueue->ExecuteCommandLists(1, copyLists);
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vk.resetCommandBuffer(slot->commandBuffer, 0) != VK_SUCCESS ||
+            vk.beginCommandBuffer(slot->commandBuffer, &beginInfo) != VK_SUCCESS)
+        {
+            SetLastError("failed to begin Vulkan command buffer");
+            return rive_renderer_status_t::internal_error;
+        }
+        return rive_renderer_status_t::ok;
+    }
 
-            contextHandle->fenceValue = 1;
-            hr = device_handle->copyQueue->Signal(contextHandle->copyFence.Get(), contextHandle->fenceValue);
-            if (FAILED(hr))
+    void DestroyVulkanStagingBuffer(ContextHandle* context, VulkanStagingBuffer* staging)
+    {
+        auto&    vk     = context->device->vk;
+        VkDevice device = context->device->vkDevice;
+        if (staging->buffer != VK_NULL_HANDLE)
+        {
+            vk.destroyBuffer(device, staging->buffer, nullptr);
+            staging->buffer = VK_NULL_HANDLE;
+        }
+        if (staging->memory != VK_NULL_HANDLE)
+        {
+            if (staging->pixels != nullptr)
             {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                SetLastError("Queue signal failed");
-                return rive_renderer_status_t::internal_error;
+                vk.unmapMemory(device, staging->memory);
             }
+            vk.freeMemory(device, staging->memory, nullptr);
+            staging->memory = VK_NULL_HANDLE;
+        }
+        staging->pixels   = nullptr;
+        staging->capacity = 0;
+    }
 
-            hr = contextHandle->copyFence->SetEventOnCompletion(contextHandle->fenceValue, contextHandle->fenceEvent);
-            if (FAILED(hr))
-            {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                SetLastError("SetEventOnCompletion failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            WaitForSingleObject(contextHandle->fenceEvent, INFINITE);
+    // Grows a staging buffer to hold size bytes. It must not be in use by a frame in flight. Host-cached memory is
+    // preferred since the CPU reads every byte back; it is invalidated before reads when it is not also coherent.
+    rive_renderer_status_t EnsureVulkanStagingBuffer(ContextHandle* context, VulkanStagingBuffer* staging,
+                                                     VkDeviceSize size)
+    {
+        if (staging->capacity >= size)
+        {
+            return rive_renderer_status_t::ok;
+        }
+        DestroyVulkanStagingBuffer(context, staging);
 
-            contextHandle->copyAllocator->Reset();
-            contextHandle->directAllocator->Reset();
-            contextHandle->copyCommandList->Reset(contextHandle->copyAllocator.Get(), nullptr);
-            contextHandle->directCommandList->Reset(contextHandle->directAllocator.Get(), nullptr);
-            contextHandle->copyCommandList->Close();
-            contextHandle->directCommandList->Close();
+        auto* device = context->device;
+        auto& vk     = device->vk;
 
-            auto targetStatus = EnsureD3D12RenderTarget(contextHandle);
-            if (targetStatus != rive_renderer_status_t::ok)
+        VkBufferCreateInfo bufferInfo {};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size        = size;
+        bufferInfo.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (vk.createBuffer(device->vkDevice, &bufferInfo, nullptr, &staging->buffer) != VK_SUCCESS)
+        {
+            SetLastError("failed to create Vulkan readback buffer");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        VkMemoryRequirements requirements {};
+        vk.getBufferMemoryRequirements(device->vkDevice, staging->buffer, &requirements);
+
+        const VkMemoryPropertyFlags preferences[] = {
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT |
+                VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        };
+        VkMemoryAllocateInfo allocateInfo {};
+        allocateInfo.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocateInfo.allocationSize  = requirements.size;
+        allocateInfo.memoryTypeIndex = std::numeric_limits<std::uint32_t>::max();
+        for (auto properties : preferences)
+        {
+            allocateInfo.memoryTypeIndex = FindVulkanMemoryType(device, requirements.memoryTypeBits, properties);
+            if (allocateInfo.memoryTypeIndex != std::numeric_limits<std::uint32_t>::max())
             {
-                ReleaseD3D12Context(contextHandle);
-                delete contextHandle;
-                return targetStatus;
+                staging->coherent = (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+                break;
             }
+        }
+        if (allocateInfo.memoryTypeIndex == std::numeric_limits<std::uint32_t>::max() ||
+            vk.allocateMemory(device->vkDevice, &allocateInfo, nullptr, &staging->memory) != VK_SUCCESS ||
+            vk.bindBufferMemory(device->vkDevice, staging->buffer, staging->memory, 0) != VK_SUCCESS ||
+            vk.mapMemory(device->vkDevice, staging->memory, 0, VK_WHOLE_SIZE, 0, &staging->pixels) != VK_SUCCESS)
+        {
+            staging->pixels = nullptr;
+            DestroyVulkanStagingBuffer(context, staging);
+            SetLastError("failed to allocate Vulkan readback memory");
+            return rive_renderer_status_t::out_of_memory;
+        }
 
-            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        staging->capacity = size;
+        return rive_renderer_status_t::ok;
+    }
 
-            out_context->handle = contextHandle;
-            ClearLastError();
+    // Makes GPU writes to a staging buffer visible to the mapping. Only needed once its frame has finished.
+    rive_renderer_status_t InvalidateVulkanStagingBuffer(ContextHandle* context, const VulkanStagingBuffer& staging)
+    {
+        if (staging.coherent)
+        {
             return rive_renderer_status_t::ok;
         }
-#endif
 
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-        if (device_handle->backend == rive_renderer_backend_t::metal)
+        VkMappedMemoryRange range {};
+        range.sType  = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = staging.memory;
+        range.size   = VK_WHOLE_SIZE;
+        if (context->device->vk.invalidateMappedMemoryRanges(context->device->vkDevice, 1, &range) != VK_SUCCESS)
         {
-            if (!ValidateContextSize(width, height))
+            SetLastError("failed to invalidate Vulkan readback memory");
+            return rive_renderer_status_t::internal_error;
+        }
+        return rive_renderer_status_t::ok;
+    }
+
+    // Takes an idle staging buffer of at least size bytes from the pool, growing or adding one when none fits.
+    VulkanStagingBuffer* AcquireVulkanStagingBuffer(ContextHandle* context, VkDeviceSize size)
+    {
+        VulkanStagingBuffer* staging = nullptr;
+        for (auto& candidate : context->stagingPool)
+        {
+            if (candidate->inUse)
             {
-                SetLastError("context dimensions must be non-zero");
-                return rive_renderer_status_t::invalid_parameter;
+                continue;
             }
-
-            auto* contextHandle = new (std::nothrow) ContextHandle();
-            if (contextHandle == nullptr)
+            if (candidate->capacity >= size)
             {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
+                staging = candidate.get();
+                break;
             }
-
-            contextHandle->device = device_handle;
-
-            std::unique_ptr<rive::gpu::RenderContext> renderContext;
-            void*                                      metalContext = nullptr;
-            auto status = rive_metal_context_create(device_handle->metalDevice, width, height, &metalContext,
-                                                    &renderContext);
-            if (status != rive_renderer_status_t::ok)
+            // Copies into a reused buffer queue behind earlier ones, but a buffer is only replaced once it is idle.
+            if (staging == nullptr && candidate->lastFrame <= context->lastCompletedFrame)
             {
-                delete contextHandle;
-                if (g_lastError.empty())
-                {
-                    SetLastError("Metal context creation failed");
-                }
-                return status;
+                staging = candidate.get();
             }
+        }
+        if (staging == nullptr)
+        {
+            context->stagingPool.push_back(std::make_unique<VulkanStagingBuffer>());
+            staging = context->stagingPool.back().get();
+        }
 
-            contextHandle->renderContext = std::move(renderContext);
-            contextHandle->metalContext  = metalContext;
-            contextHandle->width         = width;
-            contextHandle->height        = height;
-
-            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-
-            out_context->handle = contextHandle;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+        if (EnsureVulkanStagingBuffer(context, staging, size) != rive_renderer_status_t::ok)
+        {
+            return nullptr;
         }
-#endif
+        staging->inUse = true;
+        return staging;
+    }
 
-#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-        if (device_handle->backend == rive_renderer_backend_t::vulkan)
+    // Appends copies of the target to the frame's command buffer, after rive's own work, so pixels arrive with the
+    // frame instead of needing a separate submission: the whole target into the slot's staging buffer when
+    // framebuffer readback is on, and the rect of each readback requested during the frame into its own.
+    rive_renderer_status_t RecordVulkanReadbacks(ContextHandle* context, ContextHandle::FrameSlot* slot)
+    {
+        struct Copy
         {
-            if (!ValidateContextSize(width, height))
+            VkBuffer          buffer;
+            VkBufferImageCopy region;
+        };
+        std::vector<Copy> copies;
+
+        if (context->framebufferReadback)
+        {
+            const VkDeviceSize size = static_cast<VkDeviceSize>(context->width) * context->height * 4;
+            if (slot->readback.capacity < size && context->readbackSlot == slot)
             {
-                SetLastError("context dimensions must be non-zero");
-                return rive_renderer_status_t::invalid_parameter;
+                context->readbackSlot = nullptr;
             }
-
-            auto* contextHandle = new (std::nothrow) ContextHandle();
-            if (contextHandle == nullptr)
+            auto status = EnsureVulkanStagingBuffer(context, &slot->readback, size);
+            if (status != rive_renderer_status_t::ok)
             {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
+                return status;
             }
 
-            contextHandle->device = device_handle;
-            contextHandle->width  = width;
-            contextHandle->height = height;
+            Copy copy {slot->readback.buffer, {}};
+            copy.region.imageExtent = {context->width, context->height, 1};
+            copies.push_back(copy);
+            slot->readbackRecorded = true;
+            slot->readbackWidth    = context->width;
+            slot->readbackHeight   = context->height;
+        }
 
-            rive::gpu::RenderContextVulkanImpl::ContextOptions options {};
-            auto renderContext = rive::gpu::RenderContextVulkanImpl::MakeContext(
-                device_handle->vkInstance,
-                device_handle->vkPhysicalDevice,
-                device_handle->vkDevice,
-                device_handle->vkFeatures,
-                device_handle->getInstanceProcAddr,
-                options);
-            if (!renderContext)
+        for (auto* readback : context->readbacks)
+        {
+            if (readback->frameNumber == 0)
             {
-                delete contextHandle;
-                SetLastError("RenderContextVulkanImpl::MakeContext failed");
-                return rive_renderer_status_t::internal_error;
+                readback->staging->lastFrame = context->frameCounter;
+                Copy copy {readback->staging->buffer, {}};
+                copy.region.imageOffset = {static_cast<std::int32_t>(readback->rect.x),
+                                           static_cast<std::int32_t>(readback->rect.y), 0};
+                copy.region.imageExtent = {readback->rect.width, readback->rect.height, 1};
+                copies.push_back(copy);
             }
+        }
 
-            contextHandle->renderContext = std::move(renderContext);
-
-            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-
-            out_context->handle = contextHandle;
-            ClearLastError();
+        if (copies.empty())
+        {
             return rive_renderer_status_t::ok;
         }
-#endif
 
-        if (!ValidateContextSize(width, height))
+        auto& vk = context->device->vk;
+
+        VkImageMemoryBarrier toTransfer {};
+        toTransfer.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        toTransfer.srcAccessMask               = context->targetAccess.accessMask;
+        toTransfer.dstAccessMask               = VK_ACCESS_TRANSFER_READ_BIT;
+        toTransfer.oldLayout                   = context->targetAccess.layout;
+        toTransfer.newLayout                   = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        toTransfer.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+        toTransfer.image                       = context->targetImage;
+        toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        toTransfer.subresourceRange.levelCount = 1;
+        toTransfer.subresourceRange.layerCount = 1;
+        vk.cmdPipelineBarrier(slot->commandBuffer, context->targetAccess.pipelineStages,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &toTransfer);
+
+        std::vector<VkBufferMemoryBarrier> toHost;
+        toHost.reserve(copies.size());
+        for (auto& copy : copies)
+        {
+            copy.region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            copy.region.imageSubresource.layerCount = 1;
+            vk.cmdCopyImageToBuffer(slot->commandBuffer, context->targetImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                    copy.buffer, 1, &copy.region);
+
+            VkBufferMemoryBarrier barrier {};
+            barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+            barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            barrier.buffer              = copy.buffer;
+            barrier.size                = VK_WHOLE_SIZE;
+            toHost.push_back(barrier);
+        }
+        vk.cmdPipelineBarrier(slot->commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0,
+                              nullptr, static_cast<std::uint32_t>(toHost.size()), toHost.data(), 0, nullptr);
+
+        // rive transitions the target from here at the start of the next frame.
+        context->targetAccess.pipelineStages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        context->targetAccess.accessMask     = VK_ACCESS_TRANSFER_READ_BIT;
+        context->targetAccess.layout         = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+        return rive_renderer_status_t::ok;
+    }
+
+    // Copies the pixels of the newest submitted frame that read back the target, waiting for it if it is still on
+    // the GPU.
+    rive_renderer_status_t MapVulkanReadback(ContextHandle* context, const std::uint8_t** out_pixels)
+    {
+        auto* slot = context->readbackSlot;
+        if (slot == nullptr)
         {
-            SetLastError("context dimensions must be non-zero");
+            SetLastError("no frame has been read back; enable framebuffer readback before end_frame");
             return rive_renderer_status_t::invalid_parameter;
         }
-
-        auto* context = new (std::nothrow) ContextHandle();
-        if (context == nullptr)
+        if (slot->readbackWidth != context->width || slot->readbackHeight != context->height)
         {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
+            SetLastError("last read back frame does not match the context size");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        context->device        = device_handle;
-        context->width         = width;
-        context->height        = height;
-        context->renderContext = nullptr;
-        context->cpuFramebuffer.assign(static_cast<size_t>(width) * height * 4, 0);
-        context->cpuRenderTarget.reset();
-        context->cpuFrameRecording  = false;
-        context->commandListsClosed = false;
-
-        device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        auto status = WaitForVulkanSlot(context, *slot);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+        status = InvalidateVulkanStagingBuffer(context, slot->readback);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
 
-        out_context->handle = context;
-        ClearLastError();
+        *out_pixels = static_cast<const std::uint8_t*>(slot->readback.pixels);
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_retain(rive_renderer_context_t context)
+    // Waits up to timeoutMs for frame, which must have been submitted, to finish on the GPU.
+    rive_renderer_status_t WaitForVulkanFrame(ContextHandle* context, std::uint64_t frame, std::uint64_t timeoutMs)
     {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
+        for (const auto& slot : context->frameSlots)
         {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
-        }
+            if (!slot.submitted || slot.frameNumber != frame)
+            {
+                continue;
+            }
 
-        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-        ClearLastError();
+            const std::uint64_t maxMs     = std::numeric_limits<std::uint64_t>::max() / 1000000;
+            const std::uint64_t timeoutNs = timeoutMs >= maxMs ? std::numeric_limits<std::uint64_t>::max()
+                                                               : timeoutMs * 1000000;
+            VkResult result =
+                context->device->vk.waitForFences(context->device->vkDevice, 1, &slot.fence, VK_TRUE, timeoutNs);
+            if (result == VK_TIMEOUT)
+            {
+                SetLastError("readback wait timed out");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            if (result != VK_SUCCESS)
+            {
+                SetLastError("Vulkan fence wait failed");
+                return result == VK_ERROR_DEVICE_LOST ? rive_renderer_status_t::device_lost
+                                                      : rive_renderer_status_t::internal_error;
+            }
+            break;
+        }
+        RetireVulkanFrames(context);
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_release(rive_renderer_context_t context)
+    void ReleaseVulkanContext(ContextHandle* context)
     {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
+        if (context->device == nullptr || context->device->backend != rive_renderer_backend_t::vulkan)
         {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            return;
         }
 
-        if (handle->surface != nullptr)
+        auto&    vk     = context->device->vk;
+        VkDevice device = context->device->vkDevice;
+        if (context->commandPool != VK_NULL_HANDLE)
         {
-            SetLastError("context has an active surface; release the surface before destroying the context");
+            WaitForVulkanIdle(context);
+        }
+        DestroyVulkanTarget(context);
+        context->renderContext.reset();
+        for (auto& slot : context->frameSlots)
+        {
+            DestroyVulkanStagingBuffer(context, &slot.readback);
+            if (slot.fence != VK_NULL_HANDLE)
+            {
+                vk.destroyFence(device, slot.fence, nullptr);
+            }
+            slot = {};
+        }
+        for (auto& staging : context->stagingPool)
+        {
+            DestroyVulkanStagingBuffer(context, staging.get());
+        }
+        context->stagingPool.clear();
+        if (context->commandPool != VK_NULL_HANDLE)
+        {
+            vk.destroyCommandPool(device, context->commandPool, nullptr);
+            context->commandPool = VK_NULL_HANDLE;
+        }
+    }
+#endif
+    bool ConvertFillRule(rive_renderer_fill_rule_t value, rive::FillRule* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_fill_rule_t::non_zero:
+            *out = rive::FillRule::nonZero;
+            return true;
+        case rive_renderer_fill_rule_t::even_odd:
+            *out = rive::FillRule::evenOdd;
+            return true;
+        case rive_renderer_fill_rule_t::clockwise:
+            *out = rive::FillRule::clockwise;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertPaintStyle(rive_renderer_paint_style_t value, rive::RenderPaintStyle* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_paint_style_t::fill:
+            *out = rive::RenderPaintStyle::fill;
+            return true;
+        case rive_renderer_paint_style_t::stroke:
+            *out = rive::RenderPaintStyle::stroke;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertStrokeCap(rive_renderer_stroke_cap_t value, rive::StrokeCap* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_stroke_cap_t::butt:
+            *out = rive::StrokeCap::butt;
+            return true;
+        case rive_renderer_stroke_cap_t::round:
+            *out = rive::StrokeCap::round;
+            return true;
+        case rive_renderer_stroke_cap_t::square:
+            *out = rive::StrokeCap::square;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertStrokeJoin(rive_renderer_stroke_join_t value, rive::StrokeJoin* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_stroke_join_t::miter:
+            *out = rive::StrokeJoin::miter;
+            return true;
+        case rive_renderer_stroke_join_t::round:
+            *out = rive::StrokeJoin::round;
+            return true;
+        case rive_renderer_stroke_join_t::bevel:
+            *out = rive::StrokeJoin::bevel;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertBlendMode(rive_renderer_blend_mode_t value, rive::BlendMode* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_blend_mode_t::src_over:
+            *out = rive::BlendMode::srcOver;
+            return true;
+        case rive_renderer_blend_mode_t::screen:
+            *out = rive::BlendMode::screen;
+            return true;
+        case rive_renderer_blend_mode_t::overlay:
+            *out = rive::BlendMode::overlay;
+            return true;
+        case rive_renderer_blend_mode_t::darken:
+            *out = rive::BlendMode::darken;
+            return true;
+        case rive_renderer_blend_mode_t::lighten:
+            *out = rive::BlendMode::lighten;
+            return true;
+        case rive_renderer_blend_mode_t::color_dodge:
+            *out = rive::BlendMode::colorDodge;
+            return true;
+        case rive_renderer_blend_mode_t::color_burn:
+            *out = rive::BlendMode::colorBurn;
+            return true;
+        case rive_renderer_blend_mode_t::hard_light:
+            *out = rive::BlendMode::hardLight;
+            return true;
+        case rive_renderer_blend_mode_t::soft_light:
+            *out = rive::BlendMode::softLight;
+            return true;
+        case rive_renderer_blend_mode_t::difference:
+            *out = rive::BlendMode::difference;
+            return true;
+        case rive_renderer_blend_mode_t::exclusion:
+            *out = rive::BlendMode::exclusion;
+            return true;
+        case rive_renderer_blend_mode_t::multiply:
+            *out = rive::BlendMode::multiply;
+            return true;
+        case rive_renderer_blend_mode_t::hue:
+            *out = rive::BlendMode::hue;
+            return true;
+        case rive_renderer_blend_mode_t::saturation:
+            *out = rive::BlendMode::saturation;
+            return true;
+        case rive_renderer_blend_mode_t::color:
+            *out = rive::BlendMode::color;
+            return true;
+        case rive_renderer_blend_mode_t::luminosity:
+            *out = rive::BlendMode::luminosity;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertBufferType(rive_renderer_buffer_type_t value, rive::RenderBufferType* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_buffer_type_t::index:
+            *out = rive::RenderBufferType::index;
+            return true;
+        case rive_renderer_buffer_type_t::vertex:
+            *out = rive::RenderBufferType::vertex;
+            return true;
+        }
+        return false;
+    }
+
+    rive::RenderBufferFlags ConvertBufferFlags(rive_renderer_buffer_flags_t value)
+    {
+        rive::RenderBufferFlags flags = rive::RenderBufferFlags::none;
+        const std::uint32_t     bits  = static_cast<std::uint32_t>(value);
+        if ((bits & static_cast<std::uint32_t>(rive_renderer_buffer_flags_t::mapped_once_at_initialization)) != 0)
+        {
+            flags |= rive::RenderBufferFlags::mappedOnceAtInitialization;
+        }
+        return flags;
+    }
+
+    rive::ImageSampler ConvertImageSampler(const rive_renderer_image_sampler_t* sampler)
+    {
+        if (sampler == nullptr)
+        {
+            return rive::ImageSampler::LinearClamp();
+        }
+
+        rive::ImageSampler result;
+        result.wrapX  = static_cast<rive::ImageWrap>(static_cast<std::uint8_t>(sampler->wrap_x));
+        result.wrapY  = static_cast<rive::ImageWrap>(static_cast<std::uint8_t>(sampler->wrap_y));
+        result.filter = static_cast<rive::ImageFilter>(static_cast<std::uint8_t>(sampler->filter));
+        return result;
+    }
+
+#if defined(WITH_RIVE_TEXT)
+    bool ConvertTextAlign(rive_renderer_text_align_t value, rive::TextAlign* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_text_align_t::left:
+            *out = rive::TextAlign::left;
+            return true;
+        case rive_renderer_text_align_t::right:
+            *out = rive::TextAlign::right;
+            return true;
+        case rive_renderer_text_align_t::center:
+            *out = rive::TextAlign::center;
+            return true;
+        }
+        return false;
+    }
+
+    bool ConvertTextWrap(rive_renderer_text_wrap_t value, rive::TextWrap* out)
+    {
+        switch (value)
+        {
+        case rive_renderer_text_wrap_t::wrap:
+            *out = rive::TextWrap::wrap;
+            return true;
+        case rive_renderer_text_wrap_t::no_wrap:
+            *out = rive::TextWrap::noWrap;
+            return true;
+        }
+        return false;
+    }
+
+    std::uint8_t DirectionLevelFromStyle(rive_renderer_text_direction_t value)
+    {
+        switch (value)
+        {
+        case rive_renderer_text_direction_t::rtl:
+            return 1;
+        case rive_renderer_text_direction_t::ltr:
+        case rive_renderer_text_direction_t::automatic:
+        default:
+            return 0;
+        }
+    }
+#endif
+    rive::Mat2D ToMat2D(const rive_renderer_mat2d_t* mat)
+    {
+        if (mat == nullptr)
+        {
+            return rive::Mat2D();
+        }
+        return rive::Mat2D(mat->xx, mat->xy, mat->yx, mat->yy, mat->tx, mat->ty);
+    }
+
+    rive_renderer_adapter_desc_t MakeNullAdapter()
+    {
+        rive_renderer_adapter_desc_t desc {};
+        desc.backend                = rive_renderer_backend_t::null;
+        desc.backend_padding        = 0;
+        desc.vendor_id              = 0xffff;
+        desc.device_id              = 0xffff;
+        desc.subsys_id              = 0;
+        desc.revision               = 1;
+        desc.dedicated_video_memory = 0;
+        desc.shared_system_memory   = 0;
+        desc.flags                  = static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
+        desc.reserved               = 0;
+        const char name[]           = "Null Renderer";
+        std::memcpy(desc.name, name, sizeof(name));
+        std::memset(desc.reserved_padding, 0, sizeof(desc.reserved_padding));
+        return desc;
+    }
+
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+    rive_renderer_adapter_desc_t MakeMetalAdapter()
+    {
+        rive_renderer_adapter_desc_t desc {};
+        desc.backend                = rive_renderer_backend_t::metal;
+        desc.backend_padding        = 0;
+        desc.vendor_id              = 0;
+        desc.device_id              = 0;
+        desc.subsys_id              = 0;
+        desc.revision               = 1;
+        desc.dedicated_video_memory = 0;
+        desc.shared_system_memory   = 0;
+        desc.flags                  = static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
+        desc.reserved               = 0;
+        const char name[]           = "Metal Default Device";
+        std::memcpy(desc.name, name, sizeof(name));
+        std::memset(desc.reserved_padding, 0, sizeof(desc.reserved_padding));
+        return desc;
+    }
+#endif
+
+    // Brings lastCompletedFrame up to date with the GPU. Backends that finish frames at submit have nothing to poll.
+    void PollCompletedFrames(ContextHandle* context)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (context->directFence != nullptr)
+        {
+            RetireD3D12Frames(context);
+        }
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (context->metalContext != nullptr)
+        {
+            context->lastCompletedFrame = rive_metal_context_completed_frame(context->metalContext);
+        }
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (context->commandPool != VK_NULL_HANDLE)
+        {
+            RetireVulkanFrames(context);
+        }
+#endif
+        NotifyCompletedFrames(context);
+    }
+
+    // Whether frame of context has finished on the GPU, asked from a thread that need not be driving the context.
+    // Backends without frames in flight finish them at submit, where the context signals its fences itself.
+    bool QueryFrameCompleted(ContextHandle* context, std::uint64_t frame)
+    {
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        return context->metalContext != nullptr && rive_metal_context_completed_frame(context->metalContext) >= frame;
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (context->commandPool == VK_NULL_HANDLE)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(context->completionMutex);
+        if (frame <= context->recycledFrame)
+        {
+            return true;
+        }
+        for (const auto& slot : context->frameSlots)
+        {
+            if (slot.submitted && slot.frameNumber == frame)
+            {
+                return context->device->vk.getFenceStatus(context->device->vkDevice, slot.fence) == VK_SUCCESS;
+            }
+        }
+        return false;
+#else
+        (void)context;
+        (void)frame;
+        return false;
+#endif
+    }
+
+    // Raises a CPU fence to the values of its pending frames that have finished and returns whether it has reached
+    // value. fence->mutex must be held.
+    bool PollCpuFence(FenceHandle* fence, std::uint64_t value)
+    {
+        for (const auto& pending : fence->pendingFrames)
+        {
+            if (fence->completedValue < pending.value && QueryFrameCompleted(pending.context, pending.frame))
+            {
+                fence->completedValue = pending.value;
+            }
+        }
+        return fence->completedValue >= value;
+    }
+
+    // Blocks until every submitted frame of context has finished on the GPU.
+    rive_renderer_status_t WaitForContextIdle(ContextHandle* context)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        return WaitForD3D12Idle(context);
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (context->commandPool != VK_NULL_HANDLE)
+        {
+            return WaitForVulkanIdle(context);
+        }
+        return rive_renderer_status_t::ok;
+#else
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (context->metalContext != nullptr)
+        {
+            rive_metal_context_wait_idle(context->metalContext);
+        }
+#endif
+        PollCompletedFrames(context);
+        return rive_renderer_status_t::ok;
+#endif
+    }
+
+    std::unique_ptr<rive::Renderer> MakeContextRenderer(ContextHandle* context)
+    {
+        if (context->renderContext)
+        {
+            return std::make_unique<rive::RiveRenderer>(context->renderContext.get());
+        }
+        if (context->cpuContext)
+        {
+            return std::make_unique<rive_renderer_cpu::CpuRenderer>(context->cpuContext.get());
+        }
+        return nullptr;
+    }
+
+    // Clips renderer to the damage of the frame being drawn, at the base of its state stack so no restore can lift it.
+    // Clips cannot be undone, so a renderer clipped for an earlier frame first starts over with a new rive::Renderer.
+    void ClipRendererToDamage(ContextHandle* context, RendererHandle* renderer)
+    {
+        if (renderer->damageClipped)
+        {
+            if (std::unique_ptr<rive::Renderer> fresh = MakeContextRenderer(context))
+            {
+                renderer->renderer = std::move(fresh);
+            }
+            renderer->state         = {};
+            renderer->damageClipped = false;
+            renderer->stateStack.clear();
+        }
+        if (context->damageClip)
+        {
+            renderer->renderer->clipPath(context->damageClip.get());
+            renderer->state.clipBounds = context->frameDamage;
+            renderer->damageClipped    = true;
+        }
+    }
+
+    // Sets the region the frame being begun on context redraws and starts collecting damage for the next one. The
+    // whole target is redrawn unless damage tracking is on and each of the bufferCount targets frames rotate through
+    // already holds a frame of the current size; a bufferCount of 0 means the backend never keeps earlier contents.
+    // The damage of the previous bufferCount - 1 frames is redrawn too, since the target in use has not seen it yet.
+    void UpdateFrameDamage(ContextHandle* context, std::uint32_t bufferCount)
+    {
+        const rive_renderer_rect_t target {0.0f, 0.0f, static_cast<float>(context->width),
+                                           static_cast<float>(context->height)};
+        const rive_renderer_rect_t pending = context->pendingDamage;
+        context->pendingDamage             = kEmptyRect;
+        context->frameDamage               = target;
+        context->damageClip                = nullptr;
+        if (!context->damageTracking || bufferCount == 0)
+        {
+            context->damageHistory.clear();
+            context->trackedFrames = 0;
+            return;
+        }
+
+        rive_renderer_rect_t damage = pending;
+        for (const rive_renderer_rect_t& previous : context->damageHistory)
+        {
+            IncludeRect(&damage, previous);
+        }
+        context->damageHistory.push_back(pending);
+        while (context->damageHistory.size() >= bufferCount)
+        {
+            context->damageHistory.erase(context->damageHistory.begin());
+        }
+        const bool preserved   = context->trackedFrames >= bufferCount;
+        context->trackedFrames = std::min(context->trackedFrames + 1, bufferCount);
+        if (!preserved)
+        {
+            return;
+        }
+
+        // Round out so partly covered pixels are redrawn whole.
+        damage = IntersectRects(damage, target);
+        damage = IsEmptyRect(damage) ? rive_renderer_rect_t {0.0f, 0.0f, 0.0f, 0.0f}
+                                     : rive_renderer_rect_t {std::floor(damage.left), std::floor(damage.top),
+                                                             std::ceil(damage.right), std::ceil(damage.bottom)};
+        if (std::memcmp(&damage, &target, sizeof(damage)) == 0)
+        {
+            return;
+        }
+
+        rive::Factory* factory = GetFactory(context);
+        if (factory == nullptr)
+        {
+            return;
+        }
+        rive::RawPath rect;
+        rect.moveTo(damage.left, damage.top);
+        rect.lineTo(damage.right, damage.top);
+        rect.lineTo(damage.right, damage.bottom);
+        rect.lineTo(damage.left, damage.bottom);
+        rect.close();
+        context->damageClip = factory->makeRenderPath(rect, rive::FillRule::nonZero);
+        if (context->damageClip)
+        {
+            context->frameDamage = damage;
+        }
+    }
+
+    // Updates the frame damage and clips the context's renderers to it, including those kept from earlier frames, so
+    // no draw of the frame reaches the pixels it keeps.
+    void BeginFrameDamage(ContextHandle* context, std::uint32_t bufferCount)
+    {
+        UpdateFrameDamage(context, bufferCount);
+        std::lock_guard<std::mutex> lock(context->renderersMutex);
+        for (RendererHandle* renderer : context->renderers)
+        {
+            ClipRendererToDamage(context, renderer);
+        }
+    }
+
+    bool ValidateContextSize(std::uint32_t width, std::uint32_t height)
+    {
+        return width > 0 && height > 0;
+    }
+
+    // Walks a command stream, replaying it on renderer. With renderer null the stream is only validated. Returns the
+    // error for the first bad record, or null when the stream is well formed.
+    const char* ReplayCommands(const CommandBufferHandle& buffer, RendererHandle* renderer)
+    {
+        const std::uint8_t* cursor = buffer.commands.data();
+        const std::uint8_t* end    = cursor + buffer.commands.size();
+        auto                read   = [&](void* out, std::size_t size)
+        {
+            if (static_cast<std::size_t>(end - cursor) < size)
+            {
+                return false;
+            }
+            std::memcpy(out, cursor, size);
+            cursor += size;
+            return true;
+        };
+
+        while (cursor != end)
+        {
+            std::uint32_t op;
+            if (!read(&op, sizeof(op)))
+            {
+                return "command stream is truncated";
+            }
+            switch (static_cast<rive_renderer_command_op_t>(op))
+            {
+            case rive_renderer_command_op_t::save:
+                if (renderer != nullptr)
+                {
+                    SaveRenderer(renderer);
+                }
+                break;
+            case rive_renderer_command_op_t::restore:
+                if (renderer != nullptr)
+                {
+                    RestoreRenderer(renderer);
+                }
+                break;
+            case rive_renderer_command_op_t::transform:
+            {
+                rive_renderer_mat2d_t transform;
+                if (!read(&transform, sizeof(transform)))
+                {
+                    return "command stream is truncated";
+                }
+                if (renderer != nullptr)
+                {
+                    TransformRenderer(renderer, ToMat2D(&transform));
+                }
+                break;
+            }
+            case rive_renderer_command_op_t::clip_path:
+            {
+                rive_renderer_command_clip_path_t command;
+                if (!read(&command, sizeof(command)))
+                {
+                    return "command stream is truncated";
+                }
+                PathHandle* path = LookupCommandHandle(buffer.paths, command.path_slot);
+                if (path == nullptr)
+                {
+                    return "command references an unbound path slot";
+                }
+                if (renderer != nullptr)
+                {
+                    rive::RenderPath* renderPath = ResolvePath(path);
+                    if (renderPath == nullptr)
+                    {
+                        return "makeRenderPath failed";
+                    }
+                    ClipRendererPath(renderer, renderPath, path, path->bounds);
+                }
+                break;
+            }
+            case rive_renderer_command_op_t::draw_path:
+            {
+                rive_renderer_command_draw_path_t command;
+                if (!read(&command, sizeof(command)))
+                {
+                    return "command stream is truncated";
+                }
+                PathHandle*  path  = LookupCommandHandle(buffer.paths, command.path_slot);
+                PaintHandle* paint = LookupCommandHandle(buffer.paints, command.paint_slot);
+                if (path == nullptr || paint == nullptr)
+                {
+                    return "command references an unbound path or paint slot";
+                }
+                if (renderer != nullptr)
+                {
+                    rive::RenderPath* renderPath = ResolvePath(path);
+                    if (renderPath == nullptr)
+                    {
+                        return "makeRenderPath failed";
+                    }
+                    DrawPathWithPaint(renderer, renderPath, path, paint, path->bounds);
+                }
+                break;
+            }
+            case rive_renderer_command_op_t::draw_image:
+            {
+                rive_renderer_command_draw_image_t command;
+                if (!read(&command, sizeof(command)))
+                {
+                    return "command stream is truncated";
+                }
+                rive::RenderImage* image = LookupCommandSlot(buffer.images, command.image_slot);
+                if (image == nullptr)
+                {
+                    return "command references an unbound image slot";
+                }
+                rive::BlendMode mode;
+                if (!ConvertBlendMode(command.blend_mode, &mode))
+                {
+                    return "invalid blend mode in command stream";
+                }
+                if (renderer != nullptr)
+                {
+                    renderer->renderer->drawImage(image, ConvertImageSampler(&command.sampler), mode, command.opacity);
+                }
+                break;
+            }
+            default:
+                return "unknown command op";
+            }
+        }
+        return nullptr;
+    }
+
+    rive::ColorInt FadeColor(rive::ColorInt color, float opacity)
+    {
+        const auto alpha = static_cast<rive::ColorInt>(std::lround(static_cast<float>(color >> 24) * opacity));
+        return (color & 0x00ffffffu) | (alpha << 24);
+    }
+
+    // Builds a copy of state with every color's alpha scaled by opacity. Gradients are rebuilt from their definition;
+    // a shader without one cannot be faded and is shared as is.
+    rive::rcp<rive::RenderPaint> MakeFadedPaint(rive::Factory* factory, const PaintState& state, float opacity)
+    {
+        rive::rcp<rive::RenderPaint> paint = factory->makeRenderPaint();
+        if (!paint)
+        {
+            return nullptr;
+        }
+
+        paint->style(state.style);
+        paint->color(FadeColor(state.color, opacity));
+        paint->thickness(state.thickness);
+        paint->join(state.join);
+        paint->cap(state.cap);
+        paint->feather(state.feather);
+        paint->blendMode(state.blendMode);
+        if (state.gradient)
+        {
+            const GradientSpec&         spec = *state.gradient;
+            std::vector<rive::ColorInt> colors(spec.colors.size());
+            for (std::size_t i = 0; i < colors.size(); ++i)
+            {
+                colors[i] = FadeColor(spec.colors[i], opacity);
+            }
+            paint->shader(spec.radial ? factory->makeRadialGradient(spec.coords[0], spec.coords[1], spec.coords[2],
+                                                                    colors.data(), spec.stops.data(), colors.size())
+                                      : factory->makeLinearGradient(spec.coords[0], spec.coords[1], spec.coords[2],
+                                                                    spec.coords[3], colors.data(), spec.stops.data(),
+                                                                    colors.size()));
+        }
+        else if (state.shader)
+        {
+            paint->shader(state.shader);
+        }
+        return paint;
+    }
+
+    // Fills in skipTo and the spatial index of a picture whose ops were just recorded.
+    void IndexPicture(PictureHandle* picture)
+    {
+        const std::vector<PictureOp>& ops = picture->ops;
+        picture->skipTo.assign(ops.size(), static_cast<std::uint32_t>(ops.size()));
+        std::vector<std::uint32_t> openSaves;
+        auto                       nextState = static_cast<std::uint32_t>(ops.size());
+        for (std::size_t i = ops.size(); i-- > 0;)
+        {
+            if (IsDrawOp(ops[i].kind))
+            {
+                picture->skipTo[i] = nextState;
+            }
+            else
+            {
+                nextState = static_cast<std::uint32_t>(i);
+            }
+        }
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            if (ops[i].kind == PictureOp::Kind::save)
+            {
+                openSaves.push_back(static_cast<std::uint32_t>(i));
+            }
+            else if (ops[i].kind == PictureOp::Kind::restore && !openSaves.empty())
+            {
+                picture->skipTo[openSaves.back()] = static_cast<std::uint32_t>(i + 1);
+                openSaves.pop_back();
+            }
+        }
+
+        // The index holds for as long as every editable path stays within the bounds its draws and clips were
+        // recorded with, and every paint reaches no further past its paths than it did; RefitPictureIndex moves it
+        // on once they outgrow them.
+        std::unordered_map<const PathHandle*, rive_renderer_rect_t> paths;
+        std::unordered_map<const PaintHandle*, float>               outsets;
+        for (const PictureOp& op : ops)
+        {
+            if (op.pathHandle != nullptr)
+            {
+                auto [found, inserted] = paths.try_emplace(op.pathHandle, op.pathBounds);
+                found->second          = IntersectRects(found->second, op.pathBounds);
+            }
+            if (op.paintHandle != nullptr)
+            {
+                auto [found, inserted] = outsets.try_emplace(op.paintHandle, op.paintOutset);
+                found->second          = std::min(found->second, op.paintOutset);
+            }
+        }
+        picture->editablePaths.assign(paths.begin(), paths.end());
+        picture->paintOutsets.assign(outsets.begin(), outsets.end());
+
+        struct Item
+        {
+            rive_renderer_rect_t bounds;
+            std::uint32_t        op;
+            float                centerX;
+            float                centerY;
+        };
+        // Draws that are empty for now still get a leaf, since edits to their paths or clips may give them an extent.
+        std::vector<Item> items;
+        picture->drawBounds.assign(ops.size(), kEmptyRect);
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            const rive_renderer_rect_t& bounds = ops[i].bounds;
+            if (!IsDrawOp(ops[i].kind))
+            {
+                continue;
+            }
+            ++picture->drawCount;
+            picture->drawBounds[i] = bounds;
+            if (IsUnboundedRect(bounds))
+            {
+                picture->unboundedDraws.push_back(static_cast<std::uint32_t>(i));
+                continue;
+            }
+            const bool empty = IsEmptyRect(bounds);
+            items.push_back({bounds, static_cast<std::uint32_t>(i), empty ? 0.0f : 0.5f * (bounds.left + bounds.right),
+                             empty ? 0.0f : 0.5f * (bounds.top + bounds.bottom)});
+        }
+        if (items.empty())
+        {
+            return;
+        }
+
+        // Sort-tile-recursive packing: cut the draws into vertical slices of whole leaves by x, then order each
+        // slice by y, so every leaf covers a compact tile.
+        const std::size_t leafCount  = (items.size() + kPictureIndexFanout - 1) / kPictureIndexFanout;
+        const auto        sliceCount = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+        const std::size_t sliceSize  = kPictureIndexFanout * ((leafCount + sliceCount - 1) / sliceCount);
+        std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.centerX < b.centerX; });
+        for (std::size_t begin = 0; begin < items.size(); begin += sliceSize)
+        {
+            const std::size_t end = std::min(begin + sliceSize, items.size());
+            std::sort(items.begin() + static_cast<std::ptrdiff_t>(begin),
+                      items.begin() + static_cast<std::ptrdiff_t>(end),
+                      [](const Item& a, const Item& b) { return a.centerY < b.centerY; });
+        }
+
+        PictureIndex& index = picture->index;
+        for (const Item& item : items)
+        {
+            index.boxes.push_back(item.bounds);
+            index.ops.push_back(item.op);
+        }
+        index.levelStarts.push_back(0);
+        std::size_t levelBegin = 0;
+        std::size_t levelEnd   = index.boxes.size();
+        while (levelEnd - levelBegin > 1)
+        {
+            for (std::size_t i = levelBegin; i < levelEnd; i += kPictureIndexFanout)
+            {
+                rive_renderer_rect_t node = kEmptyRect;
+                for (std::size_t child = i; child < std::min(i + kPictureIndexFanout, levelEnd); ++child)
+                {
+                    IncludeRect(&node, index.boxes[child]);
+                }
+                index.boxes.push_back(node);
+            }
+            index.levelStarts.push_back(levelEnd);
+            levelBegin = levelEnd;
+            levelEnd   = index.boxes.size();
+        }
+        index.levelStarts.push_back(levelEnd);
+    }
+
+    // Whether the paths and paints picture draws still fit the bounds its index was fitted to.
+    bool PictureIndexIsCurrent(const PictureHandle& picture)
+    {
+        for (const auto& [path, bounds] : picture.editablePaths)
+        {
+            if (!RectContains(bounds, path->bounds))
+            {
+                return false;
+            }
+        }
+        for (const auto& [paint, outset] : picture.paintOutsets)
+        {
+            if (PaintOutset(paint->state) > outset)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Local bounds of the path op clips or draws, following edits made to it since recording.
+    const rive_renderer_rect_t& CurrentPathBounds(const PictureOp& op)
+    {
+        return op.pathHandle != nullptr ? op.pathHandle->bounds : op.pathBounds;
+    }
+
+    // Measures every draw of ops the way PictureRecorder placed it, from the current bounds of the paths and paints
+    // they use.
+    void MeasurePictureDraws(const std::vector<PictureOp>& ops, std::vector<rive_renderer_rect_t>* bounds)
+    {
+        RendererState              state;
+        std::vector<RendererState> stack;
+        auto place = [&state](const rive_renderer_rect_t& localBounds)
+        { return IntersectRects(TransformRect(state.matrix, localBounds), state.clipBounds); };
+        for (std::size_t i = 0; i < ops.size(); ++i)
+        {
+            const PictureOp& op = ops[i];
+            switch (op.kind)
+            {
+            case PictureOp::Kind::save:
+                stack.push_back(state);
+                break;
+            case PictureOp::Kind::restore:
+                if (!stack.empty())
+                {
+                    state = stack.back();
+                    stack.pop_back();
+                }
+                break;
+            case PictureOp::Kind::transform:
+                state.matrix = state.matrix * op.matrix;
+                break;
+            case PictureOp::Kind::clipPath:
+                // Clips recorded without bounds leave the clip bounds as they were.
+                if (!IsUnboundedRect(op.pathBounds))
+                {
+                    state.clipBounds =
+                        IntersectRects(state.clipBounds, TransformRect(state.matrix, CurrentPathBounds(op)));
+                }
+                break;
+            case PictureOp::Kind::drawPath:
+                (*bounds)[i] = op.paintHandle == nullptr
+                                   ? state.clipBounds
+                                   : place(OutsetRect(CurrentPathBounds(op), PaintOutset(op.paintHandle->state)));
+                break;
+            case PictureOp::Kind::drawImage:
+                (*bounds)[i] = place({0.0f, 0.0f, static_cast<float>(op.image->width()),
+                                      static_cast<float>(op.image->height())});
+                break;
+            case PictureOp::Kind::drawImageMesh:
+                (*bounds)[i] = state.clipBounds;
+                break;
+            }
+        }
+    }
+
+    // Brings the index of picture up to date with edits that outgrew the bounds it was fitted to: every draw is
+    // measured again, the leaves take the new bounds and each level above is refitted to its children. The tree
+    // keeps its shape, so draws that moved far may share nodes with distant ones until the picture is recorded
+    // again, but nothing is drawn that the index does not cover. Callers hold indexMutex.
+    void RefitPictureIndex(PictureHandle* picture)
+    {
+        if (PictureIndexIsCurrent(*picture))
+        {
+            return;
+        }
+
+        MeasurePictureDraws(picture->ops, &picture->drawBounds);
+        for (auto& [path, bounds] : picture->editablePaths)
+        {
+            bounds = path->bounds;
+        }
+        for (auto& [paint, outset] : picture->paintOutsets)
+        {
+            outset = PaintOutset(paint->state);
+        }
+
+        PictureIndex& index = picture->index;
+        if (index.ops.empty())
+        {
+            return;
+        }
+        for (std::size_t leaf = 0; leaf < index.ops.size(); ++leaf)
+        {
+            index.boxes[leaf] = picture->drawBounds[index.ops[leaf]];
+        }
+        for (std::size_t level = 1; level + 1 < index.levelStarts.size(); ++level)
+        {
+            const std::size_t childBegin = index.levelStarts[level - 1];
+            const std::size_t childEnd   = index.levelStarts[level];
+            for (std::size_t node = index.levelStarts[level]; node < index.levelStarts[level + 1]; ++node)
+            {
+                const std::size_t firstChild = childBegin + (node - index.levelStarts[level]) * kPictureIndexFanout;
+                rive_renderer_rect_t box = kEmptyRect;
+                for (std::size_t child = firstChild; child < std::min(firstChild + kPictureIndexFanout, childEnd);
+                     ++child)
+                {
+                    IncludeRect(&box, index.boxes[child]);
+                }
+                index.boxes[node] = box;
+            }
+        }
+    }
+
+    // Collects, in op order, every draw of picture that may touch query.
+    void CullPicture(const PictureHandle& picture, const rive_renderer_rect_t& query, std::vector<std::uint32_t>* out)
+    {
+        out->assign(picture.unboundedDraws.begin(), picture.unboundedDraws.end());
+        const PictureIndex& index = picture.index;
+        if (!index.ops.empty())
+        {
+            // Entries are (level, position within the level), starting from the single root box.
+            std::vector<std::pair<std::size_t, std::size_t>> pending {{index.levelStarts.size() - 2, 0}};
+            while (!pending.empty())
+            {
+                const auto [level, position] = pending.back();
+                pending.pop_back();
+                if (!RectsOverlap(index.boxes[index.levelStarts[level] + position], query))
+                {
+                    continue;
+                }
+                if (level == 0)
+                {
+                    out->push_back(index.ops[position]);
+                    continue;
+                }
+                const std::size_t childCount = index.levelStarts[level] - index.levelStarts[level - 1];
+                const std::size_t firstChild = position * kPictureIndexFanout;
+                for (std::size_t child = firstChild; child < std::min(firstChild + kPictureIndexFanout, childCount);
+                     ++child)
+                {
+                    pending.emplace_back(level - 1, child);
+                }
+            }
+        }
+        std::sort(out->begin(), out->end());
+    }
+
+    // Picture-space bounds of everything picture draws.
+    rive_renderer_rect_t PictureBounds(PictureHandle* picture)
+    {
+        if (!picture->unboundedDraws.empty())
+        {
+            return kUnboundedRect;
+        }
+        std::lock_guard<std::mutex> lock(picture->indexMutex);
+        RefitPictureIndex(picture);
+        return picture->index.boxes.empty() ? kEmptyRect : picture->index.boxes.back();
+    }
+
+    bool SameMatrix(const rive::Mat2D& a, const rive::Mat2D& b)
+    {
+        return a.xx() == b.xx() && a.xy() == b.xy() && a.yx() == b.yx() && a.yy() == b.yy() && a.tx() == b.tx() &&
+               a.ty() == b.ty();
+    }
+
+    // Whether the path and paint op retains are still as they were when it was recorded.
+    bool OpUnedited(const PictureOp& op)
+    {
+        return (op.pathHandle == nullptr || op.pathHandle->version == op.pathVersion) &&
+               (op.paintHandle == nullptr || op.paintHandle->state.version == op.paintVersion);
+    }
+
+    // Whether two recorded ops use the same resources in the same state. Ops whose path or paint was edited after
+    // recording never match, since nothing tells which version a previous frame drew.
+    bool SameOp(const PictureOp& a, const PictureOp& b)
+    {
+        return a.kind == b.kind && a.path.get() == b.path.get() && a.paint.get() == b.paint.get() &&
+               a.pathHandle == b.pathHandle && a.pathVersion == b.pathVersion && a.paintHandle == b.paintHandle &&
+               a.paintVersion == b.paintVersion && OpUnedited(a) && OpUnedited(b) && a.image.get() == b.image.get() &&
+               a.sampler.wrapX == b.sampler.wrapX && a.sampler.wrapY == b.sampler.wrapY &&
+               a.sampler.filter == b.sampler.filter && a.blendMode == b.blendMode && a.opacity == b.opacity &&
+               a.vertices.get() == b.vertices.get() && a.uvCoords.get() == b.uvCoords.get() &&
+               a.indices.get() == b.indices.get() && a.vertexCount == b.vertexCount && a.indexCount == b.indexCount &&
+               std::memcmp(&a.bounds, &b.bounds, sizeof(a.bounds)) == 0;
+    }
+
+    // A clip in effect for some draws of a picture: its op, the transform it was applied under and the index of the
+    // clip in effect before it, or -1.
+    struct PictureClip
+    {
+        const PictureOp* op;
+        rive::Mat2D      matrix;
+        std::int32_t     parent;
+    };
+
+    // A draw of a picture with the transform and innermost clip it draws under and the bounds it covers now.
+    struct PictureDraw
+    {
+        const PictureOp*     op;
+        rive::Mat2D          matrix;
+        std::int32_t         clip;
+        rive_renderer_rect_t current;
+    };
+
+    struct PictureDrawList
+    {
+        std::vector<PictureDraw> draws;
+        std::vector<PictureClip> clips;
+    };
+
+    // Lists the draws of picture in recorded order with the state each draws under, refitting its index first so
+    // current bounds follow path edits.
+    PictureDrawList ListPictureDraws(PictureHandle* picture)
+    {
+        PictureDrawList             list;
+        std::lock_guard<std::mutex> lock(picture->indexMutex);
+        RefitPictureIndex(picture);
+        list.draws.reserve(picture->drawCount);
+
+        rive::Mat2D                                       matrix;
+        std::int32_t                                      clip = -1;
+        std::vector<std::pair<rive::Mat2D, std::int32_t>> stack;
+        for (std::size_t i = 0; i < picture->ops.size(); ++i)
+        {
+            const PictureOp& op = picture->ops[i];
+            switch (op.kind)
+            {
+            case PictureOp::Kind::save:
+                stack.emplace_back(matrix, clip);
+                break;
+            case PictureOp::Kind::restore:
+                if (!stack.empty())
+                {
+                    std::tie(matrix, clip) = stack.back();
+                    stack.pop_back();
+                }
+                break;
+            case PictureOp::Kind::transform:
+                matrix = matrix * op.matrix;
+                break;
+            case PictureOp::Kind::clipPath:
+                list.clips.push_back({&op, matrix, clip});
+                clip = static_cast<std::int32_t>(list.clips.size() - 1);
+                break;
+            case PictureOp::Kind::drawPath:
+            case PictureOp::Kind::drawImage:
+            case PictureOp::Kind::drawImageMesh:
+                list.draws.push_back({&op, matrix, clip, picture->drawBounds[i]});
+                break;
+            }
+        }
+        return list;
+    }
+
+    // Whether two chains of clips, each given by its innermost clip, clip the same way.
+    bool SameClips(const PictureDrawList& a, std::int32_t aClip, const PictureDrawList& b, std::int32_t bClip)
+    {
+        while (aClip >= 0 && bClip >= 0)
+        {
+            const PictureClip& first  = a.clips[aClip];
+            const PictureClip& second = b.clips[bClip];
+            if (!SameOp(*first.op, *second.op) || !SameMatrix(first.matrix, second.matrix))
+            {
+                return false;
+            }
+            aClip = first.parent;
+            bClip = second.parent;
+        }
+        return aClip == bClip;
+    }
+
+    // Picture-space bounds of the draws that differ between two pictures, pairing draws in recorded order. Draws
+    // match when they use the same resources in the same state under the same transform and clips and still land in
+    // the same place. A changed draw covers both where it was recorded and where it draws now.
+    rive_renderer_rect_t PictureChanges(PictureHandle* previous, PictureHandle* next)
+    {
+        const PictureDrawList previousList = ListPictureDraws(previous);
+        const PictureDrawList nextList     = ListPictureDraws(next);
+
+        rive_renderer_rect_t changes = kEmptyRect;
+        for (std::size_t i = 0; i < std::max(previousList.draws.size(), nextList.draws.size()); ++i)
+        {
+            const PictureDraw* before = i < previousList.draws.size() ? &previousList.draws[i] : nullptr;
+            const PictureDraw* after  = i < nextList.draws.size() ? &nextList.draws[i] : nullptr;
+            if (before != nullptr && after != nullptr && SameOp(*before->op, *after->op) &&
+                SameMatrix(before->matrix, after->matrix) &&
+                SameClips(previousList, before->clip, nextList, after->clip) &&
+                std::memcmp(&before->current, &after->current, sizeof(before->current)) == 0)
+            {
+                continue;
+            }
+            for (const PictureDraw* draw : {before, after})
+            {
+                if (draw != nullptr)
+                {
+                    IncludeRect(&changes, draw->op->bounds);
+                    IncludeRect(&changes, draw->current);
+                }
+            }
+        }
+        return changes;
+    }
+
+    // Returns the context's faded copy of paint at opacity, rebuilding it when the opacity or the paint changed since
+    // it was last used.
+    rive::RenderPaint* GetFadedPaint(ContextHandle* context, rive::Factory* factory, PaintHandle* paint, float opacity)
+    {
+        auto [found, inserted] = context->fadedPaints.try_emplace(paint);
+        FadedPaint& faded      = found->second;
+        if (inserted)
+        {
+            paint->ref_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (inserted || faded.opacity != opacity || faded.version != paint->state.version)
+        {
+            faded.paint   = MakeFadedPaint(factory, paint->state, opacity);
+            faded.opacity = opacity;
+            faded.version = paint->state.version;
+        }
+        faded.lastFrame = context->frameCounter;
+        return faded.paint.get();
+    }
+
+    // Drops the faded paints that were not used in the previous frame, or every one when all is set.
+    void SweepFadedPaints(ContextHandle* context, bool all)
+    {
+        auto& paints = context->fadedPaints;
+        for (auto it = paints.begin(); it != paints.end();)
+        {
+            if (all || it->second.lastFrame + 1 < context->frameCounter)
+            {
+                PaintHandle* paint = it->first;
+                it                 = paints.erase(it);
+                rive_renderer_paint_release({paint});
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void ReplayPictureOp(const PictureOp& op, RendererHandle* renderer, rive::Factory* factory, float opacity)
+    {
+        rive::Renderer* target = renderer->renderer.get();
+        switch (op.kind)
+        {
+        case PictureOp::Kind::save:
+            SaveRenderer(renderer);
+            break;
+        case PictureOp::Kind::restore:
+            RestoreRenderer(renderer);
+            break;
+        case PictureOp::Kind::transform:
+            TransformRenderer(renderer, op.matrix);
+            break;
+        case PictureOp::Kind::clipPath:
+            ClipRendererPath(renderer, op.path.get(), op.pathHandle, CurrentPathBounds(op));
+            break;
+        case PictureOp::Kind::drawPath:
+            if (op.paintHandle == nullptr)
+            {
+                target->drawPath(op.path.get(), op.paint.get());
+            }
+            else if (opacity >= 1.0f || factory == nullptr)
+            {
+                DrawPathWithPaint(renderer, op.path.get(), op.pathHandle, op.paintHandle, CurrentPathBounds(op));
+            }
+            else
+            {
+                rive::RenderPaint* faded = GetFadedPaint(renderer->context, factory, op.paintHandle, opacity);
+                if (faded != nullptr)
+                {
+                    target->drawPath(op.path.get(), faded);
+                }
+            }
+            break;
+        case PictureOp::Kind::drawImage:
+            target->drawImage(op.image.get(), op.sampler, op.blendMode, op.opacity * opacity);
+            break;
+        case PictureOp::Kind::drawImageMesh:
+            target->drawImageMesh(op.image.get(), op.sampler, op.vertices, op.uvCoords, op.indices, op.vertexCount,
+                                  op.indexCount, op.blendMode, op.opacity * opacity);
+            break;
+        }
+    }
+
+    // Replays picture on renderer with opacity applied to every draw. Images and meshes scale their own opacity; path
+    // draws recorded through a paint handle use a faded copy of the paint, other path draws replay unchanged. When
+    // visible is given, only the draws it lists are replayed, along with the state changes they depend on.
+    void ReplayPicture(PictureHandle* picture, RendererHandle* renderer, float opacity,
+                       const std::vector<std::uint32_t>* visible)
+    {
+        rive::Factory*    factory = GetFactory(picture->context);
+        const std::size_t count   = picture->ops.size();
+        std::size_t       next    = 0;
+        for (std::size_t i = 0; i < count;)
+        {
+            const PictureOp& op = picture->ops[i];
+            if (visible != nullptr)
+            {
+                const std::size_t nextDraw = next < visible->size() ? (*visible)[next] : count;
+                if (op.kind == PictureOp::Kind::save && nextDraw >= picture->skipTo[i])
+                {
+                    i = picture->skipTo[i];
+                    continue;
+                }
+                if (IsDrawOp(op.kind))
+                {
+                    if (i != nextDraw)
+                    {
+                        i = std::min<std::size_t>(picture->skipTo[i], nextDraw);
+                        continue;
+                    }
+                    ++next;
+                }
+            }
+            ReplayPictureOp(op, renderer, factory, opacity);
+            ++i;
+        }
+    }
+
+    // Decodes rive_renderer_path_verb_t verbs and their x/y point pairs into rawPath. Returns the error for the first
+    // bad verb, or null when the verbs consume exactly pointCount points.
+    const char* DecodePathCommands(const std::uint8_t* verbs, std::size_t verbCount, const float* points,
+                                   std::size_t pointCount, rive::RawPath* rawPath)
+    {
+        std::size_t next = 0;
+        auto        take = [&](std::size_t count) -> const float*
+        {
+            if (pointCount - next < count)
+            {
+                return nullptr;
+            }
+            const float* result = points + next * 2;
+            next += count;
+            return result;
+        };
+
+        for (std::size_t i = 0; i < verbCount; ++i)
+        {
+            const float* p = nullptr;
+            switch (static_cast<rive_renderer_path_verb_t>(verbs[i]))
+            {
+            case rive_renderer_path_verb_t::move:
+                if ((p = take(1)) != nullptr)
+                {
+                    rawPath->moveTo(p[0], p[1]);
+                }
+                break;
+            case rive_renderer_path_verb_t::line:
+                if ((p = take(1)) != nullptr)
+                {
+                    rawPath->lineTo(p[0], p[1]);
+                }
+                break;
+            case rive_renderer_path_verb_t::quad:
+                if ((p = take(2)) != nullptr)
+                {
+                    rawPath->quadTo(p[0], p[1], p[2], p[3]);
+                }
+                break;
+            case rive_renderer_path_verb_t::cubic:
+                if ((p = take(3)) != nullptr)
+                {
+                    rawPath->cubicTo(p[0], p[1], p[2], p[3], p[4], p[5]);
+                }
+                break;
+            case rive_renderer_path_verb_t::close:
+                rawPath->close();
+                continue;
+            default:
+                return "invalid path verb";
+            }
+            if (p == nullptr)
+            {
+                return "path verbs need more points than were supplied";
+            }
+        }
+        if (next != pointCount)
+        {
+            return "path verbs need fewer points than were supplied";
+        }
+        return nullptr;
+    }
+
+    // Widens [*low, *high] to the extrema of a cubic Bezier along one axis. The derivative is a quadratic whose roots
+    // in (0, 1) are the interior extrema; the end points are covered by the caller.
+    void IncludeCubicExtrema(float p0, float p1, float p2, float p3, float* low, float* high)
+    {
+        const float a     = 3.0f * (p3 - p0 + 3.0f * (p1 - p2));
+        const float b     = 6.0f * (p0 - 2.0f * p1 + p2);
+        const float c     = 3.0f * (p1 - p0);
+        auto        visit = [&](float t)
+        {
+            if (t > 0.0f && t < 1.0f)
+            {
+                const float mt    = 1.0f - t;
+                const float value = mt * mt * mt * p0 + 3.0f * mt * t * (mt * p1 + t * p2) + t * t * t * p3;
+                *low              = std::min(*low, value);
+                *high             = std::max(*high, value);
+            }
+        };
+
+        if (std::abs(a) < 1e-12f)
+        {
+            if (b != 0.0f)
+            {
+                visit(-c / b);
+            }
+            return;
+        }
+        const float discriminant = b * b - 4.0f * a * c;
+        if (discriminant < 0.0f)
+        {
+            return;
+        }
+        const float root = std::sqrt(discriminant);
+        visit((-b + root) / (2.0f * a));
+        visit((-b - root) / (2.0f * a));
+    }
+
+    // Tight bounds of verbs already checked by DecodePathCommands. Quadratics are raised to cubics so both share the
+    // extrema search.
+    rive_renderer_rect_t ComputeTightBounds(const std::uint8_t* verbs, std::size_t verbCount, const float* points)
+    {
+        float left    = 0.0f;
+        float top     = 0.0f;
+        float right   = 0.0f;
+        float bottom  = 0.0f;
+        bool  any     = false;
+        auto  include = [&](float x, float y)
+        {
+            left   = any ? std::min(left, x) : x;
+            top    = any ? std::min(top, y) : y;
+            right  = any ? std::max(right, x) : x;
+            bottom = any ? std::max(bottom, y) : y;
+            any    = true;
+        };
+        auto cubic = [&](const float* from, float c1x, float c1y, float c2x, float c2y, const float* to)
+        {
+            include(from[0], from[1]);
+            include(to[0], to[1]);
+            IncludeCubicExtrema(from[0], c1x, c2x, to[0], &left, &right);
+            IncludeCubicExtrema(from[1], c1y, c2y, to[1], &top, &bottom);
+        };
+
+        float        origin[2]    = {0.0f, 0.0f};
+        const float* current      = origin;
+        const float* contourStart = origin;
+        for (std::size_t i = 0; i < verbCount; ++i)
+        {
+            switch (static_cast<rive_renderer_path_verb_t>(verbs[i]))
+            {
+            case rive_renderer_path_verb_t::move:
+                include(points[0], points[1]);
+                current = contourStart = points;
+                points += 2;
+                break;
+            case rive_renderer_path_verb_t::line:
+                include(current[0], current[1]);
+                include(points[0], points[1]);
+                current = points;
+                points += 2;
+                break;
+            case rive_renderer_path_verb_t::quad:
+            {
+                const float* control = points;
+                const float* to      = points + 2;
+                cubic(current, current[0] + (control[0] - current[0]) * (2.0f / 3.0f),
+                      current[1] + (control[1] - current[1]) * (2.0f / 3.0f),
+                      to[0] + (control[0] - to[0]) * (2.0f / 3.0f), to[1] + (control[1] - to[1]) * (2.0f / 3.0f),
+                      to);
+                current = to;
+                points += 4;
+                break;
+            }
+            case rive_renderer_path_verb_t::cubic:
+                cubic(current, points[0], points[1], points[2], points[3], points + 4);
+                current = points + 4;
+                points += 6;
+                break;
+            case rive_renderer_path_verb_t::close:
+                current = contourStart;
+                break;
+            }
+        }
+        return {left, top, right, bottom};
+    }
+
+    // Drops the render paths of destroyed immutable paths once the cache has doubled since the last sweep, so a
+    // context drawing a steady set of paths never scans it.
+    void SweepImmutablePaths(ContextHandle* context)
+    {
+        auto& paths = context->immutablePaths;
+        if (paths.size() < context->immutablePathSweepSize)
+        {
+            return;
+        }
+        for (auto it = paths.begin(); it != paths.end();)
+        {
+            it = it->second.owner.expired() ? paths.erase(it) : std::next(it);
+        }
+        context->immutablePathSweepSize = std::max(kMinImmutablePathSweepSize, paths.size() * 2);
+    }
+
+    // Returns the context's render path for an immutable path, building it the first time the context draws it.
+    rive::RenderPath* GetImmutableRenderPath(ImmutablePathHandle* path, ContextHandle* context)
+    {
+        auto found = context->immutablePaths.find(path->id);
+        if (found != context->immutablePaths.end())
+        {
+            return found->second.renderPath.get();
+        }
+
+        rive::Factory* factory = GetFactory(context);
+        if (factory == nullptr)
+        {
+            return nullptr;
+        }
+        rive::rcp<rive::RenderPath> renderPath = factory->makeEmptyRenderPath();
+        if (!renderPath)
+        {
+            return nullptr;
+        }
+        renderPath->fillRule(path->fillRule);
+        renderPath->addRawPath(path->rawPath);
+        SweepImmutablePaths(context);
+        context->immutablePaths.emplace(path->id, ContextImmutablePath {path->lifetime, renderPath});
+        return renderPath.get();
+    }
+
+    // Points out_pixels at the last rendered frame as height rows of premultiplied RGBA8 pixels, out_stride bytes
+    // apart.
+    rive_renderer_status_t GetFramebufferPixels(ContextHandle* context, const std::uint8_t** out_pixels,
+                                                std::size_t* out_stride)
+    {
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (context->device != nullptr && context->device->backend == rive_renderer_backend_t::vulkan)
+        {
+            *out_stride = static_cast<std::size_t>(context->width) * 4;
+            return MapVulkanReadback(context, out_pixels);
+        }
+#endif
+
+        if (context->device == nullptr || context->device->backend != rive_renderer_backend_t::null)
+        {
+            SetLastError("cpu framebuffer capture not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (context->externalFramebuffer != nullptr)
+        {
+            if (context->externalFormat != rive_renderer_pixel_format_t::rgba8_premultiplied)
+            {
+                SetLastError("cpu framebuffer is bound to memory in another pixel format");
+                return rive_renderer_status_t::unsupported;
+            }
+            if (!FitsPixelRows(context->externalLength, context->externalStride, context->width, context->height))
+            {
+                SetLastError("bound cpu framebuffer is too small for the context");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+        }
+        else if (context->cpuFramebuffer.size() != static_cast<std::size_t>(context->width) * context->height * 4)
+        {
+            SetLastError("cpu framebuffer not initialized");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        const CpuFramebufferView framebuffer = GetCpuFramebuffer(context);
+        *out_pixels                          = framebuffer.pixels;
+        *out_stride                          = framebuffer.stride;
+        return rive_renderer_status_t::ok;
+    }
+
+    // Output of encode_framebuffer. Keeps its context alive so bytes can go back to its buffer pool on release.
+    struct EncodedImageHandle
+    {
+        std::atomic<std::uint32_t> ref_count {1};
+        ContextHandle*             context {nullptr};
+        std::vector<std::uint8_t>  bytes;
+    };
+
+    // Released images keep at most this many buffers pooled per context.
+    constexpr std::size_t kMaxPooledEncodedBuffers = 4;
+
+    EncodedImageHandle* ToEncodedImage(const rive_renderer_encoded_image_t& image)
+    {
+        return static_cast<EncodedImageHandle*>(image.handle);
+    }
+
+    std::vector<std::uint8_t> TakeEncodedBuffer(ContextHandle* context)
+    {
+        std::vector<std::uint8_t>   buffer;
+        std::lock_guard<std::mutex> lock(context->encodedBuffersMutex);
+        if (!context->encodedBuffers.empty())
+        {
+            buffer = std::move(context->encodedBuffers.back());
+            context->encodedBuffers.pop_back();
+        }
+        buffer.clear();
+        return buffer;
+    }
+
+    void ReturnEncodedBuffer(ContextHandle* context, std::vector<std::uint8_t>&& buffer)
+    {
+        std::lock_guard<std::mutex> lock(context->encodedBuffersMutex);
+        if (context->encodedBuffers.size() < kMaxPooledEncodedBuffers)
+        {
+            context->encodedBuffers.push_back(std::move(buffer));
+        }
+    }
+
+    // Appends premultiplied RGBA8 rows encoded as a PNG to out, with quality picking the zlib level.
+    bool EncodePixels(const DeviceHandle& device, const std::uint8_t* pixels, std::size_t stride, std::uint32_t width,
+                      std::uint32_t height, std::uint8_t quality, rive_renderer_cpu::EncodeScratch* scratch,
+                      std::vector<std::uint8_t>* out)
+    {
+        const auto& kernels = rive_renderer_cpu::GetBlendKernels(device.cpuSimdLevel);
+        auto*       pool    = &rive_renderer_cpu::WorkerPool::Shared();
+        return rive_renderer_cpu::EncodePng(pixels, stride, width, height, quality * 9 / 100, kernels, pool, scratch,
+                                            out);
+    }
+
+    rive_renderer_status_t ValidateImageEncoding(rive_renderer_image_encoding_t encoding)
+    {
+        if (encoding != rive_renderer_image_encoding_t::png)
+        {
+            SetLastError("unknown image encoding");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+        return rive_renderer_status_t::ok;
+    }
+
+    // One frame of a batch in flight. The render thread renders into pixels on the null backend, or reads it back
+    // through readback on Vulkan, and points source at the result; the batch thread converts or encodes it into
+    // output, delivers it and hands the slot back.
+    struct BatchSlot
+    {
+        std::uint32_t             frameIndex {0};
+        std::vector<std::uint8_t> pixels;
+        rive_renderer_readback_t  readback {nullptr};
+        const std::uint8_t*       source {nullptr};
+        std::vector<std::uint8_t> output;
+    };
+
+    // State of one context_render_batch call. freeSlots and readySlots move slots between the render thread and the
+    // batch thread under mutex; submitted holds the Vulkan frames the render thread has not read back yet. status and
+    // error keep the first failure on either thread, after which no new frame is started or delivered.
+    struct BatchState
+    {
+        const rive_renderer_batch_render_info_t* info {nullptr};
+        const DeviceHandle*                      device {nullptr};
+        std::uint32_t                            width {0};
+        std::uint32_t                            height {0};
+        std::vector<BatchSlot>                   slots;
+        std::deque<BatchSlot*>                   submitted;
+        std::mutex                               mutex;
+        std::condition_variable                  changed;
+        std::vector<BatchSlot*>                  freeSlots;
+        std::deque<BatchSlot*>                   readySlots;
+        bool                                     finished {false};
+        rive_renderer_status_t                   status {rive_renderer_status_t::ok};
+        std::string                              error;
+    };
+
+    void FailBatch(BatchState* batch, rive_renderer_status_t status, const std::string& message)
+    {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        if (batch->status == rive_renderer_status_t::ok)
+        {
+            batch->status = status;
+            batch->error  = message.empty() ? "batch render failed" : message;
+        }
+        batch->changed.notify_all();
+    }
+
+    bool BatchFailed(BatchState* batch)
+    {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        return batch->status != rive_renderer_status_t::ok;
+    }
+
+    // Converts or encodes one frame and passes it to on_frame.
+    void DeliverBatchFrame(BatchState* batch, BatchSlot* slot, rive_renderer_cpu::EncodeScratch* scratch)
+    {
+        const auto&         info     = *batch->info;
+        const std::size_t   rowBytes = static_cast<std::size_t>(batch->width) * 4;
+        const std::uint8_t* data     = slot->source;
+        std::size_t         length   = rowBytes * batch->height;
+        if (info.encode != 0)
+        {
+            slot->output.clear();
+            if (!EncodePixels(*batch->device, slot->source, rowBytes, batch->width, batch->height, info.quality,
+                              scratch, &slot->output))
+            {
+                FailBatch(batch, rive_renderer_status_t::internal_error, "failed to encode batch frame");
+                return;
+            }
+            data   = slot->output.data();
+            length = slot->output.size();
+        }
+        else if (info.format != rive_renderer_pixel_format_t::rgba8_premultiplied)
+        {
+            slot->output.resize(length);
+            ConvertPixelRows(*batch->device, slot->source, rowBytes, slot->output.data(), rowBytes, batch->width,
+                             batch->height, info.format);
+            data = slot->output.data();
+        }
+
+        ClearLastError();
+        const auto status = info.on_frame(info.user_data, slot->frameIndex, data, length);
+        if (status != rive_renderer_status_t::ok)
+        {
+            FailBatch(batch, status, g_lastError.empty() ? "batch frame callback failed" : g_lastError);
+        }
+    }
+
+    // Body of the batch thread. Ready frames are delivered in the order they were queued until the render thread
+    // finishes; after a failure they are only handed back.
+    void RunBatchOutput(BatchState* batch)
+    {
+        rive_renderer_cpu::EncodeScratch scratch;
+        for (;;)
+        {
+            BatchSlot* slot   = nullptr;
+            bool       failed = false;
+            {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->changed.wait(lock, [batch] { return !batch->readySlots.empty() || batch->finished; });
+                if (batch->readySlots.empty())
+                {
+                    return;
+                }
+                slot = batch->readySlots.front();
+                batch->readySlots.pop_front();
+                failed = batch->status != rive_renderer_status_t::ok;
+            }
+
+            if (!failed)
+            {
+                DeliverBatchFrame(batch, slot, &scratch);
+            }
+
+            std::lock_guard<std::mutex> lock(batch->mutex);
+            batch->freeSlots.push_back(slot);
+            batch->changed.notify_all();
+        }
+    }
+
+    // Reads back the oldest submitted Vulkan frame, or takes the pixels of a null-backend frame, and queues it for
+    // the batch thread.
+    rive_renderer_status_t QueueBatchFrame(BatchState* batch, BatchSlot* slot)
+    {
+        if (slot->readback.handle != nullptr)
+        {
+            auto status = rive_renderer_readback_wait(slot->readback, std::numeric_limits<std::uint64_t>::max());
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+            rive_renderer_mapped_memory_t mapping {};
+            status = rive_renderer_readback_map(slot->readback, &mapping);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+            slot->source = static_cast<const std::uint8_t*>(mapping.data);
+        }
+        else
+        {
+            slot->source = slot->pixels.data();
+        }
+
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        batch->readySlots.push_back(slot);
+        batch->changed.notify_all();
+        return rive_renderer_status_t::ok;
+    }
+
+    // Waits for a slot the batch thread has delivered. Submitted Vulkan frames are read back first so the batch
+    // thread always has work to free slots with. Returns null once the batch has failed.
+    BatchSlot* AcquireBatchSlot(BatchState* batch)
+    {
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                if (batch->status != rive_renderer_status_t::ok)
+                {
+                    return nullptr;
+                }
+                if (!batch->freeSlots.empty())
+                {
+                    BatchSlot* slot = batch->freeSlots.back();
+                    batch->freeSlots.pop_back();
+                    return slot;
+                }
+                if (batch->submitted.empty())
+                {
+                    batch->changed.wait(lock, [batch]
+                                        {
+                                            return !batch->freeSlots.empty() ||
+                                                   batch->status != rive_renderer_status_t::ok;
+                                        });
+                    continue;
+                }
+            }
+
+            BatchSlot* oldest = batch->submitted.front();
+            batch->submitted.pop_front();
+            auto status = QueueBatchFrame(batch, oldest);
+            if (status != rive_renderer_status_t::ok)
+            {
+                FailBatch(batch, status, g_lastError);
+                return nullptr;
+            }
+        }
+    }
+
+    // Records and submits one frame of a batch into slot. A frame that fails after begin_frame is still ended and
+    // submitted so the context is left idle.
+    rive_renderer_status_t RenderBatchFrame(ContextHandle* handle, BatchState* batch, BatchSlot* slot,
+                                            std::uint32_t frame)
+    {
+        const auto&                   info    = *batch->info;
+        const rive_renderer_context_t context = {handle};
+        if (slot->readback.handle != nullptr)
+        {
+            rive_renderer_readback_release(slot->readback);
+            slot->readback = {nullptr};
+        }
+        slot->frameIndex = frame;
+        slot->source     = nullptr;
+        if (!slot->pixels.empty())
+        {
+            handle->externalFramebuffer = slot->pixels.data();
+            handle->externalStride      = static_cast<std::size_t>(batch->width) * 4;
+            handle->externalLength      = slot->pixels.size();
+            handle->externalFormat      = rive_renderer_pixel_format_t::rgba8_premultiplied;
+        }
+
+        auto status = rive_renderer_context_begin_frame(context, nullptr);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+
+        if (slot->pixels.empty())
+        {
+            status = rive_renderer_context_request_readback(context, nullptr,
+                                                            rive_renderer_pixel_format_t::rgba8_premultiplied,
+                                                            &slot->readback);
+        }
+        rive_renderer_renderer_t renderer {nullptr};
+        if (status == rive_renderer_status_t::ok)
+        {
+            status = rive_renderer_renderer_create(context, &renderer);
+        }
+        if (status == rive_renderer_status_t::ok)
+        {
+            if (info.scene != nullptr)
+            {
+                ClearLastError();
+                status = info.scene(info.user_data, renderer, frame,
+                                    info.start_time + static_cast<float>(frame) * info.time_step);
+                if (status != rive_renderer_status_t::ok && g_lastError.empty())
+                {
+                    SetLastError("batch scene callback failed");
+                }
+            }
+            else
+            {
+                status = rive_renderer_renderer_draw_picture(renderer, info.pictures[frame % info.picture_count],
+                                                             nullptr, 1.0f);
+            }
+        }
+
+        // Keep the first error message while the frame is closed.
+        const std::string error = status != rive_renderer_status_t::ok ? g_lastError : std::string();
+        if (renderer.handle != nullptr)
+        {
+            rive_renderer_renderer_release(renderer);
+        }
+        auto endStatus = rive_renderer_context_end_frame(context);
+        if (endStatus == rive_renderer_status_t::ok)
+        {
+            endStatus = rive_renderer_context_submit(context);
+        }
+        if (status != rive_renderer_status_t::ok)
+        {
+            SetLastError(error.c_str());
+            return status;
+        }
+        return endStatus;
+    }
+
+} // namespace
+
+extern "C"
+{
+
+    rive_renderer_status_t rive_renderer_enumerate_adapters(rive_renderer_adapter_desc_t* adapters,
+                                                            std::size_t capacity, std::size_t* count)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (count == nullptr)
+        {
+            SetLastError("count pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto status = EnsureD3D12Adapters();
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+
+        std::scoped_lock  lock(g_adapterMutex);
+        const std::size_t adapterCount = g_d3d12Adapters.size();
+        const std::size_t total        = adapterCount + 1; // include null adapter
+        *count                         = total;
+
+        if (adapters != nullptr && capacity > 0)
+        {
+            const std::size_t to_copy = std::min(capacity, adapterCount);
+            for (std::size_t i = 0; i < to_copy; ++i)
+            {
+                adapters[i] = g_d3d12Adapters[i].desc;
+            }
+            if (capacity > to_copy)
+            {
+                adapters[to_copy] = MakeNullAdapter();
+            }
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#else
+        if (count == nullptr)
+        {
+            SetLastError("count pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        const rive_renderer_adapter_desc_t candidates[] = {
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+            MakeMetalAdapter(),
+#endif
+            MakeNullAdapter()};
+        const std::size_t                  total        = sizeof(candidates) / sizeof(candidates[0]);
+        *count                                          = total;
+
+        if (adapters != nullptr && capacity > 0)
+        {
+            const std::size_t to_copy = capacity < total ? capacity : total;
+            std::memcpy(adapters, candidates, sizeof(rive_renderer_adapter_desc_t) * to_copy);
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_device_create(const rive_renderer_device_create_info_t* info,
+                                                       rive_renderer_device_t*                   out_device)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (info != nullptr && info->backend == rive_renderer_backend_t::d3d12)
+        {
+            auto ensureStatus = EnsureD3D12Adapters();
+            if (ensureStatus != rive_renderer_status_t::ok)
+            {
+                return ensureStatus;
+            }
+
+            std::scoped_lock lock(g_adapterMutex);
+            if (info->adapter_index >= g_d3d12Adapters.size())
+            {
+                SetLastError("adapter index out of range");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto& record = g_d3d12Adapters[info->adapter_index];
+
+            Microsoft::WRL::ComPtr<ID3D12Device> device;
+            HRESULT hr = D3D12CreateDevice(record.adapter.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&device));
+            if (FAILED(hr))
+            {
+                SetLastError("D3D12CreateDevice failed");
+                return rive_renderer_status_t::unsupported;
+            }
+
+            D3D12_COMMAND_QUEUE_DESC queueDesc {};
+            queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+            Microsoft::WRL::ComPtr<ID3D12CommandQueue> directQueue;
+            hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&directQueue));
+            if (FAILED(hr))
+            {
+                SetLastError("Failed to create direct command queue");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+            Microsoft::WRL::ComPtr<ID3D12CommandQueue> copyQueue;
+            hr = device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&copyQueue));
+            if (FAILED(hr))
+            {
+                SetLastError("Failed to create copy command queue");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            auto* handle = new (std::nothrow) DeviceHandle();
+            if (handle == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            handle->backend     = rive_renderer_backend_t::d3d12;
+            handle->adapter     = record.adapter;
+            handle->d3d12Device = device;
+            handle->directQueue = directQueue;
+            handle->copyQueue   = copyQueue;
+            handle->isIntel     = record.isIntel;
+            PopulateCapabilitiesFromD3D12(device.Get(), handle->capabilities, record.isIntel);
+
+            out_device->handle = handle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        if (info != nullptr && info->backend == rive_renderer_backend_t::metal)
+        {
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+            auto* handle = new (std::nothrow) DeviceHandle();
+            if (handle == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            rive_renderer_capabilities_t caps {};
+            void* metalDevice = rive_metal_device_new(&caps);
+            if (metalDevice == nullptr)
+            {
+                delete handle;
+                if (g_lastError.empty())
+                {
+                    SetLastError("Metal device creation failed");
+                }
+                return rive_renderer_status_t::internal_error;
+            }
+
+            handle->backend      = rive_renderer_backend_t::metal;
+            handle->metalDevice  = metalDevice;
+            handle->capabilities = caps;
+
+            out_device->handle = handle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+#else
+            SetLastError("requested backend is not yet implemented");
+            return rive_renderer_status_t::unsupported;
+#endif
+        }
+
+        if (info == nullptr || out_device == nullptr)
+        {
+            SetLastError("device_create received null pointer");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        if (info->backend == rive_renderer_backend_t::unknown)
+        {
+            SetLastError("backend must be specified");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (info->backend != rive_renderer_backend_t::null)
+        {
+            SetLastError("requested backend is not yet implemented");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        auto* device = new (std::nothrow) DeviceHandle();
+        if (device == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        device->backend                               = info->backend;
+        device->capabilities.backend                  = info->backend;
+        device->capabilities.feature_flags            = rive_renderer_feature_flags_t::headless_supported;
+        device->capabilities.max_buffer_size          = 256ull * 1024ull * 1024ull;
+        device->capabilities.max_texture_dimension    = 4096;
+        device->capabilities.max_texture_array_layers = 1;
+        device->capabilities.max_sampler_anisotropy   = 1.0f;
+        device->capabilities.supports_hdr             = 0;
+        device->capabilities.supports_presentation    = 0;
+        device->cpuSimdLevel                          = rive_renderer_cpu::DetectSimdLevel();
+
+        out_device->handle = device;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_device_create_vulkan(const rive_renderer_device_create_info_vulkan_t* info,
+                                                              rive_renderer_device_t* out_device)
+    {
+        if (out_device == nullptr)
+        {
+            SetLastError("device output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        out_device->handle = nullptr;
+
+        if (info == nullptr)
+        {
+            SetLastError("device create info is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (info->instance == nullptr || info->physical_device == nullptr || info->device == nullptr ||
+            info->graphics_queue == nullptr)
+        {
+            SetLastError("Vulkan device create info is missing required handles");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        auto* handle = new (std::nothrow) DeviceHandle();
+        if (handle == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        handle->backend                   = rive_renderer_backend_t::vulkan;
+        handle->cpuSimdLevel              = rive_renderer_cpu::DetectSimdLevel();
+        handle->vkInstance                = reinterpret_cast<VkInstance>(info->instance);
+        handle->vkPhysicalDevice          = reinterpret_cast<VkPhysicalDevice>(info->physical_device);
+        handle->vkDevice                  = reinterpret_cast<VkDevice>(info->device);
+        handle->graphicsQueue             = reinterpret_cast<VkQueue>(info->graphics_queue);
+        handle->graphicsQueueFamilyIndex  = info->graphics_queue_family_index;
+        handle->presentQueue              = info->present_queue != nullptr
+                                                ? reinterpret_cast<VkQueue>(info->present_queue)
+                                                : handle->graphicsQueue;
+        handle->presentQueueFamilyIndex =
+            info->present_queue != nullptr ? info->present_queue_family_index : handle->graphicsQueueFamilyIndex;
+        handle->getInstanceProcAddr =
+            reinterpret_cast<PFN_vkGetInstanceProcAddr>(info->get_instance_proc_addr);
+        handle->vkFeatures = ConvertVulkanFeatures(info->features);
+        if (handle->getInstanceProcAddr == nullptr || !LoadVulkanDispatch(handle))
+        {
+            delete handle;
+            SetLastError("failed to load Vulkan entry points");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        handle->capabilities.backend = rive_renderer_backend_t::vulkan;
+        auto featureFlags =
+            static_cast<std::uint32_t>(rive_renderer_feature_flags_t::headless_supported);
+        auto setFlag = [&](rive_renderer_feature_flags_t flag)
+        {
+            featureFlags |= static_cast<std::uint32_t>(flag);
+        };
+        if (handle->vkFeatures.fragmentStoresAndAtomics)
+        {
+            setFlag(rive_renderer_feature_flags_t::atomic_path_rendering);
+        }
+        if (handle->vkFeatures.rasterizationOrderColorAttachmentAccess ||
+            handle->vkFeatures.fragmentShaderPixelInterlock)
+        {
+            setFlag(rive_renderer_feature_flags_t::raster_ordering);
+        }
+        handle->capabilities.feature_flags =
+            static_cast<rive_renderer_feature_flags_t>(featureFlags);
+        handle->capabilities.max_buffer_size          = 0;
+        handle->capabilities.max_texture_dimension    = 0;
+        handle->capabilities.max_texture_array_layers = 0;
+        handle->capabilities.max_sampler_anisotropy   = 1.0f;
+        handle->capabilities.supports_hdr             = 0;
+        handle->capabilities.supports_presentation =
+            handle->presentQueue != VK_NULL_HANDLE ? 1 : 0;
+
+        out_device->handle = handle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#else
+        (void)info;
+        SetLastError("Vulkan backend is not available in this build");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_device_retain(rive_renderer_device_t device)
+    {
+        auto* handle = ToDevice(device);
+        if (handle == nullptr)
+        {
+            SetLastError("device handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_device_release(rive_renderer_device_t device)
+    {
+        auto* handle = ToDevice(device);
+        if (handle == nullptr)
+        {
+            SetLastError("device handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            SetLastError("device handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
+        {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+            handle->adapter.Reset();
+            handle->d3d12Device.Reset();
+            handle->directQueue.Reset();
+            handle->copyQueue.Reset();
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+            if (handle->metalDevice != nullptr)
+            {
+                rive_metal_device_release(handle->metalDevice);
+                handle->metalDevice = nullptr;
+            }
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+            handle->vkInstance               = VK_NULL_HANDLE;
+            handle->vkPhysicalDevice         = VK_NULL_HANDLE;
+            handle->vkDevice                 = VK_NULL_HANDLE;
+            handle->graphicsQueue            = VK_NULL_HANDLE;
+            handle->presentQueue             = VK_NULL_HANDLE;
+            handle->graphicsQueueFamilyIndex = 0;
+            handle->presentQueueFamilyIndex  = 0;
+            handle->getInstanceProcAddr      = nullptr;
+#endif
+            delete handle;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_device_capabilities(rive_renderer_device_t        device,
+                                                             rive_renderer_capabilities_t* out_capabilities)
+    {
+        if (out_capabilities == nullptr)
+        {
+            SetLastError("capabilities pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToDevice(device);
+        if (handle == nullptr)
+        {
+            SetLastError("device handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        *out_capabilities = handle->capabilities;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_create(rive_renderer_device_t device, std::uint32_t width,
+                                                        std::uint32_t height, rive_renderer_context_t* out_context)
+    {
+        if (out_context == nullptr)
+        {
+            SetLastError("context output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* device_handle = ToDevice(device);
+        if (device_handle == nullptr)
+        {
+            SetLastError("device handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (device_handle->backend == rive_renderer_backend_t::d3d12)
+        {
+            if (!ValidateContextSize(width, height))
+            {
+                SetLastError("context dimensions must be non-zero");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto* contextHandle = new (std::nothrow) ContextHandle();
+            if (contextHandle == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            contextHandle->device = device_handle;
+
+            auto initStatus = InitializeD3D12Context(device_handle, contextHandle, width, height);
+            if (initStatus != rive_renderer_status_t::ok)
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                return initStatus;
+            }
+
+            rive::gpu::D3DContextOptions contextOptions;
+            contextOptions.isIntel = device_handle->isIntel;
+
+            auto renderContext = rive::gpu::RenderContextD3D12Impl::MakeContext(
+                device_handle->d3d12Device, contextHandle->copyCommandList.Get(), contextOptions);
+            if (!renderContext)
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                SetLastError("RenderContextD3D12Impl::MakeContext failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            contextHandle->renderContext = std::move(renderContext);
+
+            HRESULT hr = contextHandle->copyCommandList->Close();
+            if (FAILED(hr))
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                SetLastError("copy command list close failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            ID3D12CommandList* copyLists[] = {contextHandle->copyCommandList.Get()};
+            device_handle->copyQueue->ExecuteCommandLists(1, copyLists);
+
+            contextHandle->fenceValue = 1;
+            hr = device_handle->copyQueue->Signal(contextHandle->copyFence.Get(), contextHandle->fenceValue);
+            if (FAILED(hr))
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                SetLastError("Queue signal failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            hr = contextHandle->copyFence->SetEventOnCompletion(contextHandle->fenceValue, contextHandle->fenceEvent);
+            if (FAILED(hr))
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                SetLastError("SetEventOnCompletion failed");
+                return rive_renderer_status_t::internal_error;
+            }
+            WaitForSingleObject(contextHandle->fenceEvent, INFINITE);
+
+            auto& slot = contextHandle->frameSlots[0];
+            slot.copyAllocator->Reset();
+            slot.directAllocator->Reset();
+            contextHandle->copyCommandList->Reset(slot.copyAllocator.Get(), nullptr);
+            contextHandle->directCommandList->Reset(slot.directAllocator.Get(), nullptr);
+            contextHandle->copyCommandList->Close();
+            contextHandle->directCommandList->Close();
+
+            auto targetStatus = EnsureD3D12RenderTarget(contextHandle);
+            if (targetStatus != rive_renderer_status_t::ok)
+            {
+                ReleaseD3D12Context(contextHandle);
+                delete contextHandle;
+                return targetStatus;
+            }
+
+            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+            out_context->handle = contextHandle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (device_handle->backend == rive_renderer_backend_t::metal)
+        {
+            if (!ValidateContextSize(width, height))
+            {
+                SetLastError("context dimensions must be non-zero");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto* contextHandle = new (std::nothrow) ContextHandle();
+            if (contextHandle == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            contextHandle->device = device_handle;
+
+            std::unique_ptr<rive::gpu::RenderContext> renderContext;
+            void*                                      metalContext = nullptr;
+            auto status = rive_metal_context_create(device_handle->metalDevice, width, height, &metalContext,
+                                                    &renderContext);
+            if (status != rive_renderer_status_t::ok)
+            {
+                delete contextHandle;
+                if (g_lastError.empty())
+                {
+                    SetLastError("Metal context creation failed");
+                }
+                return status;
+            }
+
+            contextHandle->renderContext = std::move(renderContext);
+            contextHandle->metalContext  = metalContext;
+            contextHandle->width         = width;
+            contextHandle->height        = height;
+
+            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+            out_context->handle = contextHandle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (device_handle->backend == rive_renderer_backend_t::vulkan)
+        {
+            if (!ValidateContextSize(width, height))
+            {
+                SetLastError("context dimensions must be non-zero");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto* contextHandle = new (std::nothrow) ContextHandle();
+            if (contextHandle == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            contextHandle->device = device_handle;
+            contextHandle->width  = width;
+            contextHandle->height = height;
+
+            rive::gpu::RenderContextVulkanImpl::ContextOptions options {};
+            auto renderContext = rive::gpu::RenderContextVulkanImpl::MakeContext(
+                device_handle->vkInstance,
+                device_handle->vkPhysicalDevice,
+                device_handle->vkDevice,
+                device_handle->vkFeatures,
+                device_handle->getInstanceProcAddr,
+                options);
+            if (!renderContext)
+            {
+                delete contextHandle;
+                SetLastError("RenderContextVulkanImpl::MakeContext failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            contextHandle->renderContext = std::move(renderContext);
+
+            auto initStatus = InitializeVulkanContext(contextHandle);
+            if (initStatus == rive_renderer_status_t::ok)
+            {
+                initStatus = CreateVulkanTarget(contextHandle);
+            }
+            if (initStatus != rive_renderer_status_t::ok)
+            {
+                ReleaseVulkanContext(contextHandle);
+                delete contextHandle;
+                return initStatus;
+            }
+
+            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+            out_context->handle = contextHandle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("context dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        auto* context = new (std::nothrow) ContextHandle();
+        if (context == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        context->device        = device_handle;
+        context->width         = width;
+        context->height        = height;
+        context->renderContext = nullptr;
+        context->cpuFramebuffer.assign(static_cast<size_t>(width) * height * 4, 0);
+        context->cpuRenderTarget.reset();
+        context->cpuFrameRecording  = false;
+        context->commandListsClosed = false;
+
+        if (device_handle->backend == rive_renderer_backend_t::null)
+        {
+            context->cpuContext.reset(
+                new (std::nothrow) rive_renderer_cpu::CpuRenderContext(device_handle->cpuSimdLevel));
+            if (!context->cpuContext)
+            {
+                delete context;
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+        }
+
+        device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+        out_context->handle = context;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_retain(rive_renderer_context_t context)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_release(rive_renderer_context_t context)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (handle->surface != nullptr)
+        {
+            SetLastError("context has an active surface; release the surface before destroying the context");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            SetLastError("context handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
+        {
+            if (handle->pathInterning)
+            {
+                std::lock_guard<std::mutex> lock(handle->pathInterning->mutex);
+                handle->pathInterning->factory = nullptr;
+            }
+            // The render paths and faded paints were made by this context's factory, so they go before it does.
+            handle->immutablePaths.clear();
+            SweepFadedPaints(handle, true);
+            // Fence waits must stop asking the backend about frames before it goes away.
+            for (const auto& signal : handle->fenceSignals)
+            {
+                RemovePendingFrame(handle, signal, false);
+            }
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+            WaitForD3D12Idle(handle);
+            ReturnSurfaceRenderTarget(handle);
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+            if (handle->metalContext != nullptr)
+            {
+                rive_metal_context_destroy(handle->metalContext);
+                handle->metalContext = nullptr;
+            }
+#elif defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+            ReleaseVulkanContext(handle);
+#endif
+            if (handle->device != nullptr)
+            {
+                DeviceHandle*       device      = handle->device;
+                const std::uint32_t device_prev = device->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+                if (device_prev == 1)
+                {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+                    device->adapter.Reset();
+                    device->d3d12Device.Reset();
+                    device->directQueue.Reset();
+                    device->copyQueue.Reset();
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+                    if (device->metalDevice != nullptr)
+                    {
+                        rive_metal_device_release(device->metalDevice);
+                        device->metalDevice = nullptr;
+                    }
+#endif
+                    delete device;
+                }
+            }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+            ReleaseD3D12Context(handle);
+#else
+            handle->renderContext.reset();
+            handle->cpuRenderTarget.reset();
+            handle->cpuContext.reset();
+            handle->cpuFramebuffer.clear();
+            handle->cpuFrameRecording  = false;
+            handle->commandListsClosed = false;
+#endif
+            // The frames have finished or been dropped by now, so waiters on their fences are released.
+            for (const auto& signal : handle->fenceSignals)
+            {
+                SignalCpuFence(signal.fence, signal.value);
+                rive_renderer_fence_release({signal.fence});
+            }
+            handle->surface = nullptr;
+            delete handle;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_get_size(rive_renderer_context_t context, std::uint32_t* out_width,
+                                                          std::uint32_t* out_height)
+    {
+        if (out_width == nullptr || out_height == nullptr)
+        {
+            SetLastError("size output pointers are null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        *out_width  = handle->width;
+        *out_height = handle->height;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_resize(rive_renderer_context_t context, std::uint32_t width,
+                                                        std::uint32_t height)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("context dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        handle->width  = width;
+        handle->height = height;
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null &&
+            handle->externalFramebuffer == nullptr)
+        {
+            handle->cpuFramebuffer.assign(static_cast<size_t>(width) * height * 4, 0);
+        }
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_begin_frame(rive_renderer_context_t              context,
+                                                             const rive_renderer_frame_options_t* options)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        std::uint32_t width  = handle->width;
+        std::uint32_t height = handle->height;
+        if (options != nullptr)
+        {
+            if (options->width != 0)
+            {
+                width = options->width;
+            }
+            if (options->height != 0)
+            {
+                height = options->height;
+            }
+        }
+
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("context dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (width != handle->width || height != handle->height)
+        {
+            handle->trackedFrames = 0;
+        }
+        handle->width  = width;
+        handle->height = height;
+        SweepFadedPaints(handle, false);
+
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
+        {
+            // Drawables are not preserved between frames, so Metal always redraws the whole target.
+            BeginFrameDamage(handle, 0);
+            auto status = rive_metal_context_begin_frame(handle->metalContext, handle->renderContext.get(),
+                                                         &handle->width, &handle->height, options,
+                                                         handle->surface ? handle->surface->metalSurface : nullptr,
+                                                         handle->frameCounter);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            handle->hasActiveFrame     = true;
+            handle->commandListsClosed = false;
+            handle->pendingFrameNumber = handle->frameCounter;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        {
+            // A resized offscreen target replaces a texture that frames in flight may still be drawing into.
+            if (handle->surface == nullptr && handle->renderTarget != nullptr &&
+                (handle->renderTarget->width() != handle->width || handle->renderTarget->height() != handle->height))
+            {
+                auto status = WaitForD3D12Idle(handle);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+            }
+
+            auto status = EnsureD3D12RenderTarget(handle);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            auto* slot = CurrentFrameSlot(handle);
+            status     = AcquireD3D12FrameSlot(handle, slot);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            HRESULT hr = handle->directCommandList->Reset(slot->directAllocator.Get(), nullptr);
+            if (FAILED(hr))
+            {
+                SetLastError("Reset direct command list failed");
+                return rive_renderer_status_t::internal_error;
+            }
+            hr = handle->copyCommandList->Reset(slot->copyAllocator.Get(), nullptr);
+            if (FAILED(hr))
+            {
+                SetLastError("Reset copy command list failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            BeginFrameDamage(handle, handle->surface != nullptr ? handle->surface->buffer_count : 1);
+
+            const rive::gpu::LoadAction loadAction =
+                handle->damageClip ? rive::gpu::LoadAction::preserveRenderTarget : rive::gpu::LoadAction::clear;
+
+            rive::gpu::RenderContext::FrameDescriptor descriptor;
+            descriptor.renderTargetWidth     = handle->width;
+            descriptor.renderTargetHeight    = handle->height;
+            descriptor.loadAction            = loadAction;
+            descriptor.clearColor            = 0;
+            descriptor.msaaSampleCount       = 0;
+            descriptor.disableRasterOrdering = false;
+
+            handle->renderContext->beginFrame(descriptor);
+            handle->hasActiveFrame     = true;
+            handle->commandListsClosed = false;
+            handle->pendingFrameNumber = handle->frameCounter;
+
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::vulkan)
+        {
+            if (handle->surface != nullptr)
+            {
+                SetLastError("Vulkan surfaces are not implemented");
+                return rive_renderer_status_t::unimplemented;
+            }
+
+            // Frames in flight may still be drawing into the old target, so it is only replaced once they finish.
+            if (!handle->renderTarget || handle->renderTarget->width() != handle->width ||
+                handle->renderTarget->height() != handle->height)
+            {
+                auto status = WaitForVulkanIdle(handle);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+                DestroyVulkanTarget(handle);
+                status = CreateVulkanTarget(handle);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+            }
+
+            auto status = AcquireVulkanFrameSlot(handle, CurrentFrameSlot(handle));
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            BeginFrameDamage(handle, 1);
+            handle->renderTarget->setTargetImageView(handle->targetView, handle->targetImage, handle->targetAccess);
+
+            const rive::gpu::LoadAction loadAction =
+                handle->damageClip ? rive::gpu::LoadAction::preserveRenderTarget : rive::gpu::LoadAction::clear;
+
+            rive::gpu::RenderContext::FrameDescriptor descriptor;
+            descriptor.renderTargetWidth     = handle->width;
+            descriptor.renderTargetHeight    = handle->height;
+            descriptor.loadAction            = loadAction;
+            descriptor.clearColor            = 0;
+            descriptor.msaaSampleCount       = 0;
+            descriptor.disableRasterOrdering = false;
+
+            handle->renderContext->beginFrame(descriptor);
+            handle->hasActiveFrame     = true;
+            handle->commandListsClosed = false;
+            handle->pendingFrameNumber = handle->frameCounter;
+
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        {
+            std::uint32_t bufferCount = 1;
+            if (handle->sharedFramebuffer)
+            {
+                const auto* header = handle->sharedFramebuffer->header();
+                if (header->width != handle->width || header->height != handle->height)
+                {
+                    SetLastError("shared framebuffer must be recreated after a resize");
+                    return rive_renderer_status_t::invalid_parameter;
+                }
+                BeginSharedFrame(handle);
+                bufferCount = header->slot_count;
+            }
+            else if (handle->externalFramebuffer != nullptr &&
+                     !FitsPixelRows(handle->externalLength, handle->externalStride, handle->width, handle->height))
+            {
+                SetLastError("bound cpu framebuffer is too small for the context");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            BeginFrameDamage(handle, bufferCount);
+            const size_t required = static_cast<size_t>(handle->width) * handle->height * 4;
+            if (handle->externalFramebuffer == nullptr && handle->cpuFramebuffer.size() != required)
+            {
+                handle->cpuFramebuffer.assign(required, 0);
+            }
+            else
+            {
+                // Only the damaged rows are cleared; the renderers are clipped to the same rectangle.
+                const rive_renderer_rect_t& damage      = handle->frameDamage;
+                const CpuFramebufferView    framebuffer = GetCpuFramebuffer(handle);
+                for (auto y = static_cast<std::size_t>(damage.top); y < static_cast<std::size_t>(damage.bottom); ++y)
+                {
+                    std::uint8_t* row = framebuffer.pixels + y * framebuffer.stride;
+                    std::fill(row + static_cast<std::size_t>(damage.left) * 4,
+                              row + static_cast<std::size_t>(damage.right) * 4, 0);
+                }
+            }
+            if (handle->cpuContext)
+            {
+                handle->cpuContext->beginFrame(handle->width, handle->height);
+            }
+            handle->cpuFrameRecording  = true;
+            handle->commandListsClosed = false;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+
+        SetLastError("context_begin_frame not implemented for this backend");
+        return rive_renderer_status_t::unimplemented;
+    }
+
+    rive_renderer_status_t rive_renderer_context_end_frame(rive_renderer_context_t context)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        {
+            if (!handle->hasActiveFrame)
+            {
+                SetLastError("begin_frame must be called before end_frame");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            auto* impl = GetD3D12Impl(handle);
+            if (impl == nullptr || handle->renderTarget == nullptr)
+            {
+                SetLastError("render context not initialized");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            rive::gpu::RenderContextD3D12Impl::CommandLists cmdLists {handle->copyCommandList.Get(),
+                                                                      handle->directCommandList.Get()};
+
+            RetireD3D12Frames(handle);
+
+            rive::gpu::RenderContext::FlushResources resources {};
+            resources.renderTarget          = handle->renderTarget.get();
+            resources.externalCommandBuffer = &cmdLists;
+            resources.currentFrameNumber    = handle->frameCounter;
+            resources.safeFrameNumber       = handle->lastCompletedFrame;
+
+            handle->renderContext->flush(resources);
+
+            HRESULT hr = handle->copyCommandList->Close();
+            if (FAILED(hr))
+            {
+                SetLastError("copy command list close failed");
+                return rive_renderer_status_t::internal_error;
+            }
+            hr = handle->directCommandList->Close();
+            if (FAILED(hr))
+            {
+                SetLastError("direct command list close failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            handle->hasActiveFrame     = false;
+            handle->commandListsClosed = true;
+
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#else
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
+        {
+            if (!handle->hasActiveFrame)
+            {
+                SetLastError("begin_frame must be called before end_frame");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            handle->lastCompletedFrame = rive_metal_context_completed_frame(handle->metalContext);
+            auto status = rive_metal_context_end_frame(handle->metalContext, handle->renderContext.get(),
+                                                       handle->surface ? handle->surface->metalSurface : nullptr,
+                                                       handle->frameCounter, handle->lastCompletedFrame);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            handle->hasActiveFrame     = false;
+            handle->commandListsClosed = true;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+#endif
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::vulkan)
+        {
+            if (!handle->hasActiveFrame)
+            {
+                SetLastError("begin_frame must be called before end_frame");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            RetireVulkanFrames(handle);
+            auto* slot = CurrentFrameSlot(handle);
+
+            rive::gpu::RenderContext::FlushResources resources {};
+            resources.renderTarget          = handle->renderTarget.get();
+            resources.externalCommandBuffer = slot->commandBuffer;
+            resources.currentFrameNumber    = handle->frameCounter;
+            resources.safeFrameNumber       = handle->lastCompletedFrame;
+
+            handle->renderContext->flush(resources);
+            handle->targetAccess = handle->renderTarget->targetLastAccess();
+
+            auto status = RecordVulkanReadbacks(handle, slot);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+            RecordFrameReadbacks(handle);
+
+            if (handle->device->vk.endCommandBuffer(slot->commandBuffer) != VK_SUCCESS)
+            {
+                SetLastError("failed to end Vulkan command buffer");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            handle->hasActiveFrame     = false;
+            handle->commandListsClosed = true;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        {
+            if (!handle->cpuFrameRecording)
+            {
+                SetLastError("begin_frame must be called before end_frame");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            const CpuFramebufferView framebuffer = GetCpuFramebuffer(handle);
+            if (handle->cpuContext)
+            {
+                handle->cpuContext->endFrame(framebuffer.pixels, handle->width, handle->height, framebuffer.stride);
+            }
+            for (auto* readback : handle->readbacks)
+            {
+                if (readback->frameNumber == 0)
+                {
+                    const auto& rect = readback->rect;
+                    readback->pixels.resize(static_cast<std::size_t>(rect.width) * rect.height * 4);
+                    ConvertPixelRows(*handle->device, framebuffer.pixels + rect.y * framebuffer.stride + rect.x * 4,
+                                     framebuffer.stride, readback->pixels.data(),
+                                     static_cast<std::size_t>(rect.width) * 4, rect.width, rect.height,
+                                     readback->format);
+                }
+            }
+            RecordFrameReadbacks(handle);
+
+            // Pixels outside the damage were converted by earlier frames.
+            const rive_renderer_rect_t& damage = handle->frameDamage;
+            if (handle->externalFramebuffer != nullptr &&
+                handle->externalFormat != rive_renderer_pixel_format_t::rgba8_premultiplied &&
+                damage.right > damage.left)
+            {
+                const auto    left = static_cast<std::uint32_t>(damage.left);
+                const auto    top  = static_cast<std::uint32_t>(damage.top);
+                std::uint8_t* rows = framebuffer.pixels + top * framebuffer.stride + left * 4;
+                ConvertPixelRows(*handle->device, rows, framebuffer.stride, rows, framebuffer.stride,
+                                 static_cast<std::uint32_t>(damage.right) - left,
+                                 static_cast<std::uint32_t>(damage.bottom) - top, handle->externalFormat);
+            }
+            if (handle->sharedFramebuffer)
+            {
+                PublishSharedFrame(handle);
+            }
+            handle->cpuFrameRecording  = false;
+            handle->commandListsClosed = true;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+
+        SetLastError("context_end_frame not implemented for this backend");
+        return rive_renderer_status_t::unimplemented;
+    }
+
+    rive_renderer_status_t rive_renderer_context_submit(rive_renderer_context_t context)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        {
+            if (!handle->commandListsClosed)
+            {
+                SetLastError("end_frame must be called before submit");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto* device = handle->device;
+            auto* slot   = CurrentFrameSlot(handle);
+
+            ID3D12CommandList* copyLists[] = {handle->copyCommandList.Get()};
+            device->copyQueue->ExecuteCommandLists(1, copyLists);
+
+            handle->fenceValue += 1;
+            HRESULT hr = device->copyQueue->Signal(handle->copyFence.Get(), handle->fenceValue);
+            if (FAILED(hr))
+            {
+                SetLastError("copy queue signal failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            hr = device->directQueue->Wait(handle->copyFence.Get(), handle->fenceValue);
+            if (FAILED(hr))
+            {
+                SetLastError("direct queue wait failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            ID3D12CommandList* directLists[] = {handle->directCommandList.Get()};
+            device->directQueue->ExecuteCommandLists(1, directLists);
+
+            hr = device->directQueue->Signal(handle->directFence.Get(), handle->fenceValue);
+            if (FAILED(hr))
+            {
+                SetLastError("direct queue signal failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            slot->fenceValue  = handle->fenceValue;
+            slot->frameNumber = handle->frameCounter;
+            handle->frameCounter += 1;
+            handle->pendingFrameNumber = 0;
+            handle->commandListsClosed = false;
+
+            // With a single frame in flight submit stays synchronous, as callers may read the target right after it.
+            if (handle->framesInFlight == 1)
+            {
+                auto status = WaitForD3D12Fence(handle, slot->fenceValue);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+            }
+            else
+            {
+                RetireD3D12Frames(handle);
+            }
+
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
+        {
+            if (!handle->commandListsClosed)
+            {
+                SetLastError("end_frame must be called before submit");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto status = rive_metal_context_submit(handle->metalContext, handle->surface != nullptr);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+
+            handle->pendingFrameNumber = 0;
+
+            if (handle->surface == nullptr)
+            {
+                handle->frameCounter += 1;
+                handle->lastCompletedFrame = rive_metal_context_completed_frame(handle->metalContext);
+                NotifyCompletedFrames(handle);
+            }
+
+            handle->commandListsClosed = false;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::vulkan)
+        {
+            if (!handle->commandListsClosed)
+            {
+                SetLastError("end_frame must be called before submit");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            auto* device = handle->device;
+            auto* slot   = CurrentFrameSlot(handle);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &slot->commandBuffer;
+            {
+                std::lock_guard<std::mutex> lock(handle->completionMutex);
+                VkResult result = device->vk.queueSubmit(device->graphicsQueue, 1, &submitInfo, slot->fence);
+                if (result != VK_SUCCESS)
+                {
+                    SetLastError("Vulkan queue submit failed");
+                    return result == VK_ERROR_DEVICE_LOST ? rive_renderer_status_t::device_lost
+                                                          : rive_renderer_status_t::internal_error;
+                }
+
+                slot->submitted   = true;
+                slot->frameNumber = handle->frameCounter;
+            }
+            if (slot->readbackRecorded)
+            {
+                handle->readbackSlot = slot;
+            }
+            handle->frameCounter += 1;
+            handle->pendingFrameNumber = 0;
+            handle->commandListsClosed = false;
+
+            // With a single frame in flight submit stays synchronous, as callers may read the target right after it.
+            if (handle->framesInFlight == 1)
+            {
+                auto status = WaitForVulkanSlot(handle, *slot);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+            }
+            else
+            {
+                RetireVulkanFrames(handle);
+            }
+
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        {
+            if (!handle->commandListsClosed)
+            {
+                SetLastError("end_frame must be called before submit");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            handle->lastCompletedFrame = handle->frameCounter;
+            handle->frameCounter += 1;
+            handle->commandListsClosed = false;
+            NotifyCompletedFrames(handle);
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+
+        SetLastError("context_submit not implemented for this backend");
+        return rive_renderer_status_t::unimplemented;
+    }
+
+    rive_renderer_status_t rive_renderer_context_set_frames_in_flight(rive_renderer_context_t context,
+                                                                      std::uint32_t           count)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (count == 0 || count > RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT)
+        {
+            SetLastError("frames in flight must be between 1 and RIVE_RENDERER_MAX_FRAMES_IN_FLIGHT");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (handle->hasActiveFrame || handle->cpuFrameRecording || handle->commandListsClosed)
+        {
+            SetLastError("frames in flight cannot change between begin_frame and submit");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        // Frames pick their ring slot by frame number, so the ring drains before it changes size.
+        auto status = WaitForContextIdle(handle);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        if (handle->metalContext != nullptr)
+        {
+            status = rive_metal_context_set_frames_in_flight(handle->metalContext, count);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+        }
+#endif
+
+        handle->framesInFlight = count;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_wait_idle(rive_renderer_context_t context)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto status = WaitForContextIdle(handle);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_get_completed_frame(rive_renderer_context_t context,
+                                                                     std::uint64_t*          out_frame)
+    {
+        if (out_frame == nullptr)
+        {
+            SetLastError("frame output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        PollCompletedFrames(handle);
+        *out_frame = handle->lastCompletedFrame;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_set_framebuffer_readback(rive_renderer_context_t context,
+                                                                          std::uint8_t            enabled)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        const auto backend = handle->device != nullptr ? handle->device->backend : rive_renderer_backend_t::null;
+        if (enabled != 0 && backend != rive_renderer_backend_t::null && backend != rive_renderer_backend_t::vulkan)
+        {
+            SetLastError("framebuffer readback not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        handle->framebufferReadback = enabled != 0;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_context_request_readback(rive_renderer_context_t           context,
+                                                                  const rive_renderer_pixel_rect_t* rect,
+                                                                  rive_renderer_pixel_format_t      format,
+                                                                  rive_renderer_readback_t*         out_readback)
+    {
+        if (out_readback == nullptr)
+        {
+            SetLastError("readback output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        out_readback->handle = nullptr;
+
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (!IsValidPixelFormat(format))
+        {
+            SetLastError("unknown pixel format");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        const auto backend = handle->device != nullptr ? handle->device->backend : rive_renderer_backend_t::unknown;
+        if (backend != rive_renderer_backend_t::null && backend != rive_renderer_backend_t::vulkan)
+        {
+            SetLastError("readback not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (!handle->hasActiveFrame && !handle->cpuFrameRecording)
+        {
+            SetLastError("readbacks must be requested between begin_frame and end_frame");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (handle->externalFramebuffer != nullptr &&
+            handle->externalFormat != rive_renderer_pixel_format_t::rgba8_premultiplied)
+        {
+            SetLastError("cpu framebuffer is bound to memory in another pixel format");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        const rive_renderer_pixel_rect_t region = rect != nullptr ? *rect
+                                                                  : rive_renderer_pixel_rect_t {0, 0, handle->width,
+                                                                                                handle->height};
+        if (region.width == 0 || region.height == 0 ||
+            static_cast<std::uint64_t>(region.x) + region.width > handle->width ||
+            static_cast<std::uint64_t>(region.y) + region.height > handle->height)
+        {
+            SetLastError("readback rect must be non-empty and inside the target");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        auto* readback = new (std::nothrow) ReadbackHandle();
+        if (readback == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+        readback->context = handle;
+        readback->rect    = region;
+        readback->format  = format;
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (backend == rive_renderer_backend_t::vulkan)
+        {
+            readback->staging =
+                AcquireVulkanStagingBuffer(handle, static_cast<VkDeviceSize>(region.width) * region.height * 4);
+            if (readback->staging == nullptr)
+            {
+                delete readback;
+                return rive_renderer_status_t::out_of_memory;
+            }
+        }
+#endif
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        handle->readbacks.push_back(readback);
+        out_readback->handle = readback;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_retain(rive_renderer_readback_t readback)
+    {
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_release(rive_renderer_readback_t readback)
+    {
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            SetLastError("readback handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
+        {
+            auto* context   = handle->context;
+            auto& readbacks = context->readbacks;
+            readbacks.erase(std::remove(readbacks.begin(), readbacks.end(), handle), readbacks.end());
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+            if (handle->staging != nullptr)
+            {
+                handle->staging->inUse = false;
+            }
+#endif
+            if (handle->fence != nullptr)
+            {
+                rive_renderer_fence_release({handle->fence});
+            }
+            delete handle;
+            return rive_renderer_context_release({context});
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_poll(rive_renderer_readback_t readback, std::uint8_t* out_ready)
+    {
+        if (out_ready == nullptr)
+        {
+            SetLastError("ready output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        PollCompletedFrames(handle->context);
+        *out_ready = handle->ready ? 1 : 0;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_wait(rive_renderer_readback_t readback, std::uint64_t timeout_ms)
+    {
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (!handle->ready && (handle->frameNumber == 0 || handle->frameNumber >= context->frameCounter))
+        {
+            SetLastError("readback frame has not been submitted");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (!handle->ready && handle->staging != nullptr)
+        {
+            auto status = WaitForVulkanFrame(context, handle->frameNumber, timeout_ms);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
+        }
+#else
+        (void)timeout_ms;
+#endif
+
+        PollCompletedFrames(context);
+        if (!handle->ready)
+        {
+            SetLastError("readback wait timed out");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_map(rive_renderer_readback_t       readback,
+                                                      rive_renderer_mapped_memory_t* out_mapping)
+    {
+        if (out_mapping == nullptr)
+        {
+            SetLastError("mapped memory output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        PollCompletedFrames(handle->context);
+        if (!handle->ready)
+        {
+            SetLastError("readback has not completed");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        const auto&       rect   = handle->rect;
+        const std::size_t stride = static_cast<std::size_t>(rect.width) * 4;
+        void*             data   = handle->pixels.data();
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (handle->staging != nullptr)
+        {
+            // RGBA is read straight from the staging buffer; other formats are converted once on first map.
+            if (!handle->mapped)
+            {
+                auto status = InvalidateVulkanStagingBuffer(handle->context, *handle->staging);
+                if (status != rive_renderer_status_t::ok)
+                {
+                    return status;
+                }
+                if (handle->format != rive_renderer_pixel_format_t::rgba8_premultiplied)
+                {
+                    handle->pixels.resize(stride * rect.height);
+                    ConvertPixelRows(*handle->context->device,
+                                     static_cast<const std::uint8_t*>(handle->staging->pixels), stride,
+                                     handle->pixels.data(), stride, rect.width, rect.height, handle->format);
+                }
+            }
+            data = handle->format == rive_renderer_pixel_format_t::rgba8_premultiplied ? handle->staging->pixels
+                                                                                       : handle->pixels.data();
+        }
+#endif
+        handle->mapped      = true;
+        out_mapping->data   = data;
+        out_mapping->length = stride * rect.height;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_readback_signal_fence(rive_renderer_readback_t readback,
+                                                               rive_renderer_fence_t fence, std::uint64_t value)
+    {
+        auto* handle = ToReadback(readback);
+        if (handle == nullptr)
+        {
+            SetLastError("readback handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* fence_handle = ToFence(fence);
+        if (fence_handle == nullptr)
+        {
+            SetLastError("fence handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (fence_handle->device != context->device)
+        {
+            SetLastError("fence and readback must share the same device");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (fence_handle->fence)
+        {
+            SetLastError("readbacks only signal CPU fences");
+            return rive_renderer_status_t::unsupported;
+        }
+#endif
+
+        if (handle->frameNumber == 0 && handle->fence != nullptr)
+        {
+            SetLastError("readback already has a pending fence signal");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (!ClaimCpuFenceValue(fence_handle, &value))
+        {
+            SetLastError("fence signal value must be greater than the last signaled value");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (handle->frameNumber == 0)
+        {
+            fence_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            handle->fence      = fence_handle;
+            handle->fenceValue = value;
+        }
+        else
+        {
+            PollCompletedFrames(context);
+            QueueCpuFenceSignal(context, fence_handle, value, handle->frameNumber);
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_surface_create_d3d12_hwnd(
+        rive_renderer_device_t device, rive_renderer_context_t context,
+        const rive_renderer_surface_create_info_d3d12_hwnd_t* info, rive_renderer_surface_t* out_surface)
+    {
+        if (out_surface == nullptr)
+        {
+            SetLastError("surface output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        out_surface->handle = nullptr;
+
+        if (info == nullptr)
+        {
+            SetLastError("surface create info is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* device_handle  = ToDevice(device);
+        auto* context_handle = ToContext(context);
+        if (device_handle == nullptr || context_handle == nullptr)
+        {
+            SetLastError("device or context handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (device_handle->backend == rive_renderer_backend_t::d3d12 &&
+            context_handle->device == device_handle)
+        {
+            if (info->hwnd == nullptr)
+            {
+                SetLastError("HWND pointer is null");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            if (context_handle->surface != nullptr)
+            {
+                SetLastError("context already has an attached surface");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            std::uint32_t width  = info->width != 0 ? info->width : context_handle->width;
+            std::uint32_t height = info->height != 0 ? info->height : context_handle->height;
+            if (!ValidateContextSize(width, height))
+            {
+                SetLastError("surface dimensions must be non-zero");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            std::uint32_t bufferCount = info->buffer_count != 0 ? info->buffer_count : 2;
+            if (bufferCount < 2)
+            {
+                bufferCount = 2;
+            }
+
+            Microsoft::WRL::ComPtr<IDXGIFactory4> factory4;
+            HRESULT hr = CreateDXGIFactory2(0, IID_PPV_ARGS(&factory4));
+            if (FAILED(hr))
+            {
+                SetLastError("CreateDXGIFactory2 failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            DXGI_SWAP_CHAIN_DESC1 desc {};
+            desc.Width       = width;
+            desc.Height      = height;
+            desc.Format      = DXGI_FORMAT_R8G8B8A8_UNORM;
+            desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
+            desc.SwapEffect  = DXGI_SWAP_EFFECT_FLIP_DISCARD;
+            desc.SampleDesc.Count   = 1;
+            desc.SampleDesc.Quality = 0;
+            desc.Scaling            = DXGI_SCALING_NONE;
+            desc.BufferCount        = bufferCount;
+            desc.AlphaMode          = DXGI_ALPHA_MODE_IGNORE;
+
+            bool allowTearing = false;
+            if ((static_cast<std::uint32_t>(info->flags) &
+                 static_cast<std::uint32_t>(rive_renderer_surface_flags_t::allow_tearing)) != 0)
+            {
+                allowTearing = CheckTearingSupport();
+                if (allowTearing)
+                {
+                    desc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+                }
+            }
+
+            Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain1;
+            hr = factory4->CreateSwapChainForHwnd(device_handle->directQueue.Get(),
+                                                  static_cast<HWND>(info->hwnd), &desc, nullptr, nullptr,
+                                                  &swapChain1);
+            if (FAILED(hr))
+            {
+                SetLastError("CreateSwapChainForHwnd failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            factory4->MakeWindowAssociation(static_cast<HWND>(info->hwnd), DXGI_MWA_NO_ALT_ENTER);
+
+            Microsoft::WRL::ComPtr<IDXGISwapChain3> swapChain3;
+            hr = swapChain1.As(&swapChain3);
+            if (FAILED(hr))
+            {
+                SetLastError("IDXGISwapChain3 query failed");
+                return rive_renderer_status_t::internal_error;
+            }
+
+            auto* surface = new (std::nothrow) SurfaceHandle();
+            if (surface == nullptr)
+            {
+                SetLastError("allocation failed");
+                return rive_renderer_status_t::out_of_memory;
+            }
+
+            surface->backend          = rive_renderer_backend_t::d3d12;
+            surface->device           = device_handle;
+            surface->context          = context_handle;
+            surface->width            = width;
+            surface->height           = height;
+            surface->buffer_count     = bufferCount;
+            surface->flags            = info->flags;
+            surface->present_interval = info->present_interval != 0 ? info->present_interval : 1;
+            surface->hwnd             = info->hwnd;
+            surface->swapChain        = swapChain3;
+            surface->supportsTearing  = allowTearing;
+
+            context_handle->renderTarget.reset();
+            context_handle->renderTargetTexture.Reset();
+
+            rive_renderer_status_t targetsStatus = CreateSurfaceRenderTargets(surface, width, height);
+            if (targetsStatus != rive_renderer_status_t::ok)
+            {
+                delete surface;
+                return targetsStatus;
+            }
+
+            rive_renderer_status_t retainDeviceStatus = rive_renderer_device_retain(device);
+            if (retainDeviceStatus != rive_renderer_status_t::ok)
+            {
+                delete surface;
+                return retainDeviceStatus;
+            }
+
+            rive_renderer_status_t retainContextStatus = rive_renderer_context_retain(context);
+            if (retainContextStatus != rive_renderer_status_t::ok)
+            {
+                rive_renderer_device_release(device);
+                delete surface;
+                return retainContextStatus;
+            }
+
+            context_handle->surface = surface;
+            context_handle->width   = width;
+            context_handle->height  = height;
+
+            out_surface->handle = surface;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+        SetLastError("surface creation not supported for this backend");
+        return rive_renderer_status_t::unsupported;
+#else
+        (void)info;
+        SetLastError("surface creation not supported on this platform");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_surface_create_metal_layer(
+        rive_renderer_device_t device, rive_renderer_context_t context,
+        const rive_renderer_surface_create_info_metal_layer_t* info, rive_renderer_surface_t* out_surface)
+    {
+        (void)device;
+        (void)context;
+        (void)info;
+        if (out_surface != nullptr)
+        {
+            out_surface->handle = nullptr;
+        }
+#if defined(__APPLE__) && !defined(RIVE_UNREAL)
+        auto* device_handle  = ToDevice(device);
+        auto* context_handle = ToContext(context);
+        if (device_handle == nullptr || context_handle == nullptr)
+        {
+            SetLastError("device or context handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (device_handle->backend != rive_renderer_backend_t::metal ||
+            context_handle->device != device_handle)
+        {
+            SetLastError("surface creation not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (info == nullptr)
+        {
+            SetLastError("surface create info is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        if (context_handle->surface != nullptr)
+        {
+            SetLastError("context already has an attached surface");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (info->layer == nullptr)
+        {
+            SetLastError("CAMetalLayer pointer is null");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        std::uint32_t width  = info->width != 0 ? info->width : context_handle->width;
+        std::uint32_t height = info->height != 0 ? info->height : context_handle->height;
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("surface dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+            }
+
+        auto* surface = new (std::nothrow) SurfaceHandle();
+        if (surface == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        surface->backend          = rive_renderer_backend_t::metal;
+        surface->device           = device_handle;
+        surface->context          = context_handle;
+        surface->width            = width;
+        surface->height           = height;
+        surface->buffer_count     = 1;
+        surface->flags            = info->flags;
+        surface->present_interval = 1;
+
+        rive_renderer_surface_create_info_metal_layer_t adjustedInfo = *info;
+        adjustedInfo.width  = width;
+        adjustedInfo.height = height;
+
+        void* metalSurface = nullptr;
+        rive_renderer_status_t status = rive_metal_surface_create(device_handle->metalDevice, context_handle->metalContext,
+                                                                  &adjustedInfo, &metalSurface);
+        if (status != rive_renderer_status_t::ok)
+        {
+            delete surface;
+            if (g_lastError.empty())
+            {
+                SetLastError("Metal surface creation failed");
+            }
+            return status;
+        }
+
+        surface->metalSurface = metalSurface;
+
+        rive_renderer_status_t retainDeviceStatus = rive_renderer_device_retain(device);
+        if (retainDeviceStatus != rive_renderer_status_t::ok)
+        {
+            rive_metal_surface_destroy(surface->metalSurface);
+            delete surface;
+            return retainDeviceStatus;
+        }
+
+        rive_renderer_status_t retainContextStatus = rive_renderer_context_retain(context);
+        if (retainContextStatus != rive_renderer_status_t::ok)
+        {
+            rive_renderer_device_release(device);
+            rive_metal_surface_destroy(surface->metalSurface);
+            delete surface;
+            return retainContextStatus;
+        }
+
+        context_handle->surface = surface;
+        context_handle->width   = width;
+        context_handle->height  = height;
+
+        out_surface->handle = surface;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#else
+        SetLastError("Metal surface creation not supported on this platform");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_surface_create_vulkan(
+        rive_renderer_device_t device,
+        rive_renderer_context_t context,
+        const rive_renderer_surface_create_info_vulkan_t* info,
+        rive_renderer_surface_t* out_surface)
+    {
+        if (out_surface == nullptr)
+        {
+            SetLastError("surface output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        out_surface->handle = nullptr;
+
+        if (info == nullptr)
+        {
+            SetLastError("surface create info is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* device_handle  = ToDevice(device);
+        auto* context_handle = ToContext(context);
+        if (device_handle == nullptr || context_handle == nullptr)
+        {
+            SetLastError("device or context handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
+        if (device_handle->backend != rive_renderer_backend_t::vulkan ||
+            context_handle->device != device_handle)
+        {
+            SetLastError("surface creation not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        SetLastError("Vulkan surface creation not yet implemented");
+        return rive_renderer_status_t::unimplemented;
+#else
+        (void)device;
+        (void)context;
+        (void)info;
+        SetLastError("Vulkan backend is not available in this build");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_surface_retain(rive_renderer_surface_t surface)
+    {
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_surface_release(rive_renderer_surface_t surface)
+    {
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            SetLastError("surface handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
+        {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+            if (handle->context != nullptr)
+            {
+                WaitForD3D12Idle(handle->context);
+                ReturnSurfaceRenderTarget(handle->context);
+                if (handle->context->surface == handle)
+                {
+                    handle->context->surface = nullptr;
+                }
+            }
+            handle->renderTargets.clear();
+            handle->backBuffers.clear();
+            handle->swapChain.Reset();
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+            if (handle->metalSurface != nullptr)
+            {
+                rive_metal_surface_destroy(handle->metalSurface);
+                handle->metalSurface = nullptr;
+            }
+            if (handle->context != nullptr && handle->context->surface == handle)
+            {
+                handle->context->surface = nullptr;
+            }
+#endif
+            if (handle->context != nullptr)
+            {
+                rive_renderer_context_t ctx {};
+                ctx.handle = handle->context;
+                rive_renderer_context_release(ctx);
+            }
+            if (handle->device != nullptr)
+            {
+                rive_renderer_device_t dev {};
+                dev.handle = handle->device;
+                rive_renderer_device_release(dev);
+            }
+            handle->context = nullptr;
+            handle->device  = nullptr;
+            delete handle;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_surface_get_size(rive_renderer_surface_t surface, std::uint32_t* out_width,
+                                                          std::uint32_t* out_height)
+    {
+        if (out_width == nullptr || out_height == nullptr)
+        {
+            SetLastError("surface size output pointers are null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        *out_width  = handle->width;
+        *out_height = handle->height;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_surface_resize(rive_renderer_surface_t surface, std::uint32_t width,
+                                                        std::uint32_t height)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (handle->backend != rive_renderer_backend_t::d3d12)
+        {
+            SetLastError("surface resize not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("surface dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (handle->swapChain == nullptr || handle->context == nullptr)
+        {
+            SetLastError("surface not initialized");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (context->hasActiveFrame)
+        {
+            SetLastError("cannot resize while a frame is active");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        auto idleStatus = WaitForD3D12Idle(context);
+        if (idleStatus != rive_renderer_status_t::ok)
+        {
+            return idleStatus;
+        }
+
+        ReturnSurfaceRenderTarget(context);
+        context->renderTarget.reset();
+        context->renderTargetTexture.Reset();
+
+        handle->renderTargets.clear();
+        handle->backBuffers.clear();
+
+        UINT resizeFlags = handle->supportsTearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
+        HRESULT hr = handle->swapChain->ResizeBuffers(handle->buffer_count, width, height, DXGI_FORMAT_R8G8B8A8_UNORM,
+                                                      resizeFlags);
+        if (FAILED(hr))
+        {
+            SetLastError("swapchain resize failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        rive_renderer_status_t targetsStatus = CreateSurfaceRenderTargets(handle, width, height);
+        if (targetsStatus != rive_renderer_status_t::ok)
+        {
+            return targetsStatus;
+        }
+
+        handle->width  = width;
+        handle->height = height;
+        context->width  = width;
+        context->height = height;
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (handle->backend != rive_renderer_backend_t::metal)
+        {
+            SetLastError("surface resize not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (!ValidateContextSize(width, height))
+        {
+            SetLastError("surface dimensions must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        if (handle->metalSurface == nullptr || handle->context == nullptr)
+        {
+            SetLastError("surface not initialized");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (context->hasActiveFrame)
+        {
+            SetLastError("cannot resize while a frame is active");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        rive_renderer_status_t status = rive_metal_surface_resize(handle->metalSurface, width, height);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+
+        handle->width  = width;
+        handle->height = height;
+        context->width  = width;
+        context->height = height;
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#else
+        (void)surface;
+        (void)width;
+        (void)height;
+        SetLastError("surface resize not supported on this platform");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_surface_present(rive_renderer_surface_t surface, std::uint32_t present_interval,
+                                                         rive_renderer_present_flags_t flags)
+    {
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (handle->backend != rive_renderer_backend_t::d3d12)
+        {
+            SetLastError("surface present not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (handle->swapChain == nullptr || handle->context == nullptr)
+        {
+            SetLastError("surface not initialized");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (context->hasActiveFrame || context->pendingFrameNumber != 0)
+        {
+            SetLastError("submit must be called before present");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        ReturnSurfaceRenderTarget(context);
+
+        UINT syncInterval = present_interval != 0 ? present_interval : handle->present_interval;
+        UINT presentFlags = 0;
+        if ((static_cast<std::uint32_t>(flags) &
+             static_cast<std::uint32_t>(rive_renderer_present_flags_t::allow_tearing)) != 0 &&
+            handle->supportsTearing && syncInterval == 0)
+        {
+            presentFlags |= DXGI_PRESENT_ALLOW_TEARING;
+        }
+
+        HRESULT hr = handle->swapChain->Present(syncInterval, presentFlags);
+        if (FAILED(hr))
+        {
+            if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
+            {
+                SetLastError("device lost during present");
+                return rive_renderer_status_t::device_lost;
+            }
+            SetLastError("swapchain present failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        context->renderTarget.reset();
+        context->renderTargetTexture.Reset();
+        handle->borrowedIndex = std::numeric_limits<UINT>::max();
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
+        auto* handle = ToSurface(surface);
+        if (handle == nullptr)
+        {
+            SetLastError("surface handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (handle->backend != rive_renderer_backend_t::metal)
+        {
+            SetLastError("surface present not supported for this backend");
+            return rive_renderer_status_t::unsupported;
+        }
+
+        if (handle->metalSurface == nullptr || handle->context == nullptr)
+        {
+            SetLastError("surface not initialized");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* context = handle->context;
+        if (context->hasActiveFrame || context->pendingFrameNumber != 0)
+        {
+            SetLastError("submit must be called before present");
             return rive_renderer_status_t::invalid_parameter;
         }
 
+        rive_renderer_status_t status = rive_metal_surface_present(handle->metalSurface, context->metalContext,
+                                                                   context->renderContext.get(), flags,
+                                                                   present_interval);
+        if (status != rive_renderer_status_t::ok)
+        {
+            return status;
+        }
+
+        context->frameCounter += 1;
+        context->lastCompletedFrame = rive_metal_context_completed_frame(context->metalContext);
+        context->commandListsClosed = false;
+        context->pendingFrameNumber = 0;
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+#else
+        (void)surface;
+        (void)present_interval;
+        (void)flags;
+        SetLastError("surface present not supported on this platform");
+        return rive_renderer_status_t::unsupported;
+#endif
+    }
+
+    rive_renderer_status_t rive_renderer_fence_create(rive_renderer_device_t device, rive_renderer_fence_t* out_fence)
+    {
+        if (out_fence == nullptr)
+        {
+            SetLastError("fence output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        out_fence->handle = nullptr;
+
+        auto* device_handle = ToDevice(device);
+        if (device_handle == nullptr)
+        {
+            SetLastError("device handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* fenceHandle = new (std::nothrow) FenceHandle();
+        if (fenceHandle == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (device_handle->backend != rive_renderer_backend_t::d3d12)
+        {
+            fenceHandle->device = device_handle;
+            device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            out_fence->handle = fenceHandle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+
+        HRESULT hr = device_handle->d3d12Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fenceHandle->fence));
+        if (FAILED(hr))
+        {
+            delete fenceHandle;
+            SetLastError("CreateFence failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        fenceHandle->eventHandle = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+        if (fenceHandle->eventHandle == nullptr)
+        {
+            fenceHandle->fence.Reset();
+            delete fenceHandle;
+            SetLastError("CreateEvent failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        fenceHandle->lastValue.store(0, std::memory_order_relaxed);
+#endif
+
+        fenceHandle->device = device_handle;
+        device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+        out_fence->handle = fenceHandle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_fence_retain(rive_renderer_fence_t fence)
+    {
+        auto* handle = ToFence(fence);
+        if (handle == nullptr)
+        {
+            SetLastError("fence handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_fence_release(rive_renderer_fence_t fence)
+    {
+        auto* handle = ToFence(fence);
+        if (handle == nullptr)
+        {
+            SetLastError("fence handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("context handle refcount underflow");
+            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            SetLastError("fence handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
         if (previous == 1)
         {
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
-            ReturnSurfaceRenderTarget(handle);
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-            if (handle->metalContext != nullptr)
+            if (handle->eventHandle != nullptr)
             {
-                rive_metal_context_destroy(handle->metalContext);
-                handle->metalContext = nullptr;
+                CloseHandle(handle->eventHandle);
+                handle->eventHandle = nullptr;
             }
+            handle->fence.Reset();
 #endif
             if (handle->device != nullptr)
             {
                 DeviceHandle*       device      = handle->device;
                 const std::uint32_t device_prev = device->ref_count.fetch_sub(1, std::memory_order_acq_rel);
-                if (device_prev == 1)
+                if (device_prev == 0)
+                {
+                    device->ref_count.fetch_add(1, std::memory_order_relaxed);
+                }
+                else if (device_prev == 1)
                 {
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
                     device->adapter.Reset();
                     device->d3d12Device.Reset();
                     device->directQueue.Reset();
                     device->copyQueue.Reset();
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-                    if (device->metalDevice != nullptr)
-                    {
-                        rive_metal_device_release(device->metalDevice);
-                        device->metalDevice = nullptr;
-                    }
 #endif
                     delete device;
                 }
             }
-
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-            ReleaseD3D12Context(handle);
-#else
-            handle->renderContext.reset();
-            handle->cpuRenderTarget.reset();
-            handle->cpuFramebuffer.clear();
-            handle->cpuFrameRecording  = false;
-            handle->commandListsClosed = false;
-#endif
-            handle->surface = nullptr;
             delete handle;
         }
 
@@ -1824,1136 +7287,1276 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_get_size(rive_renderer_context_t context, std::uint32_t* out_width,
-                                                          std::uint32_t* out_height)
+    rive_renderer_status_t rive_renderer_fence_get_completed_value(rive_renderer_fence_t fence,
+                                                                   std::uint64_t* out_value)
     {
-        if (out_width == nullptr || out_height == nullptr)
+        if (out_value == nullptr)
         {
-            SetLastError("size output pointers are null");
+            SetLastError("completed value pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        auto* handle = ToContext(context);
+        auto* handle = ToFence(fence);
         if (handle == nullptr)
         {
-            SetLastError("context handle is null");
+            SetLastError("fence handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        *out_width  = handle->width;
-        *out_height = handle->height;
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (handle->fence)
+        {
+            *out_value = handle->fence->GetCompletedValue();
+            ClearLastError();
+            return rive_renderer_status_t::ok;
+        }
+#endif
+
+        std::lock_guard<std::mutex> lock(handle->mutex);
+        PollCpuFence(handle, 0);
+        *out_value = handle->completedValue;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_resize(rive_renderer_context_t context, std::uint32_t width,
-                                                        std::uint32_t height)
+    rive_renderer_status_t rive_renderer_fence_wait(rive_renderer_fence_t fence, std::uint64_t value,
+                                                    std::uint64_t timeout_ms)
     {
-        auto* handle = ToContext(context);
+        auto* handle = ToFence(fence);
         if (handle == nullptr)
         {
-            SetLastError("context handle is null");
+            SetLastError("fence handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ValidateContextSize(width, height))
+#if defined(_WIN32) && !defined(RIVE_UNREAL)
+        if (handle->fence)
         {
-            SetLastError("context dimensions must be non-zero");
-            return rive_renderer_status_t::invalid_parameter;
+            return WaitForD3D12FenceHandle(handle, value, timeout_ms);
         }
+#endif
 
-        handle->width  = width;
-        handle->height = height;
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        // Frames still on the GPU are polled every millisecond, so the wait finishes even if the thread driving
+        // their context has stopped. Other signals come from contexts at submit and wake the waiter.
+        constexpr auto kPollInterval = std::chrono::milliseconds(1);
+        const bool     forever       = timeout_ms == std::numeric_limits<std::uint64_t>::max();
+        const auto     timeout       = std::min<std::uint64_t>(timeout_ms, std::numeric_limits<std::int32_t>::max());
+        const auto     deadline      = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+        std::unique_lock<std::mutex> lock(handle->mutex);
+        while (!PollCpuFence(handle, value))
         {
-            handle->cpuFramebuffer.assign(static_cast<size_t>(width) * height * 4, 0);
+            const auto now = std::chrono::steady_clock::now();
+            if (!forever && now >= deadline)
+            {
+                SetLastError("fence wait timed out");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            if (handle->pendingFrames.empty())
+            {
+                if (forever)
+                {
+                    handle->signaled.wait(lock);
+                }
+                else
+                {
+                    handle->signaled.wait_until(lock, deadline);
+                }
+            }
+            else
+            {
+                const auto poll = now + kPollInterval;
+                handle->signaled.wait_until(lock, forever ? poll : std::min(deadline, poll));
+            }
         }
+
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_begin_frame(rive_renderer_context_t              context,
-                                                             const rive_renderer_frame_options_t* options)
+    rive_renderer_status_t rive_renderer_context_signal_fence(rive_renderer_context_t context,
+                                                              rive_renderer_fence_t   fence, std::uint64_t value)
     {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
+        auto* context_handle = ToContext(context);
+        if (context_handle == nullptr)
         {
             SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        std::uint32_t width  = handle->width;
-        std::uint32_t height = handle->height;
-        if (options != nullptr)
+        auto* fence_handle = ToFence(fence);
+        if (fence_handle == nullptr)
         {
-            if (options->width != 0)
-            {
-                width = options->width;
-            }
-            if (options->height != 0)
-            {
-                height = options->height;
-            }
+            SetLastError("fence handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ValidateContextSize(width, height))
+        if (context_handle->device == nullptr || fence_handle->device == nullptr ||
+            context_handle->device != fence_handle->device)
         {
-            SetLastError("context dimensions must be non-zero");
+            SetLastError("fence and context must share the same device");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->width  = width;
-        handle->height = height;
-
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
-        {
-            auto status = rive_metal_context_begin_frame(handle->metalContext, handle->renderContext.get(),
-                                                         &handle->width, &handle->height, options,
-                                                         handle->surface ? handle->surface->metalSurface : nullptr);
-            if (status != rive_renderer_status_t::ok)
-            {
-                return status;
-            }
-
-            handle->hasActiveFrame     = true;
-            handle->commandListsClosed = false;
-            handle->pendingFrameNumber = handle->frameCounter;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
-        }
-#endif
-
 #if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        if (fence_handle->fence)
         {
-            auto status = EnsureD3D12RenderTarget(handle);
-            if (status != rive_renderer_status_t::ok)
-            {
-                return status;
-            }
-
-            HRESULT hr = handle->directAllocator->Reset();
-            if (FAILED(hr))
-            {
-                SetLastError("Reset direct allocator failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            hr = handle->copyAllocator->Reset();
-            if (FAILED(hr))
-            {
-                SetLastError("Reset copy allocator failed");
-                return rive_renderer_status_t::internal_error;
-            }
-
-            hr = handle->directCommandList->Reset(handle->directAllocator.Get(), nullptr);
-            if (FAILED(hr))
-            {
-                SetLastError("Reset direct command list failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            hr = handle->copyCommandList->Reset(handle->copyAllocator.Get(), nullptr);
-            if (FAILED(hr))
-            {
-                SetLastError("Reset copy command list failed");
-                return rive_renderer_status_t::internal_error;
-            }
-
-            rive::gpu::RenderContext::FrameDescriptor descriptor;
-            descriptor.renderTargetWidth     = handle->width;
-            descriptor.renderTargetHeight    = handle->height;
-            descriptor.loadAction            = rive::gpu::LoadAction::clear;
-            descriptor.clearColor            = 0;
-            descriptor.msaaSampleCount       = 0;
-            descriptor.disableRasterOrdering = false;
-
-            handle->renderContext->beginFrame(descriptor);
-            handle->hasActiveFrame     = true;
-            handle->commandListsClosed = false;
-            handle->pendingFrameNumber = handle->frameCounter;
-
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            return SignalD3D12FenceHandle(context_handle, fence_handle, value);
         }
 #endif
 
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        if (!ClaimCpuFenceValue(fence_handle, &value))
         {
-            const size_t required = static_cast<size_t>(handle->width) * handle->height * 4;
-            if (handle->cpuFramebuffer.size() != required)
-            {
-                handle->cpuFramebuffer.assign(required, 0);
-            }
-            else
-            {
-                std::fill(handle->cpuFramebuffer.begin(), handle->cpuFramebuffer.end(), 0);
-            }
-            handle->cpuFrameRecording  = true;
-            handle->commandListsClosed = false;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            SetLastError("fence signal value must be greater than the last signaled value");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        SetLastError("context_begin_frame not implemented for this backend");
-        return rive_renderer_status_t::unimplemented;
+        // Waits for the newest submitted frame; a frame between begin_frame and submit is not included.
+        PollCompletedFrames(context_handle);
+        QueueCpuFenceSignal(context_handle, fence_handle, value, context_handle->frameCounter - 1);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_end_frame(rive_renderer_context_t context)
+    rive_renderer_status_t rive_renderer_context_set_path_interning(rive_renderer_context_t context,
+                                                                    std::uint8_t            enabled)
     {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
             SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        // The table outlives disabling so paths already interned keep resolving while the context lives.
+        if (enabled != 0 && !ctx->pathInterning)
         {
-            if (!handle->hasActiveFrame)
-            {
-                SetLastError("begin_frame must be called before end_frame");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-            auto* impl = GetD3D12Impl(handle);
-            if (impl == nullptr || handle->renderTarget == nullptr)
-            {
-                SetLastError("render context not initialized");
-                return rive_renderer_status_t::internal_error;
-            }
-
-            rive::gpu::RenderContextD3D12Impl::CommandLists cmdLists {handle->copyCommandList.Get(),
-                                                                      handle->directCommandList.Get()};
+            auto table         = std::make_shared<PathInternTable>();
+            table->factory     = GetFactory(ctx);
+            ctx->pathInterning = std::move(table);
+        }
+        ctx->internPaths = enabled != 0;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            rive::gpu::RenderContext::FlushResources resources {};
-            resources.renderTarget          = handle->renderTarget.get();
-            resources.externalCommandBuffer = &cmdLists;
-            resources.currentFrameNumber    = handle->frameCounter;
-            resources.safeFrameNumber       = handle->lastCompletedFrame;
+    rive_renderer_status_t rive_renderer_context_set_damage_tracking(rive_renderer_context_t context,
+                                                                     std::uint8_t            enabled)
+    {
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            handle->renderContext->flush(resources);
+        ctx->damageTracking = enabled != 0;
+        ctx->trackedFrames  = 0;
+        ctx->pendingDamage  = kEmptyRect;
+        ctx->damageHistory.clear();
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            HRESULT hr = handle->copyCommandList->Close();
-            if (FAILED(hr))
-            {
-                SetLastError("copy command list close failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            hr = handle->directCommandList->Close();
-            if (FAILED(hr))
-            {
-                SetLastError("direct command list close failed");
-                return rive_renderer_status_t::internal_error;
-            }
+    rive_renderer_status_t rive_renderer_context_invalidate_rect(rive_renderer_context_t     context,
+                                                                 const rive_renderer_rect_t* rect)
+    {
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            handle->hasActiveFrame     = false;
-            handle->commandListsClosed = true;
+        IncludeRect(&ctx->pendingDamage, rect != nullptr ? *rect : kUnboundedRect);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+    rive_renderer_status_t rive_renderer_context_invalidate_picture(rive_renderer_context_t      context,
+                                                                    rive_renderer_picture_t      picture,
+                                                                    const rive_renderer_mat2d_t* transform)
+    {
+        auto* ctx           = ToContext(context);
+        auto* pictureHandle = ToPicture(picture);
+        if (ctx == nullptr || pictureHandle == nullptr)
+        {
+            SetLastError("context/picture handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
-#else
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
+
+        if (pictureHandle->context != ctx)
         {
-            if (!handle->hasActiveFrame)
-            {
-                SetLastError("begin_frame must be called before end_frame");
-                return rive_renderer_status_t::invalid_parameter;
-            }
+            SetLastError("picture belongs to a different context");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-            auto status = rive_metal_context_end_frame(handle->metalContext, handle->renderContext.get(),
-                                                       handle->surface ? handle->surface->metalSurface : nullptr);
-            if (status != rive_renderer_status_t::ok)
-            {
-                return status;
-            }
+        IncludeRect(&ctx->pendingDamage, TransformRect(ToMat2D(transform), PictureBounds(pictureHandle)));
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            handle->hasActiveFrame     = false;
-            handle->commandListsClosed = true;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+    rive_renderer_status_t rive_renderer_context_invalidate_picture_changes(rive_renderer_context_t      context,
+                                                                            rive_renderer_picture_t      previous,
+                                                                            rive_renderer_picture_t      next,
+                                                                            const rive_renderer_mat2d_t* transform)
+    {
+        auto* ctx            = ToContext(context);
+        auto* previousHandle = ToPicture(previous);
+        auto* nextHandle     = ToPicture(next);
+        if (ctx == nullptr || previousHandle == nullptr || nextHandle == nullptr)
+        {
+            SetLastError("context/picture handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
-#endif
-#endif
 
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        if (previousHandle->context != ctx || nextHandle->context != ctx)
         {
-            if (!handle->cpuFrameRecording)
-            {
-                SetLastError("begin_frame must be called before end_frame");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-            handle->cpuFrameRecording  = false;
-            handle->commandListsClosed = true;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            SetLastError("picture belongs to a different context");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        SetLastError("context_end_frame not implemented for this backend");
-        return rive_renderer_status_t::unimplemented;
+        const rive_renderer_rect_t changes = PictureChanges(previousHandle, nextHandle);
+        IncludeRect(&ctx->pendingDamage, TransformRect(ToMat2D(transform), changes));
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_submit(rive_renderer_context_t context)
+    rive_renderer_status_t rive_renderer_context_get_frame_damage(rive_renderer_context_t context,
+                                                                  rive_renderer_rect_t*   out_rect)
     {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
+        if (out_rect == nullptr)
         {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("rect output pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::d3d12)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
-            if (!handle->commandListsClosed)
-            {
-                SetLastError("end_frame must be called before submit");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-
-            auto* device = handle->device;
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            ID3D12CommandList* copyLists[] = {handle->copyCommandList.Get()};
-            device->copyQueue->ExecuteCommandLists(1, copyLists);
+        *out_rect = ctx->frameDamage;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            handle->fenceValue += 1;
-            HRESULT hr = device->copyQueue->Signal(handle->copyFence.Get(), handle->fenceValue);
-            if (FAILED(hr))
-            {
-                SetLastError("copy queue signal failed");
-                return rive_renderer_status_t::internal_error;
-            }
+    rive_renderer_status_t rive_renderer_path_create(rive_renderer_context_t   context,
+                                                     rive_renderer_fill_rule_t fill_rule,
+                                                     rive_renderer_path_t*     out_path)
+    {
+        if (out_path == nullptr)
+        {
+            SetLastError("path output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
 
-            hr = device->directQueue->Wait(handle->copyFence.Get(), handle->fenceValue);
-            if (FAILED(hr))
-            {
-                SetLastError("direct queue wait failed");
-                return rive_renderer_status_t::internal_error;
-            }
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
+        {
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            ID3D12CommandList* directLists[] = {handle->directCommandList.Get()};
-            device->directQueue->ExecuteCommandLists(1, directLists);
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
+        {
+            SetLastError("render context unavailable");
+            return rive_renderer_status_t::unsupported;
+        }
 
-            hr = device->directQueue->Signal(handle->directFence.Get(), handle->fenceValue);
-            if (FAILED(hr))
-            {
-                SetLastError("direct queue signal failed");
-                return rive_renderer_status_t::internal_error;
-            }
+        rive::FillRule rule;
+        if (!ConvertFillRule(fill_rule, &rule))
+        {
+            SetLastError("invalid fill rule");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-            hr = handle->copyFence->SetEventOnCompletion(handle->fenceValue, handle->fenceEvent);
-            if (FAILED(hr))
+        rive::rcp<rive::RenderPath> path;
+        if (!ctx->internPaths)
+        {
+            path = factory->makeEmptyRenderPath();
+            if (!path)
             {
-                SetLastError("copy fence wait failed");
+                SetLastError("makeRenderPath failed");
                 return rive_renderer_status_t::internal_error;
             }
-            WaitForSingleObject(handle->fenceEvent, INFINITE);
+            path->fillRule(rule);
+        }
 
-            hr = handle->directFence->SetEventOnCompletion(handle->fenceValue, handle->fenceEvent);
-            if (FAILED(hr))
-            {
-                SetLastError("direct fence wait failed");
-                return rive_renderer_status_t::internal_error;
-            }
-            WaitForSingleObject(handle->fenceEvent, INFINITE);
+        auto* handle = new (std::nothrow) PathHandle();
+        if (handle == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
 
-            handle->lastCompletedFrame = handle->frameCounter;
-            handle->frameCounter += 1;
-            handle->pendingFrameNumber = 0;
-            handle->commandListsClosed = false;
+        handle->path      = std::move(path);
+        handle->interning = ctx->internPaths ? ctx->pathInterning : nullptr;
+        handle->fillRule  = rule;
+        out_path->handle  = handle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            handle->copyAllocator->Reset();
-            handle->directAllocator->Reset();
-            handle->copyCommandList->Reset(handle->copyAllocator.Get(), nullptr);
-            handle->directCommandList->Reset(handle->directAllocator.Get(), nullptr);
+    rive_renderer_status_t rive_renderer_path_retain(rive_renderer_path_t path)
+    {
+        auto* handle = ToPath(path);
+        if (handle == nullptr)
+        {
+            SetLastError("path handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            handle->copyCommandList->Close();
-            handle->directCommandList->Close();
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+    rive_renderer_status_t rive_renderer_path_release(rive_renderer_path_t path)
+    {
+        auto* handle = ToPath(path);
+        if (handle == nullptr)
+        {
+            SetLastError("path handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
-#endif
 
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::metal)
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
         {
-            if (!handle->commandListsClosed)
-            {
-                SetLastError("end_frame must be called before submit");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-
-            auto status = rive_metal_context_submit(handle->metalContext, handle->surface != nullptr);
-            if (status != rive_renderer_status_t::ok)
-            {
-                return status;
-            }
-
-            handle->pendingFrameNumber = 0;
-
-            if (handle->surface == nullptr)
-            {
-                handle->lastCompletedFrame = handle->frameCounter;
-                handle->frameCounter += 1;
-            }
-
-            handle->commandListsClosed = false;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            SetLastError("path handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
         }
-#endif
 
-        if (handle->device != nullptr && handle->device->backend == rive_renderer_backend_t::null)
+        if (previous == 1)
         {
-            if (!handle->commandListsClosed)
+            if (handle->interning)
             {
-                SetLastError("end_frame must be called before submit");
-                return rive_renderer_status_t::invalid_parameter;
+                std::lock_guard<std::mutex> lock(handle->interning->mutex);
+                LeaveInternEntry(*handle->interning, handle);
             }
-            handle->lastCompletedFrame = handle->frameCounter;
-            handle->frameCounter += 1;
-            handle->commandListsClosed = false;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            delete handle;
         }
 
-        SetLastError("context_submit not implemented for this backend");
-        return rive_renderer_status_t::unimplemented;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_create_d3d12_hwnd(
-        rive_renderer_device_t device, rive_renderer_context_t context,
-        const rive_renderer_surface_create_info_d3d12_hwnd_t* info, rive_renderer_surface_t* out_surface)
+    rive_renderer_status_t rive_renderer_path_rewind(rive_renderer_path_t path)
     {
-        if (out_surface == nullptr)
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
         {
-            SetLastError("surface output pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        out_surface->handle = nullptr;
-
-        if (info == nullptr)
+        if (rive::RawPath* rawPath = EditInternedPath(handle))
         {
-            SetLastError("surface create info is null");
-            return rive_renderer_status_t::null_pointer;
+            rawPath->rewind();
         }
+        else
+        {
+            handle->path->rewind();
+        }
+        handle->bounds = kEmptyRect;
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        auto* device_handle  = ToDevice(device);
-        auto* context_handle = ToContext(context);
-        if (device_handle == nullptr || context_handle == nullptr)
+    rive_renderer_status_t rive_renderer_path_set_fill_rule(rive_renderer_path_t      path,
+                                                            rive_renderer_fill_rule_t fill_rule)
+    {
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
         {
-            SetLastError("device or context handle is invalid");
+            SetLastError("path handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (device_handle->backend == rive_renderer_backend_t::d3d12 &&
-            context_handle->device == device_handle)
+        rive::FillRule rule;
+        if (!ConvertFillRule(fill_rule, &rule))
         {
-            if (info->hwnd == nullptr)
-            {
-                SetLastError("HWND pointer is null");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-
-            if (context_handle->surface != nullptr)
-            {
-                SetLastError("context already has an attached surface");
-                return rive_renderer_status_t::invalid_parameter;
-            }
-
-            std::uint32_t width  = info->width != 0 ? info->width : context_handle->width;
-            std::uint32_t height = info->height != 0 ? info->height : context_handle->height;
-            if (!ValidateContextSize(width, height))
-            {
-                SetLastError("surface dimensions must be non-zero");
-                return rive_renderer_status_t::invalid_parameter;
-            }
+            SetLastError("invalid fill rule");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-            std::uint32_t bufferCount = info->buffer_count != 0 ? info->buffer_count : 2;
-            if (bufferCount < 2)
-            {
-                bufferCount = 2;
-            }
+        if (EditInternedPath(handle) != nullptr)
+        {
+            handle->fillRule = rule;
+        }
+        else
+        {
+            handle->path->fillRule(rule);
+        }
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            Microsoft::WRL::ComPtr<IDXGIFactory4> factory4;
-            HRESULT hr = CreateDXGIFactory2(0, IID_PPV_ARGS(&factory4));
-            if (FAILED(hr))
-            {
-                SetLastError("CreateDXGIFactory2 failed");
-                return rive_renderer_status_t::internal_error;
-            }
+    rive_renderer_status_t rive_renderer_path_move_to(rive_renderer_path_t path, float x, float y)
+    {
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
+        {
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            DXGI_SWAP_CHAIN_DESC1 desc {};
-            desc.Width       = width;
-            desc.Height      = height;
-            desc.Format      = DXGI_FORMAT_R8G8B8A8_UNORM;
-            desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-            desc.SwapEffect  = DXGI_SWAP_EFFECT_FLIP_DISCARD;
-            desc.SampleDesc.Count   = 1;
-            desc.SampleDesc.Quality = 0;
-            desc.Scaling            = DXGI_SCALING_NONE;
-            desc.BufferCount        = bufferCount;
-            desc.AlphaMode          = DXGI_ALPHA_MODE_IGNORE;
+        if (rive::RawPath* rawPath = EditInternedPath(handle))
+        {
+            rawPath->moveTo(x, y);
+        }
+        else
+        {
+            handle->path->moveTo(x, y);
+        }
+        IncludePoint(&handle->bounds, x, y);
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            bool allowTearing = false;
-            if ((static_cast<std::uint32_t>(info->flags) &
-                 static_cast<std::uint32_t>(rive_renderer_surface_flags_t::allow_tearing)) != 0)
-            {
-                allowTearing = CheckTearingSupport();
-                if (allowTearing)
-                {
-                    desc.Flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
-                }
-            }
+    rive_renderer_status_t rive_renderer_path_line_to(rive_renderer_path_t path, float x, float y)
+    {
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
+        {
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            Microsoft::WRL::ComPtr<IDXGISwapChain1> swapChain1;
-            hr = factory4->CreateSwapChainForHwnd(device_handle->directQueue.Get(),
-                                                  static_cast<HWND>(info->hwnd), &desc, nullptr, nullptr,
-                                                  &swapChain1);
-            if (FAILED(hr))
-            {
-                SetLastError("CreateSwapChainForHwnd failed");
-                return rive_renderer_status_t::internal_error;
-            }
+        if (rive::RawPath* rawPath = EditInternedPath(handle))
+        {
+            rawPath->lineTo(x, y);
+        }
+        else
+        {
+            handle->path->lineTo(x, y);
+        }
+        IncludePoint(&handle->bounds, x, y);
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            factory4->MakeWindowAssociation(static_cast<HWND>(info->hwnd), DXGI_MWA_NO_ALT_ENTER);
+    rive_renderer_status_t rive_renderer_path_cubic_to(rive_renderer_path_t path, float ox, float oy, float ix,
+                                                       float iy, float x, float y)
+    {
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
+        {
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            Microsoft::WRL::ComPtr<IDXGISwapChain3> swapChain3;
-            hr = swapChain1.As(&swapChain3);
-            if (FAILED(hr))
-            {
-                SetLastError("IDXGISwapChain3 query failed");
-                return rive_renderer_status_t::internal_error;
-            }
+        if (rive::RawPath* rawPath = EditInternedPath(handle))
+        {
+            rawPath->cubicTo(ox, oy, ix, iy, x, y);
+        }
+        else
+        {
+            handle->path->cubicTo(ox, oy, ix, iy, x, y);
+        }
+        IncludePoint(&handle->bounds, ox, oy);
+        IncludePoint(&handle->bounds, ix, iy);
+        IncludePoint(&handle->bounds, x, y);
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            auto* surface = new (std::nothrow) SurfaceHandle();
-            if (surface == nullptr)
-            {
-                SetLastError("allocation failed");
-                return rive_renderer_status_t::out_of_memory;
-            }
+    rive_renderer_status_t rive_renderer_path_close(rive_renderer_path_t path)
+    {
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
+        {
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            surface->backend          = rive_renderer_backend_t::d3d12;
-            surface->device           = device_handle;
-            surface->context          = context_handle;
-            surface->width            = width;
-            surface->height           = height;
-            surface->buffer_count     = bufferCount;
-            surface->flags            = info->flags;
-            surface->present_interval = info->present_interval != 0 ? info->present_interval : 1;
-            surface->hwnd             = info->hwnd;
-            surface->swapChain        = swapChain3;
-            surface->supportsTearing  = allowTearing;
+        if (rive::RawPath* rawPath = EditInternedPath(handle))
+        {
+            rawPath->close();
+        }
+        else
+        {
+            handle->path->close();
+        }
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-            context_handle->renderTarget.reset();
-            context_handle->renderTargetTexture.Reset();
+    rive_renderer_status_t rive_renderer_path_add_path(rive_renderer_path_t destination, rive_renderer_path_t source,
+                                                       const rive_renderer_mat2d_t* transform)
+    {
+        auto* dstHandle = ToPath(destination);
+        auto* srcHandle = ToPath(source);
+        if (!IsValidPath(dstHandle) || !IsValidPath(srcHandle))
+        {
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-            rive_renderer_status_t targetsStatus = CreateSurfaceRenderTargets(surface, width, height);
-            if (targetsStatus != rive_renderer_status_t::ok)
+        rive::Mat2D mat = ToMat2D(transform);
+        if (srcHandle->interning)
+        {
+            if (rive::RawPath* rawPath = EditInternedPath(dstHandle))
             {
-                delete surface;
-                return targetsStatus;
+                rawPath->addPath(srcHandle->rawPath, &mat);
             }
-
-            rive_renderer_status_t retainDeviceStatus = rive_renderer_device_retain(device);
-            if (retainDeviceStatus != rive_renderer_status_t::ok)
+            else
             {
-                delete surface;
-                return retainDeviceStatus;
+                dstHandle->path->addRawPath(srcHandle->rawPath.transform(mat));
             }
-
-            rive_renderer_status_t retainContextStatus = rive_renderer_context_retain(context);
-            if (retainContextStatus != rive_renderer_status_t::ok)
+        }
+        else
+        {
+            // Plain render paths cannot be read back, so an interned destination takes a render path of its own.
+            if (dstHandle->interning && !DetachInternedPath(dstHandle))
             {
-                rive_renderer_device_release(device);
-                delete surface;
-                return retainContextStatus;
+                SetLastError("makeRenderPath failed");
+                return rive_renderer_status_t::internal_error;
             }
-
-            context_handle->surface = surface;
-            context_handle->width   = width;
-            context_handle->height  = height;
-
-            out_surface->handle = surface;
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            dstHandle->path->addPath(srcHandle->path.get(), mat);
         }
-        SetLastError("surface creation not supported for this backend");
-        return rive_renderer_status_t::unsupported;
-#else
-        (void)info;
-        SetLastError("surface creation not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
+        IncludeRect(&dstHandle->bounds, TransformRect(mat, srcHandle->bounds));
+        ++dstHandle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_create_metal_layer(
-        rive_renderer_device_t device, rive_renderer_context_t context,
-        const rive_renderer_surface_create_info_metal_layer_t* info, rive_renderer_surface_t* out_surface)
+    rive_renderer_status_t rive_renderer_path_append_commands(rive_renderer_path_t path, const std::uint8_t* verbs,
+                                                              std::size_t verb_count, const float* points,
+                                                              std::size_t point_count)
     {
-        (void)device;
-        (void)context;
-        (void)info;
-        if (out_surface != nullptr)
+        auto* handle = ToPath(path);
+        if (!IsValidPath(handle))
         {
-            out_surface->handle = nullptr;
+            SetLastError("path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
-#if defined(__APPLE__) && !defined(RIVE_UNREAL)
-        auto* device_handle  = ToDevice(device);
-        auto* context_handle = ToContext(context);
-        if (device_handle == nullptr || context_handle == nullptr)
+
+        if ((verbs == nullptr && verb_count != 0) || (points == nullptr && point_count != 0))
         {
-            SetLastError("device or context handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("path command arrays must not be null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        if (device_handle->backend != rive_renderer_backend_t::metal ||
-            context_handle->device != device_handle)
+        // Decode into a reused scratch path first so a bad verb leaves the path untouched.
+        thread_local rive::RawPath rawPath;
+        rawPath.rewind();
+        if (const char* error = DecodePathCommands(verbs, verb_count, points, point_count, &rawPath))
         {
-            SetLastError("surface creation not supported for this backend");
-            return rive_renderer_status_t::unsupported;
+            SetLastError(error);
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (info == nullptr)
+        if (rive::RawPath* interned = EditInternedPath(handle))
         {
-            SetLastError("surface create info is null");
+            interned->addPath(rawPath);
+        }
+        else
+        {
+            handle->path->addRawPath(rawPath);
+        }
+        for (std::size_t i = 0; i < point_count; ++i)
+        {
+            IncludePoint(&handle->bounds, points[i * 2], points[i * 2 + 1]);
+        }
+        ++handle->version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_immutable_path_create(rive_renderer_device_t    device,
+                                                               rive_renderer_fill_rule_t fill_rule,
+                                                               const std::uint8_t* verbs, std::size_t verb_count,
+                                                               const float* points, std::size_t point_count,
+                                                               rive_renderer_immutable_path_t* out_path)
+    {
+        if (out_path == nullptr)
+        {
+            SetLastError("immutable path output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
+        out_path->handle = nullptr;
 
-        if (context_handle->surface != nullptr)
+        auto* deviceHandle = ToDevice(device);
+        if (deviceHandle == nullptr)
         {
-            SetLastError("context already has an attached surface");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("device handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        if (info->layer == nullptr)
+        if ((verbs == nullptr && verb_count != 0) || (points == nullptr && point_count != 0))
         {
-            SetLastError("CAMetalLayer pointer is null");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("path command arrays must not be null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        std::uint32_t width  = info->width != 0 ? info->width : context_handle->width;
-        std::uint32_t height = info->height != 0 ? info->height : context_handle->height;
-        if (!ValidateContextSize(width, height))
+        rive::FillRule rule;
+        if (!ConvertFillRule(fill_rule, &rule))
         {
-            SetLastError("surface dimensions must be non-zero");
+            SetLastError("invalid fill rule");
             return rive_renderer_status_t::invalid_parameter;
-            }
+        }
 
-        auto* surface = new (std::nothrow) SurfaceHandle();
-        if (surface == nullptr)
+        auto* handle = new (std::nothrow) ImmutablePathHandle();
+        if (handle == nullptr)
         {
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        surface->backend          = rive_renderer_backend_t::metal;
-        surface->device           = device_handle;
-        surface->context          = context_handle;
-        surface->width            = width;
-        surface->height           = height;
-        surface->buffer_count     = 1;
-        surface->flags            = info->flags;
-        surface->present_interval = 1;
+        if (const char* error = DecodePathCommands(verbs, verb_count, points, point_count, &handle->rawPath))
+        {
+            delete handle;
+            SetLastError(error);
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-        rive_renderer_surface_create_info_metal_layer_t adjustedInfo = *info;
-        adjustedInfo.width  = width;
-        adjustedInfo.height = height;
+        deviceHandle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        handle->device   = deviceHandle;
+        handle->fillRule = rule;
+        handle->bounds   = ComputeTightBounds(verbs, verb_count, points);
+        handle->hash =
+            HashPathCommands(static_cast<std::uint8_t>(fill_rule), verbs, verb_count, points, point_count);
+        out_path->handle = handle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        void* metalSurface = nullptr;
-        rive_renderer_status_t status = rive_metal_surface_create(device_handle->metalDevice, context_handle->metalContext,
-                                                                  &adjustedInfo, &metalSurface);
-        if (status != rive_renderer_status_t::ok)
+    rive_renderer_status_t rive_renderer_immutable_path_retain(rive_renderer_immutable_path_t path)
+    {
+        auto* handle = ToImmutablePath(path);
+        if (handle == nullptr)
         {
-            delete surface;
-            if (g_lastError.empty())
-            {
-                SetLastError("Metal surface creation failed");
-            }
-            return status;
+            SetLastError("immutable path handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        surface->metalSurface = metalSurface;
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        rive_renderer_status_t retainDeviceStatus = rive_renderer_device_retain(device);
-        if (retainDeviceStatus != rive_renderer_status_t::ok)
+    rive_renderer_status_t rive_renderer_immutable_path_release(rive_renderer_immutable_path_t path)
+    {
+        auto* handle = ToImmutablePath(path);
+        if (handle == nullptr)
         {
-            rive_metal_surface_destroy(surface->metalSurface);
-            delete surface;
-            return retainDeviceStatus;
+            SetLastError("immutable path handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        rive_renderer_status_t retainContextStatus = rive_renderer_context_retain(context);
-        if (retainContextStatus != rive_renderer_status_t::ok)
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            SetLastError("immutable path handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
         {
+            rive_renderer_device_t device {};
+            device.handle = handle->device;
+            delete handle;
             rive_renderer_device_release(device);
-            rive_metal_surface_destroy(surface->metalSurface);
-            delete surface;
-            return retainContextStatus;
         }
 
-        context_handle->surface = surface;
-        context_handle->width   = width;
-        context_handle->height  = height;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        out_surface->handle = surface;
+    rive_renderer_status_t rive_renderer_immutable_path_get_bounds(rive_renderer_immutable_path_t path,
+                                                                   rive_renderer_rect_t*          out_bounds)
+    {
+        if (out_bounds == nullptr)
+        {
+            SetLastError("bounds output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToImmutablePath(path);
+        if (handle == nullptr)
+        {
+            SetLastError("immutable path handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        *out_bounds = handle->bounds;
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        SetLastError("Metal surface creation not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_surface_create_vulkan(
-        rive_renderer_device_t device,
-        rive_renderer_context_t context,
-        const rive_renderer_surface_create_info_vulkan_t* info,
-        rive_renderer_surface_t* out_surface)
+    rive_renderer_status_t rive_renderer_immutable_path_get_hash(rive_renderer_immutable_path_t path,
+                                                                 std::uint64_t*                 out_hash)
     {
-        if (out_surface == nullptr)
+        if (out_hash == nullptr)
         {
-            SetLastError("surface output pointer is null");
+            SetLastError("hash output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        out_surface->handle = nullptr;
+        auto* handle = ToImmutablePath(path);
+        if (handle == nullptr)
+        {
+            SetLastError("immutable path handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
-        if (info == nullptr)
+        *out_hash = handle->hash;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_create(rive_renderer_context_t context, rive_renderer_paint_t* out_paint)
+    {
+        if (out_paint == nullptr)
         {
-            SetLastError("surface create info is null");
+            SetLastError("paint output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        auto* device_handle  = ToDevice(device);
-        auto* context_handle = ToContext(context);
-        if (device_handle == nullptr || context_handle == nullptr)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
-            SetLastError("device or context handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(RIVE_RENDERER_FFI_HAS_VULKAN)
-        if (device_handle->backend != rive_renderer_backend_t::vulkan ||
-            context_handle->device != device_handle)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
-            SetLastError("surface creation not supported for this backend");
+            SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
         }
 
-        SetLastError("Vulkan surface creation not yet implemented");
-        return rive_renderer_status_t::unimplemented;
-#else
-        (void)device;
-        (void)context;
-        (void)info;
-        SetLastError("Vulkan backend is not available in this build");
-        return rive_renderer_status_t::unsupported;
-#endif
+        rive::rcp<rive::RenderPaint> paint = factory->makeRenderPaint();
+        if (!paint)
+        {
+            SetLastError("makeRenderPaint failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        auto* handle = new (std::nothrow) PaintHandle();
+        if (handle == nullptr)
+        {
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
+        }
+
+        handle->paint     = std::move(paint);
+        out_paint->handle = handle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_retain(rive_renderer_surface_t surface)
+    rive_renderer_status_t rive_renderer_paint_retain(rive_renderer_paint_t paint)
     {
-        auto* handle = ToSurface(surface);
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr)
+        {
+            SetLastError("paint handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_release(rive_renderer_paint_t paint)
+    {
+        auto* handle = ToPaint(paint);
         if (handle == nullptr)
         {
-            SetLastError("surface handle is null");
+            SetLastError("paint handle is null");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
+        {
+            SetLastError("paint handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        if (previous == 1)
+        {
+            delete handle;
+        }
+
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_set_style(rive_renderer_paint_t paint, rive_renderer_paint_style_t style)
+    {
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
+        {
+            SetLastError("paint handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        rive::RenderPaintStyle cppStyle;
+        if (!ConvertPaintStyle(style, &cppStyle))
+        {
+            SetLastError("invalid paint style");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        handle->paint->style(cppStyle);
+        handle->state.style = cppStyle;
+        ++handle->state.version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_set_color(rive_renderer_paint_t paint, rive_renderer_color_t color)
+    {
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
+        {
+            SetLastError("paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        handle->paint->color(static_cast<rive::ColorInt>(color));
+        handle->state.color = static_cast<rive::ColorInt>(color);
+        ++handle->state.version;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_release(rive_renderer_surface_t surface)
+    rive_renderer_status_t rive_renderer_paint_set_thickness(rive_renderer_paint_t paint, float thickness)
     {
-        auto* handle = ToSurface(surface);
-        if (handle == nullptr)
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
         {
-            SetLastError("surface handle is null");
+            SetLastError("paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
-        if (previous == 0)
+        handle->paint->thickness(thickness);
+        handle->state.thickness = thickness;
+        ++handle->state.version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_set_join(rive_renderer_paint_t paint, rive_renderer_stroke_join_t join)
+    {
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
         {
-            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-            SetLastError("surface handle refcount underflow");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("paint handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        if (previous == 1)
+        rive::StrokeJoin cppJoin;
+        if (!ConvertStrokeJoin(join, &cppJoin))
         {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-            if (handle->context != nullptr)
-            {
-                ReturnSurfaceRenderTarget(handle->context);
-                if (handle->context->surface == handle)
-                {
-                    handle->context->surface = nullptr;
-                }
-            }
-            handle->renderTargets.clear();
-            handle->backBuffers.clear();
-            handle->swapChain.Reset();
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-            if (handle->metalSurface != nullptr)
-            {
-                rive_metal_surface_destroy(handle->metalSurface);
-                handle->metalSurface = nullptr;
-            }
-            if (handle->context != nullptr && handle->context->surface == handle)
-            {
-                handle->context->surface = nullptr;
-            }
-#endif
-            if (handle->context != nullptr)
-            {
-                rive_renderer_context_t ctx {};
-                ctx.handle = handle->context;
-                rive_renderer_context_release(ctx);
-            }
-            if (handle->device != nullptr)
-            {
-                rive_renderer_device_t dev {};
-                dev.handle = handle->device;
-                rive_renderer_device_release(dev);
-            }
-            handle->context = nullptr;
-            handle->device  = nullptr;
-            delete handle;
+            SetLastError("invalid stroke join");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
+        handle->paint->join(cppJoin);
+        handle->state.join = cppJoin;
+        ++handle->state.version;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_get_size(rive_renderer_surface_t surface, std::uint32_t* out_width,
-                                                          std::uint32_t* out_height)
+    rive_renderer_status_t rive_renderer_paint_set_cap(rive_renderer_paint_t paint, rive_renderer_stroke_cap_t cap)
     {
-        if (out_width == nullptr || out_height == nullptr)
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
         {
-            SetLastError("surface size output pointers are null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("paint handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        auto* handle = ToSurface(surface);
-        if (handle == nullptr)
+        rive::StrokeCap cppCap;
+        if (!ConvertStrokeCap(cap, &cppCap))
         {
-            SetLastError("surface handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("invalid stroke cap");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        *out_width  = handle->width;
-        *out_height = handle->height;
+        handle->paint->cap(cppCap);
+        handle->state.cap = cppCap;
+        ++handle->state.version;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_surface_resize(rive_renderer_surface_t surface, std::uint32_t width,
-                                                        std::uint32_t height)
+    rive_renderer_status_t rive_renderer_paint_set_feather(rive_renderer_paint_t paint, float feather)
     {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        auto* handle = ToSurface(surface);
-        if (handle == nullptr)
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
         {
-            SetLastError("surface handle is null");
+            SetLastError("paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (handle->backend != rive_renderer_backend_t::d3d12)
+        handle->paint->feather(feather);
+        handle->state.feather = feather;
+        ++handle->state.version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_paint_set_blend_mode(rive_renderer_paint_t      paint,
+                                                              rive_renderer_blend_mode_t blend_mode)
+    {
+        auto* handle = ToPaint(paint);
+        if (handle == nullptr || !handle->paint)
         {
-            SetLastError("surface resize not supported for this backend");
-            return rive_renderer_status_t::unsupported;
+            SetLastError("paint handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ValidateContextSize(width, height))
+        rive::BlendMode cppBlend;
+        if (!ConvertBlendMode(blend_mode, &cppBlend))
         {
-            SetLastError("surface dimensions must be non-zero");
+            SetLastError("invalid blend mode");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (handle->swapChain == nullptr || handle->context == nullptr)
+        handle->paint->blendMode(cppBlend);
+        handle->state.blendMode = cppBlend;
+        ++handle->state.version;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_create(rive_renderer_context_t   context,
+                                                         rive_renderer_renderer_t* out_renderer)
+    {
+        if (out_renderer == nullptr)
         {
-            SetLastError("surface not initialized");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("renderer output pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        auto* context = handle->context;
-        if (context->hasActiveFrame)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
-            SetLastError("cannot resize while a frame is active");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        ReturnSurfaceRenderTarget(context);
-        context->renderTarget.reset();
-        context->renderTargetTexture.Reset();
-
-        handle->renderTargets.clear();
-        handle->backBuffers.clear();
-
-        UINT resizeFlags = handle->supportsTearing ? DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING : 0;
-        HRESULT hr = handle->swapChain->ResizeBuffers(handle->buffer_count, width, height, DXGI_FORMAT_R8G8B8A8_UNORM,
-                                                      resizeFlags);
-        if (FAILED(hr))
+        if (!ctx->renderContext && !ctx->cpuContext)
         {
-            SetLastError("swapchain resize failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("render context unavailable");
+            return rive_renderer_status_t::unsupported;
+        }
+        std::unique_ptr<rive::Renderer> renderer = MakeContextRenderer(ctx);
+        if (!renderer)
+        {
+            SetLastError("renderer allocation failed");
+            return rive_renderer_status_t::out_of_memory;
         }
 
-        rive_renderer_status_t targetsStatus = CreateSurfaceRenderTargets(handle, width, height);
-        if (targetsStatus != rive_renderer_status_t::ok)
+        auto* handle = new (std::nothrow) RendererHandle();
+        if (handle == nullptr)
         {
-            return targetsStatus;
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
         }
 
-        handle->width  = width;
-        handle->height = height;
-        context->width  = width;
-        context->height = height;
+        handle->context  = ctx;
+        handle->renderer = std::move(renderer);
+        {
+            std::lock_guard<std::mutex> lock(ctx->renderersMutex);
+            ClipRendererToDamage(ctx, handle);
+            ctx->renderers.push_back(handle);
+        }
+        ctx->ref_count.fetch_add(1, std::memory_order_relaxed);
 
+        out_renderer->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-        auto* handle = ToSurface(surface);
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_retain(rive_renderer_renderer_t renderer)
+    {
+        auto* handle = ToRenderer(renderer);
         if (handle == nullptr)
         {
-            SetLastError("surface handle is null");
+            SetLastError("renderer handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (handle->backend != rive_renderer_backend_t::metal)
-        {
-            SetLastError("surface resize not supported for this backend");
-            return rive_renderer_status_t::unsupported;
-        }
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        if (!ValidateContextSize(width, height))
+    rive_renderer_status_t rive_renderer_renderer_release(rive_renderer_renderer_t renderer)
+    {
+        auto* handle = ToRenderer(renderer);
+        if (handle == nullptr)
         {
-            SetLastError("surface dimensions must be non-zero");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("renderer handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        if (handle->metalSurface == nullptr || handle->context == nullptr)
+        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+        if (previous == 0)
         {
-            SetLastError("surface not initialized");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("renderer handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
         }
 
-        auto* context = handle->context;
-        if (context->hasActiveFrame)
+        if (previous == 1)
         {
-            SetLastError("cannot resize while a frame is active");
-            return rive_renderer_status_t::invalid_parameter;
+            if (ContextHandle* context = handle->context)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(context->renderersMutex);
+                    auto& renderers = context->renderers;
+                    renderers.erase(std::remove(renderers.begin(), renderers.end(), handle), renderers.end());
+                }
+                delete handle;
+                return rive_renderer_context_release({context});
+            }
+            delete handle;
         }
 
-        rive_renderer_status_t status = rive_metal_surface_resize(handle->metalSurface, width, height);
-        if (status != rive_renderer_status_t::ok)
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_save(rive_renderer_renderer_t renderer)
+    {
+        auto* handle = ToRenderer(renderer);
+        if (handle == nullptr || !handle->renderer)
         {
-            return status;
+            SetLastError("renderer handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->width  = width;
-        handle->height = height;
-        context->width  = width;
-        context->height = height;
+        SaveRenderer(handle);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_restore(rive_renderer_renderer_t renderer)
+    {
+        auto* handle = ToRenderer(renderer);
+        if (handle == nullptr || !handle->renderer)
+        {
+            SetLastError("renderer handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
 
+        RestoreRenderer(handle);
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        (void)surface;
-        (void)width;
-        (void)height;
-        SetLastError("surface resize not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_surface_present(rive_renderer_surface_t surface, std::uint32_t present_interval,
-                                                         rive_renderer_present_flags_t flags)
+    rive_renderer_status_t rive_renderer_renderer_transform(rive_renderer_renderer_t     renderer,
+                                                            const rive_renderer_mat2d_t* transform)
     {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        auto* handle = ToSurface(surface);
-        if (handle == nullptr)
+        auto* handle = ToRenderer(renderer);
+        if (handle == nullptr || !handle->renderer)
         {
-            SetLastError("surface handle is null");
+            SetLastError("renderer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (handle->backend != rive_renderer_backend_t::d3d12)
+        if (transform == nullptr)
         {
-            SetLastError("surface present not supported for this backend");
-            return rive_renderer_status_t::unsupported;
+            SetLastError("transform pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        if (handle->swapChain == nullptr || handle->context == nullptr)
+        TransformRenderer(handle, ToMat2D(transform));
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_draw_path(rive_renderer_renderer_t renderer,
+                                                            rive_renderer_path_t path, rive_renderer_paint_t paint)
+    {
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* pathHandle     = ToPath(path);
+        auto* paintHandle    = ToPaint(paint);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || !IsValidPath(pathHandle) ||
+            paintHandle == nullptr || !paintHandle->paint)
         {
-            SetLastError("surface not initialized");
+            SetLastError("renderer/path/paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        auto* context = handle->context;
-        if (context->hasActiveFrame || context->pendingFrameNumber != 0)
+        rive::RenderPath* renderPath = ResolvePath(pathHandle);
+        if (renderPath == nullptr)
         {
-            SetLastError("submit must be called before present");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("makeRenderPath failed");
+            return rive_renderer_status_t::internal_error;
         }
 
-        ReturnSurfaceRenderTarget(context);
+        DrawPathWithPaint(rendererHandle, renderPath, pathHandle, paintHandle, pathHandle->bounds);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        UINT syncInterval = present_interval != 0 ? present_interval : handle->present_interval;
-        UINT presentFlags = 0;
-        if ((static_cast<std::uint32_t>(flags) &
-             static_cast<std::uint32_t>(rive_renderer_present_flags_t::allow_tearing)) != 0 &&
-            handle->supportsTearing && syncInterval == 0)
+    rive_renderer_status_t rive_renderer_renderer_clip_path(rive_renderer_renderer_t renderer,
+                                                            rive_renderer_path_t     path)
+    {
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* pathHandle     = ToPath(path);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || !IsValidPath(pathHandle))
         {
-            presentFlags |= DXGI_PRESENT_ALLOW_TEARING;
+            SetLastError("renderer/path handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        HRESULT hr = handle->swapChain->Present(syncInterval, presentFlags);
-        if (FAILED(hr))
+        rive::RenderPath* renderPath = ResolvePath(pathHandle);
+        if (renderPath == nullptr)
         {
-            if (hr == DXGI_ERROR_DEVICE_REMOVED || hr == DXGI_ERROR_DEVICE_RESET)
-            {
-                SetLastError("device lost during present");
-                return rive_renderer_status_t::device_lost;
-            }
-            SetLastError("swapchain present failed");
+            SetLastError("makeRenderPath failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        context->renderTarget.reset();
-        context->renderTargetTexture.Reset();
-        handle->borrowedIndex = std::numeric_limits<UINT>::max();
-
+        ClipRendererPath(rendererHandle, renderPath, pathHandle, pathHandle->bounds);
         ClearLastError();
         return rive_renderer_status_t::ok;
-#elif defined(__APPLE__) && !defined(RIVE_UNREAL)
-        auto* handle = ToSurface(surface);
-        if (handle == nullptr)
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_draw_immutable_path(rive_renderer_renderer_t       renderer,
+                                                                      rive_renderer_immutable_path_t path,
+                                                                      rive_renderer_paint_t          paint)
+    {
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* pathHandle     = ToImmutablePath(path);
+        auto* paintHandle    = ToPaint(paint);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || rendererHandle->context == nullptr ||
+            pathHandle == nullptr || paintHandle == nullptr || !paintHandle->paint)
         {
-            SetLastError("surface handle is null");
+            SetLastError("renderer/path/paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (handle->backend != rive_renderer_backend_t::metal)
+        if (rendererHandle->context->device != pathHandle->device)
         {
-            SetLastError("surface present not supported for this backend");
-            return rive_renderer_status_t::unsupported;
+            SetLastError("immutable path belongs to a different device");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (handle->metalSurface == nullptr || handle->context == nullptr)
+        rive::RenderPath* renderPath = GetImmutableRenderPath(pathHandle, rendererHandle->context);
+        if (renderPath == nullptr)
         {
-            SetLastError("surface not initialized");
+            SetLastError("makeRenderPath failed");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        DrawPathWithPaint(rendererHandle, renderPath, nullptr, paintHandle, pathHandle->bounds);
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_renderer_clip_immutable_path(rive_renderer_renderer_t       renderer,
+                                                                      rive_renderer_immutable_path_t path)
+    {
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* pathHandle     = ToImmutablePath(path);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || rendererHandle->context == nullptr ||
+            pathHandle == nullptr)
+        {
+            SetLastError("renderer/path handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        auto* context = handle->context;
-        if (context->hasActiveFrame || context->pendingFrameNumber != 0)
+        if (rendererHandle->context->device != pathHandle->device)
         {
-            SetLastError("submit must be called before present");
+            SetLastError("immutable path belongs to a different device");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive_renderer_status_t status = rive_metal_surface_present(handle->metalSurface, context->metalContext,
-                                                                   context->renderContext.get(), flags,
-                                                                   present_interval);
-        if (status != rive_renderer_status_t::ok)
+        rive::RenderPath* renderPath = GetImmutableRenderPath(pathHandle, rendererHandle->context);
+        if (renderPath == nullptr)
         {
-            return status;
+            SetLastError("makeRenderPath failed");
+            return rive_renderer_status_t::internal_error;
         }
 
-        context->lastCompletedFrame = context->frameCounter;
-        context->frameCounter += 1;
-        context->commandListsClosed = false;
-        context->pendingFrameNumber = 0;
-
+        ClipRendererPath(rendererHandle, renderPath, nullptr, pathHandle->bounds);
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        (void)surface;
-        (void)present_interval;
-        (void)flags;
-        SetLastError("surface present not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_fence_create(rive_renderer_device_t device, rive_renderer_fence_t* out_fence)
+    rive_renderer_status_t rive_renderer_buffer_create(rive_renderer_context_t      context,
+                                                       rive_renderer_buffer_type_t  type,
+                                                       rive_renderer_buffer_flags_t flags, std::size_t size_in_bytes,
+                                                       rive_renderer_buffer_t* out_buffer)
     {
-        if (out_fence == nullptr)
+        if (out_buffer == nullptr)
         {
-            SetLastError("fence output pointer is null");
+            SetLastError("buffer output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        out_fence->handle = nullptr;
-
-        auto* device_handle = ToDevice(device);
-        if (device_handle == nullptr)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
-            SetLastError("device handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (device_handle->backend != rive_renderer_backend_t::d3d12)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
-            SetLastError("fence creation not supported for this backend");
+            SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
         }
 
-        auto* fenceHandle = new (std::nothrow) FenceHandle();
-        if (fenceHandle == nullptr)
+        rive::RenderBufferType bufferType;
+        if (!ConvertBufferType(type, &bufferType))
         {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
+            SetLastError("invalid buffer type");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        HRESULT hr = device_handle->d3d12Device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fenceHandle->fence));
-        if (FAILED(hr))
+        rive::RenderBufferFlags nativeFlags = ConvertBufferFlags(flags);
+
+        rive::rcp<rive::RenderBuffer> buffer = factory->makeRenderBuffer(bufferType, nativeFlags, size_in_bytes);
+        if (!buffer)
         {
-            delete fenceHandle;
-            SetLastError("CreateFence failed");
+            SetLastError("makeRenderBuffer failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        fenceHandle->eventHandle = CreateEvent(nullptr, FALSE, FALSE, nullptr);
-        if (fenceHandle->eventHandle == nullptr)
+        auto* handle = new (std::nothrow) BufferHandle();
+        if (handle == nullptr)
         {
-            fenceHandle->fence.Reset();
-            delete fenceHandle;
-            SetLastError("CreateEvent failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
         }
 
-        fenceHandle->device = device_handle;
-        fenceHandle->lastValue.store(0, std::memory_order_relaxed);
-        device_handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-
-        out_fence->handle = fenceHandle;
+        handle->buffer        = std::move(buffer);
+        handle->type          = type;
+        handle->size_in_bytes = handle->buffer->sizeInBytes();
+        out_buffer->handle    = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        (void)device;
-        (void)device_handle;
-        SetLastError("fence creation not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_fence_retain(rive_renderer_fence_t fence)
+    rive_renderer_status_t rive_renderer_buffer_retain(rive_renderer_buffer_t buffer)
     {
-        auto* handle = ToFence(fence);
-        if (handle == nullptr)
+        auto* handle = ToBuffer(buffer);
+        if (handle == nullptr || !handle->buffer)
         {
-            SetLastError("fence handle is null");
+            SetLastError("buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
@@ -2962,242 +8565,141 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_fence_release(rive_renderer_fence_t fence)
+    rive_renderer_status_t rive_renderer_buffer_release(rive_renderer_buffer_t buffer)
     {
-        auto* handle = ToFence(fence);
-        if (handle == nullptr)
+        auto* handle = ToBuffer(buffer);
+        if (handle == nullptr || !handle->buffer)
         {
-            SetLastError("fence handle is null");
+            SetLastError("buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
-            SetLastError("fence handle refcount underflow");
-            return rive_renderer_status_t::internal_error;
-        }
-
-        if (previous == 1)
-        {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-            if (handle->eventHandle != nullptr)
-            {
-                CloseHandle(handle->eventHandle);
-                handle->eventHandle = nullptr;
-            }
-            handle->fence.Reset();
-#endif
-            if (handle->device != nullptr)
-            {
-                DeviceHandle*       device      = handle->device;
-                const std::uint32_t device_prev = device->ref_count.fetch_sub(1, std::memory_order_acq_rel);
-                if (device_prev == 0)
-                {
-                    device->ref_count.fetch_add(1, std::memory_order_relaxed);
-                }
-                else if (device_prev == 1)
-                {
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-                    device->adapter.Reset();
-                    device->d3d12Device.Reset();
-                    device->directQueue.Reset();
-                    device->copyQueue.Reset();
-#endif
-                    delete device;
-                }
-            }
-            delete handle;
-        }
-
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_fence_get_completed_value(rive_renderer_fence_t fence,
-                                                                   std::uint64_t* out_value)
-    {
-        if (out_value == nullptr)
-        {
-            SetLastError("completed value pointer is null");
-            return rive_renderer_status_t::null_pointer;
-        }
-
-        auto* handle = ToFence(fence);
-        if (handle == nullptr)
-        {
-            SetLastError("fence handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("buffer handle refcount underflow");
+            return rive_renderer_status_t::internal_error;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (!handle->fence)
+        if (previous == 1)
         {
-            SetLastError("fence not initialized");
-            return rive_renderer_status_t::internal_error;
+            delete handle;
         }
 
-        *out_value = handle->fence->GetCompletedValue();
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        (void)out_value;
-        SetLastError("fence operations not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_fence_wait(rive_renderer_fence_t fence, std::uint64_t value,
-                                                    std::uint64_t timeout_ms)
+    rive_renderer_status_t rive_renderer_buffer_upload(rive_renderer_buffer_t buffer, const void* data,
+                                                       std::size_t data_length, std::size_t offset)
     {
-        auto* handle = ToFence(fence);
-        if (handle == nullptr)
+        auto* handle = ToBuffer(buffer);
+        if (handle == nullptr || !handle->buffer)
         {
-            SetLastError("fence handle is null");
+            SetLastError("buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (!handle->fence)
-        {
-            SetLastError("fence not initialized");
-            return rive_renderer_status_t::internal_error;
-        }
-
-        if (handle->fence->GetCompletedValue() >= value)
+        if (data_length == 0)
         {
             ClearLastError();
             return rive_renderer_status_t::ok;
         }
 
-        if (value == 0)
+        if (data == nullptr)
         {
-            SetLastError("fence wait value must be non-zero");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("data pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        if (timeout_ms == 0)
+        if (offset > handle->size_in_bytes || data_length > handle->size_in_bytes ||
+            offset + data_length > handle->size_in_bytes)
         {
-            SetLastError("fence wait timed out");
+            SetLastError("upload exceeds buffer bounds");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        HRESULT hr = handle->fence->SetEventOnCompletion(value, handle->eventHandle);
-        if (FAILED(hr))
+        void* mapped = handle->buffer->map();
+        if (mapped == nullptr)
         {
-            SetLastError("SetEventOnCompletion failed");
+            SetLastError("buffer map failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        DWORD timeoutValue = INFINITE;
-        if (timeout_ms != std::numeric_limits<std::uint64_t>::max())
-        {
-            timeoutValue = timeout_ms >= static_cast<std::uint64_t>(INFINITE - 1)
-                               ? INFINITE
-                               : static_cast<DWORD>(timeout_ms);
-        }
-
-        DWORD waitResult = WaitForSingleObject(handle->eventHandle, timeoutValue);
-        if (waitResult == WAIT_OBJECT_0)
-        {
-            ClearLastError();
-            return rive_renderer_status_t::ok;
-        }
-        if (waitResult == WAIT_TIMEOUT)
-        {
-            SetLastError("fence wait timed out");
-            return rive_renderer_status_t::invalid_parameter;
-        }
-
-        SetLastError("fence wait failed");
-        return rive_renderer_status_t::internal_error;
-#else
-        (void)value;
-        (void)timeout_ms;
-        SetLastError("fence operations not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
+        std::memcpy(static_cast<std::uint8_t*>(mapped) + offset, data, data_length);
+        handle->buffer->unmap();
+        ClearLastError();
+        return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_context_signal_fence(rive_renderer_context_t context,
-                                                              rive_renderer_fence_t   fence, std::uint64_t value)
+    rive_renderer_status_t rive_renderer_buffer_map(rive_renderer_buffer_t buffer,
+                                                    rive_renderer_buffer_map_flags_t /*flags*/,
+                                                    rive_renderer_mapped_memory_t* out_mapping)
     {
-        auto* context_handle = ToContext(context);
-        if (context_handle == nullptr)
+        if (out_mapping == nullptr)
         {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("mapped memory output pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        auto* fence_handle = ToFence(fence);
-        if (fence_handle == nullptr)
+        auto* handle = ToBuffer(buffer);
+        if (handle == nullptr || !handle->buffer)
         {
-            SetLastError("fence handle is null");
+            SetLastError("buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-#if defined(_WIN32) && !defined(RIVE_UNREAL)
-        if (context_handle->device == nullptr || fence_handle->device == nullptr ||
-            context_handle->device != fence_handle->device)
+        if (handle->mapped_ptr != nullptr)
         {
-            SetLastError("fence and context must share the same device");
+            SetLastError("buffer is already mapped");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (context_handle->device->backend != rive_renderer_backend_t::d3d12)
-        {
-            SetLastError("fence signaling not supported for this backend");
-            return rive_renderer_status_t::unsupported;
-        }
-
-        auto* device = context_handle->device;
-        if (!device->directQueue)
+        void* mapped = handle->buffer->map();
+        if (mapped == nullptr)
         {
-            SetLastError("direct queue unavailable");
+            SetLastError("buffer map failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        std::uint64_t previousValue = fence_handle->lastValue.load(std::memory_order_acquire);
-        std::uint64_t targetValue   = value;
-        if (targetValue == 0)
-        {
-            targetValue = previousValue + 1;
-        }
-        else if (targetValue <= previousValue)
+        handle->mapped_ptr = mapped;
+        out_mapping->data  = mapped;
+        out_mapping->length =
+            handle->size_in_bytes == 0 ? handle->buffer->sizeInBytes() : handle->size_in_bytes;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_buffer_unmap(rive_renderer_buffer_t buffer,
+                                                      const rive_renderer_mapped_memory_t* /*mapping*/,
+                                                      std::size_t written_bytes)
+    {
+        auto* handle = ToBuffer(buffer);
+        if (handle == nullptr || !handle->buffer)
         {
-            SetLastError("fence signal value must be greater than the last signaled value");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("buffer handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        fence_handle->lastValue.store(targetValue, std::memory_order_release);
-
-        HRESULT hr = device->directQueue->Signal(fence_handle->fence.Get(), targetValue);
-        if (FAILED(hr))
+        if (handle->mapped_ptr == nullptr)
         {
-            fence_handle->lastValue.store(previousValue, std::memory_order_release);
-            SetLastError("queue signal failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("buffer is not mapped");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
+        handle->buffer->unmap();
+        handle->mapped_ptr = nullptr;
+        static_cast<void>(written_bytes);
         ClearLastError();
         return rive_renderer_status_t::ok;
-#else
-        (void)context;
-        (void)fence;
-        (void)value;
-        SetLastError("fence signaling not supported on this platform");
-        return rive_renderer_status_t::unsupported;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_path_create(rive_renderer_context_t   context,
-                                                     rive_renderer_fill_rule_t fill_rule,
-                                                     rive_renderer_path_t*     out_path)
+    rive_renderer_status_t rive_renderer_image_decode(rive_renderer_context_t context, const std::uint8_t* encoded_data,
+                                                      std::size_t encoded_length, rive_renderer_image_t* out_image)
     {
-        if (out_path == nullptr)
+        if (out_image == nullptr)
         {
-            SetLastError("path output pointer is null");
+            SetLastError("image output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
@@ -3208,47 +8710,46 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
             SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
         }
 
-        rive::FillRule rule;
-        if (!ConvertFillRule(fill_rule, &rule))
+        if (encoded_data == nullptr || encoded_length == 0)
         {
-            SetLastError("invalid fill rule");
+            SetLastError("encoded image data is invalid");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::rcp<rive::RenderPath> path = ctx->renderContext->makeEmptyRenderPath();
-        if (!path)
+        rive::Span<const std::uint8_t> bytes(encoded_data, encoded_length);
+        rive::rcp<rive::RenderImage>   image = factory->decodeImage(bytes);
+        if (!image)
         {
-            SetLastError("makeRenderPath failed");
+            SetLastError("decodeImage failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        path->fillRule(rule);
-
-        auto* handle = new (std::nothrow) PathHandle();
+        auto* handle = new (std::nothrow) ImageHandle();
         if (handle == nullptr)
         {
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        handle->path     = std::move(path);
-        out_path->handle = handle;
+        handle->image     = std::move(image);
+        out_image->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_path_retain(rive_renderer_path_t path)
+    rive_renderer_status_t rive_renderer_image_retain(rive_renderer_image_t image)
     {
-        auto* handle = ToPath(path);
-        if (handle == nullptr)
+        auto* handle = ToImage(image);
+        if (handle == nullptr || !handle->image)
         {
-            SetLastError("path handle is null");
+            SetLastError("image handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
@@ -3257,19 +8758,19 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_path_release(rive_renderer_path_t path)
+    rive_renderer_status_t rive_renderer_image_release(rive_renderer_image_t image)
     {
-        auto* handle = ToPath(path);
-        if (handle == nullptr)
+        auto* handle = ToImage(image);
+        if (handle == nullptr || !handle->image)
         {
-            SetLastError("path handle is null");
+            SetLastError("image handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("path handle refcount underflow");
+            SetLastError("image handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
@@ -3282,121 +8783,113 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_path_rewind(rive_renderer_path_t path)
-    {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
-        {
-            SetLastError("path handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
-        }
-
-        handle->path->rewind();
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_path_set_fill_rule(rive_renderer_path_t      path,
-                                                            rive_renderer_fill_rule_t fill_rule)
+    rive_renderer_status_t rive_renderer_image_get_size(rive_renderer_image_t image, std::uint32_t* out_width,
+                                                        std::uint32_t* out_height)
     {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
+        auto* handle = ToImage(image);
+        if (handle == nullptr || !handle->image)
         {
-            SetLastError("path handle is invalid");
+            SetLastError("image handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::FillRule rule;
-        if (!ConvertFillRule(fill_rule, &rule))
+        if (out_width == nullptr || out_height == nullptr)
         {
-            SetLastError("invalid fill rule");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("size output pointers are null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        handle->path->fillRule(rule);
+        *out_width  = static_cast<std::uint32_t>(handle->image->width());
+        *out_height = static_cast<std::uint32_t>(handle->image->height());
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_path_move_to(rive_renderer_path_t path, float x, float y)
+    rive_renderer_status_t rive_renderer_renderer_draw_image(rive_renderer_renderer_t             renderer,
+                                                             rive_renderer_image_t                image,
+                                                             const rive_renderer_image_sampler_t* sampler,
+                                                             rive_renderer_blend_mode_t blend_mode, float opacity)
     {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* imageHandle    = ToImage(image);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || imageHandle == nullptr || !imageHandle->image)
         {
-            SetLastError("path handle is invalid");
+            SetLastError("renderer/image handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->path->moveTo(x, y);
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_path_line_to(rive_renderer_path_t path, float x, float y)
-    {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
+        rive::BlendMode mode;
+        if (!ConvertBlendMode(blend_mode, &mode))
         {
-            SetLastError("path handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("invalid blend mode");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->path->lineTo(x, y);
+        rive::ImageSampler nativeSampler = ConvertImageSampler(sampler);
+        rendererHandle->renderer->drawImage(imageHandle->image.get(), nativeSampler, mode, opacity);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_path_cubic_to(rive_renderer_path_t path, float ox, float oy, float ix,
-                                                       float iy, float x, float y)
+    rive_renderer_status_t rive_renderer_renderer_draw_image_mesh(
+        rive_renderer_renderer_t renderer, rive_renderer_image_t image, const rive_renderer_image_sampler_t* sampler,
+        rive_renderer_buffer_t vertices, rive_renderer_buffer_t uvs, rive_renderer_buffer_t indices,
+        std::uint32_t vertex_count, std::uint32_t index_count, rive_renderer_blend_mode_t blend_mode, float opacity)
     {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* imageHandle    = ToImage(image);
+        auto* verticesHandle = ToBuffer(vertices);
+        auto* uvsHandle      = ToBuffer(uvs);
+        auto* indicesHandle  = ToBuffer(indices);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || imageHandle == nullptr || !imageHandle->image ||
+            verticesHandle == nullptr || !verticesHandle->buffer || uvsHandle == nullptr || !uvsHandle->buffer ||
+            indicesHandle == nullptr || !indicesHandle->buffer)
         {
-            SetLastError("path handle is invalid");
+            SetLastError("renderer/image/buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->path->cubicTo(ox, oy, ix, iy, x, y);
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
+        if (verticesHandle->type != rive_renderer_buffer_type_t::vertex ||
+            uvsHandle->type != rive_renderer_buffer_type_t::vertex)
+        {
+            SetLastError("vertex/uv buffers must be vertex buffers");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-    rive_renderer_status_t rive_renderer_path_close(rive_renderer_path_t path)
-    {
-        auto* handle = ToPath(path);
-        if (handle == nullptr || !handle->path)
+        if (indicesHandle->type != rive_renderer_buffer_type_t::index)
         {
-            SetLastError("path handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("index buffer must be an index buffer");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->path->close();
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
+        if (vertex_count == 0 || index_count == 0)
+        {
+            SetLastError("vertex/index counts must be non-zero");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-    rive_renderer_status_t rive_renderer_path_add_path(rive_renderer_path_t destination, rive_renderer_path_t source,
-                                                       const rive_renderer_mat2d_t* transform)
-    {
-        auto* dstHandle = ToPath(destination);
-        auto* srcHandle = ToPath(source);
-        if (dstHandle == nullptr || !dstHandle->path || srcHandle == nullptr || !srcHandle->path)
+        rive::BlendMode mode;
+        if (!ConvertBlendMode(blend_mode, &mode))
         {
-            SetLastError("path handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("invalid blend mode");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::Mat2D mat = ToMat2D(transform);
-        dstHandle->path->addPath(srcHandle->path.get(), mat);
+        rive::ImageSampler nativeSampler = ConvertImageSampler(sampler);
+
+        rendererHandle->renderer->drawImageMesh(imageHandle->image.get(), nativeSampler, verticesHandle->buffer,
+                                                uvsHandle->buffer, indicesHandle->buffer, vertex_count, index_count,
+                                                mode, opacity);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_create(rive_renderer_context_t context, rive_renderer_paint_t* out_paint)
+    rive_renderer_status_t rive_renderer_command_buffer_create(rive_renderer_context_t         context,
+                                                               rive_renderer_command_buffer_t* out_buffer)
     {
-        if (out_paint == nullptr)
+        if (out_buffer == nullptr)
         {
-            SetLastError("paint output pointer is null");
+            SetLastError("command buffer output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
@@ -3407,38 +8900,27 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
-        {
-            SetLastError("render context unavailable");
-            return rive_renderer_status_t::unsupported;
-        }
-
-        rive::rcp<rive::RenderPaint> paint = ctx->renderContext->makeRenderPaint();
-        if (!paint)
-        {
-            SetLastError("makeRenderPaint failed");
-            return rive_renderer_status_t::internal_error;
-        }
-
-        auto* handle = new (std::nothrow) PaintHandle();
+        auto* handle = new (std::nothrow) CommandBufferHandle();
         if (handle == nullptr)
         {
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        handle->paint     = std::move(paint);
-        out_paint->handle = handle;
+        handle->context = ctx;
+        ctx->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+        out_buffer->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_retain(rive_renderer_paint_t paint)
+    rive_renderer_status_t rive_renderer_command_buffer_retain(rive_renderer_command_buffer_t buffer)
     {
-        auto* handle = ToPaint(paint);
+        auto* handle = ToCommandBuffer(buffer);
         if (handle == nullptr)
         {
-            SetLastError("paint handle is null");
+            SetLastError("command buffer handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
@@ -3447,164 +8929,204 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_release(rive_renderer_paint_t paint)
+    rive_renderer_status_t rive_renderer_command_buffer_release(rive_renderer_command_buffer_t buffer)
     {
-        auto* handle = ToPaint(paint);
+        auto* handle = ToCommandBuffer(buffer);
         if (handle == nullptr)
         {
-            SetLastError("paint handle is null");
+            SetLastError("command buffer handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("paint handle refcount underflow");
+            SetLastError("command buffer handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
         if (previous == 1)
         {
+            for (PathHandle* path : handle->paths)
+            {
+                if (path != nullptr)
+                {
+                    rive_renderer_path_release({path});
+                }
+            }
+            for (PaintHandle* paint : handle->paints)
+            {
+                if (paint != nullptr)
+                {
+                    rive_renderer_paint_release({paint});
+                }
+            }
+            auto* context = handle->context;
             delete handle;
+            if (context != nullptr)
+            {
+                return rive_renderer_context_release({context});
+            }
         }
 
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_style(rive_renderer_paint_t paint, rive_renderer_paint_style_t style)
+    rive_renderer_status_t rive_renderer_command_buffer_reset(rive_renderer_command_buffer_t buffer)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* handle = ToCommandBuffer(buffer);
+        if (handle == nullptr)
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("command buffer handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::RenderPaintStyle cppStyle;
-        if (!ConvertPaintStyle(style, &cppStyle))
-        {
-            SetLastError("invalid paint style");
-            return rive_renderer_status_t::invalid_parameter;
-        }
-
-        handle->paint->style(cppStyle);
+        handle->commands.clear();
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_color(rive_renderer_paint_t paint, rive_renderer_color_t color)
+    rive_renderer_status_t rive_renderer_command_buffer_write(rive_renderer_command_buffer_t buffer, const void* data,
+                                                              std::size_t data_length)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* handle = ToCommandBuffer(buffer);
+        if (handle == nullptr)
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("command buffer handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->paint->color(static_cast<rive::ColorInt>(color));
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_paint_set_thickness(rive_renderer_paint_t paint, float thickness)
-    {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        if (data == nullptr && data_length > 0)
         {
-            SetLastError("paint handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("command data pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        handle->paint->thickness(thickness);
+        const auto* bytes = static_cast<const std::uint8_t*>(data);
+        handle->commands.insert(handle->commands.end(), bytes, bytes + data_length);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_join(rive_renderer_paint_t paint, rive_renderer_stroke_join_t join)
+    rive_renderer_status_t rive_renderer_command_buffer_bind_path(rive_renderer_command_buffer_t buffer,
+                                                                  std::uint32_t slot, rive_renderer_path_t path)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* handle     = ToCommandBuffer(buffer);
+        auto* pathHandle = ToPath(path);
+        if (handle == nullptr || !IsValidPath(pathHandle))
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("command buffer/path handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::StrokeJoin cppJoin;
-        if (!ConvertStrokeJoin(join, &cppJoin))
+        if (slot >= kMaxCommandSlots)
         {
-            SetLastError("invalid stroke join");
+            SetLastError("command slot is out of range");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->paint->join(cppJoin);
+        // Paths are bound by handle so interned paths are resolved to their current content on every submit.
+        pathHandle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= handle->paths.size())
+        {
+            handle->paths.resize(static_cast<std::size_t>(slot) + 1, nullptr);
+        }
+        if (PathHandle* previous = std::exchange(handle->paths[slot], pathHandle))
+        {
+            rive_renderer_path_release({previous});
+        }
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_cap(rive_renderer_paint_t paint, rive_renderer_stroke_cap_t cap)
+    rive_renderer_status_t rive_renderer_command_buffer_bind_paint(rive_renderer_command_buffer_t buffer,
+                                                                   std::uint32_t slot, rive_renderer_paint_t paint)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* handle      = ToCommandBuffer(buffer);
+        auto* paintHandle = ToPaint(paint);
+        if (handle == nullptr || paintHandle == nullptr || !paintHandle->paint)
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("command buffer/paint handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::StrokeCap cppCap;
-        if (!ConvertStrokeCap(cap, &cppCap))
+        if (slot >= kMaxCommandSlots)
         {
-            SetLastError("invalid stroke cap");
+            SetLastError("command slot is out of range");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->paint->cap(cppCap);
+        // Paints are bound by handle so buffers submitted to a picture recorder record draws the picture can fade.
+        paintHandle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= handle->paints.size())
+        {
+            handle->paints.resize(static_cast<std::size_t>(slot) + 1, nullptr);
+        }
+        if (PaintHandle* previous = std::exchange(handle->paints[slot], paintHandle))
+        {
+            rive_renderer_paint_release({previous});
+        }
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_feather(rive_renderer_paint_t paint, float feather)
+    rive_renderer_status_t rive_renderer_command_buffer_bind_image(rive_renderer_command_buffer_t buffer,
+                                                                   std::uint32_t slot, rive_renderer_image_t image)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* handle      = ToCommandBuffer(buffer);
+        auto* imageHandle = ToImage(image);
+        if (handle == nullptr || imageHandle == nullptr || !imageHandle->image)
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("command buffer/image handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->paint->feather(feather);
+        if (slot >= kMaxCommandSlots)
+        {
+            SetLastError("command slot is out of range");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        BindCommandSlot(&handle->images, slot, imageHandle->image);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_paint_set_blend_mode(rive_renderer_paint_t      paint,
-                                                              rive_renderer_blend_mode_t blend_mode)
+    rive_renderer_status_t rive_renderer_renderer_submit_commands(rive_renderer_renderer_t       renderer,
+                                                                  rive_renderer_command_buffer_t buffer)
     {
-        auto* handle = ToPaint(paint);
-        if (handle == nullptr || !handle->paint)
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* bufferHandle   = ToCommandBuffer(buffer);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || bufferHandle == nullptr)
         {
-            SetLastError("paint handle is invalid");
+            SetLastError("renderer/command buffer handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::BlendMode cppBlend;
-        if (!ConvertBlendMode(blend_mode, &cppBlend))
+        if (rendererHandle->context != bufferHandle->context)
         {
-            SetLastError("invalid blend mode");
+            SetLastError("command buffer belongs to a different context");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->paint->blendMode(cppBlend);
+        if (const char* error = ReplayCommands(*bufferHandle, nullptr))
+        {
+            SetLastError(error);
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        ReplayCommands(*bufferHandle, rendererHandle);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_create(rive_renderer_context_t   context,
-                                                         rive_renderer_renderer_t* out_renderer)
+    rive_renderer_status_t rive_renderer_picture_recorder_create(rive_renderer_context_t   context,
+                                                                 rive_renderer_renderer_t* out_recorder)
     {
-        if (out_renderer == nullptr)
+        if (out_recorder == nullptr)
         {
-            SetLastError("renderer output pointer is null");
+            SetLastError("recorder output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
@@ -3615,41 +9137,71 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        if (GetFactory(ctx) == nullptr)
         {
             SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
         }
 
-        auto renderer = std::make_unique<rive::RiveRenderer>(ctx->renderContext.get());
-        if (!renderer)
+        auto* recorder = new (std::nothrow) PictureRecorder();
+        auto* handle   = new (std::nothrow) RendererHandle();
+        if (recorder == nullptr || handle == nullptr)
         {
-            SetLastError("renderer allocation failed");
+            delete recorder;
+            delete handle;
+            SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        auto* handle = new (std::nothrow) RendererHandle();
-        if (handle == nullptr)
+        handle->context  = ctx;
+        handle->recorder = recorder;
+        handle->renderer.reset(recorder);
+        ctx->ref_count.fetch_add(1, std::memory_order_relaxed);
+
+        out_recorder->handle = handle;
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
+
+    rive_renderer_status_t rive_renderer_picture_recorder_finish(rive_renderer_renderer_t recorder,
+                                                                 rive_renderer_picture_t* out_picture)
+    {
+        if (out_picture == nullptr)
+        {
+            SetLastError("picture output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        auto* handle = ToRenderer(recorder);
+        if (handle == nullptr || handle->recorder == nullptr)
+        {
+            SetLastError("renderer is not a picture recorder");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        auto* picture = new (std::nothrow) PictureHandle();
+        if (picture == nullptr)
         {
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        handle->context  = ctx;
-        handle->renderer = std::move(renderer);
-        ctx->ref_count.fetch_add(1, std::memory_order_relaxed);
+        picture->context = handle->context;
+        picture->ops     = handle->recorder->finish();
+        IndexPicture(picture);
+        picture->context->ref_count.fetch_add(1, std::memory_order_relaxed);
 
-        out_renderer->handle = handle;
+        out_picture->handle = picture;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_retain(rive_renderer_renderer_t renderer)
+    rive_renderer_status_t rive_renderer_picture_retain(rive_renderer_picture_t picture)
     {
-        auto* handle = ToRenderer(renderer);
+        auto* handle = ToPicture(picture);
         if (handle == nullptr)
         {
-            SetLastError("renderer handle is null");
+            SetLastError("picture handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
@@ -3658,130 +9210,138 @@ extern "C"
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_release(rive_renderer_renderer_t renderer)
+    rive_renderer_status_t rive_renderer_picture_release(rive_renderer_picture_t picture)
     {
-        auto* handle = ToRenderer(renderer);
+        auto* handle = ToPicture(picture);
         if (handle == nullptr)
         {
-            SetLastError("renderer handle is null");
+            SetLastError("picture handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("renderer handle refcount underflow");
+            SetLastError("picture handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
         if (previous == 1)
         {
-            if (handle->context)
+            ReleasePictureOps(&handle->ops);
+            auto* context = handle->context;
+            delete handle;
+            if (context != nullptr)
             {
-                handle->context->ref_count.fetch_sub(1, std::memory_order_acq_rel);
+                return rive_renderer_context_release({context});
             }
-            delete handle;
         }
 
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_save(rive_renderer_renderer_t renderer)
+    rive_renderer_status_t rive_renderer_renderer_draw_picture(rive_renderer_renderer_t     renderer,
+                                                               rive_renderer_picture_t      picture,
+                                                               const rive_renderer_mat2d_t* transform, float opacity)
     {
-        auto* handle = ToRenderer(renderer);
-        if (handle == nullptr || !handle->renderer)
+        auto* rendererHandle = ToRenderer(renderer);
+        auto* pictureHandle  = ToPicture(picture);
+        if (rendererHandle == nullptr || !rendererHandle->renderer || pictureHandle == nullptr)
         {
-            SetLastError("renderer handle is invalid");
+            SetLastError("renderer/picture handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        handle->renderer->save();
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_renderer_restore(rive_renderer_renderer_t renderer)
-    {
-        auto* handle = ToRenderer(renderer);
-        if (handle == nullptr || !handle->renderer)
+        if (rendererHandle->context != pictureHandle->context)
         {
-            SetLastError("renderer handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("picture belongs to a different context");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->renderer->restore();
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
+        if (!(opacity >= 0.0f && opacity <= 1.0f))
+        {
+            SetLastError("picture opacity must be between 0 and 1");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-    rive_renderer_status_t rive_renderer_renderer_transform(rive_renderer_renderer_t     renderer,
-                                                            const rive_renderer_mat2d_t* transform)
-    {
-        auto* handle = ToRenderer(renderer);
-        if (handle == nullptr || !handle->renderer)
+        if (opacity == 0.0f)
         {
-            SetLastError("renderer handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            ClearLastError();
+            return rive_renderer_status_t::ok;
         }
 
-        if (transform == nullptr)
+        SaveRenderer(rendererHandle);
+        if (transform != nullptr)
         {
-            SetLastError("transform pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            TransformRenderer(rendererHandle, ToMat2D(transform));
         }
 
-        rive::Mat2D mat = ToMat2D(transform);
-        handle->renderer->transform(mat);
+        // Cull against the render target and the known clip, mapped back into picture space. Recorders keep every
+        // draw since the picture they record may be replayed anywhere.
+        thread_local std::vector<std::uint32_t> visibleDraws;
+        const std::vector<std::uint32_t>*       visible = nullptr;
+        rive::Mat2D                             inverse;
+        ContextHandle*                          context = rendererHandle->context;
+        if (rendererHandle->recorder == nullptr && !pictureHandle->index.ops.empty() &&
+            rendererHandle->state.matrix.invert(&inverse))
+        {
+            const rive_renderer_rect_t viewport = IntersectRects(
+                {0.0f, 0.0f, static_cast<float>(context->width), static_cast<float>(context->height)},
+                rendererHandle->state.clipBounds);
+            std::lock_guard<std::mutex> lock(pictureHandle->indexMutex);
+            RefitPictureIndex(pictureHandle);
+            CullPicture(*pictureHandle, TransformRect(inverse, viewport), &visibleDraws);
+            visible = &visibleDraws;
+        }
+        const std::uint32_t replayed = visible != nullptr ? static_cast<std::uint32_t>(visible->size())
+                                                          : pictureHandle->drawCount;
+        context->pictureDrawsReplayed.fetch_add(replayed, std::memory_order_relaxed);
+        context->pictureDrawsCulled.fetch_add(pictureHandle->drawCount - replayed, std::memory_order_relaxed);
+        ReplayPicture(pictureHandle, rendererHandle, opacity, visible);
+        RestoreRenderer(rendererHandle);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_draw_path(rive_renderer_renderer_t renderer,
-                                                            rive_renderer_path_t path, rive_renderer_paint_t paint)
+    rive_renderer_status_t rive_renderer_context_get_picture_stats(rive_renderer_context_t        context,
+                                                                   rive_renderer_picture_stats_t* out_stats)
     {
-        auto* rendererHandle = ToRenderer(renderer);
-        auto* pathHandle     = ToPath(path);
-        auto* paintHandle    = ToPaint(paint);
-        if (rendererHandle == nullptr || !rendererHandle->renderer || pathHandle == nullptr || !pathHandle->path ||
-            paintHandle == nullptr || !paintHandle->paint)
+        if (out_stats == nullptr)
         {
-            SetLastError("renderer/path/paint handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("picture stats output pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        rendererHandle->renderer->drawPath(pathHandle->path.get(), paintHandle->paint.get());
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_renderer_clip_path(rive_renderer_renderer_t renderer,
-                                                            rive_renderer_path_t     path)
-    {
-        auto* rendererHandle = ToRenderer(renderer);
-        auto* pathHandle     = ToPath(path);
-        if (rendererHandle == nullptr || !rendererHandle->renderer || pathHandle == nullptr || !pathHandle->path)
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
         {
-            SetLastError("renderer/path handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rendererHandle->renderer->clipPath(pathHandle->path.get());
+        out_stats->draws_replayed = ctx->pictureDrawsReplayed.load(std::memory_order_relaxed);
+        out_stats->draws_culled   = ctx->pictureDrawsCulled.load(std::memory_order_relaxed);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_buffer_create(rive_renderer_context_t      context,
-                                                       rive_renderer_buffer_type_t  type,
-                                                       rive_renderer_buffer_flags_t flags, std::size_t size_in_bytes,
-                                                       rive_renderer_buffer_t* out_buffer)
+    rive_renderer_status_t rive_renderer_font_decode(rive_renderer_context_t context, const std::uint8_t* font_data,
+                                                     std::size_t font_length, rive_renderer_font_t* out_font)
     {
-        if (out_buffer == nullptr)
+        if (out_font == nullptr)
         {
-            SetLastError("buffer output pointer is null");
+            SetLastError("font output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
+#if !defined(WITH_RIVE_TEXT)
+        (void) context;
+        (void) font_data;
+        (void) font_length;
+        SetLastError("text support not available");
+        return rive_renderer_status_t::unsupported;
+#else
         auto* ctx = ToContext(context);
         if (ctx == nullptr)
         {
@@ -3789,71 +9349,79 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
             SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
         }
 
-        rive::RenderBufferType bufferType;
-        if (!ConvertBufferType(type, &bufferType))
+        if (font_data == nullptr || font_length == 0)
         {
-            SetLastError("invalid buffer type");
+            SetLastError("font data is invalid");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::RenderBufferFlags nativeFlags = ConvertBufferFlags(flags);
-
-        rive::rcp<rive::RenderBuffer> buffer =
-            ctx->renderContext->makeRenderBuffer(bufferType, nativeFlags, size_in_bytes);
-        if (!buffer)
+        rive::Span<const std::uint8_t> bytes(font_data, font_length);
+        rive::rcp<rive::Font>          font = factory->decodeFont(bytes);
+        if (!font)
         {
-            SetLastError("makeRenderBuffer failed");
+            SetLastError("decodeFont failed");
             return rive_renderer_status_t::internal_error;
         }
 
-        auto* handle = new (std::nothrow) BufferHandle();
+        auto* handle = new (std::nothrow) FontHandle();
         if (handle == nullptr)
         {
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
 
-        handle->buffer        = std::move(buffer);
-        handle->type          = type;
-        handle->size_in_bytes = handle->buffer->sizeInBytes();
-        out_buffer->handle    = handle;
+        handle->font     = std::move(font);
+        out_font->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
+#endif
     }
 
-    rive_renderer_status_t rive_renderer_buffer_retain(rive_renderer_buffer_t buffer)
+    rive_renderer_status_t rive_renderer_font_retain(rive_renderer_font_t font)
     {
-        auto* handle = ToBuffer(buffer);
-        if (handle == nullptr || !handle->buffer)
+#if !defined(WITH_RIVE_TEXT)
+        (void) font;
+        SetLastError("text support not available");
+        return rive_renderer_status_t::unsupported;
+#else
+        auto* handle = ToFont(font);
+        if (handle == nullptr || !handle->font)
         {
-            SetLastError("buffer handle is invalid");
+            SetLastError("font handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
         handle->ref_count.fetch_add(1, std::memory_order_relaxed);
         ClearLastError();
         return rive_renderer_status_t::ok;
+#endif
     }
 
-    rive_renderer_status_t rive_renderer_buffer_release(rive_renderer_buffer_t buffer)
+    rive_renderer_status_t rive_renderer_font_release(rive_renderer_font_t font)
     {
-        auto* handle = ToBuffer(buffer);
-        if (handle == nullptr || !handle->buffer)
+#if !defined(WITH_RIVE_TEXT)
+        (void) font;
+        SetLastError("text support not available");
+        return rive_renderer_status_t::unsupported;
+#else
+        auto* handle = ToFont(font);
+        if (handle == nullptr || !handle->font)
         {
-            SetLastError("buffer handle is invalid");
+            SetLastError("font handle is invalid");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("buffer handle refcount underflow");
+            SetLastError("font handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
@@ -3864,660 +9432,764 @@ extern "C"
 
         ClearLastError();
         return rive_renderer_status_t::ok;
+#endif
     }
 
-    rive_renderer_status_t rive_renderer_buffer_upload(rive_renderer_buffer_t buffer, const void* data,
-                                                       std::size_t data_length, std::size_t offset)
+    rive_renderer_status_t rive_renderer_text_create_path(rive_renderer_context_t context, rive_renderer_font_t font,
+                                                          const char* utf8_text, std::size_t utf8_length,
+                                                          const rive_renderer_text_style_t* style,
+                                                          rive_renderer_fill_rule_t         fill_rule,
+                                                          rive_renderer_path_t*             out_path)
     {
-        auto* handle = ToBuffer(buffer);
-        if (handle == nullptr || !handle->buffer)
+        if (out_path == nullptr)
         {
-            SetLastError("buffer handle is invalid");
+            SetLastError("path output pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+#if !defined(WITH_RIVE_TEXT)
+        (void) context;
+        (void) font;
+        (void) utf8_text;
+        (void) utf8_length;
+        (void) style;
+        (void) fill_rule;
+        SetLastError("text support not available");
+        return rive_renderer_status_t::unsupported;
+#else
+        auto* ctx = ToContext(context);
+        if (ctx == nullptr)
+        {
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (data_length == 0)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
-            ClearLastError();
-            return rive_renderer_status_t::ok;
+            SetLastError("render context unavailable");
+            return rive_renderer_status_t::unsupported;
         }
 
-        if (data == nullptr)
+        auto* fontHandle = ToFont(font);
+        if (fontHandle == nullptr || !fontHandle->font)
         {
-            SetLastError("data pointer is null");
+            SetLastError("font handle is invalid");
+            return rive_renderer_status_t::invalid_handle;
+        }
+
+        if (style == nullptr)
+        {
+            SetLastError("text style pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        if (offset > handle->size_in_bytes || data_length > handle->size_in_bytes ||
-            offset + data_length > handle->size_in_bytes)
+        if (utf8_length > 0 && utf8_text == nullptr)
         {
-            SetLastError("upload exceeds buffer bounds");
+            SetLastError("text pointer is null");
+            return rive_renderer_status_t::null_pointer;
+        }
+
+        if (style->size <= 0.0f)
+        {
+            SetLastError("text size must be positive");
+            return rive_renderer_status_t::invalid_parameter;
+        }
+
+        rive::FillRule rule;
+        if (!ConvertFillRule(fill_rule, &rule))
+        {
+            SetLastError("invalid fill rule");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        void* mapped = handle->buffer->map();
-        if (mapped == nullptr)
+        rive::rcp<rive::RenderPath> renderPath = factory->makeEmptyRenderPath();
+        if (!renderPath)
+        {
+            SetLastError("makeRenderPath failed");
+            return rive_renderer_status_t::internal_error;
+        }
+        renderPath->fillRule(rule);
+
+        std::vector<std::uint8_t>  utf8Buffer;
+        std::vector<rive::Unichar> codepoints;
+        if (utf8_text != nullptr && utf8_length > 0)
+        {
+            utf8Buffer.resize(utf8_length + 1);
+            std::memcpy(utf8Buffer.data(), utf8_text, utf8_length);
+            utf8Buffer[utf8_length] = 0;
+
+            const std::uint8_t* cursor = utf8Buffer.data();
+            while (*cursor != 0)
+            {
+                codepoints.push_back(rive::UTF::NextUTF8(&cursor));
+            }
+        }
+
+        if (!codepoints.empty())
+        {
+            float lineHeight       = style->line_height > 0.0f ? style->line_height : -1.0f;
+            float letterSpacing    = style->letter_spacing;
+            float paragraphSpacing = style->paragraph_spacing >= 0.0f ? style->paragraph_spacing : 0.0f;
+            float maxWidth         = style->width > 0.0f ? style->width : -1.0f;
+
+            rive::TextAlign align;
+            if (!ConvertTextAlign(style->align, &align))
+            {
+                SetLastError("invalid text alignment");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            rive::TextWrap wrap;
+            if (!ConvertTextWrap(style->wrap, &wrap))
+            {
+                SetLastError("invalid text wrap mode");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+
+            std::vector<rive::TextRun> runs;
+            runs.resize(1);
+            runs[0].font          = fontHandle->font;
+            runs[0].size          = style->size;
+            runs[0].lineHeight    = lineHeight;
+            runs[0].letterSpacing = letterSpacing;
+            runs[0].unicharCount  = static_cast<std::uint32_t>(codepoints.size());
+            runs[0].script        = 0;
+            runs[0].styleId       = 0;
+            runs[0].level         = DirectionLevelFromStyle(style->direction);
+
+            rive::Span<const rive::Unichar> textSpan(codepoints.data(), codepoints.size());
+            rive::Span<const rive::TextRun> runSpan(runs.data(), runs.size());
+
+            rive::SimpleArray<rive::Paragraph> paragraphs = fontHandle->font->shapeText(textSpan, runSpan);
+            if (!paragraphs.empty())
+            {
+                rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>> lines =
+                    rive::Text::BreakLines(paragraphs, maxWidth, align, wrap);
+
+                float baselineShift = 0.0f;
+                for (const auto& paragraphLines : lines)
+                {
+                    if (!paragraphLines.empty())
+                    {
+                        baselineShift = paragraphLines[0].baseline;
+                        break;
+                    }
+                }
+
+                float paragraphOffset = 0.0f;
+
+                for (std::size_t paragraphIndex = 0; paragraphIndex < paragraphs.size(); ++paragraphIndex)
+                {
+                    const rive::Paragraph& paragraph      = paragraphs[paragraphIndex];
+                    const auto&            paragraphLines = lines[paragraphIndex];
+
+                    for (const rive::GlyphLine& line : paragraphLines)
+                    {
+                        float renderY = paragraphOffset + line.baseline - baselineShift;
+
+                        float lineWidth = 0.0f;
+                        if (!paragraph.runs.empty())
+                        {
+                            const rive::GlyphRun& endRun   = paragraph.runs[line.endRunIndex];
+                            const rive::GlyphRun& startRun = paragraph.runs[line.startRunIndex];
+                            lineWidth = endRun.xpos[line.endGlyphIndex] - startRun.xpos[line.startGlyphIndex];
+                        }
+
+                        rive::OrderedLine orderedLine(paragraph, line, lineWidth, false, false, nullptr, renderY);
+                        float             curX = line.startX;
+                        for (auto glyphEntry : orderedLine)
+                        {
+                            const rive::GlyphRun* glyphRun;
+                            std::uint32_t         glyphIndex;
+                            std::tie(glyphRun, glyphIndex) = glyphEntry;
+                            if (glyphRun == nullptr || glyphIndex >= glyphRun->glyphs.size())
+                            {
+                                continue;
+                            }
+
+                            float         advance   = glyphRun->advances[glyphIndex];
+                            rive::RawPath glyphPath = glyphRun->font->getPath(glyphRun->glyphs[glyphIndex]);
+
+                            rive::TransformComponents components;
+                            components.scaleX(glyphRun->size);
+                            components.scaleY(glyphRun->size);
+                            components.x(-advance * 0.5f);
+
+                            rive::Mat2D        glyphMatrix = rive::Mat2D::compose(components);
+                            const rive::Vec2D& offset      = glyphRun->offsets[glyphIndex];
+                            glyphMatrix =
+                                rive::Mat2D::fromTranslate(curX + advance * 0.5f + offset.x, renderY + offset.y) *
+                                glyphMatrix;
+                            glyphPath.transformInPlace(glyphMatrix);
+                            renderPath->addRawPath(glyphPath);
+                            curX += advance;
+                        }
+                    }
+
+                    if (!paragraphLines.empty())
+                    {
+                        paragraphOffset += paragraphLines.back().bottom - baselineShift;
+                    }
+                    paragraphOffset += paragraphSpacing;
+                }
+            }
+        }
+
+        auto* handle = new (std::nothrow) PathHandle();
+        if (handle == nullptr)
         {
-            SetLastError("buffer map failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("allocation failed");
+            return rive_renderer_status_t::out_of_memory;
         }
 
-        std::memcpy(static_cast<std::uint8_t*>(mapped) + offset, data, data_length);
-        handle->buffer->unmap();
+        handle->path     = std::move(renderPath);
+        out_path->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
+#endif
     }
 
-    rive_renderer_status_t rive_renderer_buffer_map(rive_renderer_buffer_t buffer,
-                                                    rive_renderer_buffer_map_flags_t /*flags*/,
-                                                    rive_renderer_mapped_memory_t* out_mapping)
+    rive_renderer_status_t rive_renderer_context_bind_cpu_framebuffer(rive_renderer_context_t      context,
+                                                                      std::uint8_t*                pixels,
+                                                                      std::size_t                  stride,
+                                                                      std::size_t                  length,
+                                                                      rive_renderer_pixel_format_t format)
     {
-        if (out_mapping == nullptr)
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
-            SetLastError("mapped memory output pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        auto* handle = ToBuffer(buffer);
-        if (handle == nullptr || !handle->buffer)
+        if (handle->device == nullptr || handle->device->backend != rive_renderer_backend_t::null)
         {
-            SetLastError("buffer handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("cpu framebuffer binding not supported for this backend");
+            return rive_renderer_status_t::unsupported;
         }
 
-        if (handle->mapped_ptr != nullptr)
+        if (handle->cpuFrameRecording)
         {
-            SetLastError("buffer is already mapped");
+            SetLastError("cpu framebuffer cannot be rebound while a frame is recording");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        void* mapped = handle->buffer->map();
-        if (mapped == nullptr)
+        if (handle->sharedFramebuffer)
         {
-            SetLastError("buffer map failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("cpu framebuffer is shared; release the shared framebuffer first");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->mapped_ptr = mapped;
-        out_mapping->data  = mapped;
-        out_mapping->length =
-            handle->size_in_bytes == 0 ? handle->buffer->sizeInBytes() : handle->size_in_bytes;
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_buffer_unmap(rive_renderer_buffer_t buffer,
-                                                      const rive_renderer_mapped_memory_t* /*mapping*/,
-                                                      std::size_t written_bytes)
-    {
-        auto* handle = ToBuffer(buffer);
-        if (handle == nullptr || !handle->buffer)
+        if (pixels != nullptr)
         {
-            SetLastError("buffer handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            if (!IsValidPixelFormat(format))
+            {
+                SetLastError("unknown pixel format");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            if (reinterpret_cast<std::uintptr_t>(pixels) % 4 != 0 || stride % 4 != 0)
+            {
+                SetLastError("cpu framebuffer pixels and stride must be 4-byte aligned");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+            if (!FitsPixelRows(length, stride, handle->width, handle->height))
+            {
+                SetLastError("cpu framebuffer memory is too small for the context");
+                return rive_renderer_status_t::invalid_parameter;
+            }
         }
 
-        if (handle->mapped_ptr == nullptr)
+        handle->externalFramebuffer = pixels;
+        handle->externalStride      = pixels != nullptr ? stride : 0;
+        handle->externalLength      = pixels != nullptr ? length : 0;
+        handle->externalFormat      = pixels != nullptr ? format : rive_renderer_pixel_format_t::rgba8_premultiplied;
+        // Neither the new memory nor a reallocated internal framebuffer holds the previous frame.
+        handle->trackedFrames = 0;
+        if (pixels != nullptr)
         {
-            SetLastError("buffer is not mapped");
-            return rive_renderer_status_t::invalid_parameter;
+            std::vector<std::uint8_t>().swap(handle->cpuFramebuffer);
         }
-
-        handle->buffer->unmap();
-        handle->mapped_ptr = nullptr;
-        static_cast<void>(written_bytes);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_image_decode(rive_renderer_context_t context, const std::uint8_t* encoded_data,
-                                                      std::size_t encoded_length, rive_renderer_image_t* out_image)
+    rive_renderer_status_t rive_renderer_context_set_shared_framebuffer(rive_renderer_context_t      context,
+                                                                        std::uint32_t                slot_count,
+                                                                        rive_renderer_pixel_format_t format,
+                                                                        rive_renderer_shared_framebuffer_t* out_info)
     {
-        if (out_image == nullptr)
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
-            SetLastError("image output pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("context handle is null");
+            return rive_renderer_status_t::invalid_handle;
         }
 
-        auto* ctx = ToContext(context);
-        if (ctx == nullptr)
+        if (slot_count != 0 && out_info == nullptr)
         {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("shared framebuffer output pointer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        if (!ctx->renderContext)
+        if (handle->device == nullptr || handle->device->backend != rive_renderer_backend_t::null)
         {
-            SetLastError("render context unavailable");
+            SetLastError("shared framebuffer not supported for this backend");
             return rive_renderer_status_t::unsupported;
         }
 
-        if (encoded_data == nullptr || encoded_length == 0)
+        if (handle->cpuFrameRecording)
         {
-            SetLastError("encoded image data is invalid");
+            SetLastError("shared framebuffer cannot change while a frame is recording");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::Span<const std::uint8_t> bytes(encoded_data, encoded_length);
-        rive::rcp<rive::RenderImage>   image = ctx->renderContext->decodeImage(bytes);
-        if (!image)
+        if (!handle->sharedFramebuffer && handle->externalFramebuffer != nullptr)
         {
-            SetLastError("decodeImage failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("cpu framebuffer memory is bound; unbind it first");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        auto* handle = new (std::nothrow) ImageHandle();
-        if (handle == nullptr)
+        if (slot_count != 0 && (slot_count < 2 || slot_count > RIVE_RENDERER_MAX_SHARED_FRAMEBUFFER_SLOTS))
         {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
+            SetLastError("shared framebuffer slot count must be between 2 and "
+                         "RIVE_RENDERER_MAX_SHARED_FRAMEBUFFER_SLOTS");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        handle->image     = std::move(image);
-        out_image->handle = handle;
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
+        if (slot_count != 0 && !IsValidPixelFormat(format))
+        {
+            SetLastError("unknown pixel format");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-    rive_renderer_status_t rive_renderer_image_retain(rive_renderer_image_t image)
-    {
-        auto* handle = ToImage(image);
-        if (handle == nullptr || !handle->image)
+        std::unique_ptr<SharedFramebuffer> framebuffer;
+        if (slot_count != 0)
         {
-            SetLastError("image handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            auto status = CreateSharedFramebuffer(handle->width, handle->height, slot_count, format, &framebuffer);
+            if (status != rive_renderer_status_t::ok)
+            {
+                return status;
+            }
         }
 
-        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        handle->sharedFramebuffer   = std::move(framebuffer);
+        handle->externalFramebuffer = nullptr;
+        handle->externalStride      = 0;
+        handle->externalLength      = 0;
+        handle->externalFormat      = rive_renderer_pixel_format_t::rgba8_premultiplied;
+        handle->trackedFrames       = 0;
+        if (handle->sharedFramebuffer)
+        {
+            std::vector<std::uint8_t>().swap(handle->cpuFramebuffer);
+            out_info->fd       = handle->sharedFramebuffer->fd;
+            out_info->reserved = 0;
+            out_info->size     = handle->sharedFramebuffer->size;
+        }
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_image_release(rive_renderer_image_t image)
+    rive_renderer_status_t rive_renderer_context_copy_cpu_framebuffer(rive_renderer_context_t context,
+                                                                      std::uint8_t*           out_pixels,
+                                                                      std::size_t             buffer_length)
     {
-        auto* handle = ToImage(image);
-        if (handle == nullptr || !handle->image)
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
-            SetLastError("image handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
-        if (previous == 0)
+        if (out_pixels == nullptr)
         {
-            SetLastError("image handle refcount underflow");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("output pixel buffer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        if (previous == 1)
+        const std::size_t required = static_cast<std::size_t>(handle->width) * handle->height * 4;
+        if (buffer_length < required)
         {
-            delete handle;
+            SetLastError("output buffer too small");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_image_get_size(rive_renderer_image_t image, std::uint32_t* out_width,
-                                                        std::uint32_t* out_height)
-    {
-        auto* handle = ToImage(image);
-        if (handle == nullptr || !handle->image)
+        const std::uint8_t* pixels = nullptr;
+        std::size_t         stride = 0;
+        auto                status = GetFramebufferPixels(handle, &pixels, &stride);
+        if (status != rive_renderer_status_t::ok)
         {
-            SetLastError("image handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            return status;
         }
 
-        if (out_width == nullptr || out_height == nullptr)
+        const std::size_t rowBytes = static_cast<std::size_t>(handle->width) * 4;
+        if (stride == rowBytes)
         {
-            SetLastError("size output pointers are null");
-            return rive_renderer_status_t::null_pointer;
+            std::memcpy(out_pixels, pixels, required);
+        }
+        else
+        {
+            for (std::uint32_t y = 0; y < handle->height; ++y)
+            {
+                std::memcpy(out_pixels + y * rowBytes, pixels + y * stride, rowBytes);
+            }
         }
-
-        *out_width  = static_cast<std::uint32_t>(handle->image->width());
-        *out_height = static_cast<std::uint32_t>(handle->image->height());
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_renderer_draw_image(rive_renderer_renderer_t             renderer,
-                                                             rive_renderer_image_t                image,
-                                                             const rive_renderer_image_sampler_t* sampler,
-                                                             rive_renderer_blend_mode_t blend_mode, float opacity)
+    rive_renderer_status_t rive_renderer_context_copy_cpu_framebuffer_region(rive_renderer_context_t context,
+                                                                             const rive_renderer_pixel_rect_t* rect,
+                                                                             rive_renderer_pixel_format_t format,
+                                                                             std::uint8_t* out_pixels,
+                                                                             std::size_t   destination_stride,
+                                                                             std::size_t   buffer_length)
     {
-        auto* rendererHandle = ToRenderer(renderer);
-        auto* imageHandle    = ToImage(image);
-        if (rendererHandle == nullptr || !rendererHandle->renderer || imageHandle == nullptr || !imageHandle->image)
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
-            SetLastError("renderer/image handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        rive::BlendMode mode;
-        if (!ConvertBlendMode(blend_mode, &mode))
+        if (out_pixels == nullptr)
         {
-            SetLastError("invalid blend mode");
-            return rive_renderer_status_t::invalid_parameter;
+            SetLastError("output pixel buffer is null");
+            return rive_renderer_status_t::null_pointer;
         }
 
-        rive::ImageSampler nativeSampler = ConvertImageSampler(sampler);
-        rendererHandle->renderer->drawImage(imageHandle->image.get(), nativeSampler, mode, opacity);
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-    }
-
-    rive_renderer_status_t rive_renderer_renderer_draw_image_mesh(
-        rive_renderer_renderer_t renderer, rive_renderer_image_t image, const rive_renderer_image_sampler_t* sampler,
-        rive_renderer_buffer_t vertices, rive_renderer_buffer_t uvs, rive_renderer_buffer_t indices,
-        std::uint32_t vertex_count, std::uint32_t index_count, rive_renderer_blend_mode_t blend_mode, float opacity)
-    {
-        auto* rendererHandle = ToRenderer(renderer);
-        auto* imageHandle    = ToImage(image);
-        auto* verticesHandle = ToBuffer(vertices);
-        auto* uvsHandle      = ToBuffer(uvs);
-        auto* indicesHandle  = ToBuffer(indices);
-        if (rendererHandle == nullptr || !rendererHandle->renderer || imageHandle == nullptr || !imageHandle->image ||
-            verticesHandle == nullptr || !verticesHandle->buffer || uvsHandle == nullptr || !uvsHandle->buffer ||
-            indicesHandle == nullptr || !indicesHandle->buffer)
+        if (!IsValidPixelFormat(format))
         {
-            SetLastError("renderer/image/buffer handle is invalid");
-            return rive_renderer_status_t::invalid_handle;
+            SetLastError("unknown pixel format");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (verticesHandle->type != rive_renderer_buffer_type_t::vertex ||
-            uvsHandle->type != rive_renderer_buffer_type_t::vertex)
+        const rive_renderer_pixel_rect_t region = rect != nullptr ? *rect
+                                                                  : rive_renderer_pixel_rect_t {0, 0, handle->width,
+                                                                                                handle->height};
+        if (region.width == 0 || region.height == 0 ||
+            static_cast<std::uint64_t>(region.x) + region.width > handle->width ||
+            static_cast<std::uint64_t>(region.y) + region.height > handle->height)
         {
-            SetLastError("vertex/uv buffers must be vertex buffers");
+            SetLastError("copy rect must be non-empty and inside the target");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (indicesHandle->type != rive_renderer_buffer_type_t::index)
+        if (destination_stride < static_cast<std::size_t>(region.width) * 4)
         {
-            SetLastError("index buffer must be an index buffer");
+            SetLastError("destination stride is smaller than a row");
             return rive_renderer_status_t::invalid_parameter;
         }
-
-        if (vertex_count == 0 || index_count == 0)
+        if (!FitsPixelRows(buffer_length, destination_stride, region.width, region.height))
         {
-            SetLastError("vertex/index counts must be non-zero");
+            SetLastError("output buffer too small");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::BlendMode mode;
-        if (!ConvertBlendMode(blend_mode, &mode))
+        const std::uint8_t* pixels       = nullptr;
+        std::size_t         sourceStride = 0;
+        auto                status       = GetFramebufferPixels(handle, &pixels, &sourceStride);
+        if (status != rive_renderer_status_t::ok)
         {
-            SetLastError("invalid blend mode");
-            return rive_renderer_status_t::invalid_parameter;
+            return status;
         }
 
-        rive::ImageSampler nativeSampler = ConvertImageSampler(sampler);
-
-        rendererHandle->renderer->drawImageMesh(imageHandle->image.get(), nativeSampler, verticesHandle->buffer,
-                                                uvsHandle->buffer, indicesHandle->buffer, vertex_count, index_count,
-                                                mode, opacity);
+        ConvertPixelRows(*handle->device, pixels + region.y * sourceStride + region.x * 4, sourceStride, out_pixels,
+                         destination_stride, region.width, region.height, format);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
 
-    rive_renderer_status_t rive_renderer_font_decode(rive_renderer_context_t context, const std::uint8_t* font_data,
-                                                     std::size_t font_length, rive_renderer_font_t* out_font)
+    rive_renderer_status_t rive_renderer_context_encode_framebuffer(rive_renderer_context_t        context,
+                                                                    rive_renderer_image_encoding_t encoding,
+                                                                    std::uint8_t                   quality,
+                                                                    rive_renderer_encoded_image_t* out_image)
     {
-        if (out_font == nullptr)
+        if (out_image == nullptr)
         {
-            SetLastError("font output pointer is null");
+            SetLastError("encoded image output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-#if !defined(WITH_RIVE_TEXT)
-        (void) context;
-        (void) font_data;
-        (void) font_length;
-        SetLastError("text support not available");
-        return rive_renderer_status_t::unsupported;
-#else
-        auto* ctx = ToContext(context);
-        if (ctx == nullptr)
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
             SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        auto encodingStatus = ValidateImageEncoding(encoding);
+        if (encodingStatus != rive_renderer_status_t::ok)
         {
-            SetLastError("render context unavailable");
-            return rive_renderer_status_t::unsupported;
+            return encodingStatus;
         }
 
-        if (font_data == nullptr || font_length == 0)
+        if (quality > 100)
         {
-            SetLastError("font data is invalid");
+            SetLastError("quality must be between 0 and 100");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::Span<const std::uint8_t> bytes(font_data, font_length);
-        rive::rcp<rive::Font>          font = ctx->renderContext->decodeFont(bytes);
-        if (!font)
+        const std::uint8_t* pixels = nullptr;
+        std::size_t         stride = 0;
+        auto                status = GetFramebufferPixels(handle, &pixels, &stride);
+        if (status != rive_renderer_status_t::ok)
         {
-            SetLastError("decodeFont failed");
-            return rive_renderer_status_t::internal_error;
+            return status;
         }
 
-        auto* handle = new (std::nothrow) FontHandle();
-        if (handle == nullptr)
+        if (handle->encodeScratch == nullptr)
+        {
+            handle->encodeScratch.reset(new (std::nothrow) rive_renderer_cpu::EncodeScratch());
+        }
+        auto* image = new (std::nothrow) EncodedImageHandle();
+        if (image == nullptr || handle->encodeScratch == nullptr)
         {
+            delete image;
             SetLastError("allocation failed");
             return rive_renderer_status_t::out_of_memory;
         }
+        image->bytes = TakeEncodedBuffer(handle);
 
-        handle->font     = std::move(font);
-        out_font->handle = handle;
+        if (!EncodePixels(*handle->device, pixels, stride, handle->width, handle->height, quality,
+                          handle->encodeScratch.get(), &image->bytes))
+        {
+            ReturnEncodedBuffer(handle, std::move(image->bytes));
+            delete image;
+            SetLastError("failed to encode framebuffer");
+            return rive_renderer_status_t::internal_error;
+        }
+
+        image->context = handle;
+        handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+        out_image->handle = image;
         ClearLastError();
         return rive_renderer_status_t::ok;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_font_retain(rive_renderer_font_t font)
+    rive_renderer_status_t rive_renderer_encoded_image_retain(rive_renderer_encoded_image_t image)
     {
-#if !defined(WITH_RIVE_TEXT)
-        (void) font;
-        SetLastError("text support not available");
-        return rive_renderer_status_t::unsupported;
-#else
-        auto* handle = ToFont(font);
-        if (handle == nullptr || !handle->font)
+        auto* handle = ToEncodedImage(image);
+        if (handle == nullptr)
         {
-            SetLastError("font handle is invalid");
+            SetLastError("encoded image handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
         handle->ref_count.fetch_add(1, std::memory_order_relaxed);
         ClearLastError();
         return rive_renderer_status_t::ok;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_font_release(rive_renderer_font_t font)
+    rive_renderer_status_t rive_renderer_encoded_image_release(rive_renderer_encoded_image_t image)
     {
-#if !defined(WITH_RIVE_TEXT)
-        (void) font;
-        SetLastError("text support not available");
-        return rive_renderer_status_t::unsupported;
-#else
-        auto* handle = ToFont(font);
-        if (handle == nullptr || !handle->font)
+        auto* handle = ToEncodedImage(image);
+        if (handle == nullptr)
         {
-            SetLastError("font handle is invalid");
+            SetLastError("encoded image handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
         const std::uint32_t previous = handle->ref_count.fetch_sub(1, std::memory_order_acq_rel);
         if (previous == 0)
         {
-            SetLastError("font handle refcount underflow");
+            handle->ref_count.fetch_add(1, std::memory_order_relaxed);
+            SetLastError("encoded image handle refcount underflow");
             return rive_renderer_status_t::internal_error;
         }
 
         if (previous == 1)
         {
+            auto* context = handle->context;
+            ReturnEncodedBuffer(context, std::move(handle->bytes));
             delete handle;
+            return rive_renderer_context_release({context});
         }
 
         ClearLastError();
         return rive_renderer_status_t::ok;
-#endif
     }
 
-    rive_renderer_status_t rive_renderer_text_create_path(rive_renderer_context_t context, rive_renderer_font_t font,
-                                                          const char* utf8_text, std::size_t utf8_length,
-                                                          const rive_renderer_text_style_t* style,
-                                                          rive_renderer_fill_rule_t         fill_rule,
-                                                          rive_renderer_path_t*             out_path)
+    rive_renderer_status_t rive_renderer_encoded_image_map(rive_renderer_encoded_image_t  image,
+                                                           rive_renderer_mapped_memory_t* out_mapping)
     {
-        if (out_path == nullptr)
+        if (out_mapping == nullptr)
         {
-            SetLastError("path output pointer is null");
+            SetLastError("mapped memory output pointer is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-#if !defined(WITH_RIVE_TEXT)
-        (void) context;
-        (void) font;
-        (void) utf8_text;
-        (void) utf8_length;
-        (void) style;
-        (void) fill_rule;
-        SetLastError("text support not available");
-        return rive_renderer_status_t::unsupported;
-#else
-        auto* ctx = ToContext(context);
-        if (ctx == nullptr)
+        auto* handle = ToEncodedImage(image);
+        if (handle == nullptr)
         {
-            SetLastError("context handle is null");
+            SetLastError("encoded image handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
-        {
-            SetLastError("render context unavailable");
-            return rive_renderer_status_t::unsupported;
-        }
+        out_mapping->data   = handle->bytes.data();
+        out_mapping->length = handle->bytes.size();
+        ClearLastError();
+        return rive_renderer_status_t::ok;
+    }
 
-        auto* fontHandle = ToFont(font);
-        if (fontHandle == nullptr || !fontHandle->font)
+    rive_renderer_status_t rive_renderer_context_render_batch(rive_renderer_context_t                  context,
+                                                              const rive_renderer_batch_render_info_t* info)
+    {
+        auto* handle = ToContext(context);
+        if (handle == nullptr)
         {
-            SetLastError("font handle is invalid");
+            SetLastError("context handle is null");
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (style == nullptr)
+        if (info == nullptr || info->on_frame == nullptr)
         {
-            SetLastError("text style pointer is null");
+            SetLastError("batch render info or frame callback is null");
             return rive_renderer_status_t::null_pointer;
         }
 
-        if (utf8_length > 0 && utf8_text == nullptr)
+        if ((info->scene == nullptr) == (info->pictures == nullptr || info->picture_count == 0))
         {
-            SetLastError("text pointer is null");
-            return rive_renderer_status_t::null_pointer;
+            SetLastError("batch needs either a scene callback or pictures");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (style->size <= 0.0f)
+        if (info->frame_count == 0 || info->max_frames_in_flight == 0 ||
+            info->max_frames_in_flight > RIVE_RENDERER_MAX_BATCH_FRAMES_IN_FLIGHT)
         {
-            SetLastError("text size must be positive");
+            SetLastError("batch frame count and frames in flight are out of range");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::FillRule rule;
-        if (!ConvertFillRule(fill_rule, &rule))
+        if (info->encode != 0)
         {
-            SetLastError("invalid fill rule");
+            auto encodingStatus = ValidateImageEncoding(info->encoding);
+            if (encodingStatus != rive_renderer_status_t::ok)
+            {
+                return encodingStatus;
+            }
+            if (info->quality > 100)
+            {
+                SetLastError("batch quality must be between 0 and 100");
+                return rive_renderer_status_t::invalid_parameter;
+            }
+        }
+        else if (!IsValidPixelFormat(info->format))
+        {
+            SetLastError("unknown pixel format");
             return rive_renderer_status_t::invalid_parameter;
         }
 
-        rive::rcp<rive::RenderPath> renderPath = ctx->renderContext->makeEmptyRenderPath();
-        if (!renderPath)
+        const auto backend = handle->device != nullptr ? handle->device->backend : rive_renderer_backend_t::unknown;
+        if (backend != rive_renderer_backend_t::null && backend != rive_renderer_backend_t::vulkan)
         {
-            SetLastError("makeRenderPath failed");
-            return rive_renderer_status_t::internal_error;
+            SetLastError("batch rendering not supported for this backend");
+            return rive_renderer_status_t::unsupported;
         }
-        renderPath->fillRule(rule);
 
-        std::vector<std::uint8_t>  utf8Buffer;
-        std::vector<rive::Unichar> codepoints;
-        if (utf8_text != nullptr && utf8_length > 0)
+        if (handle->hasActiveFrame || handle->cpuFrameRecording)
         {
-            utf8Buffer.resize(utf8_length + 1);
-            std::memcpy(utf8Buffer.data(), utf8_text, utf8_length);
-            utf8Buffer[utf8_length] = 0;
-
-            const std::uint8_t* cursor = utf8Buffer.data();
-            while (*cursor != 0)
-            {
-                codepoints.push_back(rive::UTF::NextUTF8(&cursor));
-            }
+            SetLastError("batch cannot start while a frame is recording");
+            return rive_renderer_status_t::invalid_parameter;
         }
 
-        if (!codepoints.empty())
+        if (handle->externalFramebuffer != nullptr || handle->sharedFramebuffer)
         {
-            float lineHeight       = style->line_height > 0.0f ? style->line_height : -1.0f;
-            float letterSpacing    = style->letter_spacing;
-            float paragraphSpacing = style->paragraph_spacing >= 0.0f ? style->paragraph_spacing : 0.0f;
-            float maxWidth         = style->width > 0.0f ? style->width : -1.0f;
+            SetLastError("batch cannot render while cpu framebuffer memory is bound or shared");
+            return rive_renderer_status_t::invalid_parameter;
+        }
 
-            rive::TextAlign align;
-            if (!ConvertTextAlign(style->align, &align))
+        BatchState batch;
+        batch.info   = info;
+        batch.device = handle->device;
+        batch.width  = handle->width;
+        batch.height = handle->height;
+        batch.slots.resize(info->max_frames_in_flight);
+        for (auto& slot : batch.slots)
+        {
+            if (backend == rive_renderer_backend_t::null)
             {
-                SetLastError("invalid text alignment");
-                return rive_renderer_status_t::invalid_parameter;
+                slot.pixels.resize(static_cast<std::size_t>(batch.width) * batch.height * 4);
             }
+            batch.freeSlots.push_back(&slot);
+        }
 
-            rive::TextWrap wrap;
-            if (!ConvertTextWrap(style->wrap, &wrap))
+        // Every frame is drawn in full, so damage tracking is suspended until the batch ends.
+        const bool damageTracking = handle->damageTracking;
+        handle->damageTracking    = false;
+
+        std::thread output(RunBatchOutput, &batch);
+        for (std::uint32_t frame = 0; frame < info->frame_count; ++frame)
+        {
+            BatchSlot* slot = AcquireBatchSlot(&batch);
+            if (slot == nullptr)
             {
-                SetLastError("invalid text wrap mode");
-                return rive_renderer_status_t::invalid_parameter;
+                break;
             }
 
-            std::vector<rive::TextRun> runs;
-            runs.resize(1);
-            runs[0].font          = fontHandle->font;
-            runs[0].size          = style->size;
-            runs[0].lineHeight    = lineHeight;
-            runs[0].letterSpacing = letterSpacing;
-            runs[0].unicharCount  = static_cast<std::uint32_t>(codepoints.size());
-            runs[0].script        = 0;
-            runs[0].styleId       = 0;
-            runs[0].level         = DirectionLevelFromStyle(style->direction);
-
-            rive::Span<const rive::Unichar> textSpan(codepoints.data(), codepoints.size());
-            rive::Span<const rive::TextRun> runSpan(runs.data(), runs.size());
-
-            rive::SimpleArray<rive::Paragraph> paragraphs = fontHandle->font->shapeText(textSpan, runSpan);
-            if (!paragraphs.empty())
+            auto status = RenderBatchFrame(handle, &batch, slot, frame);
+            if (status == rive_renderer_status_t::ok)
             {
-                rive::SimpleArray<rive::SimpleArray<rive::GlyphLine>> lines =
-                    rive::Text::BreakLines(paragraphs, maxWidth, align, wrap);
-
-                float baselineShift = 0.0f;
-                for (const auto& paragraphLines : lines)
+                if (slot->readback.handle != nullptr)
                 {
-                    if (!paragraphLines.empty())
+                    batch.submitted.push_back(slot);
+                    // Frames past the in-flight limit have finished on the GPU, or soon will.
+                    while (batch.submitted.size() > handle->framesInFlight && status == rive_renderer_status_t::ok)
                     {
-                        baselineShift = paragraphLines[0].baseline;
-                        break;
+                        BatchSlot* oldest = batch.submitted.front();
+                        batch.submitted.pop_front();
+                        status = QueueBatchFrame(&batch, oldest);
                     }
                 }
-
-                float paragraphOffset = 0.0f;
-
-                for (std::size_t paragraphIndex = 0; paragraphIndex < paragraphs.size(); ++paragraphIndex)
+                else
                 {
-                    const rive::Paragraph& paragraph      = paragraphs[paragraphIndex];
-                    const auto&            paragraphLines = lines[paragraphIndex];
-
-                    for (const rive::GlyphLine& line : paragraphLines)
-                    {
-                        float renderY = paragraphOffset + line.baseline - baselineShift;
-
-                        float lineWidth = 0.0f;
-                        if (!paragraph.runs.empty())
-                        {
-                            const rive::GlyphRun& endRun   = paragraph.runs[line.endRunIndex];
-                            const rive::GlyphRun& startRun = paragraph.runs[line.startRunIndex];
-                            lineWidth = endRun.xpos[line.endGlyphIndex] - startRun.xpos[line.startGlyphIndex];
-                        }
-
-                        rive::OrderedLine orderedLine(paragraph, line, lineWidth, false, false, nullptr, renderY);
-                        float             curX = line.startX;
-                        for (auto glyphEntry : orderedLine)
-                        {
-                            const rive::GlyphRun* glyphRun;
-                            std::uint32_t         glyphIndex;
-                            std::tie(glyphRun, glyphIndex) = glyphEntry;
-                            if (glyphRun == nullptr || glyphIndex >= glyphRun->glyphs.size())
-                            {
-                                continue;
-                            }
-
-                            float         advance   = glyphRun->advances[glyphIndex];
-                            rive::RawPath glyphPath = glyphRun->font->getPath(glyphRun->glyphs[glyphIndex]);
-
-                            rive::TransformComponents components;
-                            components.scaleX(glyphRun->size);
-                            components.scaleY(glyphRun->size);
-                            components.x(-advance * 0.5f);
-
-                            rive::Mat2D        glyphMatrix = rive::Mat2D::compose(components);
-                            const rive::Vec2D& offset      = glyphRun->offsets[glyphIndex];
-                            glyphMatrix =
-                                rive::Mat2D::fromTranslate(curX + advance * 0.5f + offset.x, renderY + offset.y) *
-                                glyphMatrix;
-                            glyphPath.transformInPlace(glyphMatrix);
-                            renderPath->addRawPath(glyphPath);
-                            curX += advance;
-                        }
-                    }
-
-                    if (!paragraphLines.empty())
-                    {
-                        paragraphOffset += paragraphLines.back().bottom - baselineShift;
-                    }
-                    paragraphOffset += paragraphSpacing;
+                    status = QueueBatchFrame(&batch, slot);
                 }
             }
+            if (status != rive_renderer_status_t::ok)
+            {
+                FailBatch(&batch, status, g_lastError);
+                break;
+            }
         }
 
-        auto* handle = new (std::nothrow) PathHandle();
-        if (handle == nullptr)
-        {
-            SetLastError("allocation failed");
-            return rive_renderer_status_t::out_of_memory;
-        }
-
-        handle->path     = std::move(renderPath);
-        out_path->handle = handle;
-        ClearLastError();
-        return rive_renderer_status_t::ok;
-#endif
-    }
-
-    rive_renderer_status_t rive_renderer_context_copy_cpu_framebuffer(rive_renderer_context_t context,
-                                                                      std::uint8_t*           out_pixels,
-                                                                      std::size_t             buffer_length)
-    {
-        auto* handle = ToContext(context);
-        if (handle == nullptr)
-        {
-            SetLastError("context handle is null");
-            return rive_renderer_status_t::invalid_handle;
-        }
-
-        if (out_pixels == nullptr)
+        while (!batch.submitted.empty() && !BatchFailed(&batch))
         {
-            SetLastError("output pixel buffer is null");
-            return rive_renderer_status_t::null_pointer;
+            BatchSlot* oldest = batch.submitted.front();
+            batch.submitted.pop_front();
+            auto status = QueueBatchFrame(&batch, oldest);
+            if (status != rive_renderer_status_t::ok)
+            {
+                FailBatch(&batch, status, g_lastError);
+            }
         }
 
-        const std::size_t required = static_cast<std::size_t>(handle->width) * handle->height * 4;
-        if (buffer_length < required)
         {
-            SetLastError("output buffer too small");
-            return rive_renderer_status_t::invalid_parameter;
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            batch.finished = true;
+            batch.changed.notify_all();
         }
+        output.join();
 
-        if (handle->device == nullptr || handle->device->backend != rive_renderer_backend_t::null)
+        for (auto& slot : batch.slots)
         {
-            SetLastError("cpu framebuffer capture not supported for this backend");
-            return rive_renderer_status_t::unsupported;
+            if (slot.readback.handle != nullptr)
+            {
+                rive_renderer_readback_release(slot.readback);
+            }
         }
+        handle->externalFramebuffer = nullptr;
+        handle->externalStride      = 0;
+        handle->externalLength      = 0;
+        handle->externalFormat      = rive_renderer_pixel_format_t::rgba8_premultiplied;
+        handle->damageTracking      = damageTracking;
+        handle->trackedFrames       = 0;
 
-        if (handle->cpuFramebuffer.size() != required)
+        if (batch.status != rive_renderer_status_t::ok)
         {
-            SetLastError("cpu framebuffer not initialized");
-            return rive_renderer_status_t::internal_error;
+            SetLastError(batch.error.c_str());
+            return batch.status;
         }
-
-        std::memcpy(out_pixels, handle->cpuFramebuffer.data(), required);
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
@@ -4541,7 +10213,8 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
             SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
@@ -4561,7 +10234,7 @@ extern "C"
             stopValues[i]  = stops[i];
         }
 
-        rive::rcp<rive::RenderShader> shader = ctx->renderContext->makeLinearGradient(
+        rive::rcp<rive::RenderShader> shader = factory->makeLinearGradient(
             start_x, start_y, end_x, end_y, colorValues.data(), stopValues.data(), stop_count);
         if (!shader)
         {
@@ -4576,7 +10249,16 @@ extern "C"
             return rive_renderer_status_t::out_of_memory;
         }
 
+        auto gradient       = std::make_shared<GradientSpec>();
+        gradient->coords[0] = start_x;
+        gradient->coords[1] = start_y;
+        gradient->coords[2] = end_x;
+        gradient->coords[3] = end_y;
+        gradient->colors    = std::move(colorValues);
+        gradient->stops     = std::move(stopValues);
+
         handle->shader     = std::move(shader);
+        handle->gradient   = std::move(gradient);
         out_shader->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
@@ -4601,7 +10283,8 @@ extern "C"
             return rive_renderer_status_t::invalid_handle;
         }
 
-        if (!ctx->renderContext)
+        rive::Factory* factory = GetFactory(ctx);
+        if (factory == nullptr)
         {
             SetLastError("render context unavailable");
             return rive_renderer_status_t::unsupported;
@@ -4621,7 +10304,7 @@ extern "C"
             stopValues[i]  = stops[i];
         }
 
-        rive::rcp<rive::RenderShader> shader = ctx->renderContext->makeRadialGradient(
+        rive::rcp<rive::RenderShader> shader = factory->makeRadialGradient(
             center_x, center_y, radius, colorValues.data(), stopValues.data(), stop_count);
         if (!shader)
         {
@@ -4636,7 +10319,16 @@ extern "C"
             return rive_renderer_status_t::out_of_memory;
         }
 
+        auto gradient       = std::make_shared<GradientSpec>();
+        gradient->radial    = true;
+        gradient->coords[0] = center_x;
+        gradient->coords[1] = center_y;
+        gradient->coords[2] = radius;
+        gradient->colors    = std::move(colorValues);
+        gradient->stops     = std::move(stopValues);
+
         handle->shader     = std::move(shader);
+        handle->gradient   = std::move(gradient);
         out_shader->handle = handle;
         ClearLastError();
         return rive_renderer_status_t::ok;
@@ -4699,6 +10391,9 @@ extern "C"
 
         paintHandle->paint->shader(shaderHandle->shader);
         paintHandle->paint->invalidateStroke();
+        paintHandle->state.shader   = shaderHandle->shader;
+        paintHandle->state.gradient = shaderHandle->gradient;
+        ++paintHandle->state.version;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
@@ -4714,6 +10409,9 @@ extern "C"
 
         paintHandle->paint->shader(nullptr);
         paintHandle->paint->invalidateStroke();
+        paintHandle->state.shader   = nullptr;
+        paintHandle->state.gradient = nullptr;
+        ++paintHandle->state.version;
         ClearLastError();
         return rive_renderer_status_t::ok;
     }
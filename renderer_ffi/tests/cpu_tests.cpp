@@ -0,0 +1,531 @@
+// Tests for the CPU backend's rasterizer and kernels, built straight from src/cpu without river-renderer. Run every
+// test with no arguments, or a single one by name.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "cpu_canvas.hpp"
+#include "cpu_worker_pool.hpp"
+
+#if defined(RIVE_RENDERER_CPU_TESTS_HAVE_ZLIB)
+#include <zlib.h>
+
+#include "cpu_encode.hpp"
+#endif
+
+using namespace rive_renderer_cpu;
+
+namespace
+{
+    bool Check(bool condition, const char* what)
+    {
+        if (!condition)
+        {
+            std::fprintf(stderr, "  check failed: %s\n", what);
+        }
+        return condition;
+    }
+
+    PathData Rect(float x, float y, float width, float height)
+    {
+        PathData path;
+        path.moveTo(x, y);
+        path.lineTo(x + width, y);
+        path.lineTo(x + width, y + height);
+        path.lineTo(x, y + height);
+        path.close();
+        return path;
+    }
+
+    PathData Circle(float cx, float cy, float radius)
+    {
+        constexpr float kCubic = 0.5522848f;
+        const float     k      = radius * kCubic;
+        PathData        path;
+        path.moveTo(cx + radius, cy);
+        path.cubicTo(cx + radius, cy + k, cx + k, cy + radius, cx, cy + radius);
+        path.cubicTo(cx - k, cy + radius, cx - radius, cy + k, cx - radius, cy);
+        path.cubicTo(cx - radius, cy - k, cx - k, cy - radius, cx, cy - radius);
+        path.cubicTo(cx + k, cy - radius, cx + radius, cy - k, cx + radius, cy);
+        path.close();
+        return path;
+    }
+
+    PathData Star(float cx, float cy, float outer, float inner, int points)
+    {
+        PathData path;
+        for (int i = 0; i < points * 2; ++i)
+        {
+            const float radius = (i % 2) == 0 ? outer : inner;
+            const float angle  = 3.14159265f * static_cast<float>(i) / static_cast<float>(points);
+            const float x      = cx + radius * std::cos(angle);
+            const float y      = cy + radius * std::sin(angle);
+            if (i == 0)
+            {
+                path.moveTo(x, y);
+            }
+            else
+            {
+                path.lineTo(x, y);
+            }
+        }
+        path.close();
+        return path;
+    }
+
+    // Draws a frame whose shapes straddle tile edges and overlap under several blend modes, strokes, a gradient,
+    // feathering and a nested clip, then returns its pixels.
+    std::vector<std::uint8_t> RenderScene(WorkerPool* pool, std::uint32_t width, std::uint32_t height)
+    {
+        Canvas      canvas(pool, DetectSimdLevel());
+        CanvasState state;
+        canvas.beginFrame(width, height);
+
+        Paint background;
+        background.color = 0xff202020;
+        canvas.drawPath(state, Rect(0, 0, static_cast<float>(width), static_cast<float>(height)), background);
+
+        const std::uint32_t colors[] = {0xffff0000, 0x8000ff00, 0xff0000ff};
+        const float         stops[]  = {0.0f, 0.5f, 1.0f};
+        Paint               gradient;
+        gradient.shader = GradientShader::MakeLinear(0, 0, static_cast<float>(width), static_cast<float>(height),
+                                                     colors, stops, 3);
+        canvas.drawPath(state, Circle(70, 60, 55), gradient);
+
+        const BlendMode modes[] = {BlendMode::screen, BlendMode::multiply, BlendMode::difference, BlendMode::hue,
+                                   BlendMode::softLight, BlendMode::colorDodge};
+        for (std::size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+        {
+            Paint paint;
+            paint.color     = 0xc0000000u | (0x3f9a17u * static_cast<std::uint32_t>(i + 1) & 0xffffffu);
+            paint.blendMode = modes[i];
+            canvas.drawPath(state, Circle(40.0f + 37.0f * static_cast<float>(i), 100, 45), paint);
+        }
+
+        Paint stroke;
+        stroke.style            = PaintStyle::stroke;
+        stroke.color            = 0xe0ffd040;
+        stroke.stroke.thickness = 7;
+        stroke.stroke.join      = StrokeJoin::round;
+        canvas.drawPath(state, Star(200, 90, 80, 30, 7), stroke);
+
+        Paint feathered;
+        feathered.color   = 0x9040a0ff;
+        feathered.feather = 12;
+        canvas.drawPath(state, Rect(120, 20, 140, 50), feathered);
+
+        CanvasState clipped = state;
+        canvas.clipPath(&clipped, Circle(160, 140, 70));
+        canvas.clipPath(&clipped, Star(170, 140, 75, 40, 5));
+        Paint evenOdd;
+        evenOdd.color = 0xff30ff90;
+        PathData rings = Circle(165, 140, 60);
+        rings.addPath(Circle(165, 140, 30), Mat2D());
+        rings.fillRule = FillRule::evenOdd;
+        canvas.drawPath(clipped, rings, evenOdd);
+
+        std::vector<std::uint8_t> pixels(static_cast<std::size_t>(width) * height * 4, 0);
+        canvas.endFrame(pixels.data(), width, height, static_cast<std::size_t>(width) * 4);
+        return pixels;
+    }
+
+    bool ParallelRasterizationMatchesSingleThreaded()
+    {
+        // Not a multiple of the tile size, so edge tiles are partial.
+        constexpr std::uint32_t kWidth  = 301;
+        constexpr std::uint32_t kHeight = 203;
+
+        const auto serial = RenderScene(nullptr, kWidth, kHeight);
+
+        bool ok = Check(serial[(100 * kWidth + 40) * 4 + 3] != 0, "scene draws into the frame");
+        for (std::size_t threads : {1, 3, 6})
+        {
+            WorkerPool pool(threads);
+            for (int run = 0; run < 3; ++run)
+            {
+                ok &= Check(RenderScene(&pool, kWidth, kHeight) == serial,
+                            "parallel tiles produce the same pixels as the calling thread alone");
+            }
+        }
+        return ok;
+    }
+
+    // Deterministic pixel generator, so failures reproduce.
+    struct Random
+    {
+        std::uint32_t state {0x12345678u};
+
+        std::uint32_t next()
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        // Premultiplied pixel, biased towards the alpha extremes where the kernels take shortcuts.
+        std::uint32_t pixel()
+        {
+            const std::uint32_t bits = next();
+            std::uint32_t       a    = bits >> 24;
+            if ((bits & 7) == 0)
+            {
+                a = 0;
+            }
+            else if ((bits & 7) == 1)
+            {
+                a = 255;
+            }
+            auto channel = [this, a]() { return a == 0 ? 0 : next() % (a + 1); };
+            return channel() | (channel() << 8) | (channel() << 16) | (a << 24);
+        }
+    };
+
+    const char* SimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::sse41:
+            return "sse4.1";
+        case SimdLevel::avx2:
+            return "avx2";
+        case SimdLevel::avx512:
+            return "avx512";
+        default:
+            return "portable";
+        }
+    }
+
+    // Kernels for every level above portable that this build and CPU can run.
+    std::vector<const BlendKernels*> SimdKernels()
+    {
+        std::vector<const BlendKernels*> kernels;
+        const SimdLevel                  supported = DetectSimdLevel();
+        for (SimdLevel level : {SimdLevel::sse41, SimdLevel::avx2, SimdLevel::avx512})
+        {
+            const BlendKernels& candidate = GetBlendKernels(level);
+            if (level <= supported && candidate.level == level)
+            {
+                kernels.push_back(&candidate);
+            }
+            else
+            {
+                std::printf("  skipping %s: not supported here\n", SimdLevelName(level));
+            }
+        }
+        return kernels;
+    }
+
+    bool BlendKernelsMatchPortable()
+    {
+        const BlendMode modes[] = {BlendMode::srcOver,    BlendMode::screen,    BlendMode::overlay,
+                                   BlendMode::darken,     BlendMode::lighten,   BlendMode::colorDodge,
+                                   BlendMode::colorBurn,  BlendMode::hardLight, BlendMode::softLight,
+                                   BlendMode::difference, BlendMode::exclusion, BlendMode::multiply,
+                                   BlendMode::hue,        BlendMode::saturation, BlendMode::color,
+                                   BlendMode::luminosity};
+        // Lengths around every vector width exercise both the wide loops and their scalar tails.
+        const std::int32_t     counts[]            = {1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 67, 130};
+        const std::uint8_t     constantCoverages[] = {0, 1, 128, 254, 255};
+        constexpr std::int32_t kMaxCount           = 130;
+
+        Random                     random;
+        std::vector<std::uint32_t> dst(kMaxCount + 1);
+        std::vector<std::uint32_t> src(kMaxCount + 1);
+        std::vector<std::uint8_t>  coverage(kMaxCount + 1);
+        std::vector<std::uint32_t> expected(kMaxCount + 1);
+        std::vector<std::uint32_t> actual(kMaxCount + 1);
+
+        bool ok = true;
+        for (const BlendKernels* kernels : SimdKernels())
+        {
+            std::size_t mismatches = 0;
+            for (BlendMode mode : modes)
+            {
+                for (std::int32_t count : counts)
+                {
+                    // Starting one pixel in leaves the spans unaligned.
+                    for (std::int32_t offset : {0, 1})
+                    {
+                        if (offset + count > kMaxCount + 1)
+                        {
+                            continue;
+                        }
+                        for (std::size_t i = 0; i < dst.size(); ++i)
+                        {
+                            dst[i]      = random.pixel();
+                            src[i]      = random.pixel();
+                            coverage[i] = static_cast<std::uint8_t>((random.next() & 3) == 0 ? 255 : random.next());
+                        }
+                        const std::uint32_t color = random.pixel();
+
+                        for (int variant = 0; variant < 2 + 2 * 5; ++variant)
+                        {
+                            const bool          solid        = variant % 2 == 1;
+                            const std::uint8_t* spanCoverage = variant < 2 ? coverage.data() + offset : nullptr;
+                            const std::uint8_t  constant = variant < 2 ? 255 : constantCoverages[(variant - 2) / 2];
+                            expected                     = dst;
+                            actual                       = dst;
+                            if (solid)
+                            {
+                                BlendSolidSpan(mode, expected.data() + offset, color, spanCoverage, constant, count);
+                                kernels->blendSolidSpan(mode, actual.data() + offset, color, spanCoverage, constant,
+                                                        count);
+                            }
+                            else
+                            {
+                                BlendSpan(mode, expected.data() + offset, src.data() + offset, spanCoverage, constant,
+                                          count);
+                                kernels->blendSpan(mode, actual.data() + offset, src.data() + offset, spanCoverage,
+                                                   constant, count);
+                            }
+                            if (actual != expected && mismatches++ == 0)
+                            {
+                                std::fprintf(stderr, "  %s: mode %d count %d offset %d variant %d differs\n",
+                                             SimdLevelName(kernels->level), static_cast<int>(mode), count, offset,
+                                             variant);
+                            }
+                        }
+                    }
+                }
+            }
+            ok &= Check(mismatches == 0, "SIMD blend kernels match the portable kernels");
+        }
+        return ok;
+    }
+
+    bool ConvertKernelsMatchPortable()
+    {
+        // Every color value against every alpha, including the a == 0 and c > a inputs valid premultiplied pixels never
+        // hold, in each channel.
+        std::vector<std::uint32_t> pixels;
+        pixels.reserve(256 * 256);
+        for (std::uint32_t a = 0; a < 256; ++a)
+        {
+            for (std::uint32_t c = 0; c < 256; ++c)
+            {
+                pixels.push_back(c | ((255 - c) << 8) | ((c * 7 & 0xff) << 16) | (a << 24));
+            }
+        }
+        const auto count = static_cast<std::int32_t>(pixels.size());
+
+        // One spare pixel either side, so the kernels also run on unaligned spans.
+        std::vector<std::uint8_t> src((pixels.size() + 2) * 4);
+        std::vector<std::uint8_t> dst(src.size());
+
+        bool ok = true;
+        for (const BlendKernels* kernels : SimdKernels())
+        {
+            std::size_t mismatches = 0;
+            for (int variant = 0; variant < 4; ++variant)
+            {
+                const bool swapRedBlue   = (variant & 1) != 0;
+                const bool unpremultiply = (variant & 2) != 0;
+                for (std::size_t offset : {0, 1})
+                {
+                    std::memcpy(src.data() + offset * 4, pixels.data(), pixels.size() * 4);
+                    for (bool inPlace : {false, true})
+                    {
+                        // The copy leaves src untouched, so the in-place pass that follows still reads the inputs.
+                        std::uint8_t* out = inPlace ? src.data() : dst.data();
+                        kernels->convertSpan(out + offset * 4, src.data() + offset * 4, count, swapRedBlue,
+                                             unpremultiply);
+                        for (std::size_t i = 0; i < pixels.size(); ++i)
+                        {
+                            std::uint32_t actual;
+                            std::memcpy(&actual, out + (offset + i) * 4, sizeof(actual));
+                            const std::uint32_t expected = ConvertPixel(pixels[i], swapRedBlue, unpremultiply);
+                            if (actual != expected && mismatches++ == 0)
+                            {
+                                std::fprintf(stderr,
+                                             "  %s: swap %d unpremultiply %d offset %zu: %08x became %08x, not %08x\n",
+                                             SimdLevelName(kernels->level), swapRedBlue, unpremultiply, offset,
+                                             pixels[i], actual, expected);
+                            }
+                        }
+                    }
+                }
+            }
+            ok &= Check(mismatches == 0, "SIMD convert kernels match ConvertPixel");
+        }
+        return ok;
+    }
+
+#if defined(RIVE_RENDERER_CPU_TESTS_HAVE_ZLIB)
+    std::uint32_t ReadBigEndian(const std::uint8_t* bytes)
+    {
+        return (static_cast<std::uint32_t>(bytes[0]) << 24) | (static_cast<std::uint32_t>(bytes[1]) << 16) |
+               (static_cast<std::uint32_t>(bytes[2]) << 8) | bytes[3];
+    }
+
+    // Inflates the IDAT chunks of an 8-bit RGBA PNG and undoes each row's filter, returning the raw rows, or nothing
+    // when the file is malformed.
+    std::vector<std::uint8_t> DecodePngRows(const std::vector<std::uint8_t>& png, std::uint32_t width,
+                                            std::uint32_t height)
+    {
+        std::vector<std::uint8_t> compressed;
+        for (std::size_t offset = 8; offset + 12 <= png.size();)
+        {
+            const std::uint32_t length = ReadBigEndian(png.data() + offset);
+            if (offset + 12 + length > png.size())
+            {
+                return {};
+            }
+            if (std::memcmp(png.data() + offset + 4, "IDAT", 4) == 0)
+            {
+                compressed.insert(compressed.end(), png.begin() + offset + 8, png.begin() + offset + 8 + length);
+            }
+            offset += 12 + length;
+        }
+
+        const std::size_t         rowBytes = static_cast<std::size_t>(width) * 4;
+        std::vector<std::uint8_t> filtered(height * (rowBytes + 1));
+        uLongf                    filteredLength = static_cast<uLongf>(filtered.size());
+        if (uncompress(filtered.data(), &filteredLength, compressed.data(), static_cast<uLong>(compressed.size())) !=
+                Z_OK ||
+            filteredLength != filtered.size())
+        {
+            return {};
+        }
+
+        std::vector<std::uint8_t> rows(height * rowBytes);
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            const std::uint8_t* in    = filtered.data() + y * (rowBytes + 1);
+            std::uint8_t*       row   = rows.data() + y * rowBytes;
+            const std::uint8_t* above = y > 0 ? row - rowBytes : nullptr;
+            for (std::size_t i = 0; i < rowBytes; ++i)
+            {
+                const int left      = i >= 4 ? row[i - 4] : 0;
+                const int upper     = above != nullptr ? above[i] : 0;
+                const int upperLeft = above != nullptr && i >= 4 ? above[i - 4] : 0;
+                int       predicted = 0;
+                switch (in[0])
+                {
+                case 0:
+                    break;
+                case 1:
+                    predicted = left;
+                    break;
+                case 2:
+                    predicted = upper;
+                    break;
+                case 3:
+                    predicted = (left + upper) / 2;
+                    break;
+                case 4:
+                {
+                    const int p  = left + upper - upperLeft;
+                    const int pa = std::abs(p - left);
+                    const int pb = std::abs(p - upper);
+                    const int pc = std::abs(p - upperLeft);
+                    predicted    = pa <= pb && pa <= pc ? left : pb <= pc ? upper : upperLeft;
+                    break;
+                }
+                default:
+                    return {};
+                }
+                row[i] = static_cast<std::uint8_t>(in[1 + i] + predicted);
+            }
+        }
+        return rows;
+    }
+
+    bool PngBandsDecodeToEveryRow()
+    {
+        // Tall enough for several bands, with content that changes across every band boundary so each band's filters
+        // and dictionary depend on the rows before it.
+        constexpr std::uint32_t kWidth  = 45;
+        constexpr std::uint32_t kHeight = 301;
+
+        Random                     random;
+        std::vector<std::uint32_t> pixels(kWidth * kHeight);
+        for (std::uint32_t y = 0; y < kHeight; ++y)
+        {
+            for (std::uint32_t x = 0; x < kWidth; ++x)
+            {
+                // Smooth diagonal bands that favour the Up and Paeth filters, sprinkled with noise that favours None.
+                const std::uint32_t a = (x + y) % 3 == 0 ? 255 : (x * 5 + y * 3) % 256;
+                const std::uint32_t c = (x + 2 * y) % (a + 1);
+                const std::uint32_t smooth = c | (c << 8) | (c / 2 << 16) | (a << 24);
+                pixels[y * kWidth + x]     = random.next() % 7 == 0 ? random.pixel() : smooth;
+            }
+        }
+
+        std::vector<std::uint8_t> expected(pixels.size() * 4);
+        ConvertSpan(expected.data(), reinterpret_cast<const std::uint8_t*>(pixels.data()),
+                    static_cast<std::int32_t>(pixels.size()), false, true);
+
+        const BlendKernels& kernels = GetBlendKernels(DetectSimdLevel());
+        WorkerPool          pool(6);
+        EncodeScratch       scratch;
+        bool                ok = true;
+        for (int level : {0, 1, 6, 9})
+        {
+            for (WorkerPool* encodePool : {static_cast<WorkerPool*>(nullptr), &pool})
+            {
+                std::vector<std::uint8_t> png;
+                ok &= Check(EncodePng(reinterpret_cast<const std::uint8_t*>(pixels.data()), kWidth * 4, kWidth,
+                                      kHeight, level, kernels, encodePool, &scratch, &png),
+                            "PNG encodes");
+                const auto rows = DecodePngRows(png, kWidth, kHeight);
+                ok &= Check(rows.size() == expected.size(), "PNG inflates to one filtered scanline per row");
+                for (std::uint32_t y = 0; y < kHeight && rows.size() == expected.size(); ++y)
+                {
+                    const std::size_t offset = static_cast<std::size_t>(y) * kWidth * 4;
+                    if (std::memcmp(rows.data() + offset, expected.data() + offset, kWidth * 4) != 0)
+                    {
+                        std::fprintf(stderr, "  level %d, %s: row %u differs\n", level,
+                                     encodePool != nullptr ? "banded" : "one band", y);
+                        ok = false;
+                        break;
+                    }
+                }
+            }
+        }
+        return ok;
+    }
+#endif
+
+    struct TestCase
+    {
+        const char* name;
+        bool (*run)();
+    };
+
+    const TestCase kTests[] = {
+        {"ParallelRasterizationMatchesSingleThreaded", &ParallelRasterizationMatchesSingleThreaded},
+        {"BlendKernelsMatchPortable", &BlendKernelsMatchPortable},
+        {"ConvertKernelsMatchPortable", &ConvertKernelsMatchPortable},
+#if defined(RIVE_RENDERER_CPU_TESTS_HAVE_ZLIB)
+        {"PngBandsDecodeToEveryRow", &PngBandsDecodeToEveryRow},
+#endif
+    };
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int failures = 0;
+    int ran      = 0;
+    for (const auto& test : kTests)
+    {
+        if (argc > 1 && std::strcmp(argv[1], test.name) != 0)
+        {
+            continue;
+        }
+        ++ran;
+        const bool passed = test.run();
+        std::printf("%s %s\n", passed ? "PASS" : "FAIL", test.name);
+        failures += passed ? 0 : 1;
+    }
+    if (ran == 0)
+    {
+        std::fprintf(stderr, "no test named %s\n", argv[1]);
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
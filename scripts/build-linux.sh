@@ -25,6 +25,14 @@ fi
 
 mkdir -p "${RUNTIME_ROOT}"
 
+# Set RIVE_RENDERER_FFI_VULKAN=1 to build the headless Vulkan backend alongside the CPU one.
+PREMAKE_ARGS="--with_rive_text --with_rive_layout"
+FFI_CMAKE_ARGS=()
+if [[ "${RIVE_RENDERER_FFI_VULKAN:-0}" == "1" ]]; then
+  PREMAKE_ARGS="${PREMAKE_ARGS} --with_vulkan"
+  FFI_CMAKE_ARGS+=(-DRIVE_RENDERER_FFI_VULKAN=ON)
+fi
+
 SEARCH_DIRS=(
   "${ROOT_DIR}/extern/river-renderer/out"
   "${ROOT_DIR}/extern/river-renderer/renderer/out"
@@ -133,7 +141,7 @@ for config in "${CONFIGS[@]}"; do
     if [[ ! -f premake5.lua ]]; then
       ln -sf premake5_v2.lua premake5.lua
     fi
-    RIVE_PREMAKE_ARGS="--with_rive_text --with_rive_layout" ./build/build_rive.sh clean >/dev/null 2>&1 || true
+    RIVE_PREMAKE_ARGS="${PREMAKE_ARGS}" ./build/build_rive.sh clean >/dev/null 2>&1 || true
     rm -rf out
   )
 
@@ -143,20 +151,21 @@ for config in "${CONFIGS[@]}"; do
     if [[ ! -f premake5.lua ]]; then
       ln -sf premake5_v2.lua premake5.lua
     fi
-    RIVE_PREMAKE_ARGS="--with_rive_text --with_rive_layout" ./build/build_rive.sh "${config}"
+    RIVE_PREMAKE_ARGS="${PREMAKE_ARGS}" ./build/build_rive.sh "${config}"
   )
 
   echo "==> Building river-renderer GPU targets (${config})"
   (
     cd "${ROOT_DIR}/extern/river-renderer/renderer"
-    RIVE_PREMAKE_ARGS="--with_rive_text --with_rive_layout" ../build/build_rive.sh clean >/dev/null 2>&1 || true
+    RIVE_PREMAKE_ARGS="${PREMAKE_ARGS}" ../build/build_rive.sh clean >/dev/null 2>&1 || true
     rm -rf out
-    RIVE_PREMAKE_ARGS="--with_rive_text --with_rive_layout" ../build/build_rive.sh "${config}"
+    RIVE_PREMAKE_ARGS="${PREMAKE_ARGS}" ../build/build_rive.sh "${config}"
   )
 
   BUILD_DIR="${ROOT_DIR}/renderer_ffi/build-linux-${config}"
   echo "==> Configuring renderer_ffi (${config})"
-  cmake -S "${ROOT_DIR}/renderer_ffi" -B "${BUILD_DIR}" -G "Ninja" -DCMAKE_BUILD_TYPE="${config^}"
+  cmake -S "${ROOT_DIR}/renderer_ffi" -B "${BUILD_DIR}" -G "Ninja" -DCMAKE_BUILD_TYPE="${config^}" \
+    ${FFI_CMAKE_ARGS[@]+"${FFI_CMAKE_ARGS[@]}"}
 
   echo "==> Building renderer_ffi (${config})"
   cmake --build "${BUILD_DIR}"
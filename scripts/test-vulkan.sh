@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+
+# Runs the managed Vulkan backend tests on Mesa's lavapipe. Build the native library first with
+# RIVE_RENDERER_FFI_VULKAN=1 ./scripts/build-linux.sh <config>, and install mesa-vulkan-drivers.
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+ROOT_DIR="$(cd "${SCRIPT_DIR}/.." && pwd)"
+
+CONFIG="${1:-release}"
+CONFIG_LOWER="$(echo "${CONFIG}" | tr '[:upper:]' '[:lower:]')"
+
+RUNTIME_DIR="${ROOT_DIR}/dotnet/RiveRenderer/runtimes/linux-$(uname -m)/native/${CONFIG_LOWER}"
+if [[ ! -d "${RUNTIME_DIR}" ]]; then
+    echo "error: runtime directory ${RUNTIME_DIR} not found. Build native artifacts first." >&2
+    exit 1
+fi
+export LD_LIBRARY_PATH="${RUNTIME_DIR}:${LD_LIBRARY_PATH:-}"
+
+# Point the loader at lavapipe alone, so a GPU driver on the machine cannot stand in for it.
+if [[ -z "${VK_ICD_FILENAMES:-}" ]]; then
+    LVP_ICD="$(ls /usr/share/vulkan/icd.d/lvp_icd*.json 2>/dev/null | head -n 1 || true)"
+    if [[ -z "${LVP_ICD}" ]]; then
+        echo "error: lavapipe ICD not found; install mesa-vulkan-drivers." >&2
+        exit 1
+    fi
+    export VK_ICD_FILENAMES="${LVP_ICD}"
+fi
+
+# Fail rather than skip when lavapipe cannot be used.
+export RIVE_RENDERER_REQUIRE_LAVAPIPE=1
+
+echo "Running Vulkan backend tests on ${VK_ICD_FILENAMES} (config=${CONFIG_LOWER})" >&2
+dotnet test "${ROOT_DIR}/dotnet/RiveRenderer.Tests/RiveRenderer.Tests.csproj" -c Release \
+    --filter "FullyQualifiedName~RiveRenderer.Tests.VulkanBackendTests"